@@ -0,0 +1,192 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "BgJob.h"
+#include "Scheduler.h"
+#include "MidStm.h"
+#include "ExeVerification.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define BG_JOB_GUARD_CNT            (BG_JOB_GUARD_US * MID_TIMER_CNT_PER_US)
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static BgJob stBgJob[BG_JOB_NUMBER];
+static uint32_t ulBgJobNext = 0u;      /*Round robin position*/
+static uint32_t ulBgJobDeferEndCnt = 0u;   /*Release of the last slice that postponed a step*/
+static uint64 ullBgJobLoadNowCnt = 0u;
+static uint64 ullBgJobLoadBusyCnt = 0u;
+
+BgJobStat stBgJobStat;
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Queue--------------------------*/
+/*
+ * Queues a job, callable from any task. param_StepBudgetUs is the longest
+ * step expected, a longer measured step replaces it. A job already queued
+ * with the same step function and context is not queued twice.
+ * FALSE if the queue is full.
+ */
+boolean BgJobSubmit(BgJobStepFnc param_StepFnc, void *param_Ctx, uint32_t param_StepBudgetUs)
+{
+    uint32_t ulIdx;
+    uint32_t ulFreeIdx = BG_JOB_NUMBER;
+    boolean bAccepted = TRUE;
+    boolean bEnabled = Scheduler_EnterCritical();
+
+    for(ulIdx = 0u; ulIdx < BG_JOB_NUMBER; ulIdx++)
+    {
+        if((stBgJob[ulIdx].pStepFnc == param_StepFnc) && (stBgJob[ulIdx].pCtx == param_Ctx))
+        {
+            break;
+        }
+
+        if((stBgJob[ulIdx].pStepFnc == NULL_PTR) && (ulFreeIdx == BG_JOB_NUMBER))
+        {
+            ulFreeIdx = ulIdx;
+        }
+    }
+
+    if(ulIdx == BG_JOB_NUMBER)
+    {
+        if(ulFreeIdx < BG_JOB_NUMBER)
+        {
+            stBgJob[ulFreeIdx].pCtx            = param_Ctx;
+            stBgJob[ulFreeIdx].ulStepBudgetCnt = param_StepBudgetUs * MID_TIMER_CNT_PER_US;
+            stBgJob[ulFreeIdx].ulStepCnt       = 0u;
+            stBgJob[ulFreeIdx].pStepFnc        = param_StepFnc;
+        }
+        else
+        {
+            stBgJobStat.ulRejectCnt++;
+            bAccepted = FALSE;
+        }
+    }
+
+    Scheduler_ExitCritical(bEnabled);
+
+    return bAccepted;
+}
+
+/*---------------------Background Slice--------------------------*/
+/*
+ * Called by the background loop when no task is ready. One step of each
+ * queued job, round robin, as long as the longest step of the job still ends
+ * before param_EndCnt (STM count of the next release). Steps run to
+ * completion: a job only yields between two steps.
+ * TRUE if a step did some work.
+ */
+boolean BgJobRun(uint32_t param_EndCnt)
+{
+    uint32_t ulTurn;
+    boolean bWorked = FALSE;
+
+    for(ulTurn = 0u; ulTurn < BG_JOB_NUMBER; ulTurn++)
+    {
+        BgJob *pJob = &stBgJob[ulBgJobNext];
+        BgJobStepFnc pStepFnc = pJob->pStepFnc;
+        ExeProfCtx stProfCtx;
+        E_BG_JOB_STATE eState;
+        uint32_t ulExecCnt;
+
+        ulBgJobNext = (ulBgJobNext + 1u) % BG_JOB_NUMBER;
+
+        if(pStepFnc == NULL_PTR)
+        {
+            continue;
+        }
+
+        if((int32_t)(param_EndCnt - MidGetTimerCnt()) < (int32_t)(pJob->ulStepBudgetCnt + BG_JOB_GUARD_CNT))
+        {
+            if(param_EndCnt != ulBgJobDeferEndCnt)
+            {
+                ulBgJobDeferEndCnt = param_EndCnt;
+                stBgJobStat.ulDeferCnt++;
+            }
+            continue;
+        }
+
+        ExeProfStart(&stProfCtx);
+        eState = pStepFnc(pJob->pCtx);
+
+        /*A waiting step is not profiled, so its time stays idle*/
+        if(eState == BG_JOB_WAIT)
+        {
+            continue;
+        }
+
+        ulExecCnt = ExeProfStop(EXE_PROF_BG_JOB, &stProfCtx);
+        bWorked = TRUE;
+        pJob->ulStepCnt++;
+        stBgJobStat.ulStepCnt++;
+
+        if(ulExecCnt > pJob->ulStepBudgetCnt)
+        {
+            pJob->ulStepBudgetCnt = ulExecCnt;
+        }
+
+        if((int32_t)(MidGetTimerCnt() - param_EndCnt) > 0)
+        {
+            stBgJobStat.ulLateCnt++;
+        }
+
+        if(eState == BG_JOB_DONE)
+        {
+            boolean bEnabled = Scheduler_EnterCritical();
+
+            pJob->pStepFnc = NULL_PTR;
+
+            Scheduler_ExitCritical(bEnabled);
+        }
+    }
+
+    return bWorked;
+}
+
+/*---------------------CPU Load--------------------------*/
+/*
+ * Busy share of the time since the previous call. Busy is the time of the
+ * profiled tasks, ISRs and job steps, the rest (background loop, waiting
+ * steps, CPU idle mode) is idle. Called once per load window.
+ */
+void BgJobUpdateLoad(void)
+{
+    uint64 ullNowCnt;
+    uint64 ullBusyCnt;
+
+    ExeProfGetBusy(&ullNowCnt, &ullBusyCnt);
+
+    if((ullBgJobLoadNowCnt != 0u) && (ullNowCnt > ullBgJobLoadNowCnt))
+    {
+        uint64 ullLoad = ((ullBusyCnt - ullBgJobLoadBusyCnt) * 1000u) / (ullNowCnt - ullBgJobLoadNowCnt);
+
+        stBgJobStat.ulCpuLoadPm = (ullLoad > 1000u) ? 1000u : (uint32_t)ullLoad;
+    }
+
+    ullBgJobLoadNowCnt  = ullNowCnt;
+    ullBgJobLoadBusyCnt = ullBusyCnt;
+}
+
+/*Per mille*/
+uint32_t BgJobGetCpuLoad(void)
+{
+    return stBgJobStat.ulCpuLoadPm;
+}
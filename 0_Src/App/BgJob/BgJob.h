@@ -0,0 +1,61 @@
+#ifndef BGJOB_H
+#define BGJOB_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define BG_JOB_NUMBER               8u      /*Jobs queued at the same time*/
+#define BG_JOB_GUARD_US             10u     /*Margin kept before the next task release*/
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef enum
+{
+    BG_JOB_DONE = 0u,                   /*Finished, the slot is freed*/
+    BG_JOB_PENDING,                     /*Work done, call again*/
+    BG_JOB_WAIT                         /*Nothing could be done (resource busy), call again; counted as idle*/
+}E_BG_JOB_STATE;
+
+/*
+ * Resumable step of a job. One call does a bounded piece of the work, the
+ * state of the job is kept in param_Ctx between the calls.
+ */
+typedef E_BG_JOB_STATE (*BgJobStepFnc)(void *param_Ctx);
+
+typedef struct
+{
+    BgJobStepFnc pStepFnc;              /*NULL_PTR : free slot*/
+    void *pCtx;
+    uint32_t ulStepBudgetCnt;           /*Longest step, declared or measured, STM count*/
+    uint32_t ulStepCnt;
+}BgJob;
+
+typedef struct
+{
+    uint32_t ulStepCnt;                 /*Steps run*/
+    uint32_t ulDeferCnt;                /*Slices ended with a step postponed: it could have reached the next release*/
+    uint32_t ulLateCnt;                 /*Steps that ended after the next release anyway*/
+    uint32_t ulRejectCnt;               /*Submits with a full queue*/
+    uint32_t ulCpuLoadPm;               /*Busy time of the last window, per mille*/
+}BgJobStat;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+extern BgJobStat stBgJobStat;
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+boolean BgJobSubmit(BgJobStepFnc param_StepFnc, void *param_Ctx, uint32_t param_StepBudgetUs);
+boolean BgJobRun(uint32_t param_EndCnt);
+void BgJobUpdateLoad(void);
+uint32_t BgJobGetCpuLoad(void);
+#endif
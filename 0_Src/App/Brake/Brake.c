@@ -0,0 +1,151 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <math.h>
+#include "Brake.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static float32_t BrakeDistance(Brake *param_Brake, float32_t param_Speed);
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void BrakeInit(Brake *param_Brake, const BrakeConfig *param_Cfg, uint32_t param_Mode)
+{
+    param_Brake->stCfg   = *param_Cfg;
+    param_Brake->ulMode  = BRAKE_COAST;
+    param_Brake->ulState = BRAKE_OFF;
+    param_Brake->fDuty   = 0.0f;
+
+    BrakeSetMode(param_Brake, param_Mode);
+}
+
+/*Takes effect at the next BrakeStart, coast also releases a brake applied*/
+void BrakeSetMode(Brake *param_Brake, uint32_t param_Mode)
+{
+    if(param_Mode >= BRAKE_MODE_NUMBER)
+    {
+        return;
+    }
+
+    param_Brake->ulMode = param_Mode;
+
+    if(param_Mode == BRAKE_COAST)
+    {
+        BrakeRelease(param_Brake);
+    }
+}
+
+/*---------------------Stop--------------------------*/
+/*Stop from param_Speed (magnitude), nothing to do when coasting*/
+void BrakeStart(Brake *param_Brake, float32_t param_Speed)
+{
+    if(param_Brake->ulMode == BRAKE_COAST)
+    {
+        return;
+    }
+
+    param_Brake->fSpeedStart = param_Speed;
+    param_Brake->fDecel      = (param_Speed * param_Speed) / (2.0f * param_Brake->stCfg.fDistance);
+    param_Brake->fTravel     = 0.0f;
+    param_Brake->fIntegral   = 0.0f;
+    param_Brake->fDuty       = 0.0f;
+    param_Brake->ulState     = (param_Speed < param_Brake->stCfg.fSpeedMin) ? BRAKE_STOPPED : BRAKE_STOPPING;
+}
+
+void BrakeRelease(Brake *param_Brake)
+{
+    param_Brake->ulState = BRAKE_OFF;
+    param_Brake->fDuty   = 0.0f;
+}
+
+/*
+ * One step of stCfg.fSampleTime with the measured speed (magnitude). Returns
+ * the strength in %, the share of the PWM period with the motors shorted.
+ */
+float32_t BrakeStep(Brake *param_Brake, float32_t param_Speed)
+{
+    float32_t fDuty = 0.0f;
+
+    if(param_Brake->ulState == BRAKE_STOPPING)
+    {
+        param_Brake->fTravel += param_Speed * param_Brake->stCfg.fSampleTime;
+
+        if(param_Speed < param_Brake->stCfg.fSpeedMin)
+        {
+            param_Brake->ulState = BRAKE_STOPPED;
+            fDuty = BRAKE_DUTY_MAX;
+        }
+        else if(param_Brake->ulMode == BRAKE_DYNAMIC)
+        {
+            fDuty = BRAKE_DUTY_MAX;
+        }
+        else if(param_Brake->ulMode == BRAKE_PWM)
+        {
+            fDuty = param_Brake->stCfg.fStrength;
+        }
+        else if(param_Brake->ulMode == BRAKE_DISTANCE)
+        {
+            fDuty = BrakeDistance(param_Brake, param_Speed);
+        }
+        else
+        {
+            /*No Code*/
+        }
+    }
+    else if(param_Brake->ulState == BRAKE_STOPPED)
+    {
+        /*No current at standstill, the short only resists a push*/
+        fDuty = BRAKE_DUTY_MAX;
+    }
+    else
+    {
+        /*No Code*/
+    }
+
+    param_Brake->fDuty = fDuty;
+
+    return fDuty;
+}
+
+/*---------------------Static Function--------------------------*/
+/*PI on the speed above the profile, the integral kept within 0..BRAKE_DUTY_MAX*/
+static float32_t BrakeDistance(Brake *param_Brake, float32_t param_Speed)
+{
+    const BrakeConfig *pCfg = &param_Brake->stCfg;
+    float32_t fLeft = pCfg->fDistance - param_Brake->fTravel;
+    float32_t fRef  = (fLeft > 0.0f) ? sqrtf(2.0f * param_Brake->fDecel * fLeft) : 0.0f;
+    float32_t fError = param_Speed - fRef;
+    float32_t fIntegral = param_Brake->fIntegral + (pCfg->fKi * fError * pCfg->fSampleTime);
+    float32_t fDuty;
+
+    fIntegral = (fIntegral > BRAKE_DUTY_MAX) ? BRAKE_DUTY_MAX : fIntegral;
+    fIntegral = (fIntegral < 0.0f) ? 0.0f : fIntegral;
+    param_Brake->fIntegral = fIntegral;
+
+    fDuty = (pCfg->fKp * fError) + fIntegral;
+    fDuty = (fDuty > BRAKE_DUTY_MAX) ? BRAKE_DUTY_MAX : fDuty;
+    fDuty = (fDuty < 0.0f) ? 0.0f : fDuty;
+
+    return fDuty;
+}
@@ -0,0 +1,78 @@
+#ifndef BRAKE_H
+#define BRAKE_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define BRAKE_DUTY_MAX              100.0f  /*Enable always on*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef enum
+{
+    BRAKE_COAST = 0u,                   /*Enables off, the car rolls out on friction*/
+    BRAKE_DYNAMIC,                      /*Motors shorted by the bridge, full strength*/
+    BRAKE_PWM,                          /*Shorted for fStrength of each PWM period*/
+    BRAKE_DISTANCE,                     /*Strength from the speed and the distance left*/
+    BRAKE_MODE_NUMBER
+}E_BRAKE_MODE;
+
+typedef enum
+{
+    BRAKE_OFF = 0u,                     /*The speed loops drive*/
+    BRAKE_STOPPING,
+    BRAKE_STOPPED                       /*Held at BRAKE_DUTY_MAX until BrakeRelease*/
+}E_BRAKE_STATE;
+
+/*Speeds in m/s, lengths in m, times in s, strength in % of the PWM period*/
+typedef struct
+{
+    float32_t fStrength;                /*BRAKE_PWM*/
+    float32_t fDistance;                /*BRAKE_DISTANCE: from BrakeStart to standstill*/
+    float32_t fKp;                      /*% per m/s above the stop profile*/
+    float32_t fKi;                      /*% per m above the stop profile*/
+    float32_t fSpeedMin;                /*Stopped below*/
+    float32_t fSampleTime;              /*Period of BrakeStep*/
+}BrakeConfig;
+
+/*
+ * Stop of the car. BRAKE_DISTANCE follows the constant deceleration profile
+ * from the speed at BrakeStart to 0 over fDistance,
+ *   v(s) = sqrt(2*a*(fDistance - s)),  a = v0^2 / (2*fDistance)
+ * with a PI on the measured speed above it. A braked motor only slows down:
+ * below the profile the strength goes to 0 and the car rolls out.
+ */
+typedef struct
+{
+    BrakeConfig stCfg;
+    uint32_t ulMode;                    /*E_BRAKE_MODE*/
+    uint32_t ulState;                   /*E_BRAKE_STATE*/
+    float32_t fDecel;                   /*a of the profile*/
+    float32_t fSpeedStart;
+    float32_t fTravel;                  /*Since BrakeStart*/
+    float32_t fIntegral;
+    float32_t fDuty;                    /*Last strength*/
+}Brake;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void BrakeInit(Brake *param_Brake, const BrakeConfig *param_Cfg, uint32_t param_Mode);
+void BrakeSetMode(Brake *param_Brake, uint32_t param_Mode);
+void BrakeStart(Brake *param_Brake, float32_t param_Speed);
+void BrakeRelease(Brake *param_Brake);
+float32_t BrakeStep(Brake *param_Brake, float32_t param_Speed);
+#endif
@@ -0,0 +1,81 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "ExeTrace.h"
+#include "IfxStm.h"
+#include "IfxCpu.h"
+#include "MidStm.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define EXE_TRACE_RECORD_MASK       (EXE_TRACE_RECORD_NUMBER - 1u)
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+/*LMU RAM: not in the CPU0 DSPR used by the stacks and the drivers*/
+ExeTraceBuffer stExeTraceBuffer __attribute__ ((section (".bss_lmu"), aligned(8)));
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void ExeTraceInit(void)
+{
+    stExeTraceBuffer.ulMagic        = EXE_TRACE_MAGIC;
+    stExeTraceBuffer.ulRecordNumber = EXE_TRACE_RECORD_NUMBER;
+    stExeTraceBuffer.ulTimeCntPerUs = MID_TIMER_CNT_PER_US;
+    stExeTraceBuffer.ulHead         = 0u;
+    stExeTraceBuffer.ulFreeze       = OFF;
+}
+
+/*---------------------Record--------------------------*/
+/*
+ * Callable from any interrupt level. The slot is reserved with cmpswap, a
+ * writer preempted between the reservation and the store only delays its own
+ * record: the preempting writers take the next slots.
+ */
+void ExeTraceEvent(E_EXE_TRACE_EVENT param_Event, uint32_t param_Id, uint32_t param_Data)
+{
+    ExeTraceRecord *pRecord;
+    uint32_t ulHead;
+
+    if(stExeTraceBuffer.ulFreeze != OFF)
+    {
+        return;
+    }
+
+    do
+    {
+        ulHead = stExeTraceBuffer.ulHead;
+    } while(__cmpAndSwap((unsigned int volatile *)&stExeTraceBuffer.ulHead, ulHead + 1u, ulHead) != ulHead);
+
+    pRecord = &stExeTraceBuffer.stRecord[ulHead & EXE_TRACE_RECORD_MASK];
+    pRecord->ulTimeCnt = IfxStm_getLower(&MODULE_STM0);
+    pRecord->ulInfo    = EXE_TRACE_INFO(param_Event, param_Id, param_Data);
+}
+
+void ExeTraceMarker(uint32_t param_Id, uint32_t param_Data)
+{
+    EXE_TRACE(EXE_TRACE_MARKER, param_Id, param_Data);
+}
+
+/*ON stops the recording, e.g. right after a latency spike, before the dump*/
+void ExeTraceFreeze(uint32_t param_Freeze)
+{
+    stExeTraceBuffer.ulFreeze = param_Freeze;
+}
@@ -0,0 +1,75 @@
+#ifndef EXETRACE_H
+#define EXETRACE_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define EXE_TRACE_ENABLE            ON
+#define EXE_TRACE_RECORD_BITS       11u     /*2048 records, 16KB of the 32KB LMU RAM*/
+#define EXE_TRACE_RECORD_NUMBER     (0x1u << EXE_TRACE_RECORD_BITS)
+#define EXE_TRACE_MAGIC             0x31435254u /*"TRC1"*/
+
+/*Record info word: event [31:24], id [23:16], data [15:0]*/
+#define EXE_TRACE_INFO(event, id, data)     ((((uint32_t)(event) & 0xFFu) << 24) | \
+                                             (((uint32_t)(id) & 0xFFu) << 16) | \
+                                             ((uint32_t)(data) & 0xFFFFu))
+
+#if (EXE_TRACE_ENABLE == ON)
+#define EXE_TRACE(event, id, data)          ExeTraceEvent((event), (id), (data))
+#else
+#define EXE_TRACE(event, id, data)
+#endif
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef enum
+{
+    EXE_TRACE_TASK_BEGIN = 1u,          /*id : E_SCHEDULER_TASK*/
+    EXE_TRACE_TASK_END,
+    EXE_TRACE_ISR_ENTER,                /*id : E_EXE_PROF_ID*/
+    EXE_TRACE_ISR_EXIT,
+    EXE_TRACE_MARKER                    /*id and data : user defined*/
+}E_EXE_TRACE_EVENT;
+
+typedef struct
+{
+    uint32_t ulTimeCnt;                 /*STM0 lower count*/
+    uint32_t ulInfo;                    /*EXE_TRACE_INFO*/
+}ExeTraceRecord;
+
+/*
+ * Layout of the dump read by the debugger or the host sim and decoded by
+ * 1_ToolEnv/2_TraceDecode. The oldest record is at ulHead % ulRecordNumber
+ * once the ring has wrapped.
+ */
+typedef struct
+{
+    uint32_t ulMagic;
+    uint32_t ulRecordNumber;
+    uint32_t ulTimeCntPerUs;
+    volatile uint32_t ulHead;           /*Records reserved since the start*/
+    volatile uint32_t ulFreeze;         /*ON : records are dropped, the ring can be read*/
+    uint32_t ulReserved;
+    ExeTraceRecord stRecord[EXE_TRACE_RECORD_NUMBER];
+}ExeTraceBuffer;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+extern ExeTraceBuffer stExeTraceBuffer;
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void ExeTraceInit(void);
+void ExeTraceEvent(E_EXE_TRACE_EVENT param_Event, uint32_t param_Id, uint32_t param_Data);
+void ExeTraceMarker(uint32_t param_Id, uint32_t param_Data);
+void ExeTraceFreeze(uint32_t param_Freeze);
+#endif
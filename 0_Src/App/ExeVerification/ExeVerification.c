@@ -1,33 +1,300 @@
 /*----------------------------------------------------------------*/
 /*                        Include Header File                          */
 /*----------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
 #include "ExeVerification.h"
+#include "IfxStm.h"
+#include "IfxCpu.h"
+#include "DrvAsc.h"
+#include "MidStm.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
-
+#define EXE_PROF_DUMP_LINE_SIZE     128u
+#define EXE_PROF_DUMP_HIST_BINS     8u      /*Histogram bins per dump line*/
+#define EXE_PROF_DUMP_HIST_LINES    (EXE_PROF_HIST_BIN_NUMBER / EXE_PROF_DUMP_HIST_BINS)
 
 /*----------------------------------------------------------------*/
 /*                        Typedefs                                    */
 /*----------------------------------------------------------------*/
 
 
-
 /*----------------------------------------------------------------*/
 /*                        Static Function Prototype                  */
 /*----------------------------------------------------------------*/
+static uint32_t ExeProfUpdate(E_EXE_PROF_ID param_Id, const ExeProfCtx *param_Ctx, boolean param_Release, uint32_t param_ReleaseCnt);
+static uint32_t ExeProfLog2(uint32_t param_Value);
+static uint32_t ExeProfDumpFormat(void);
 
 
 /*----------------------------------------------------------------*/
 /*                        Variables                                    */
 /*----------------------------------------------------------------*/
-CycleInfo stCycleInfo;
+ExeProfStat stExeProfStat[EXE_PROF_NUMBER];
+uint64 ullExeProfNestedCnt = 0u;       /*Measured time of the completed outermost sections*/
+
+static uint32_t ulExeProfDumpId = EXE_PROF_NUMBER;
+static uint32_t ulExeProfDumpLine = 0u;
+static ExeProfStat stExeProfDumpStat;
+static char cExeProfDumpBuf[EXE_PROF_DUMP_LINE_SIZE];
+static uint32_t ulExeProfDumpLen = 0u;
+static uint32_t ulExeProfDumpPos = 0u;
 
 
 /*----------------------------------------------------------------*/
 /*                        Functions                                    */
 /*----------------------------------------------------------------*/
 
+/*---------------------Measurement--------------------------*/
+/*
+ * The STM0 lower count and the CAP latch are read under lock: a nested read
+ * between them would overwrite CAP.
+ */
+void ExeProfStart(ExeProfCtx *param_Ctx)
+{
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    param_Ctx->ullStartCnt  = IfxStm_get(&MODULE_STM0);
+    param_Ctx->ullNestedCnt = ullExeProfNestedCnt;
+
+    IfxCpu_restoreInterrupts(bEnabled);
+}
+
+/*Returns the execution time without the nested sections, STM ticks*/
+uint32_t ExeProfStop(E_EXE_PROF_ID param_Id, const ExeProfCtx *param_Ctx)
+{
+    return ExeProfUpdate(param_Id, param_Ctx, FALSE, 0u);
+}
+
+/*As ExeProfStop, the start jitter is taken against the STM lower count param_ReleaseCnt*/
+uint32_t ExeProfStopRelease(E_EXE_PROF_ID param_Id, const ExeProfCtx *param_Ctx, uint32_t param_ReleaseCnt)
+{
+    return ExeProfUpdate(param_Id, param_Ctx, TRUE, param_ReleaseCnt);
+}
+
+static uint32_t ExeProfUpdate(E_EXE_PROF_ID param_Id, const ExeProfCtx *param_Ctx, boolean param_Release, uint32_t param_ReleaseCnt)
+{
+    ExeProfStat *pStat = &stExeProfStat[param_Id];
+    boolean bEnabled = IfxCpu_disableInterrupts();
+    uint64 ullGrossCnt = IfxStm_get(&MODULE_STM0) - param_Ctx->ullStartCnt;
+    uint64 ullExecCnt = ullGrossCnt - (ullExeProfNestedCnt - param_Ctx->ullNestedCnt);
+    uint32_t ulExecCnt = (ullExecCnt > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (uint32_t)ullExecCnt;
+
+    /*The enclosing section only sees this one, the sections nested here are in ullGrossCnt*/
+    ullExeProfNestedCnt = param_Ctx->ullNestedCnt + ullGrossCnt;
+
+    if((pStat->ulRunCnt == 0u) || (ulExecCnt < pStat->ulMinExecCnt))
+    {
+        pStat->ulMinExecCnt = ulExecCnt;
+    }
+
+    if(ulExecCnt > pStat->ulMaxExecCnt)
+    {
+        pStat->ulMaxExecCnt = ulExecCnt;
+    }
+
+    pStat->ulRunCnt++;
+    pStat->ullSumExecCnt += ulExecCnt;
+    pStat->ullLastStartCnt = param_Ctx->ullStartCnt;
+    pStat->ulExecHist[ExeProfLog2(ulExecCnt)]++;
+
+    if(param_Release != FALSE)
+    {
+        /*Wrap safe as long as the start is within 21s of the release*/
+        int32_t slJitterCnt = (int32_t)((uint32_t)param_Ctx->ullStartCnt - param_ReleaseCnt);
+
+        if((pStat->ulReleaseCnt == 0u) || (slJitterCnt < pStat->slMinJitterCnt))
+        {
+            pStat->slMinJitterCnt = slJitterCnt;
+        }
+
+        if((pStat->ulReleaseCnt == 0u) || (slJitterCnt > pStat->slMaxJitterCnt))
+        {
+            pStat->slMaxJitterCnt = slJitterCnt;
+        }
+
+        pStat->ulReleaseCnt++;
+        pStat->sllSumJitterCnt += slJitterCnt;
+    }
+
+    IfxCpu_restoreInterrupts(bEnabled);
+
+    return ulExecCnt;
+}
+
+/*Index of the highest set bit, 0 for 0*/
+static uint32_t ExeProfLog2(uint32_t param_Value)
+{
+    uint32_t ulBit = 0u;
+
+    if(param_Value >= 0x10000u)
+    {
+        param_Value >>= 16;
+        ulBit += 16u;
+    }
+    if(param_Value >= 0x100u)
+    {
+        param_Value >>= 8;
+        ulBit += 8u;
+    }
+    if(param_Value >= 0x10u)
+    {
+        param_Value >>= 4;
+        ulBit += 4u;
+    }
+    if(param_Value >= 0x4u)
+    {
+        param_Value >>= 2;
+        ulBit += 2u;
+    }
+    if(param_Value >= 0x2u)
+    {
+        ulBit += 1u;
+    }
+
+    return ulBit;
+}
+
+/*---------------------Snapshot--------------------------*/
+void ExeProfGetSnapshot(E_EXE_PROF_ID param_Id, ExeProfStat *param_Snapshot)
+{
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    *param_Snapshot = stExeProfStat[param_Id];
+
+    IfxCpu_restoreInterrupts(bEnabled);
+}
+
+/*
+ * STM0 count and time spent in the completed outermost sections, read
+ * together. Everything not profiled is idle for the CPU load.
+ */
+void ExeProfGetBusy(uint64 *param_NowCnt, uint64 *param_BusyCnt)
+{
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    *param_NowCnt  = IfxStm_get(&MODULE_STM0);
+    *param_BusyCnt = ullExeProfNestedCnt;
+
+    IfxCpu_restoreInterrupts(bEnabled);
+}
+
+void ExeProfReset(void)
+{
+    uint32_t ulId;
+
+    for(ulId = 0u; ulId < EXE_PROF_NUMBER; ulId++)
+    {
+        boolean bEnabled = IfxCpu_disableInterrupts();
+
+        memset(&stExeProfStat[ulId], 0, sizeof(ExeProfStat));
+
+        IfxCpu_restoreInterrupts(bEnabled);
+    }
+}
+
+/*---------------------UART Dump--------------------------*/
+/*
+ * Text dump on ASCLIN0, one line per profile and one per non empty group of
+ * histogram bins:
+ *   p <id> <runs> <exec min> <exec max> <exec mean> <jitter min> <jitter max> <jitter mean>
+ *   h <id> <first bin> <count> x8
+ * Every profile is copied when its turn comes, so each line is consistent.
+ */
+void ExeProfDumpStart(void)
+{
+    if(ulExeProfDumpId < EXE_PROF_NUMBER)
+    {
+        return;
+    }
+
+    ulExeProfDumpId   = 0u;
+    ulExeProfDumpLine = 0u;
+    ulExeProfDumpLen  = (uint32_t)sprintf(cExeProfDumpBuf, "# exe prof, STM ticks %lu/us\r\n", (unsigned long)MID_TIMER_CNT_PER_US);
+    ulExeProfDumpPos  = 0u;
+}
+
+/*Non blocking, sends what fits in the UART buffer. Returns the bytes queued*/
+uint32_t ExeProfDumpStep(void)
+{
+    uint32_t ulSent = 0u;
+
+    if(ulExeProfDumpPos == ulExeProfDumpLen)
+    {
+        ulExeProfDumpLen = ExeProfDumpFormat();
+        ulExeProfDumpPos = 0u;
+    }
+
+    if(ulExeProfDumpPos < ulExeProfDumpLen)
+    {
+        ulSent = DrvAscWrite((const uint8_t *)&cExeProfDumpBuf[ulExeProfDumpPos], ulExeProfDumpLen - ulExeProfDumpPos);
+        ulExeProfDumpPos += ulSent;
+    }
+
+    return ulSent;
+}
+
+/*Lines left to format or to send*/
+boolean ExeProfDumpActive(void)
+{
+    return ((ulExeProfDumpId < EXE_PROF_NUMBER) || (ulExeProfDumpPos < ulExeProfDumpLen)) ? TRUE : FALSE;
+}
+
+/*Next line of the dump, 0 at the end*/
+static uint32_t ExeProfDumpFormat(void)
+{
+    while(ulExeProfDumpId < EXE_PROF_NUMBER)
+    {
+        const ExeProfStat *pStat = &stExeProfDumpStat;
+        uint32_t ulFirstBin;
+        uint32_t ulBin;
+        uint32_t ulCnt = 0u;
+
+        if(ulExeProfDumpLine == 0u)
+        {
+            ExeProfGetSnapshot((E_EXE_PROF_ID)ulExeProfDumpId, &stExeProfDumpStat);
+            ulExeProfDumpLine++;
+
+            return (uint32_t)sprintf(cExeProfDumpBuf, "p %lu %lu %lu %lu %lu %ld %ld %ld\r\n",
+                                     (unsigned long)ulExeProfDumpId,
+                                     (unsigned long)pStat->ulRunCnt,
+                                     (unsigned long)pStat->ulMinExecCnt,
+                                     (unsigned long)pStat->ulMaxExecCnt,
+                                     (unsigned long)((pStat->ulRunCnt != 0u) ? (pStat->ullSumExecCnt / pStat->ulRunCnt) : 0u),
+                                     (long)pStat->slMinJitterCnt,
+                                     (long)pStat->slMaxJitterCnt,
+                                     (long)((pStat->ulReleaseCnt != 0u) ? (pStat->sllSumJitterCnt / (sint64)pStat->ulReleaseCnt) : 0));
+        }
+
+        if(ulExeProfDumpLine > EXE_PROF_DUMP_HIST_LINES)
+        {
+            ulExeProfDumpId++;
+            ulExeProfDumpLine = 0u;
+            continue;
+        }
+
+        ulFirstBin = (ulExeProfDumpLine - 1u) * EXE_PROF_DUMP_HIST_BINS;
+        ulExeProfDumpLine++;
+
+        for(ulBin = ulFirstBin; ulBin < (ulFirstBin + EXE_PROF_DUMP_HIST_BINS); ulBin++)
+        {
+            ulCnt |= pStat->ulExecHist[ulBin];
+        }
+
+        if(ulCnt != 0u)
+        {
+            const uint32_t *pHist = &pStat->ulExecHist[ulFirstBin];
 
+            return (uint32_t)sprintf(cExeProfDumpBuf, "h %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu\r\n",
+                                     (unsigned long)ulExeProfDumpId, (unsigned long)ulFirstBin,
+                                     (unsigned long)pHist[0], (unsigned long)pHist[1],
+                                     (unsigned long)pHist[2], (unsigned long)pHist[3],
+                                     (unsigned long)pHist[4], (unsigned long)pHist[5],
+                                     (unsigned long)pHist[6], (unsigned long)pHist[7]);
+        }
+    }
 
+    return 0u;
+}
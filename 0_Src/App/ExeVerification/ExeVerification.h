@@ -5,70 +5,96 @@
 /*                        Include Header File                          */
 /*----------------------------------------------------------------*/
 #include "Ifx_Types.h"
-#include "IfxStm.h"
+#include "Common.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
-#define STM_CLOCK_HZ    100000.0f /*100MHz*/ 
+#define EXE_PROF_ENABLE             ON
+#define EXE_PROF_HIST_BIN_NUMBER    32u     /*Bin n counts the execution times of [2^n, 2^(n+1)) STM ticks, bin 0 also 0*/
 
-#define CYCLE_CHECK(x)   CycleVerfication(x)
+/*
+ * Profiling of a whole ISR body. The execution time of the ISRs nested in it
+ * is not counted, they are profiled on their own.
+ */
+#if (EXE_PROF_ENABLE == ON)
+#define EXE_PROF_ISR_ENTER()                ExeProfCtx stExeProfCtx; ExeProfStart(&stExeProfCtx)
+#define EXE_PROF_ISR_EXIT(id)               (void)ExeProfStop((id), &stExeProfCtx)
+#define EXE_PROF_ISR_EXIT_RELEASE(id, cnt)  (void)ExeProfStopRelease((id), &stExeProfCtx, (cnt))
+#else
+#define EXE_PROF_ISR_ENTER()
+#define EXE_PROF_ISR_EXIT(id)
+#define EXE_PROF_ISR_EXIT_RELEASE(id, cnt)
+#endif
 
 /*----------------------------------------------------------------*/
 /*                        Typedefs                                    */
 /*----------------------------------------------------------------*/
 typedef enum
 {
-    TASK_1MS = 0u,
-    TASK_5MS,
-    TASK_10MS,
-    TASK_50MS,    
-    TASK_100MS,
-    TASK_200MS,
-    TASK_500MS,
-    TASK_1S,
-    TASK_NUMBER    
-}E_TASK;
-    
+    EXE_PROF_TASK_1MS = 0u,             /*Same order as E_SCHEDULER_TASK*/
+    EXE_PROF_TASK_5MS,
+    EXE_PROF_TASK_10MS,
+    EXE_PROF_TASK_50MS,
+    EXE_PROF_TASK_100MS,
+    EXE_PROF_TASK_200MS,
+    EXE_PROF_TASK_500MS,
+    EXE_PROF_TASK_1S,
+    EXE_PROF_ISR_STM0,
+    EXE_PROF_ISR_ASC0_TX,
+    EXE_PROF_ISR_ASC0_RX,
+    EXE_PROF_ISR_ASC0_EX,
+    EXE_PROF_ISR_GPSR_CH1,
+    EXE_PROF_ISR_GPSR_CH2,
+    EXE_PROF_ISR_GPSR_CH3,
+    EXE_PROF_ISR_TFT_UPDATE,
+    EXE_PROF_ISR_QSPI0_TX,
+    EXE_PROF_ISR_QSPI0_RX,
+    EXE_PROF_ISR_QSPI0_ER,
+    EXE_PROF_ISR_BACKLIGHT,
+    EXE_PROF_ISR_ADC_DMA,               /*Motor control step*/
+    EXE_PROF_ISR_ADC_LIMIT,             /*Bridge overcurrent*/
+    EXE_PROF_BG_JOB,                    /*Steps of the background jobs*/
+    EXE_PROF_NUMBER
+}E_EXE_PROF_ID;
+
+/*One measurement in progress, kept on the stack of the measured code*/
+typedef struct
+{
+    uint64 ullStartCnt;                 /*64 bit STM count at the start*/
+    uint64 ullNestedCnt;                /*Nested time counter at the start*/
+}ExeProfCtx;
+
+/*Profile of one task or ISR, all times in STM ticks (10ns)*/
 typedef struct
 {
-    uint8_t ucCycleFlag[TASK_NUMBER];
-    uint32_t ulCycleStartCnt[TASK_NUMBER];
-    uint32_t ulCycleEndCnt[TASK_NUMBER]; 
-    float32_t fCycleTaskMs[TASK_NUMBER];
-}CycleInfo;
+    uint32_t ulRunCnt;
+    uint32_t ulMinExecCnt;
+    uint32_t ulMaxExecCnt;
+    uint64 ullSumExecCnt;               /*Mean = ullSumExecCnt / ulRunCnt*/
+    uint32_t ulReleaseCnt;              /*Runs measured against a release time*/
+    int32_t slMinJitterCnt;             /*Start - ideal release*/
+    int32_t slMaxJitterCnt;
+    sint64 sllSumJitterCnt;             /*Mean = sllSumJitterCnt / ulReleaseCnt*/
+    uint64 ullLastStartCnt;
+    uint32_t ulExecHist[EXE_PROF_HIST_BIN_NUMBER];
+}ExeProfStat;
 
 /*----------------------------------------------------------------*/
 /*                        Variables                                    */
 /*----------------------------------------------------------------*/
-extern CycleInfo stCycleInfo;
+
 
 /*----------------------------------------------------------------*/
 /*                        Global Function Prototype                  */
 /*----------------------------------------------------------------*/
-IFX_INLINE void CycleVerfication(E_TASK param_Task)
-{
-    uint32_t ulTemp = 0u;
-
-    if(stCycleInfo.ucCycleFlag[param_Task] == 0u)
-    {
-        /*Change Cycle Flag*/
-        stCycleInfo.ucCycleFlag[param_Task] = 1u;
-        
-        /*Obtain STM Start Clock*/
-        stCycleInfo.ulCycleStartCnt[param_Task]    = MODULE_STM0.TIM0.U;
-    }
-    else
-    {
-        /*Change Cycle Flag*/
-        stCycleInfo.ucCycleFlag[param_Task] = 0u;    
-        
-        /*Obtain STM End Clock*/
-        stCycleInfo.ulCycleEndCnt[param_Task]    = MODULE_STM0.TIM0.U;
-
-        /*Calculation of Task Execution*/
-        ulTemp = stCycleInfo.ulCycleEndCnt[param_Task] - stCycleInfo.ulCycleStartCnt[param_Task];
-        stCycleInfo.fCycleTaskMs[param_Task] = (float32_t)ulTemp/STM_CLOCK_HZ;
-    }
-}
+void ExeProfStart(ExeProfCtx *param_Ctx);
+uint32_t ExeProfStop(E_EXE_PROF_ID param_Id, const ExeProfCtx *param_Ctx);
+uint32_t ExeProfStopRelease(E_EXE_PROF_ID param_Id, const ExeProfCtx *param_Ctx, uint32_t param_ReleaseCnt);
+void ExeProfGetSnapshot(E_EXE_PROF_ID param_Id, ExeProfStat *param_Snapshot);
+void ExeProfGetBusy(uint64 *param_NowCnt, uint64 *param_BusyCnt);
+void ExeProfReset(void);
+void ExeProfDumpStart(void);
+uint32_t ExeProfDumpStep(void);
+boolean ExeProfDumpActive(void);
 #endif
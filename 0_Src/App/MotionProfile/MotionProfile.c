@@ -0,0 +1,244 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <math.h>
+#include "MotionProfile.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static void MotionProfilePlan(MotionProfile *param_Profile, float32_t param_Target);
+static void MotionProfilePlanSCurve(MotionProfile *param_Profile, float32_t param_Target);
+static void MotionProfileLoadSeg(MotionProfile *param_Profile);
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void MotionProfileInit(MotionProfile *param_Profile, const MotionProfileConfig *param_Cfg)
+{
+    param_Profile->stCfg = *param_Cfg;
+    Ifx_RampF32_init(&param_Profile->stRamp, param_Cfg->fAccelMax, param_Cfg->fSampleTime);
+
+    MotionProfileReset(param_Profile, 0.0f);
+}
+
+/*Stands at param_Vel*/
+void MotionProfileReset(MotionProfile *param_Profile, float32_t param_Vel)
+{
+    param_Profile->stRamp.uk    = param_Vel;
+    param_Profile->stRamp.ik    = param_Vel;
+    param_Profile->ulSegIndex   = MOTION_PROFILE_SEG_NUMBER;
+    param_Profile->ulTickLeft   = 0u;
+    param_Profile->fDv          = 0.0f;
+    param_Profile->fDdv         = 0.0f;
+    param_Profile->fVel         = param_Vel;
+    param_Profile->fTarget      = param_Vel;
+    param_Profile->fPending     = param_Vel;
+    param_Profile->bPending     = FALSE;
+}
+
+/*---------------------Profile--------------------------*/
+/*The plan is made here, not in MotionProfileStep*/
+void MotionProfileSetTarget(MotionProfile *param_Profile, float32_t param_Target)
+{
+    float32_t fVel = param_Profile->fVel;
+
+    if(param_Target == param_Profile->fTarget)
+    {
+        return;
+    }
+
+    param_Profile->fTarget = param_Target;
+
+    if(((fVel > 0.0f) && (param_Target < 0.0f)) || ((fVel < 0.0f) && (param_Target > 0.0f)))
+    {
+        param_Profile->fPending = param_Target;
+        param_Profile->bPending = TRUE;
+        MotionProfilePlan(param_Profile, 0.0f);
+    }
+    else
+    {
+        param_Profile->bPending = FALSE;
+        MotionProfilePlan(param_Profile, param_Target);
+    }
+}
+
+/*
+ * One step of stCfg.fSampleTime, returns the new velocity. Trapezoid: one
+ * add and compare in Ifx_RampF32_step. S-curve: two adds and a count down,
+ * the end of a segment sets its exact end velocity.
+ */
+float32_t MotionProfileStep(MotionProfile *param_Profile)
+{
+    if(param_Profile->stCfg.ulType == MOTION_PROFILE_TRAPEZOID)
+    {
+        param_Profile->fVel = Ifx_RampF32_step(&param_Profile->stRamp);
+    }
+    else if(param_Profile->ulTickLeft != 0u)
+    {
+        param_Profile->fVel += param_Profile->fDv;
+        param_Profile->fDv  += param_Profile->fDdv;
+        param_Profile->ulTickLeft--;
+
+        if(param_Profile->ulTickLeft == 0u)
+        {
+            param_Profile->fVel = param_Profile->stSeg[param_Profile->ulSegIndex].fVelEnd;
+            param_Profile->ulSegIndex++;
+            MotionProfileLoadSeg(param_Profile);
+        }
+    }
+    else
+    {
+        /*No Code*/
+    }
+
+    /*Stopped for a reversal: the next step leaves 0 to the other side*/
+    if((param_Profile->bPending != FALSE) && (param_Profile->fVel == 0.0f))
+    {
+        param_Profile->bPending = FALSE;
+        MotionProfilePlan(param_Profile, param_Profile->fPending);
+    }
+
+    return param_Profile->fVel;
+}
+
+boolean MotionProfileIsDone(const MotionProfile *param_Profile)
+{
+    return (param_Profile->fVel == param_Profile->fTarget) ? TRUE : FALSE;
+}
+
+/*---------------------Static Function--------------------------*/
+static void MotionProfilePlan(MotionProfile *param_Profile, float32_t param_Target)
+{
+    if(param_Profile->stCfg.ulType == MOTION_PROFILE_TRAPEZOID)
+    {
+        Ifx_RampF32_setRef(&param_Profile->stRamp, param_Target);
+    }
+    else
+    {
+        MotionProfilePlanSCurve(param_Profile, param_Target);
+    }
+}
+
+/*
+ * From the velocity and acceleration of now to param_Target at 0
+ * acceleration, in the direction s of the target seen from the velocity
+ * reached by bringing the acceleration to 0 first. In that direction:
+ * A0 -> Ap at the jerk limit, Ap for t2, Ap -> 0 at the jerk limit, with
+ *   dV = (2*Ap^2 - A0^2)/(2*j) + Ap*t2
+ * Ap is the acceleration limit, or lower with t2 = 0 for small changes.
+ * The times are rounded up to whole steps and Ap is fitted again so the
+ * steps reach dV.
+ */
+static void MotionProfilePlanSCurve(MotionProfile *param_Profile, float32_t param_Target)
+{
+    const float32_t fTs    = param_Profile->stCfg.fSampleTime;
+    const float32_t fJerk  = param_Profile->stCfg.fJerkMax;
+    const float32_t fAccel = param_Profile->stCfg.fAccelMax;
+    float32_t fVel = param_Profile->fVel;
+    float32_t fA0 = 0.0f;
+    float32_t fSign;
+    float32_t fDeltaV;
+    float32_t fAp;
+    float32_t fT2;
+    float32_t fStartAccel[MOTION_PROFILE_SEG_NUMBER];
+    float32_t fEndAccel[MOTION_PROFILE_SEG_NUMBER];
+    float32_t fSteps;
+    uint32_t ulSeg;
+
+    if(param_Profile->ulTickLeft != 0u)
+    {
+        fA0 = (param_Profile->fDv - (0.5f * param_Profile->fDdv)) / fTs;
+    }
+
+    fSign   = (param_Target >= (fVel + ((fA0 * __absf(fA0)) / (2.0f * fJerk)))) ? 1.0f : -1.0f;
+    fA0     = fSign * fA0;
+    fDeltaV = fSign * (param_Target - fVel);
+
+    if((((2.0f * fAccel * fAccel) - (fA0 * fA0)) / (2.0f * fJerk)) <= fDeltaV)
+    {
+        fAp = fAccel;
+        fT2 = (fDeltaV - (((2.0f * fAccel * fAccel) - (fA0 * fA0)) / (2.0f * fJerk))) / fAccel;
+    }
+    else
+    {
+        fAp = sqrtf(((2.0f * fJerk * fDeltaV) + (fA0 * fA0)) * 0.5f);
+        fT2 = 0.0f;
+    }
+
+    param_Profile->stSeg[0].ulTicks = (uint32_t)ceilf((fAp - fA0) / (fJerk * fTs));
+    param_Profile->stSeg[1].ulTicks = (uint32_t)((fT2 / fTs) + 0.5f);
+    param_Profile->stSeg[2].ulTicks = (uint32_t)ceilf(fAp / (fJerk * fTs));
+
+    fSteps = (0.5f * (float32_t)param_Profile->stSeg[0].ulTicks) + (float32_t)param_Profile->stSeg[1].ulTicks + (0.5f * (float32_t)param_Profile->stSeg[2].ulTicks);
+    if(fSteps > 0.0f)
+    {
+        fAp = (fDeltaV - (0.5f * fA0 * (float32_t)param_Profile->stSeg[0].ulTicks * fTs)) / (fSteps * fTs);
+    }
+
+    fStartAccel[0] = fSign * fA0;
+    fEndAccel[0]   = fSign * fAp;
+    fStartAccel[1] = fSign * fAp;
+    fEndAccel[1]   = fSign * fAp;
+    fStartAccel[2] = fSign * fAp;
+    fEndAccel[2]   = 0.0f;
+
+    for(ulSeg = 0u; ulSeg < MOTION_PROFILE_SEG_NUMBER; ulSeg++)
+    {
+        MotionProfileSeg *pSeg = &param_Profile->stSeg[ulSeg];
+
+        if(pSeg->ulTicks != 0u)
+        {
+            pSeg->fDdv     = ((fEndAccel[ulSeg] - fStartAccel[ulSeg]) * fTs) / (float32_t)pSeg->ulTicks;
+            pSeg->fDvStart = (fStartAccel[ulSeg] * fTs) + (0.5f * pSeg->fDdv);
+            fVel += (float32_t)pSeg->ulTicks * fTs * 0.5f * (fStartAccel[ulSeg] + fEndAccel[ulSeg]);
+        }
+
+        pSeg->fVelEnd = fVel;
+    }
+
+    param_Profile->stSeg[MOTION_PROFILE_SEG_NUMBER - 1u].fVelEnd = param_Target;
+    param_Profile->ulSegIndex = 0u;
+    MotionProfileLoadSeg(param_Profile);
+}
+
+/*Segments of no step only set their end velocity*/
+static void MotionProfileLoadSeg(MotionProfile *param_Profile)
+{
+    while((param_Profile->ulSegIndex < MOTION_PROFILE_SEG_NUMBER) && (param_Profile->stSeg[param_Profile->ulSegIndex].ulTicks == 0u))
+    {
+        param_Profile->fVel = param_Profile->stSeg[param_Profile->ulSegIndex].fVelEnd;
+        param_Profile->ulSegIndex++;
+    }
+
+    if(param_Profile->ulSegIndex < MOTION_PROFILE_SEG_NUMBER)
+    {
+        param_Profile->ulTickLeft = param_Profile->stSeg[param_Profile->ulSegIndex].ulTicks;
+        param_Profile->fDv        = param_Profile->stSeg[param_Profile->ulSegIndex].fDvStart;
+        param_Profile->fDdv       = param_Profile->stSeg[param_Profile->ulSegIndex].fDdv;
+    }
+    else
+    {
+        param_Profile->ulTickLeft = 0u;
+        param_Profile->fDv        = 0.0f;
+        param_Profile->fDdv       = 0.0f;
+    }
+}
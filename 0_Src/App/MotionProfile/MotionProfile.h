@@ -0,0 +1,75 @@
+#ifndef MOTIONPROFILE_H
+#define MOTIONPROFILE_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+#include "SysSe/Math/Ifx_RampF32.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define MOTION_PROFILE_SEG_NUMBER   3u      /*Jerk up, constant acceleration, jerk down*/
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef enum
+{
+    MOTION_PROFILE_TRAPEZOID = 0u,      /*Acceleration limit only, Ifx_RampF32*/
+    MOTION_PROFILE_SCURVE               /*Acceleration and jerk limits*/
+}E_MOTION_PROFILE_TYPE;
+
+/*Velocity in any unit, times in s*/
+typedef struct
+{
+    uint32_t ulType;                    /*E_MOTION_PROFILE_TYPE*/
+    float32_t fAccelMax;                /*Velocity per s*/
+    float32_t fJerkMax;                 /*Velocity per s^2, S-curve only*/
+    float32_t fSampleTime;              /*Period of MotionProfileStep*/
+}MotionProfileConfig;
+
+/*Constant jerk over ulTicks steps, the velocity steps are precomputed*/
+typedef struct
+{
+    uint32_t ulTicks;
+    float32_t fDvStart;                 /*Velocity change of the first step*/
+    float32_t fDdv;                     /*Change of the velocity change per step*/
+    float32_t fVelEnd;                  /*Velocity at the end, set to remove the rounding*/
+}MotionProfileSeg;
+
+/*
+ * Velocity reference moving to fTarget. A target of the other sign than the
+ * velocity is reached through a stop at exactly 0, fPending holds it.
+ */
+typedef struct
+{
+    MotionProfileConfig stCfg;
+    Ifx_RampF32 stRamp;                 /*Trapezoid*/
+    MotionProfileSeg stSeg[MOTION_PROFILE_SEG_NUMBER];
+    uint32_t ulSegIndex;                /*MOTION_PROFILE_SEG_NUMBER : done*/
+    uint32_t ulTickLeft;
+    float32_t fDv;
+    float32_t fDdv;
+    float32_t fVel;
+    float32_t fTarget;
+    float32_t fPending;
+    boolean bPending;
+}MotionProfile;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void MotionProfileInit(MotionProfile *param_Profile, const MotionProfileConfig *param_Cfg);
+void MotionProfileReset(MotionProfile *param_Profile, float32_t param_Vel);
+void MotionProfileSetTarget(MotionProfile *param_Profile, float32_t param_Target);
+float32_t MotionProfileStep(MotionProfile *param_Profile);
+boolean MotionProfileIsDone(const MotionProfile *param_Profile);
+#endif
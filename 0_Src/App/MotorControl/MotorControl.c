@@ -1,117 +1,830 @@
 /*----------------------------------------------------------------*/
 /*                        Include Header File                          */
 /*----------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
 #include "MotorControl.h"
 #include "MidDio.h"
 #include "DrvGtm.h"
+#include "DrvAdc.h"
+#include "IfxCpu.h"
+#include "SigBus.h"
+#include "Pid.h"
+#include "MidTim.h"
+#include "Odom.h"
+#include "MotionProfile.h"
+#include "PidTune.h"
+#include "Rls.h"
+#include "Brake.h"
+#include "Move.h"
+#include "MidTom.h"
+#include "MidNvm.h"
+#include "BgJob.h"
+#include "DrvAsc.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
+#define MOTOR_CTRL_PERIOD_S         0.005f              /*DRV_ADC_CTRL_PERIOD_NUMBER PWM periods, ADC DMA interrupt*/
+#define MOTOR_WHEEL_DIAMETER_M      0.065f
+#define MOTOR_TRACK_WIDTH_M         0.170f              /*Left to right wheel centre*/
+#define MOTOR_RPM_TO_MPS            ((IFX_PI * MOTOR_WHEEL_DIAMETER_M) / 60.0f)
+#define MOTOR_PULSE_TO_M            ((IFX_PI * MOTOR_WHEEL_DIAMETER_M) / MID_TIM_PULSE_PER_REV)
+
+#define MOTOR_ADC_REF_V             5.0f
+#define MOTOR_SENSE_OHM             0.5f                /*L298N SENSE A/B to ground*/
+#define MOTOR_BATTERY_DIVIDER       3.0f                /*Battery to VADC G0 CH4*/
+#define MOTOR_ADC_CNT_TO_V          (MOTOR_ADC_REF_V / (float32_t)DRV_ADC_FULL_SCALE_CNT)
+
+#define MOTOR_OC_LIMIT_A            0.6f                /*At the ADC trigger: about 1A stalled at full duty, below 0.2A running*/
+#define MOTOR_OC_LIMIT_CNT          ((uint32_t)((MOTOR_OC_LIMIT_A * MOTOR_SENSE_OHM) / MOTOR_ADC_CNT_TO_V))
+#define MOTOR_OC_OFF_STEP           20u                 /*100ms with the bridges off after a trip*/
+#define MOTOR_OC_RETRY_NUMBER       3u                  /*Trips before the outputs stay off*/
+#define MOTOR_OC_CLEAR_STEP         200u                /*1s on without a trip forgets the trips before*/
+
+#define MOTOR_SIDE_LEFT             0u                  /*IN1/IN2 of both L298N*/
+#define MOTOR_SIDE_RIGHT            1u                  /*IN3/IN4*/
+#define MOTOR_SIDE_NUMBER           2u
+
+#define MOTOR_RPM_REF_STEP          20.0f               /*'+'/'-' on fRpmRef*/
+#define MOTOR_RPM_REF_MIN           20.0f
+#define MOTOR_RPM_REF_MAX           100.0f              /*About 80% duty, the PID limit*/
+#define MOTOR_STEER_STEP_DEG        10.0f               /*'j'/'l' on fMotorSteerDeg, + left*/
+#define MOTOR_MOVE_DISTANCE_M       1.0f                /*'m' forward, 'n' back*/
+
+#define MOTOR_TUNE_RPM              60.0f               /*Speed of the relay experiment*/
+#define MOTOR_TUNE_VERSION          1u                  /*MotorTuneRecord layout*/
+#define MOTOR_TUNE_TX_SIZE          512u                /*Reports with every value at its longest*/
 
 
 /*----------------------------------------------------------------*/
 /*                        Typedefs                                    */
 /*----------------------------------------------------------------*/
+typedef struct
+{
+    uint32_t ulFront;                   /*MID_DIO_FRONT_PATTERN*/
+    uint32_t ulRear;                    /*MID_DIO_REAR_PATTERN*/
+}MotorDirPattern;
+
+typedef enum
+{
+    MOTOR_OC_RUN = 0u,
+    MOTOR_OC_TRIP,                      /*Set by the ADC limit interrupt, outputs off*/
+    MOTOR_OC_OFF,                       /*Hiccup: on again after MOTOR_OC_OFF_STEP*/
+    MOTOR_OC_LATCHED                    /*Off until the next command*/
+}E_MOTOR_OC_STATE;
+
+/*MID_NVM_BLOCK_MOTOR_TUNE, the gains are computed again from Ku/Tu at boot*/
+typedef struct
+{
+    uint32_t ulVersion;
+    uint32_t ulRule;                    /*E_PID_TUNE_RULE*/
+    float32_t fKu[MID_TIM_WHEEL_NUMBER];
+    float32_t fTu[MID_TIM_WHEEL_NUMBER];
+}MotorTuneRecord;
+
+/*Reports waiting for cMotorTuneTxBuf, sent in this order*/
+typedef enum
+{
+    MOTOR_REPORT_MOVE = 0u,
+    MOTOR_REPORT_TUNE,
+    MOTOR_REPORT_ID,
+    MOTOR_REPORT_NUMBER
+}E_MOTOR_REPORT;
+
+typedef struct
+{
+    char cText[MOTOR_TUNE_TX_SIZE];
+    uint32_t ulLen;                     /*0 : none*/
+}MotorReport;
 
 
 /*----------------------------------------------------------------*/
 /*                        Static Function Prototype                  */
 /*----------------------------------------------------------------*/
-
+static void MotorSenseRpm(void);
+static void MotorSenseAdc(void);
+static void MotorOdometry(void);
+static void MotorDirection(void);
+static float32_t MotorSpeed(void);
+static void MotorBrakeUpdate(void);
+static float32_t MotorTravel(void);
+static float32_t MotorVelocity(void);
+static void MotorMoveStart(float32_t param_Distance);
+static void MotorMoveUpdate(void);
+static void MotorMoveReport(uint32_t param_State);
+static void MotorReportQueue(uint32_t param_Report, uint32_t param_Len);
+static void MotorOverCurrent(uint32_t param_ChMask);
+static boolean MotorProtect(void);
+static void MotorSetTarget(float32_t param_Left, float32_t param_Right);
+static void MotorTuneLoad(void);
+static void MotorTuneStart(void);
+static void MotorTuneEnd(uint32_t param_State);
+static void MotorTuneApply(uint32_t param_Rule);
+static void MotorTuneReport(uint32_t param_State);
+static void MotorIdReport(void);
+static E_BG_JOB_STATE MotorJobTune(void *param_Ctx);
 
 
 
 /*----------------------------------------------------------------*/
 /*                        Variables                                    */
 /*----------------------------------------------------------------*/
-float32_t fPwmDuty = 0.6f;    
-float32_t fSenseMotorRpm = 0.0f;
-uint32_t ulRpmRef =80u;
-uint32_t ulPGain = 3u; 
-uint32_t ulIGain = 12u;
+/*Per wheel, E_MID_TIM_WHEEL order*/
+float32_t fPwmDuty[MID_TIM_WHEEL_NUMBER] = {0.6f, 0.6f, 0.6f, 0.6f};
+float32_t fSenseMotorRpm[MID_TIM_WHEEL_NUMBER];
+float32_t fRpmRef = 80.0f;                          /*Wheel speed of the wireless commands*/
+float32_t fMotorSteerDeg = 0.0f;                    /*Steering servo angle of the wireless commands*/
+float32_t fSideRpmRef[MOTOR_SIDE_NUMBER];           /*Profiled, signed: + forward*/
+uint32_t ulSenseMotorAgeUs[MID_TIM_WHEEL_NUMBER];  /*Age of the last encoder edge when fSenseMotorRpm was computed*/
+float32_t fSenseMotorCurrent[MID_TIM_WHEEL_NUMBER]; /*A, bridge current at the ADC trigger, 0 in the low phase of the PWM*/
+float32_t fSenseBatteryV;
+uint32_t ulMotorOcTripCnt[MID_TIM_WHEEL_NUMBER];    /*Overcurrent trips since the start*/
+int32_t slMotorTravelCnt;                           /*Encoder pulses of the four wheels, signed by the H-bridge command*/
+
+/*Duty in %, gains per rpm, the same for all wheels*/
+static const PidConfig stMotorPidCfg =
+{
+    0.3f,                   /*fKp*/
+    1.2f,                   /*fKi*/
+    0.0f,                   /*fKd*/
+    1.0f,                   /*fSetpointWeight*/
+    4.0f,                   /*fTrackingGain : fKi/fKp*/
+    20.0f,                  /*fDerivCutOffHz*/
+    0.0f,                   /*fOutMin*/
+    80.0f,                  /*fOutMax*/
+    400.0f,                 /*fRateMax : 0 to 80% in 200ms*/
+    MOTOR_CTRL_PERIOD_S     /*fSampleTime*/
+};
+
+PidBank stMotorPid;
+
+static const OdomConfig stMotorOdomCfg =
+{
+    MOTOR_TRACK_WIDTH_M,    /*fTrackWidth*/
+    MOTOR_CTRL_PERIOD_S     /*fSampleTime*/
+};
+
+Odom stMotorOdom;
+
+/*rpm per s, 0 to 80rpm in 0.5s*/
+static const MotionProfileConfig stMotorProfileCfg =
+{
+    MOTION_PROFILE_SCURVE,  /*ulType*/
+    200.0f,                 /*fAccelMax*/
+    2000.0f,                /*fJerkMax : 100ms to full acceleration*/
+    MOTOR_CTRL_PERIOD_S     /*fSampleTime*/
+};
+
+MotionProfile stMotorProfile[MOTOR_SIDE_NUMBER];
+
+/*Duty % step around the bias and rpm hysteresis of the relay, about 3s in all*/
+static const PidTuneConfig stMotorTuneCfg =
+{
+    15.0f,                  /*fAmplitude*/
+    2.0f,                   /*fHysteresis : above the T method quantisation at 60rpm*/
+    300u,                   /*ulSettleStep : ramp to MOTOR_TUNE_RPM and 0.75s of mean duty*/
+    2u,                     /*ulSkipCycle*/
+    4u,                     /*ulMeasureCycle*/
+    2000u                   /*ulTimeoutStep : 10s*/
+};
+
+PidTune stMotorTune;
+uint32_t ulMotorTuneRule = PID_TUNE_TL_PI;         /*Rule of the next tune, '0'..'4' on the UART*/
+static volatile uint32_t ulMotorTuneEndState = PID_TUNE_IDLE;   /*Set by the control interrupt, ended by Unit_WirelessControl*/
+/*Duty % to rpm, 1s of memory: follows the battery and the load, not the PWM ripple*/
+static const RlsConfig stMotorRlsCfg =
+{
+    0.995f,                 /*fForgetting*/
+    100.0f,                 /*fCovInit*/
+    1000.0f,                /*fTraceMax*/
+    10.0f,                  /*fMeasMin : above the stiction speed*/
+    0.1f,                   /*fConfidence*/
+    MOTOR_CTRL_PERIOD_S     /*fSampleTime*/
+};
+
+RlsBank stMotorRls;
+
+/*Stop in 10cm from the speeds that would roll further, the car coasts 18cm from 80rpm*/
+static const BrakeConfig stMotorBrakeCfg =
+{
+    50.0f,                  /*fStrength*/
+    0.10f,                  /*fDistance*/
+    400.0f,                 /*fKp : 40% at 0.1m/s above the profile*/
+    4000.0f,                /*fKi*/
+    0.01f,                  /*fSpeedMin : about 3rpm*/
+    MOTOR_CTRL_PERIOD_S     /*fSampleTime*/
+};
+
+Brake stMotorBrake;
+static const float32_t fMotorNoDrive[MID_TIM_WHEEL_NUMBER] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+/*Below the 0.12m/s2 the car coasts at from 40rpm: the speed loops do not brake*/
+static const MoveConfig stMotorMoveCfg =
+{
+    0.25f,                  /*fVelMax : about 73rpm*/
+    0.3f,                   /*fAccelMax*/
+    0.1f,                   /*fDecelMax*/
+    4.0f,                   /*fKp*/
+    0.05f,                  /*fCorrMax : about 15rpm*/
+    0.5f,                   /*fLookAhead*/
+    0.005f,                 /*fDeadBand*/
+    0.01f,                  /*fSettleVel : about 3rpm*/
+    20u,                    /*ulSettleStep : 100ms*/
+    MOTOR_CTRL_PERIOD_S     /*fSampleTime*/
+};
+
+Move stMotorMove;
+static volatile uint32_t ulMotorMoveEndState = MOVE_IDLE;   /*Set by the control interrupt, reported by Unit_WirelessControl*/
+static uint32_t ulMotorPulseOld[MID_TIM_WHEEL_NUMBER];
+
+static volatile uint32_t ulMotorOcState = MOTOR_OC_RUN;    /*E_MOTOR_OC_STATE*/
+static uint32_t ulMotorOcStep = 0u;                 /*Control steps in the state*/
+static uint32_t ulMotorOcRetry = 0u;                /*Trips without MOTOR_OC_CLEAR_STEP on in between*/
+
+static MotorTuneRecord stMotorTuneRecord;
+static boolean bMotorTuneValid = FALSE;             /*stMotorTuneRecord holds a result*/
+static boolean bMotorTuneSavePending = FALSE;       /*stMotorTuneRecord not yet handed to MidNvmWrite*/
+static char cMotorTuneTxBuf[MOTOR_TUNE_TX_SIZE];
+static uint32_t ulMotorTuneTxLen = 0u;
+static uint32_t ulMotorTuneTxPos = 0u;
+static MotorReport stMotorReport[MOTOR_REPORT_NUMBER];   /*E_MOTOR_REPORT*/
+static uint32_t ulMotorRxCnt = 0u;
+
+/*IN1..4 of both bridges, IN1/IN2 left side, IN3/IN4 right side*/
+static const MotorDirPattern stMotorDirPattern[MOTOR_CMD_MAX] =
+{
+    {MID_DIO_FRONT_PATTERN(0u, 0u, 0u, 0u), MID_DIO_REAR_PATTERN(0u, 0u, 0u, 0u)},     /*MOTOR_STOP*/
+    {MID_DIO_FRONT_PATTERN(1u, 0u, 1u, 0u), MID_DIO_REAR_PATTERN(1u, 0u, 1u, 0u)},     /*MOTOR_FWD*/
+    {MID_DIO_FRONT_PATTERN(1u, 0u, 0u, 1u), MID_DIO_REAR_PATTERN(1u, 0u, 0u, 1u)},     /*MOTOR_TURN_RIGHT*/
+    {MID_DIO_FRONT_PATTERN(0u, 1u, 1u, 0u), MID_DIO_REAR_PATTERN(0u, 1u, 1u, 0u)},     /*MOTOR_TURN_LEFT*/
+    {MID_DIO_FRONT_PATTERN(0u, 1u, 0u, 1u), MID_DIO_REAR_PATTERN(0u, 1u, 0u, 1u)},     /*MOTOR_REVERSE*/
+    {MID_DIO_FRONT_PATTERN(1u, 1u, 1u, 1u), MID_DIO_REAR_PATTERN(1u, 1u, 1u, 1u)}      /*MOTOR_BRAKE : high side short, not on SENSE*/
+};
 
-extern uint32_t gu32nuAscRxData;
-extern uint32_t ulPulseCnt;
+/*The encoders give no direction: the sign of each side comes from the H-bridge command*/
+static float32_t fMotorDirLeft = 1.0f;
+static float32_t fMotorDirRight = 1.0f;
+static MOTOR_CMD_TYPE eMotorCmd = MOTOR_STOP;
 
 
 /*----------------------------------------------------------------*/
 /*                        Functions                                    */
 /*----------------------------------------------------------------*/
+void MotorControlInit(void)
+{
+    PidBankInit(&stMotorPid, &stMotorPidCfg);
+    OdomInit(&stMotorOdom, &stMotorOdomCfg);
+    MotionProfileInit(&stMotorProfile[MOTOR_SIDE_LEFT], &stMotorProfileCfg);
+    MotionProfileInit(&stMotorProfile[MOTOR_SIDE_RIGHT], &stMotorProfileCfg);
+    RlsBankInit(&stMotorRls, &stMotorRlsCfg);
+    BrakeInit(&stMotorBrake, &stMotorBrakeCfg, BRAKE_DISTANCE);
+    MoveInit(&stMotorMove, &stMotorMoveCfg);
+    MidTomServoInit();
+    MotorTuneLoad();
+    DrvRegAdcCallbackFnc(MotorFeedbackController);
+    DrvRegAdcLimitCallbackFnc(MotorOverCurrent);
+    DrvAdcSetLimit(MOTOR_OC_LIMIT_CNT);
+}
+
+/*
+ * Speed loops of the four wheels, every MOTOR_CTRL_PERIOD_S from the ADC DMA
+ * interrupt: the scan of the PWM period is in, the new duties must be staged
+ * before its end. Odometry and identification come after DrvGtmPwmUpdate.
+ */
 void MotorFeedbackController(void)
-{            
-    static int32_t lProportionalControlInput = 0;
-    static int32_t lIntegralControlInput = 0;
-    static int32_t lIntegralControlOld = 0;
-    static uint32_t ulSamplingFrequency = 10u; /*100ms*/
+{
+    float32_t fRef[MID_TIM_WHEEL_NUMBER];
+    float32_t fOut[MID_TIM_WHEEL_NUMBER];
+    uint32_t ulDutyCnt[MID_TIM_WHEEL_NUMBER];
+    uint32_t ulWheel;
+
+    MidTimUpdate();             /*Wheel speed on the signal bus*/
+    MotorSenseRpm();
+    MotorSenseAdc();
+    MotorBrakeUpdate();
 
-    int32_t g_nError = 0;
-    int32_t g_nControlInput = 0;
+    fSideRpmRef[MOTOR_SIDE_LEFT]  = MotionProfileStep(&stMotorProfile[MOTOR_SIDE_LEFT]);
+    fSideRpmRef[MOTOR_SIDE_RIGHT] = MotionProfileStep(&stMotorProfile[MOTOR_SIDE_RIGHT]);
+    MotorMoveUpdate();
+    MotorDirection();
 
-    fSenseMotorRpm = ((float32_t)ulPulseCnt*60.0f*10.0f)/(8.0f*120.0f);
-    ulPulseCnt = 0u;
+    /*The H-bridge gives the sign, the speed loops get the magnitude*/
+    fRef[MID_TIM_WHEEL_RL] = __absf(fSideRpmRef[MOTOR_SIDE_LEFT]);
+    fRef[MID_TIM_WHEEL_FL] = fRef[MID_TIM_WHEEL_RL];
+    fRef[MID_TIM_WHEEL_RR] = __absf(fSideRpmRef[MOTOR_SIDE_RIGHT]);
+    fRef[MID_TIM_WHEEL_FR] = fRef[MID_TIM_WHEEL_RR];
 
-    //PID Contorller
-    g_nError =((int32_t)ulRpmRef- (int32_t)fSenseMotorRpm); 		    
-    lProportionalControlInput = (int32_t)ulPGain*g_nError/10;	// Not to express the gain as float -> g_nPGain/10						
+    if(MotorProtect() != FALSE)
+    {
+        /*Bridges off: the loops start again from 0, a tune fails*/
+        if((stMotorTune.ulState == PID_TUNE_SETTLE) || (stMotorTune.ulState == PID_TUNE_RELAY))
+        {
+            PidTuneStop(&stMotorTune);
+            MotorSetTarget(0.0f, 0.0f);
+            ulMotorTuneEndState = PID_TUNE_FAIL;
+        }
 
-    lIntegralControlInput = lIntegralControlOld + ((int32_t)ulIGain*g_nError/(int32_t)ulSamplingFrequency/10);	
-    g_nControlInput = (lProportionalControlInput + lIntegralControlInput);  //PID control input	 
-    lIntegralControlOld = lIntegralControlInput;								
+        if(MoveIsActive(&stMotorMove) != FALSE)
+        {
+            MoveAbort(&stMotorMove);
+            ulMotorMoveEndState = MOVE_ABORT;
+        }
 
-    if(lIntegralControlOld > 80u) 
+        PidBankReset(&stMotorPid, 0.0f);
+
+        for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+        {
+            fOut[ulWheel] = 0.0f;
+        }
+    }
+    else if(stMotorBrake.ulState != BRAKE_OFF)
     {
-        lIntegralControlOld = 80u; //Limit accumulated value by I gain
-    }     
+        /*Motors shorted for the brake strength of the period, the loops start again from 0*/
+        float32_t fBrake = BrakeStep(&stMotorBrake, MotorSpeed());
+
+        PidBankReset(&stMotorPid, 0.0f);
 
-    if(g_nControlInput >= 80u)
+        for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+        {
+            fOut[ulWheel] = fBrake;
+        }
+    }
+    else if((stMotorTune.ulState == PID_TUNE_SETTLE) || (stMotorTune.ulState == PID_TUNE_RELAY))
     {
-        g_nControlInput =80u;  //Limit control input (0<=contorl input<100)  
-    }    
-    else if(g_nControlInput <= 0u)
+        uint32_t ulState = PidTuneRun(&stMotorTune, &stMotorPid, fRef, fSenseMotorRpm, fOut);
+
+        if(ulState >= PID_TUNE_DONE)
+        {
+            MotorSetTarget(0.0f, 0.0f);
+            ulMotorTuneEndState = ulState;
+        }
+    }
+    else
+    {
+        PidBankRun(&stMotorPid, fRef, fSenseMotorRpm, fOut);
+    }
+
+    for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+    {
+        fPwmDuty[ulWheel]  = fOut[ulWheel]/100.0f;
+        ulDutyCnt[ulWheel] = (uint32_t)(fPwmDuty[ulWheel] * (float32_t)DRV_GTM_PWM_PERIOD_CNT);
+    }
+
+    /*TOM1 CH4..7 : RL, RR, FL, FR, all on the same PWM period*/
+    DrvGtmPwmUpdate(DRV_GTM_PWM_CH_ALL, ulDutyCnt);
+
+    MotorOdometry();
+
+    /*Model of each wheel from the duty of the last period to the speed now, not while braking*/
+    RlsBankRun(&stMotorRls, (stMotorBrake.ulState == BRAKE_OFF) ? fOut : fMotorNoDrive, fSenseMotorRpm);
+}
+
+/*
+ * Wheel speeds of MidTimUpdate, their age is the time since the last encoder
+ * edge. The pulses since the last step go to slMotorTravelCnt with the sign
+ * of the side, still the one they were counted under.
+ */
+static void MotorSenseRpm(void)
+{
+    SigWheelSpeed stSpeed;
+    uint32_t ulStampCnt;
+    uint32_t ulWheel;
+    int32_t slPulse;
+
+    for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+    {
+        if(SigBusRead((E_SIG_ID)(SIG_WHEEL_SPEED_RL + ulWheel), &stSpeed, &ulStampCnt) != 0u)
+        {
+            fSenseMotorRpm[ulWheel]    = stSpeed.fRpm;
+            ulSenseMotorAgeUs[ulWheel] = SigBusGetAgeUs(ulStampCnt);
+
+            slPulse = (int32_t)(stSpeed.ulPulseCnt - ulMotorPulseOld[ulWheel]);
+            ulMotorPulseOld[ulWheel] = stSpeed.ulPulseCnt;
+            slMotorTravelCnt += ((ulWheel == MID_TIM_WHEEL_RL) || (ulWheel == MID_TIM_WHEEL_FL)) ?
+                                ((fMotorDirLeft > 0.0f) ? slPulse : -slPulse) : ((fMotorDirRight > 0.0f) ? slPulse : -slPulse);
+        }
+    }
+}
+
+/*Bridge currents and battery voltage of the scan that started the control step*/
+static void MotorSenseAdc(void)
+{
+    uint32_t ulCnt[DRV_ADC_CH_NUMBER];
+    uint32_t ulWheel;
+
+    DrvAdcGetSample(ulCnt);
+
+    for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+    {
+        fSenseMotorCurrent[ulWheel] = ((float32_t)ulCnt[ulWheel] * MOTOR_ADC_CNT_TO_V) / MOTOR_SENSE_OHM;
+    }
+
+    fSenseBatteryV = (float32_t)ulCnt[DRV_ADC_CH_BATTERY] * (MOTOR_ADC_CNT_TO_V * MOTOR_BATTERY_DIVIDER);
+}
+
+/*Pose from the mean speed of the front and rear wheel of each side*/
+static void MotorOdometry(void)
+{
+    float32_t fLeft  = (fSenseMotorRpm[MID_TIM_WHEEL_RL] + fSenseMotorRpm[MID_TIM_WHEEL_FL]) * (0.5f * MOTOR_RPM_TO_MPS);
+    float32_t fRight = (fSenseMotorRpm[MID_TIM_WHEEL_RR] + fSenseMotorRpm[MID_TIM_WHEEL_FR]) * (0.5f * MOTOR_RPM_TO_MPS);
+
+    OdomStep(&stMotorOdom, fMotorDirLeft * fLeft, fMotorDirRight * fRight);
+}
+
+/*
+ * Direction pins from the sign of the profiled speed of each side. A
+ * reversal stops at exactly 0 for one step, the pins change on the step
+ * after, at the lowest speed of the profile.
+ */
+static void MotorDirection(void)
+{
+    MOTOR_CMD_TYPE eCmd;
+
+    if(fSideRpmRef[MOTOR_SIDE_LEFT] != 0.0f)
+    {
+        fMotorDirLeft = (fSideRpmRef[MOTOR_SIDE_LEFT] > 0.0f) ? 1.0f : -1.0f;
+    }
+
+    if(fSideRpmRef[MOTOR_SIDE_RIGHT] != 0.0f)
+    {
+        fMotorDirRight = (fSideRpmRef[MOTOR_SIDE_RIGHT] > 0.0f) ? 1.0f : -1.0f;
+    }
+
+    if(stMotorBrake.ulState != BRAKE_OFF)
+    {
+        eCmd = MOTOR_BRAKE;
+    }
+    else if((stMotorProfile[MOTOR_SIDE_LEFT].fTarget == 0.0f) && (stMotorProfile[MOTOR_SIDE_RIGHT].fTarget == 0.0f) &&
+       (MoveIsActive(&stMotorMove) == FALSE) && (MotionProfileIsDone(&stMotorProfile[MOTOR_SIDE_LEFT]) != FALSE) && (MotionProfileIsDone(&stMotorProfile[MOTOR_SIDE_RIGHT]) != FALSE))
+    {
+        eCmd = MOTOR_STOP;
+    }
+    else if(fMotorDirLeft > 0.0f)
+    {
+        eCmd = (fMotorDirRight > 0.0f) ? MOTOR_FWD : MOTOR_TURN_RIGHT;
+    }
+    else
+    {
+        eCmd = (fMotorDirRight > 0.0f) ? MOTOR_TURN_LEFT : MOTOR_REVERSE;
+    }
+
+    if(eCmd != eMotorCmd)
+    {
+        eMotorCmd = eCmd;
+        Unit_MotorFrontDirectionCtl(eCmd);
+        Unit_MotorRearDirectionCtl(eCmd);
+    }
+}
+
+/*Mean wheel speed magnitude, m/s*/
+static float32_t MotorSpeed(void)
+{
+    float32_t fSum = 0.0f;
+    uint32_t ulWheel;
+
+    for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+    {
+        fSum += __absf(fSenseMotorRpm[ulWheel]);
+    }
+
+    return fSum * (MOTOR_RPM_TO_MPS / (float32_t)MID_TIM_WHEEL_NUMBER);
+}
+
+/*---------------------Brake--------------------------*/
+/*
+ * A stop (both targets 0) starts the brake from the measured speed, the
+ * profiles are then at 0. Any other target releases it and the profiles go
+ * on from the measured side speeds. A move drives with the brake released.
+ */
+static void MotorBrakeUpdate(void)
+{
+    float32_t fLeft  = stMotorProfile[MOTOR_SIDE_LEFT].fTarget;
+    float32_t fRight = stMotorProfile[MOTOR_SIDE_RIGHT].fTarget;
+
+    if(MoveIsActive(&stMotorMove) != FALSE)
+    {
+        BrakeRelease(&stMotorBrake);
+    }
+    else if((fLeft == 0.0f) && (fRight == 0.0f))
+    {
+        if(stMotorBrake.ulState == BRAKE_OFF)
+        {
+            BrakeStart(&stMotorBrake, MotorSpeed());
+
+            if(stMotorBrake.ulState != BRAKE_OFF)
+            {
+                MotionProfileReset(&stMotorProfile[MOTOR_SIDE_LEFT], 0.0f);
+                MotionProfileReset(&stMotorProfile[MOTOR_SIDE_RIGHT], 0.0f);
+            }
+        }
+    }
+    else if(stMotorBrake.ulState != BRAKE_OFF)
+    {
+        BrakeRelease(&stMotorBrake);
+        MotionProfileReset(&stMotorProfile[MOTOR_SIDE_LEFT],
+                           fMotorDirLeft * 0.5f * (fSenseMotorRpm[MID_TIM_WHEEL_RL] + fSenseMotorRpm[MID_TIM_WHEEL_FL]));
+        MotionProfileReset(&stMotorProfile[MOTOR_SIDE_RIGHT],
+                           fMotorDirRight * 0.5f * (fSenseMotorRpm[MID_TIM_WHEEL_RR] + fSenseMotorRpm[MID_TIM_WHEEL_FR]));
+        MotionProfileSetTarget(&stMotorProfile[MOTOR_SIDE_LEFT], fLeft);
+        MotionProfileSetTarget(&stMotorProfile[MOTOR_SIDE_RIGHT], fRight);
+    }
+    else
+    {
+        /*No Code*/
+    }
+}
+
+/*---------------------Move--------------------------*/
+/*Signed path length of the centre since the start from slMotorTravelCnt, m*/
+static float32_t MotorTravel(void)
+{
+    return (float32_t)slMotorTravelCnt * (MOTOR_PULSE_TO_M / (float32_t)MID_TIM_WHEEL_NUMBER);
+}
+
+/*Signed speed of the centre, m/s*/
+static float32_t MotorVelocity(void)
+{
+    float32_t fLeft  = fMotorDirLeft * (fSenseMotorRpm[MID_TIM_WHEEL_RL] + fSenseMotorRpm[MID_TIM_WHEEL_FL]);
+    float32_t fRight = fMotorDirRight * (fSenseMotorRpm[MID_TIM_WHEEL_RR] + fSenseMotorRpm[MID_TIM_WHEEL_FR]);
+
+    return (fLeft + fRight) * (0.25f * MOTOR_RPM_TO_MPS);
+}
+
+/*
+ * Straight move of param_Distance (m, + forward) from where the car is now.
+ * The profiles wait at 0 for the end of the move, a brake applied is
+ * released by MotorBrakeUpdate.
+ */
+static void MotorMoveStart(float32_t param_Distance)
+{
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    MoveStart(&stMotorMove, MotorTravel(), MotorVelocity(), param_Distance);
+    MotionProfileReset(&stMotorProfile[MOTOR_SIDE_LEFT], 0.0f);
+    MotionProfileReset(&stMotorProfile[MOTOR_SIDE_RIGHT], 0.0f);
+    ulMotorMoveEndState = MOVE_IDLE;
+
+    IfxCpu_restoreInterrupts(bEnabled);
+}
+
+/*
+ * Position loop of a move on top of the speed loops, both sides get its
+ * speed reference. At the end the targets are 0 already: the brake of the
+ * stop holds the car where it settled.
+ */
+static void MotorMoveUpdate(void)
+{
+    float32_t fRef;
+
+    if(MoveIsActive(&stMotorMove) == FALSE)
     {
-        g_nControlInput = 0u;    
+        return;
+    }
+
+    fRef = MoveStep(&stMotorMove, MotorTravel(), MotorVelocity()) * (1.0f / MOTOR_RPM_TO_MPS);
+    fSideRpmRef[MOTOR_SIDE_LEFT]  = fRef;
+    fSideRpmRef[MOTOR_SIDE_RIGHT] = fRef;
+
+    if(stMotorMove.ulState == MOVE_DONE)
+    {
+        ulMotorMoveEndState = MOVE_DONE;
+    }
+}
+
+/*
+ * End of a move on the UART, lengths in mm, the error from the encoders:
+ *   move <done|abort> dist <distance> err <target less position> t <ms>
+ */
+static void MotorMoveReport(uint32_t param_State)
+{
+    uint32_t ulLen;
+
+    ulLen = (uint32_t)sprintf(stMotorReport[MOTOR_REPORT_MOVE].cText, "move %s dist %ld err %ld t %lu\r\n",
+                              (param_State == MOVE_DONE) ? "done" : "abort",
+                              (long)(stMotorMove.fDistance * 1000.0f),
+                              (long)(stMotorMove.fError * 1000.0f),
+                              (unsigned long)((float32_t)stMotorMove.ulStepCnt * (MOTOR_CTRL_PERIOD_S * 1000.0f)));
+
+    MotorReportQueue(MOTOR_REPORT_MOVE, ulLen);
+}
+
+/*
+ * A report of the tasks goes out after the one being sent. Never dropped,
+ * a newer report of the same kind replaces one not yet sent.
+ */
+static void MotorReportQueue(uint32_t param_Report, uint32_t param_Len)
+{
+    stMotorReport[param_Report].ulLen = param_Len;
+    (void)BgJobSubmit(MotorJobTune, NULL_PTR, 50u);
+}
+
+/*---------------------Overcurrent--------------------------*/
+/*
+ * ADC limit interrupt, a scan saw the bridge current of the wheels of
+ * param_ChMask above MOTOR_OC_LIMIT_A. The outputs go off before anything
+ * else, MotorProtect does the rest in the next control step.
+ */
+static void MotorOverCurrent(uint32_t param_ChMask)
+{
+    uint32_t ulWheel;
+
+    DrvGtmPwmOutputOff();
+
+    for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+    {
+        ulMotorOcTripCnt[ulWheel] += (param_ChMask >> ulWheel) & 0x1u;
+    }
+
+    ulMotorOcState = MOTOR_OC_TRIP;
+}
+
+/*
+ * Hiccup of the outputs: MOTOR_OC_OFF_STEP off after a trip, then on again.
+ * The MOTOR_OC_RETRY_NUMBER-th trip without MOTOR_OC_CLEAR_STEP on in
+ * between leaves them off until Unit_WirelessControl gets a command. TRUE
+ * while the outputs are off.
+ */
+static boolean MotorProtect(void)
+{
+    boolean bEnabled = IfxCpu_disableInterrupts();
+    boolean bOff = TRUE;
+
+    if(ulMotorOcState == MOTOR_OC_TRIP)
+    {
+        ulMotorOcRetry++;
+        ulMotorOcStep  = 0u;
+        ulMotorOcState = (ulMotorOcRetry >= MOTOR_OC_RETRY_NUMBER) ? MOTOR_OC_LATCHED : MOTOR_OC_OFF;
+    }
+    else if(ulMotorOcState == MOTOR_OC_OFF)
+    {
+        ulMotorOcStep++;
+
+        if(ulMotorOcStep >= MOTOR_OC_OFF_STEP)
+        {
+            ulMotorOcStep  = 0u;
+            ulMotorOcState = MOTOR_OC_RUN;
+            DrvGtmPwmOutputOn();
+            bOff = FALSE;
+        }
+    }
+    else if(ulMotorOcState == MOTOR_OC_RUN)
+    {
+        if(ulMotorOcStep < MOTOR_OC_CLEAR_STEP)
+        {
+            ulMotorOcStep++;
+        }
+        else
+        {
+            ulMotorOcRetry = 0u;
+        }
+
+        bOff = FALSE;
     }
     else
     {
         /*No Code*/
     }
 
-    /*Gtm PWM Test*/
-    fPwmDuty = (float32_t)g_nControlInput/100.0f;
-    DrvGtmPwmTest(fPwmDuty,fPwmDuty,fPwmDuty,fPwmDuty);  	    	  
+    IfxCpu_restoreInterrupts(bEnabled);
+
+    return bOff;
 }
 
+/*Signed side speeds in rpm, profiled by MotorFeedbackController. Ends a move, the profiles go on from its reference*/
+static void MotorSetTarget(float32_t param_Left, float32_t param_Right)
+{
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    if(MoveIsActive(&stMotorMove) != FALSE)
+    {
+        MoveAbort(&stMotorMove);
+        MotionProfileReset(&stMotorProfile[MOTOR_SIDE_LEFT], fSideRpmRef[MOTOR_SIDE_LEFT]);
+        MotionProfileReset(&stMotorProfile[MOTOR_SIDE_RIGHT], fSideRpmRef[MOTOR_SIDE_RIGHT]);
+        ulMotorMoveEndState = MOVE_ABORT;
+    }
+
+    MotionProfileSetTarget(&stMotorProfile[MOTOR_SIDE_LEFT], param_Left);
+    MotionProfileSetTarget(&stMotorProfile[MOTOR_SIDE_RIGHT], param_Right);
+
+    IfxCpu_restoreInterrupts(bEnabled);
+}
+
+/*
+ * Motion commands act while they are the last byte received. 't' (auto-tune),
+ * '0'..'4' (tuning rule) and 'i' (identified models) act once per byte
+ * received, any other byte received during a tune ends it. A tune ended by
+ * the control interrupt is finished here, out of interrupt context. Any
+ * byte received gives the outputs back after an overcurrent latch. 'c', 'b',
+ * 'v', 'g' select the brake of the next stop, '+'/'-' the speed of the
+ * motion commands, 'j'/'l'/'k' steer left, right and straight and 'm'/'n'
+ * move MOTOR_MOVE_DISTANCE_M forward and back, once per byte as well. Any
+ * motion command ends a move.
+ */
 void Unit_WirelessControl(void)
 {
+    SigUartRx stRx = {0u, 0u};
     uint8_t ucWirelessCmd = 0u;
-    
-    ucWirelessCmd = (uint8_t)gu32nuAscRxData;
-    
+    boolean bNewCmd;
+    boolean bEnabled;
+
+    if(ulMotorTuneEndState != PID_TUNE_IDLE)
+    {
+        MotorTuneEnd(ulMotorTuneEndState);
+        ulMotorTuneEndState = PID_TUNE_IDLE;
+    }
+
+    if(ulMotorMoveEndState != MOVE_IDLE)
+    {
+        MotorMoveReport(ulMotorMoveEndState);
+        ulMotorMoveEndState = MOVE_IDLE;
+    }
+
+    (void)SigBusRead(SIG_UART_RX, &stRx, NULL_PTR);
+    ucWirelessCmd = (uint8_t)stRx.ulData;
+    bNewCmd = (stRx.ulRxCnt != ulMotorRxCnt) ? TRUE : FALSE;
+    ulMotorRxCnt = stRx.ulRxCnt;
+
+    if(bNewCmd != FALSE)
+    {
+        bEnabled = IfxCpu_disableInterrupts();
+
+        if((stMotorTune.ulState == PID_TUNE_SETTLE) || (stMotorTune.ulState == PID_TUNE_RELAY))
+        {
+            PidTuneStop(&stMotorTune);
+            MotorSetTarget(0.0f, 0.0f);
+        }
+
+        if(ulMotorOcState == MOTOR_OC_LATCHED)
+        {
+            ulMotorOcRetry = 0u;
+            ulMotorOcStep  = MOTOR_OC_OFF_STEP;
+            ulMotorOcState = MOTOR_OC_OFF;
+        }
+
+        IfxCpu_restoreInterrupts(bEnabled);
+    }
+
     if(ucWirelessCmd == 'w')    /*Forward*/
     {
-        Unit_MotorFrontDirectionCtl(MOTOR_FWD);
-        Unit_MotorRearDirectionCtl(MOTOR_FWD);
+        MotorSetTarget(fRpmRef, fRpmRef);
     }
     else if(ucWirelessCmd == 'd') /*TurnRight*/
     {
-        Unit_MotorFrontDirectionCtl(MOTOR_TURN_RIGHT);    
-        Unit_MotorRearDirectionCtl(MOTOR_TURN_RIGHT);
+        MotorSetTarget(fRpmRef, -fRpmRef);
     }
     else if(ucWirelessCmd == 'a') /*TurnLeft*/
     {
-        Unit_MotorFrontDirectionCtl(MOTOR_TURN_LEFT);    
-        Unit_MotorRearDirectionCtl(MOTOR_TURN_LEFT);
+        MotorSetTarget(-fRpmRef, fRpmRef);
     }
     else if(ucWirelessCmd == 'x') /*Reverse*/
     {
-        Unit_MotorFrontDirectionCtl(MOTOR_REVERSE);    
-        Unit_MotorRearDirectionCtl(MOTOR_REVERSE);
+        MotorSetTarget(-fRpmRef, -fRpmRef);
     }    
     else if(ucWirelessCmd == 's') /*Stop*/
     {
-        Unit_MotorFrontDirectionCtl(MOTOR_STOP);    
-        Unit_MotorRearDirectionCtl(MOTOR_STOP);
+        MotorSetTarget(0.0f, 0.0f);
+    }
+    else if((ucWirelessCmd == 't') && (bNewCmd != FALSE)) /*Auto-tune*/
+    {
+        MotorTuneStart();
+    }
+    else if((ucWirelessCmd >= '0') && (ucWirelessCmd < ('0' + PID_TUNE_RULE_NUMBER)) && (bNewCmd != FALSE)) /*Tuning rule*/
+    {
+        ulMotorTuneRule = (uint32_t)(ucWirelessCmd - '0');
+
+        if(bMotorTuneValid != FALSE)
+        {
+            MotorTuneApply(ulMotorTuneRule);
+            MotorTuneReport(PID_TUNE_DONE);
+        }
+    }
+    else if((ucWirelessCmd == 'i') && (bNewCmd != FALSE)) /*Identified models*/
+    {
+        MotorIdReport();
+    }
+    else if(((ucWirelessCmd == 'c') || (ucWirelessCmd == 'b') || (ucWirelessCmd == 'v') || (ucWirelessCmd == 'g')) && (bNewCmd != FALSE)) /*Brake mode*/
+    {
+        bEnabled = IfxCpu_disableInterrupts();
+        BrakeSetMode(&stMotorBrake, (ucWirelessCmd == 'c') ? BRAKE_COAST : ((ucWirelessCmd == 'b') ? BRAKE_DYNAMIC :
+                                    ((ucWirelessCmd == 'v') ? BRAKE_PWM : BRAKE_DISTANCE)));
+        IfxCpu_restoreInterrupts(bEnabled);
+    }
+    else if(((ucWirelessCmd == '+') || (ucWirelessCmd == '-')) && (bNewCmd != FALSE)) /*Speed*/
+    {
+        fRpmRef += (ucWirelessCmd == '+') ? MOTOR_RPM_REF_STEP : -MOTOR_RPM_REF_STEP;
+        fRpmRef  = (fRpmRef > MOTOR_RPM_REF_MAX) ? MOTOR_RPM_REF_MAX : fRpmRef;
+        fRpmRef  = (fRpmRef < MOTOR_RPM_REF_MIN) ? MOTOR_RPM_REF_MIN : fRpmRef;
+    }
+    else if(((ucWirelessCmd == 'j') || (ucWirelessCmd == 'k') || (ucWirelessCmd == 'l')) && (bNewCmd != FALSE)) /*Steering*/
+    {
+        fMotorSteerDeg = (ucWirelessCmd == 'k') ? 0.0f : (fMotorSteerDeg + ((ucWirelessCmd == 'j') ? MOTOR_STEER_STEP_DEG : -MOTOR_STEER_STEP_DEG));
+        MidTomServoSetAngle(fMotorSteerDeg);
+        fMotorSteerDeg = MidTomServoGetTarget();
+    }
+    else if(((ucWirelessCmd == 'm') || (ucWirelessCmd == 'n')) && (bNewCmd != FALSE)) /*Move*/
+    {
+        MotorMoveStart((ucWirelessCmd == 'm') ? MOTOR_MOVE_DISTANCE_M : -MOTOR_MOVE_DISTANCE_M);
     }
     else
     {
@@ -119,102 +832,211 @@ void Unit_WirelessControl(void)
     }  
 }
 
-void Unit_MotorFrontDirectionCtl(MOTOR_CMD_TYPE param_DirectionType)
+/*---------------------Auto-Tune--------------------------*/
+/*Gains of the last tune, the PidConfig ones if there is none*/
+static void MotorTuneLoad(void)
 {
-    switch(param_DirectionType)
+    if((MidNvmRead(MID_NVM_BLOCK_MOTOR_TUNE, &stMotorTuneRecord, sizeof(stMotorTuneRecord)) != FALSE) &&
+       (stMotorTuneRecord.ulVersion == MOTOR_TUNE_VERSION) &&
+       (PidTuneGains(stMotorTuneRecord.fKu, stMotorTuneRecord.fTu, stMotorTuneRecord.ulRule, &stMotorPid) != FALSE))
     {
-        case MOTOR_STOP: /*Stop*/
-        {
-            MidDio_SetFrontIn1(0u);
-            MidDio_SetFrontIn2(0u);
-            MidDio_SetFrontIn3(0u);
-            MidDio_SetFrontIn4(0u);    
-            break;
-        }
-        case MOTOR_FWD: /*Forward*/
+        ulMotorTuneRule = stMotorTuneRecord.ulRule;
+        bMotorTuneValid = TRUE;
+    }
+}
+
+/*
+ * Relay experiment on the four wheels, driving forward at MOTOR_TUNE_RPM:
+ * about 0.6m of free floor is needed. The car stops at the end.
+ */
+static void MotorTuneStart(void)
+{
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    MotorSetTarget(MOTOR_TUNE_RPM, MOTOR_TUNE_RPM);
+    PidTuneStart(&stMotorTune, &stMotorTuneCfg);
+
+    IfxCpu_restoreInterrupts(bEnabled);
+}
+
+/*The targets are already 0, set by MotorFeedbackController*/
+static void MotorTuneEnd(uint32_t param_State)
+{
+    uint32_t ulWheel;
+
+    if(param_State == PID_TUNE_DONE)
+    {
+        for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
         {
-            MidDio_SetFrontIn1(1u);
-            MidDio_SetFrontIn2(0u);
-            MidDio_SetFrontIn3(1u);
-            MidDio_SetFrontIn4(0u);            
-            break;           
+            stMotorTuneRecord.fKu[ulWheel] = stMotorTune.fKu[ulWheel];
+            stMotorTuneRecord.fTu[ulWheel] = stMotorTune.fTu[ulWheel];
         }
-        case MOTOR_TURN_RIGHT: /*TurnRight*/
+
+        bMotorTuneValid = TRUE;
+        MotorTuneApply(ulMotorTuneRule);
+    }
+
+    MotorTuneReport(param_State);
+}
+
+/*Gains of param_Rule from the stored Ku/Tu, saved by MotorJobTune for the next boot*/
+static void MotorTuneApply(uint32_t param_Rule)
+{
+    boolean bEnabled;
+    boolean bApplied;
+
+    stMotorTuneRecord.ulVersion = MOTOR_TUNE_VERSION;
+    stMotorTuneRecord.ulRule    = param_Rule;
+
+    bEnabled = IfxCpu_disableInterrupts();
+    bApplied = PidTuneGains(stMotorTuneRecord.fKu, stMotorTuneRecord.fTu, param_Rule, &stMotorPid);
+    IfxCpu_restoreInterrupts(bEnabled);
+
+    if(bApplied != FALSE)
+    {
+        bMotorTuneSavePending = TRUE;
+        (void)BgJobSubmit(MotorJobTune, NULL_PTR, 50u);
+    }
+}
+
+/*
+ * Result on the UART, gains per rpm and Ku times 1000, Tu in ms:
+ *   tune <ok|fail> rule <n>
+ *   w<wheel> ku <Ku> tu <Tu> kp <Kp> ki <Ki> kd <Kd>
+ */
+static void MotorTuneReport(uint32_t param_State)
+{
+    uint32_t ulWheel;
+    uint32_t ulLen;
+
+    ulLen = (uint32_t)sprintf(stMotorReport[MOTOR_REPORT_TUNE].cText, "tune %s rule %lu\r\n",
+                              (param_State == PID_TUNE_DONE) ? "ok" : "fail", (unsigned long)ulMotorTuneRule);
+
+    for(ulWheel = 0u; (ulWheel < MID_TIM_WHEEL_NUMBER) && (bMotorTuneValid != FALSE); ulWheel++)
+    {
+        ulLen += (uint32_t)sprintf(&stMotorReport[MOTOR_REPORT_TUNE].cText[ulLen], "w%lu ku %ld tu %ld kp %ld ki %ld kd %ld\r\n",
+                                   (unsigned long)ulWheel,
+                                   (long)(stMotorTuneRecord.fKu[ulWheel] * 1000.0f),
+                                   (long)(stMotorTuneRecord.fTu[ulWheel] * 1000.0f),
+                                   (long)(stMotorPid.fKp[ulWheel] * 1000.0f),
+                                   (long)(stMotorPid.fKi[ulWheel] * 1000.0f),
+                                   (long)(stMotorPid.fKd[ulWheel] * 1000.0f));
+    }
+
+    MotorReportQueue(MOTOR_REPORT_TUNE, ulLen);
+}
+
+/*---------------------Identification--------------------------*/
+/*
+ * Models of stMotorRls on the UART, K in rpm per duty % and dead duty in %
+ * times 1000, tau in ms, relative deviations of K and tau in 1/1000:
+ *   id w<wheel> k <K> tau <tau> dead <duty> sd <K> <tau> <ok|wait>
+ *   id w<wheel> none
+ */
+static void MotorIdReport(void)
+{
+    char *pText = stMotorReport[MOTOR_REPORT_ID].cText;
+    RlsModel stModel;
+    uint32_t ulWheel;
+    uint32_t ulLen = 0u;
+    boolean bEnabled;
+    boolean bModel;
+
+    for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+    {
+        bEnabled = IfxCpu_disableInterrupts();
+        bModel   = RlsBankGetModel(&stMotorRls, ulWheel, &stModel);
+        IfxCpu_restoreInterrupts(bEnabled);
+
+        if(bModel != FALSE)
         {
-            MidDio_SetFrontIn1(1u);
-            MidDio_SetFrontIn2(0u);
-            MidDio_SetFrontIn3(0u);
-            MidDio_SetFrontIn4(1u);    
-            break;            
+            ulLen += (uint32_t)sprintf(&pText[ulLen], "id w%lu k %ld tau %ld dead %ld sd %ld %ld %s\r\n",
+                                       (unsigned long)ulWheel,
+                                       (long)(stModel.fGain * 1000.0f),
+                                       (long)(stModel.fTimeConst * 1000.0f),
+                                       (long)(stModel.fInDead * 1000.0f),
+                                       (long)(stModel.fGainStd * 1000.0f),
+                                       (long)(stModel.fTimeConstStd * 1000.0f),
+                                       (stModel.bConverged != FALSE) ? "ok" : "wait");
         }
-        case MOTOR_TURN_LEFT: /*TurnLeft*/
+        else
         {
-            MidDio_SetFrontIn1(0u);
-            MidDio_SetFrontIn2(1u);
-            MidDio_SetFrontIn3(1u);
-            MidDio_SetFrontIn4(0u);            
-            break;            
+            ulLen += (uint32_t)sprintf(&pText[ulLen], "id w%lu none\r\n", (unsigned long)ulWheel);
         }
-        case MOTOR_REVERSE: /*Reverse*/
+    }
+
+    MotorReportQueue(MOTOR_REPORT_ID, ulLen);
+}
+
+/*---------------------Background Job--------------------------*/
+/*
+ * Report on the UART and data flash write, waits while the TX buffer is full
+ * or the flash is busy. A queued report goes out after the one being sent,
+ * gains applied during a flash write are saved once it has ended.
+ */
+static E_BG_JOB_STATE MotorJobTune(void *param_Ctx)
+{
+    MotorTuneRecord stRecord;
+    uint32_t ulReport;
+    uint32_t ulSent = 0u;
+    boolean bEnabled;
+
+    (void)param_Ctx;
+
+    if((bMotorTuneSavePending != FALSE) && (MidNvmIsBusy() == FALSE))
+    {
+        /*Copy locked against a MotorTuneApply from the tasks*/
+        bEnabled = IfxCpu_disableInterrupts();
+        stRecord = stMotorTuneRecord;
+        bMotorTuneSavePending = FALSE;
+        IfxCpu_restoreInterrupts(bEnabled);
+
+        (void)MidNvmWrite(MID_NVM_BLOCK_MOTOR_TUNE, &stRecord, sizeof(stRecord));
+    }
+
+    /*A report left queued means the TX buffer is not drained, the job waits for it*/
+    for(ulReport = 0u; (ulReport < MOTOR_REPORT_NUMBER) && (ulMotorTuneTxPos >= ulMotorTuneTxLen); ulReport++)
+    {
+        if(stMotorReport[ulReport].ulLen != 0u)
         {
-            MidDio_SetFrontIn1(0u);
-            MidDio_SetFrontIn2(1u);
-            MidDio_SetFrontIn3(0u);
-            MidDio_SetFrontIn4(1u);            
-            break;            
+            /*Locked against a MotorReportQueue from the tasks*/
+            bEnabled = IfxCpu_disableInterrupts();
+            memcpy(cMotorTuneTxBuf, stMotorReport[ulReport].cText, stMotorReport[ulReport].ulLen);
+            ulMotorTuneTxLen = stMotorReport[ulReport].ulLen;
+            ulMotorTuneTxPos = 0u;
+            stMotorReport[ulReport].ulLen = 0u;
+            IfxCpu_restoreInterrupts(bEnabled);
         }
-        default:
-        break;
     }
+
+    if(ulMotorTuneTxPos < ulMotorTuneTxLen)
+    {
+        ulSent = DrvAscWrite((const uint8_t *)&cMotorTuneTxBuf[ulMotorTuneTxPos], ulMotorTuneTxLen - ulMotorTuneTxPos);
+        ulMotorTuneTxPos += ulSent;
+    }
+
+    if((MidNvmWriteStep() != FALSE) || (ulSent != 0u))
+    {
+        return BG_JOB_PENDING;
+    }
+
+    return ((MidNvmIsBusy() != FALSE) || (bMotorTuneSavePending != FALSE) || (ulMotorTuneTxPos < ulMotorTuneTxLen)) ? BG_JOB_WAIT : BG_JOB_DONE;
 }
 
+/*One OMR store per bridge*/
+void Unit_MotorFrontDirectionCtl(MOTOR_CMD_TYPE param_DirectionType)
+{
+    if(param_DirectionType < MOTOR_CMD_MAX)
+    {
+        MidDio_SetFrontBridge(stMotorDirPattern[param_DirectionType].ulFront);
+    }
+}
 
 void Unit_MotorRearDirectionCtl(MOTOR_CMD_TYPE param_DirectionType)
 {
-    switch(param_DirectionType)
+    if(param_DirectionType < MOTOR_CMD_MAX)
     {
-        case MOTOR_STOP: /*Stop*/
-        {
-            MidDio_SetRearIn1(0u);
-            MidDio_SetRearIn2(0u);
-            MidDio_SetRearIn3(0u);
-            MidDio_SetRearIn4(0u);    
-            break;
-        }
-        case MOTOR_FWD: /*Forward*/
-        {
-            MidDio_SetRearIn1(1u);
-            MidDio_SetRearIn2(0u);
-            MidDio_SetRearIn3(1u);
-            MidDio_SetRearIn4(0u);    
-            break;
-        }        
-        case MOTOR_TURN_RIGHT: /*TurnRight*/
-        {
-            MidDio_SetRearIn1(1u);
-            MidDio_SetRearIn2(0u);
-            MidDio_SetRearIn3(0u);
-            MidDio_SetRearIn4(1u);    
-            break;
-        }
-        case MOTOR_TURN_LEFT: /*TurnLeft*/
-        {
-            MidDio_SetRearIn1(0u);
-            MidDio_SetRearIn2(1u);
-            MidDio_SetRearIn3(1u);
-            MidDio_SetRearIn4(0u);     
-            break;
-        }
-        case MOTOR_REVERSE: /*Reverse*/
-        {
-            MidDio_SetRearIn1(0u);
-            MidDio_SetRearIn2(1u);
-            MidDio_SetRearIn3(0u);
-            MidDio_SetRearIn4(1u);    
-            break;
-        }
-        default:
-        break;
+        MidDio_SetRearBridge(stMotorDirPattern[param_DirectionType].ulRear);
     }
 }
 
@@ -21,6 +21,7 @@ typedef enum t_MOTOR_CMD_TYPE
     MOTOR_TURN_RIGHT,
     MOTOR_TURN_LEFT,
     MOTOR_REVERSE,
+    MOTOR_BRAKE,
     MOTOR_CMD_MAX
 }MOTOR_CMD_TYPE;
 
@@ -33,6 +34,7 @@ typedef enum t_MOTOR_CMD_TYPE
 /*----------------------------------------------------------------*/
 /*                        Global Function Prototype                  */
 /*----------------------------------------------------------------*/
+extern void MotorControlInit(void);
 extern void MotorFeedbackController(void);
 extern void Unit_WirelessControl(void);
 extern void Unit_MotorFrontDirectionCtl(MOTOR_CMD_TYPE param_DirectionType);
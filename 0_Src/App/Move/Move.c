@@ -0,0 +1,175 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <math.h>
+#include "IfxCpu_Intrinsics.h"
+#include "Move.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static void MoveReference(Move *param_Move);
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void MoveInit(Move *param_Move, const MoveConfig *param_Cfg)
+{
+    param_Move->stCfg     = *param_Cfg;
+    param_Move->ulState   = MOVE_IDLE;
+    param_Move->fStart    = 0.0f;
+    param_Move->fDistance = 0.0f;
+    param_Move->fDir      = 1.0f;
+    param_Move->fPosRef   = 0.0f;
+    param_Move->fVelRef   = 0.0f;
+    param_Move->fError    = 0.0f;
+    param_Move->ulSettleCnt = 0u;
+    param_Move->ulStepCnt   = 0u;
+}
+
+/*---------------------Move--------------------------*/
+/*From the measured position and speed, the reference starts at that speed if it goes the way of the move*/
+void MoveStart(Move *param_Move, float32_t param_Pos, float32_t param_Vel, float32_t param_Distance)
+{
+    float32_t fVel;
+
+    param_Move->fStart    = param_Pos;
+    param_Move->fDistance = param_Distance;
+    param_Move->fDir      = (param_Distance < 0.0f) ? -1.0f : 1.0f;
+    param_Move->fPosRef   = 0.0f;
+    param_Move->fError    = param_Distance;
+    param_Move->ulSettleCnt = 0u;
+    param_Move->ulStepCnt   = 0u;
+
+    fVel = param_Move->fDir * param_Vel;
+    fVel = (fVel > param_Move->stCfg.fVelMax) ? param_Move->stCfg.fVelMax : fVel;
+    param_Move->fVelRef = (fVel > 0.0f) ? fVel : 0.0f;
+    param_Move->ulState = MOVE_RUN;
+}
+
+void MoveAbort(Move *param_Move)
+{
+    if(MoveIsActive(param_Move) != FALSE)
+    {
+        param_Move->ulState = MOVE_ABORT;
+    }
+}
+
+/*
+ * One step of stCfg.fSampleTime with the measured position and speed.
+ * Returns the speed reference, signed, 0 once the move is over.
+ */
+float32_t MoveStep(Move *param_Move, float32_t param_Pos, float32_t param_Vel)
+{
+    const MoveConfig *pCfg = &param_Move->stCfg;
+    float32_t fTarget = param_Move->fStart + param_Move->fDistance;
+    float32_t fCorr;
+    float32_t fLeft;
+    float32_t fVelMax;
+    float32_t fOut;
+
+    if(MoveIsActive(param_Move) == FALSE)
+    {
+        return 0.0f;
+    }
+
+    param_Move->ulStepCnt++;
+
+    if(param_Move->ulState == MOVE_RUN)
+    {
+        MoveReference(param_Move);
+    }
+
+    param_Move->fError = fTarget - param_Pos;
+    fCorr = pCfg->fKp * ((param_Move->fStart + (param_Move->fDir * param_Move->fPosRef)) - param_Pos);
+    fCorr = (fCorr > pCfg->fCorrMax) ? pCfg->fCorrMax : fCorr;
+    fCorr = (fCorr < -pCfg->fCorrMax) ? -pCfg->fCorrMax : fCorr;
+
+    if((param_Move->ulState == MOVE_SETTLE) && (__absf(param_Move->fError) <= pCfg->fDeadBand))
+    {
+        fCorr = 0.0f;
+
+        if(__absf(param_Vel) < pCfg->fSettleVel)
+        {
+            param_Move->ulSettleCnt++;
+
+            if(param_Move->ulSettleCnt >= pCfg->ulSettleStep)
+            {
+                param_Move->ulState = MOVE_DONE;
+            }
+        }
+        else
+        {
+            param_Move->ulSettleCnt = 0u;
+        }
+    }
+    else
+    {
+        param_Move->ulSettleCnt = 0u;
+    }
+
+    /*No faster than fVelMax, nor than the car could stop from in the distance it has left after fLookAhead*/
+    fLeft   = __absf(param_Move->fError) - (__absf(param_Vel) * pCfg->fLookAhead);
+    fVelMax = (fLeft > 0.0f) ? sqrtf(2.0f * pCfg->fDecelMax * fLeft) : 0.0f;
+    fVelMax = (fVelMax > pCfg->fVelMax) ? pCfg->fVelMax : fVelMax;
+    fOut = (param_Move->fDir * param_Move->fVelRef) + fCorr;
+    fOut = (fOut > fVelMax) ? fVelMax : fOut;
+    fOut = (fOut < -fVelMax) ? -fVelMax : fOut;
+    fOut = (param_Move->ulState == MOVE_DONE) ? 0.0f : fOut;
+
+    /*Not against the motion before the car nearly stands: it only rolls out, counted the wrong way*/
+    if(((fOut * param_Vel) < 0.0f) && (__absf(param_Vel) >= pCfg->fSettleVel))
+    {
+        fOut = 0.0f;
+    }
+
+    return fOut;
+}
+
+boolean MoveIsActive(const Move *param_Move)
+{
+    return ((param_Move->ulState == MOVE_RUN) || (param_Move->ulState == MOVE_SETTLE)) ? TRUE : FALSE;
+}
+
+/*---------------------Static Function--------------------------*/
+/*Next step of the trapezoid, MOVE_SETTLE once it is at the target*/
+static void MoveReference(Move *param_Move)
+{
+    const MoveConfig *pCfg = &param_Move->stCfg;
+    float32_t fLength = __absf(param_Move->fDistance);
+    float32_t fLeft = fLength - param_Move->fPosRef;
+    float32_t fVel = param_Move->fVelRef + (pCfg->fAccelMax * pCfg->fSampleTime);
+    float32_t fVelStop = (fLeft > 0.0f) ? sqrtf(2.0f * pCfg->fDecelMax * fLeft) : 0.0f;
+
+    fVel = (fVel > pCfg->fVelMax) ? pCfg->fVelMax : fVel;
+    fVel = (fVel > fVelStop) ? fVelStop : fVel;
+
+    param_Move->fPosRef += fVel * pCfg->fSampleTime;
+    param_Move->fVelRef  = fVel;
+
+    /*The last step of the square root profile, or no stopping distance left; not on fVel, low on the first steps*/
+    if((param_Move->fPosRef >= fLength) || (fVelStop < (pCfg->fDecelMax * pCfg->fSampleTime)))
+    {
+        param_Move->fPosRef = fLength;
+        param_Move->fVelRef = 0.0f;
+        param_Move->ulState = MOVE_SETTLE;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef enum
+{
+    MOVE_IDLE = 0u,
+    MOVE_RUN,                           /*Reference on its way to the target*/
+    MOVE_SETTLE,                        /*Reference at the target, the car closing in*/
+    MOVE_DONE,                          /*Settled within fDeadBand*/
+    MOVE_ABORT                          /*MoveAbort before MOVE_DONE*/
+}E_MOVE_STATE;
+
+/*Positions in m, speeds in m/s, times in s*/
+typedef struct
+{
+    float32_t fVelMax;                  /*Cruise speed of the reference*/
+    float32_t fAccelMax;
+    float32_t fDecelMax;                /*At most what the car does without drive: the speed loops do not brake*/
+    float32_t fKp;                      /*Speed per position error, 1/s*/
+    float32_t fCorrMax;                 /*Limit of fKp times the error*/
+    float32_t fLookAhead;               /*Lag of the speed loop behind a falling reference*/
+    float32_t fDeadBand;                /*No correction within, once the reference is at the target*/
+    float32_t fSettleVel;               /*Settled below this speed ...*/
+    uint32_t ulSettleStep;              /*... for this many steps within fDeadBand*/
+    float32_t fSampleTime;              /*Period of MoveStep*/
+}MoveConfig;
+
+/*
+ * Move over a distance, cascaded on a speed loop. The position reference
+ * is a trapezoid: up at fAccelMax to fVelMax, then down at fDecelMax so that
+ * it stops at the target,
+ *   v = min(v + fAccelMax*T, fVelMax, sqrt(2*fDecelMax*left))
+ * The speed reference is v plus fKp times the position error, held below
+ * the speed the car stops from in the distance it has left after fLookAhead.
+ * Two square roots per step, no table.
+ */
+typedef struct
+{
+    MoveConfig stCfg;
+    uint32_t ulState;                   /*E_MOVE_STATE*/
+    float32_t fStart;                   /*Position at MoveStart*/
+    float32_t fDistance;                /*Signed*/
+    float32_t fDir;                     /*Sign of fDistance*/
+    float32_t fPosRef;                  /*Along fDir from fStart, 0..|fDistance|*/
+    float32_t fVelRef;                  /*Along fDir, not below 0*/
+    float32_t fError;                   /*Target less position, the last step*/
+    uint32_t ulSettleCnt;
+    uint32_t ulStepCnt;                 /*Since MoveStart*/
+}Move;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void MoveInit(Move *param_Move, const MoveConfig *param_Cfg);
+void MoveStart(Move *param_Move, float32_t param_Pos, float32_t param_Vel, float32_t param_Distance);
+void MoveAbort(Move *param_Move);
+float32_t MoveStep(Move *param_Move, float32_t param_Pos, float32_t param_Vel);
+boolean MoveIsActive(const Move *param_Move);
+#endif
@@ -0,0 +1,114 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Odom.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define ODOM_HEADING_FRAC_MASK      ((1u << ODOM_HEADING_LUT_SHIFT) - 1u)
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static float32_t OdomSum(float32_t param_Sum, float32_t param_Value, float32_t *param_Lost);
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void OdomInit(Odom *param_Odom, const OdomConfig *param_Cfg)
+{
+    param_Odom->stCfg = *param_Cfg;
+
+#if IFX_LUT_TABLE_CONST == 0
+    Ifx_LutSincosF32_init();
+#endif
+
+    OdomReset(param_Odom, 0.0f, 0.0f, 0.0f);
+}
+
+/*Heading -pi..pi*/
+void OdomReset(Odom *param_Odom, float32_t param_X, float32_t param_Y, float32_t param_HeadingRad)
+{
+    param_Odom->fX        = param_X;
+    param_Odom->fY        = param_Y;
+    param_Odom->fXLost    = 0.0f;
+    param_Odom->fYLost    = 0.0f;
+    param_Odom->ulHeading = (uint32_t)(sint32)(param_HeadingRad * ODOM_HEADING_CNT_PER_RAD);
+    param_Odom->fDist     = 0.0f;
+}
+
+/*---------------------Pose--------------------------*/
+/*
+ * One step of stCfg.fSampleTime with the wheel speeds (m/s) of the step,
+ * both sides taken as constant over it: the centre moves on an arc. The arc
+ * is replaced by its chord, along the heading at the middle of the step and
+ * shortened by 1 - dh^2/24, so a constant speed step has no error beyond the
+ * float rounding.
+ *
+ * The table of Ifx_LutSincosF32 has a step of 2pi/4096. The heading bits
+ * below the table index are added by sin(a+d) = sin(a) + d*cos(a), which
+ * leaves an error under 3e-7. The steps are a few mm against a pose of
+ * tens of m, so x and y are summed with the rounding carried over.
+ */
+void OdomStep(Odom *param_Odom, float32_t param_SpeedLeft, float32_t param_SpeedRight)
+{
+    float32_t fTs = param_Odom->stCfg.fSampleTime;
+    float32_t fDelta;
+    float32_t fDist;
+    float32_t fFrac;
+    float32_t fSin;
+    float32_t fCos;
+    sint32 slDeltaCnt;
+    uint32_t ulMid;
+    Ifx_Lut_FxpAngle slLutAngle;
+
+    fDelta = ((param_SpeedRight - param_SpeedLeft) * fTs) / param_Odom->stCfg.fTrackWidth;
+    fDist  = (param_SpeedLeft + param_SpeedRight) * 0.5f * fTs;
+
+    slDeltaCnt = (sint32)((fDelta * ODOM_HEADING_CNT_PER_RAD) + ((fDelta < 0.0f) ? -0.5f : 0.5f));
+    fDelta     = (float32_t)slDeltaCnt * ODOM_HEADING_RAD_PER_CNT;
+    fDist      = fDist * (1.0f - ((fDelta * fDelta) * (1.0f / 24.0f)));
+
+    ulMid      = param_Odom->ulHeading + (uint32_t)(slDeltaCnt / 2);
+    slLutAngle = (Ifx_Lut_FxpAngle)(ulMid >> ODOM_HEADING_LUT_SHIFT);
+    fFrac      = (float32_t)(ulMid & ODOM_HEADING_FRAC_MASK) * ODOM_HEADING_RAD_PER_CNT;
+    fSin       = Ifx_LutSincosF32_sin(slLutAngle);
+    fCos       = Ifx_LutSincosF32_cos(slLutAngle);
+
+    param_Odom->fX        = OdomSum(param_Odom->fX, fDist * (fCos - (fFrac * fSin)), &param_Odom->fXLost);
+    param_Odom->fY        = OdomSum(param_Odom->fY, fDist * (fSin + (fFrac * fCos)), &param_Odom->fYLost);
+    param_Odom->ulHeading += (uint32_t)slDeltaCnt;
+    param_Odom->fDist     += fDist;
+}
+
+/*-pi..pi*/
+float32_t OdomGetHeadingRad(const Odom *param_Odom)
+{
+    return (float32_t)(sint32)param_Odom->ulHeading * ODOM_HEADING_RAD_PER_CNT;
+}
+
+/*Kahan summation*/
+static float32_t OdomSum(float32_t param_Sum, float32_t param_Value, float32_t *param_Lost)
+{
+    float32_t fValue = param_Value - *param_Lost;
+    float32_t fSum   = param_Sum + fValue;
+
+    *param_Lost = (fSum - param_Sum) - fValue;
+
+    return fSum;
+}
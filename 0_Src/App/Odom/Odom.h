@@ -0,0 +1,56 @@
+#ifndef ODOM_H
+#define ODOM_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+#include "SysSe/Math/Ifx_LutSincosF32.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*Heading: one turn is 2^32 counts, the uint32 wraps with the angle*/
+#define ODOM_HEADING_CNT_PER_RAD    (4294967296.0f / (2.0f * IFX_PI))
+#define ODOM_HEADING_RAD_PER_CNT    ((2.0f * IFX_PI) / 4294967296.0f)
+#define ODOM_HEADING_LUT_SHIFT      (32u - IFX_LUT_ANGLE_BITS)      /*Heading to Ifx_Lut_FxpAngle*/
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+/*Lengths in m, times in s*/
+typedef struct
+{
+    float32_t fTrackWidth;              /*Between the left and right wheel contacts*/
+    float32_t fSampleTime;              /*Period of OdomStep*/
+}OdomConfig;
+
+/*
+ * Differential drive pose. x along the heading 0, y to its left, heading
+ * counter clockwise.
+ */
+typedef struct
+{
+    OdomConfig stCfg;
+    float32_t fX;
+    float32_t fY;
+    float32_t fXLost;                   /*Rounding lost by the sums of fX and fY*/
+    float32_t fYLost;
+    uint32_t ulHeading;                 /*ODOM_HEADING_CNT_PER_RAD*/
+    float32_t fDist;                    /*Path length of the centre, signed*/
+}Odom;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void OdomInit(Odom *param_Odom, const OdomConfig *param_Cfg);
+void OdomReset(Odom *param_Odom, float32_t param_X, float32_t param_Y, float32_t param_HeadingRad);
+void OdomStep(Odom *param_Odom, float32_t param_SpeedLeft, float32_t param_SpeedRight);
+float32_t OdomGetHeadingRad(const Odom *param_Odom);
+#endif
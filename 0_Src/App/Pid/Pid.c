@@ -0,0 +1,210 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Pid.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static float32_t PidLimit(float32_t param_Value, float32_t param_Min, float32_t param_Max);
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void PidInit(Pid *param_Pid, const PidConfig *param_Cfg)
+{
+    Ifx_LowPassPt1F32_Config stFilterCfg;
+
+    param_Pid->stCfg = *param_Cfg;
+
+    /*Ifx_LowPassPt1F32 takes the cut off as 1/time constant*/
+    stFilterCfg.cutOffFrequency = 2.0f * IFX_PI * param_Cfg->fDerivCutOffHz;
+    stFilterCfg.gain            = 1.0f;
+    stFilterCfg.samplingTime    = param_Cfg->fSampleTime;
+    Ifx_LowPassPt1F32_init(&param_Pid->stDerivFilter, &stFilterCfg);
+
+    PidReset(param_Pid, PidLimit(0.0f, param_Cfg->fOutMin, param_Cfg->fOutMax));
+}
+
+/*Bumpless restart from param_Out, e.g. the output applied while the loop was off*/
+void PidReset(Pid *param_Pid, float32_t param_Out)
+{
+    Ifx_LowPassPt1F32_reset(&param_Pid->stDerivFilter);
+    param_Pid->fIntegral = param_Out;
+    param_Pid->fMeasOld  = 0.0f;
+    param_Pid->fOut      = param_Out;
+    param_Pid->bFirst    = TRUE;
+}
+
+/*---------------------Controller--------------------------*/
+/*
+ * One sample, every stCfg.fSampleTime. The derivative acts on the
+ * measurement only, so a step of the reference gives no kick. The integrator
+ * is pulled back by fTrackingGain * (applied - computed output) while the
+ * output is clamped or rate limited.
+ */
+float32_t PidRun(Pid *param_Pid, float32_t param_Ref, float32_t param_Meas)
+{
+    const PidConfig *pCfg = &param_Pid->stCfg;
+    float32_t fProportional;
+    float32_t fDerivative;
+    float32_t fOutRaw;
+    float32_t fOut;
+
+    if(param_Pid->bFirst != FALSE)
+    {
+        param_Pid->fMeasOld = param_Meas;
+        param_Pid->bFirst   = FALSE;
+    }
+
+    fProportional = pCfg->fKp * ((pCfg->fSetpointWeight * param_Ref) - param_Meas);
+    fDerivative   = -pCfg->fKd * Ifx_LowPassPt1F32_do(&param_Pid->stDerivFilter, (param_Meas - param_Pid->fMeasOld) / pCfg->fSampleTime);
+    param_Pid->fMeasOld = param_Meas;
+
+    fOutRaw = fProportional + param_Pid->fIntegral + fDerivative;
+    fOut    = PidLimit(fOutRaw, pCfg->fOutMin, pCfg->fOutMax);
+
+    if(pCfg->fRateMax > 0.0f)
+    {
+        float32_t fStepMax = pCfg->fRateMax * pCfg->fSampleTime;
+
+        fOut = PidLimit(fOut, param_Pid->fOut - fStepMax, param_Pid->fOut + fStepMax);
+    }
+
+    /*Integration after the output: back-calculation with the applied output*/
+    param_Pid->fIntegral += pCfg->fSampleTime * ((pCfg->fKi * (param_Ref - param_Meas)) + (pCfg->fTrackingGain * (fOut - fOutRaw)));
+    param_Pid->fOut = fOut;
+
+    return fOut;
+}
+
+/*---------------------Controller Bank--------------------------*/
+void PidBankInit(PidBank *param_Bank, const PidConfig *param_Cfg)
+{
+    Ifx_LowPassPt1F32_Config stFilterCfg;
+    Ifx_LowPassPt1F32 stFilter;
+    uint32_t ulLoop;
+
+    param_Bank->stCfg = *param_Cfg;
+
+    for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+    {
+        param_Bank->fKp[ulLoop] = param_Cfg->fKp;
+        param_Bank->fKi[ulLoop] = param_Cfg->fKi;
+        param_Bank->fKd[ulLoop] = param_Cfg->fKd;
+    }
+
+    /*Same PT1 as PidInit, its coefficients are applied inline by PidBankRun*/
+    stFilterCfg.cutOffFrequency = 2.0f * IFX_PI * param_Cfg->fDerivCutOffHz;
+    stFilterCfg.gain            = 1.0f;
+    stFilterCfg.samplingTime    = param_Cfg->fSampleTime;
+    Ifx_LowPassPt1F32_init(&stFilter, &stFilterCfg);
+    param_Bank->fDerivA = stFilter.a;
+    param_Bank->fDerivB = stFilter.b;
+
+    PidBankReset(param_Bank, PidLimit(0.0f, param_Cfg->fOutMin, param_Cfg->fOutMax));
+}
+
+void PidBankReset(PidBank *param_Bank, float32_t param_Out)
+{
+    uint32_t ulLoop;
+
+    for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+    {
+        param_Bank->fIntegral[ulLoop] = param_Out;
+        param_Bank->fMeasOld[ulLoop]  = 0.0f;
+        param_Bank->fDeriv[ulLoop]    = 0.0f;
+        param_Bank->fOut[ulLoop]      = param_Out;
+    }
+
+    param_Bank->bFirst = TRUE;
+}
+
+/*
+ * PidRun for all loops in one pass. The shared parameters are loaded once and
+ * the loop body has no call, so each step stays in registers.
+ */
+void PidBankRun(PidBank *param_Bank, const float32_t *param_Ref, const float32_t *param_Meas, float32_t *param_Out)
+{
+    const float32_t fTs        = param_Bank->stCfg.fSampleTime;
+    const float32_t fWeight    = param_Bank->stCfg.fSetpointWeight;
+    const float32_t fTracking  = param_Bank->stCfg.fTrackingGain;
+    const float32_t fOutMin    = param_Bank->stCfg.fOutMin;
+    const float32_t fOutMax    = param_Bank->stCfg.fOutMax;
+    const float32_t fStepMax   = param_Bank->stCfg.fRateMax * fTs;
+    const float32_t fDerivA    = param_Bank->fDerivA / fTs;
+    const float32_t fDerivB    = param_Bank->fDerivB;
+    const boolean bRateLimit   = (param_Bank->stCfg.fRateMax > 0.0f) ? TRUE : FALSE;
+    uint32_t ulLoop;
+
+    if(param_Bank->bFirst != FALSE)
+    {
+        for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+        {
+            param_Bank->fMeasOld[ulLoop] = param_Meas[ulLoop];
+        }
+
+        param_Bank->bFirst = FALSE;
+    }
+
+    for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+    {
+        float32_t fRef   = param_Ref[ulLoop];
+        float32_t fMeas  = param_Meas[ulLoop];
+        float32_t fDeriv = param_Bank->fDeriv[ulLoop];
+        float32_t fOutOld = param_Bank->fOut[ulLoop];
+        float32_t fOutRaw;
+        float32_t fOut;
+
+        fDeriv  = fDeriv + (fDerivA * (fMeas - param_Bank->fMeasOld[ulLoop])) - (fDerivB * fDeriv);
+        fOutRaw = (param_Bank->fKp[ulLoop] * ((fWeight * fRef) - fMeas)) + param_Bank->fIntegral[ulLoop] - (param_Bank->fKd[ulLoop] * fDeriv);
+
+        fOut = (fOutRaw > fOutMax) ? fOutMax : fOutRaw;
+        fOut = (fOut < fOutMin) ? fOutMin : fOut;
+
+        if(bRateLimit != FALSE)
+        {
+            fOut = (fOut > (fOutOld + fStepMax)) ? (fOutOld + fStepMax) : fOut;
+            fOut = (fOut < (fOutOld - fStepMax)) ? (fOutOld - fStepMax) : fOut;
+        }
+
+        param_Bank->fIntegral[ulLoop] += fTs * ((param_Bank->fKi[ulLoop] * (fRef - fMeas)) + (fTracking * (fOut - fOutRaw)));
+        param_Bank->fDeriv[ulLoop]   = fDeriv;
+        param_Bank->fMeasOld[ulLoop] = fMeas;
+        param_Bank->fOut[ulLoop]     = fOut;
+        param_Out[ulLoop]            = fOut;
+    }
+}
+
+static float32_t PidLimit(float32_t param_Value, float32_t param_Min, float32_t param_Max)
+{
+    if(param_Value > param_Max)
+    {
+        return param_Max;
+    }
+
+    if(param_Value < param_Min)
+    {
+        return param_Min;
+    }
+
+    return param_Value;
+}
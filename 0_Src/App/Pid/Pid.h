@@ -0,0 +1,83 @@
+#ifndef PID_H
+#define PID_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+#include "SysSe/Math/Ifx_LowPassPt1F32.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define PID_BANK_NUMBER             4u      /*Loops of a PidBank*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+/*Gains in output unit per measurement unit, times in s*/
+typedef struct
+{
+    float32_t fKp;
+    float32_t fKi;                      /*1/s*/
+    float32_t fKd;                      /*s*/
+    float32_t fSetpointWeight;          /*P term on fSetpointWeight*ref - meas, 1 : classic PID*/
+    float32_t fTrackingGain;            /*Back-calculation gain 1/s, 0 : no anti-windup*/
+    float32_t fDerivCutOffHz;           /*PT1 on the derivative of the measurement*/
+    float32_t fOutMin;
+    float32_t fOutMax;
+    float32_t fRateMax;                 /*Output change per s, 0 : no limit*/
+    float32_t fSampleTime;              /*Period of PidRun*/
+}PidConfig;
+
+/*
+ * One controller. The gains of stCfg can be changed at run time, the
+ * derivative filter and the sample time only through PidInit.
+ */
+typedef struct
+{
+    PidConfig stCfg;
+    Ifx_LowPassPt1F32 stDerivFilter;
+    float32_t fIntegral;
+    float32_t fMeasOld;
+    float32_t fOut;                     /*Last output, after the limits*/
+    boolean bFirst;                     /*No measurement yet: no derivative*/
+}Pid;
+
+/*
+ * PID_BANK_NUMBER controllers of the same structure stepped together by
+ * PidBankRun, state held as arrays. The gains are per loop and can be changed
+ * at run time, the limits, the filter and the sample time are shared.
+ */
+typedef struct
+{
+    PidConfig stCfg;                    /*Shared part, fKp/fKi/fKd unused*/
+    float32_t fDerivA;                  /*PT1 coefficients, see Ifx_LowPassPt1F32*/
+    float32_t fDerivB;
+    float32_t fKp[PID_BANK_NUMBER];
+    float32_t fKi[PID_BANK_NUMBER];
+    float32_t fKd[PID_BANK_NUMBER];
+    float32_t fIntegral[PID_BANK_NUMBER];
+    float32_t fMeasOld[PID_BANK_NUMBER];
+    float32_t fDeriv[PID_BANK_NUMBER];  /*Filtered derivative of the measurement*/
+    float32_t fOut[PID_BANK_NUMBER];
+    boolean bFirst;
+}PidBank;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void PidInit(Pid *param_Pid, const PidConfig *param_Cfg);
+void PidReset(Pid *param_Pid, float32_t param_Out);
+float32_t PidRun(Pid *param_Pid, float32_t param_Ref, float32_t param_Meas);
+void PidBankInit(PidBank *param_Bank, const PidConfig *param_Cfg);
+void PidBankReset(PidBank *param_Bank, float32_t param_Out);
+void PidBankRun(PidBank *param_Bank, const float32_t *param_Ref, const float32_t *param_Meas, float32_t *param_Out);
+#endif
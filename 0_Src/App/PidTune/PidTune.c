@@ -0,0 +1,277 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <math.h>
+#include "PidTune.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+/*Kp = fKp * Ku, Ti = fTi * Tu, Td = fTd * Tu*/
+typedef struct
+{
+    float32_t fKp;
+    float32_t fTi;
+    float32_t fTd;
+}PidTuneRule;
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static void PidTuneRelay(PidTune *param_Tune, const PidBank *param_Bank, const float32_t *param_Ref, const float32_t *param_Meas, float32_t *param_Out);
+static void PidTuneFinish(PidTune *param_Tune, PidBank *param_Bank, float32_t *param_Out);
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static const PidTuneRule stPidTuneRule[PID_TUNE_RULE_NUMBER] =
+{
+    {0.45f,         1.0f / 1.2f,    0.0f},          /*PID_TUNE_ZN_PI*/
+    {0.6f,          0.5f,           0.125f},        /*PID_TUNE_ZN_PID*/
+    {1.0f / 3.2f,   2.2f,           0.0f},          /*PID_TUNE_TL_PI*/
+    {1.0f / 2.2f,   2.2f,           1.0f / 6.3f},   /*PID_TUNE_TL_PID*/
+    {0.2f,          0.5f,           1.0f / 3.0f}    /*PID_TUNE_NO_OVERSHOOT_PID*/
+};
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Experiment--------------------------*/
+void PidTuneStart(PidTune *param_Tune, const PidTuneConfig *param_Cfg)
+{
+    uint32_t ulLoop;
+
+    param_Tune->stCfg   = *param_Cfg;
+    param_Tune->ulState = PID_TUNE_SETTLE;
+    param_Tune->ulStep  = 0u;
+
+    for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+    {
+        param_Tune->fBias[ulLoop]      = 0.0f;
+        param_Tune->bHigh[ulLoop]      = TRUE;
+        param_Tune->ulCycle[ulLoop]    = 0u;
+        param_Tune->ulRiseStep[ulLoop] = 0u;
+        param_Tune->fMax[ulLoop]       = 0.0f;
+        param_Tune->fMin[ulLoop]       = 0.0f;
+        param_Tune->fPeriodSum[ulLoop] = 0.0f;
+        param_Tune->fPeakSum[ulLoop]   = 0.0f;
+        param_Tune->fKu[ulLoop]        = 0.0f;
+        param_Tune->fTu[ulLoop]        = 0.0f;
+    }
+}
+
+/*The bank keeps running from its state, without a bump*/
+void PidTuneStop(PidTune *param_Tune)
+{
+    param_Tune->ulState = PID_TUNE_IDLE;
+}
+
+/*
+ * Takes the place of PidBankRun while an experiment runs, one call every
+ * stCfg.fSampleTime of the bank. Settle: the bank holds the reference and the
+ * mean output of the second half of ulSettleStep is the bias of each relay.
+ * Relay: the output is bias + d while the error is above -eps, bias - d
+ * while it is below +eps, see PidTuneRelay. At the end the integrators of the
+ * bank start from the biases. Returns the E_PID_TUNE_STATE after the step.
+ */
+uint32_t PidTuneRun(PidTune *param_Tune, PidBank *param_Bank, const float32_t *param_Ref, const float32_t *param_Meas, float32_t *param_Out)
+{
+    const uint32_t ulSettleHalf = param_Tune->stCfg.ulSettleStep / 2u;
+    uint32_t ulLoop;
+
+    if(param_Tune->ulState == PID_TUNE_SETTLE)
+    {
+        PidBankRun(param_Bank, param_Ref, param_Meas, param_Out);
+
+        if(param_Tune->ulStep >= ulSettleHalf)
+        {
+            for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+            {
+                param_Tune->fBias[ulLoop] += param_Out[ulLoop];
+            }
+        }
+
+        param_Tune->ulStep++;
+
+        if(param_Tune->ulStep >= param_Tune->stCfg.ulSettleStep)
+        {
+            for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+            {
+                param_Tune->fBias[ulLoop] /= (float32_t)(param_Tune->stCfg.ulSettleStep - ulSettleHalf);
+                param_Tune->fMax[ulLoop]   = param_Meas[ulLoop];
+                param_Tune->fMin[ulLoop]   = param_Meas[ulLoop];
+            }
+
+            param_Tune->ulState = PID_TUNE_RELAY;
+        }
+    }
+    else if(param_Tune->ulState == PID_TUNE_RELAY)
+    {
+        PidTuneRelay(param_Tune, param_Bank, param_Ref, param_Meas, param_Out);
+        param_Tune->ulStep++;
+
+        if(param_Tune->ulState != PID_TUNE_RELAY)
+        {
+            PidTuneFinish(param_Tune, param_Bank, param_Out);
+        }
+        else if(param_Tune->ulStep >= param_Tune->stCfg.ulTimeoutStep)
+        {
+            param_Tune->ulState = PID_TUNE_FAIL;
+            PidTuneFinish(param_Tune, param_Bank, param_Out);
+        }
+        else
+        {
+            /*No Code*/
+        }
+    }
+    else
+    {
+        PidBankRun(param_Bank, param_Ref, param_Meas, param_Out);
+    }
+
+    return param_Tune->ulState;
+}
+
+/*---------------------Tuning Rules--------------------------*/
+/*
+ * Gains of param_Rule for every loop of param_Bank from their Ku and Tu, as
+ * Ki = Kp/Ti and Kd = Kp*Td. Nothing is changed if one Ku or Tu is not
+ * positive (no result, or a failed experiment).
+ */
+boolean PidTuneGains(const float32_t *param_Ku, const float32_t *param_Tu, uint32_t param_Rule, PidBank *param_Bank)
+{
+    const PidTuneRule *pRule;
+    uint32_t ulLoop;
+
+    if(param_Rule >= PID_TUNE_RULE_NUMBER)
+    {
+        return FALSE;
+    }
+
+    for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+    {
+        if((param_Ku[ulLoop] <= 0.0f) || (param_Tu[ulLoop] <= 0.0f))
+        {
+            return FALSE;
+        }
+    }
+
+    pRule = &stPidTuneRule[param_Rule];
+
+    for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+    {
+        float32_t fKp = pRule->fKp * param_Ku[ulLoop];
+
+        param_Bank->fKp[ulLoop] = fKp;
+        param_Bank->fKi[ulLoop] = fKp / (pRule->fTi * param_Tu[ulLoop]);
+        param_Bank->fKd[ulLoop] = fKp * pRule->fTd * param_Tu[ulLoop];
+    }
+
+    return TRUE;
+}
+
+/*---------------------Static Function--------------------------*/
+/*
+ * A cycle ends at each switch to the high output: Tu is the mean time
+ * between these switches and a half the mean peak to peak measurement of the
+ * cycles in between. With hysteresis the describing function of the relay
+ * gives Ku = 4d / (pi * sqrt(a^2 - eps^2)), d being the half step actually
+ * applied after the output limits.
+ */
+static void PidTuneRelay(PidTune *param_Tune, const PidBank *param_Bank, const float32_t *param_Ref, const float32_t *param_Meas, float32_t *param_Out)
+{
+    const float32_t fEps   = param_Tune->stCfg.fHysteresis;
+    const uint32_t ulFirst = param_Tune->stCfg.ulSkipCycle + 1u;
+    const uint32_t ulLast  = param_Tune->stCfg.ulSkipCycle + param_Tune->stCfg.ulMeasureCycle;
+    uint32_t ulDoneCnt = 0u;
+    uint32_t ulLoop;
+
+    for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+    {
+        float32_t fMeas  = param_Meas[ulLoop];
+        float32_t fError = param_Ref[ulLoop] - fMeas;
+        float32_t fHigh  = param_Tune->fBias[ulLoop] + param_Tune->stCfg.fAmplitude;
+        float32_t fLow   = param_Tune->fBias[ulLoop] - param_Tune->stCfg.fAmplitude;
+
+        fHigh = (fHigh > param_Bank->stCfg.fOutMax) ? param_Bank->stCfg.fOutMax : fHigh;
+        fLow  = (fLow < param_Bank->stCfg.fOutMin) ? param_Bank->stCfg.fOutMin : fLow;
+
+        param_Tune->fMax[ulLoop] = (fMeas > param_Tune->fMax[ulLoop]) ? fMeas : param_Tune->fMax[ulLoop];
+        param_Tune->fMin[ulLoop] = (fMeas < param_Tune->fMin[ulLoop]) ? fMeas : param_Tune->fMin[ulLoop];
+
+        if((param_Tune->bHigh[ulLoop] != FALSE) && (fError < -fEps))
+        {
+            param_Tune->bHigh[ulLoop] = FALSE;
+        }
+        else if((param_Tune->bHigh[ulLoop] == FALSE) && (fError > fEps))
+        {
+            uint32_t ulCycle = param_Tune->ulCycle[ulLoop];
+
+            param_Tune->bHigh[ulLoop] = TRUE;
+
+            if((ulCycle >= ulFirst) && (ulCycle <= ulLast))
+            {
+                param_Tune->fPeriodSum[ulLoop] += (float32_t)(param_Tune->ulStep - param_Tune->ulRiseStep[ulLoop]);
+                param_Tune->fPeakSum[ulLoop]   += param_Tune->fMax[ulLoop] - param_Tune->fMin[ulLoop];
+            }
+
+            if(ulCycle == ulLast)
+            {
+                float32_t fA = param_Tune->fPeakSum[ulLoop] / (2.0f * (float32_t)param_Tune->stCfg.ulMeasureCycle);
+                float32_t fD = 0.5f * (fHigh - fLow);
+
+                param_Tune->fTu[ulLoop] = (param_Tune->fPeriodSum[ulLoop] * param_Bank->stCfg.fSampleTime) / (float32_t)param_Tune->stCfg.ulMeasureCycle;
+                param_Tune->fKu[ulLoop] = (fA > fEps) ? ((4.0f * fD) / (IFX_PI * sqrtf((fA * fA) - (fEps * fEps)))) : 0.0f;
+            }
+
+            param_Tune->ulCycle[ulLoop]    = ulCycle + 1u;
+            param_Tune->ulRiseStep[ulLoop] = param_Tune->ulStep;
+            param_Tune->fMax[ulLoop]       = fMeas;
+            param_Tune->fMin[ulLoop]       = fMeas;
+        }
+        else
+        {
+            /*No Code*/
+        }
+
+        param_Out[ulLoop] = (param_Tune->bHigh[ulLoop] != FALSE) ? fHigh : fLow;
+        ulDoneCnt += (param_Tune->ulCycle[ulLoop] > ulLast) ? 1u : 0u;
+    }
+
+    if(ulDoneCnt == PID_BANK_NUMBER)
+    {
+        param_Tune->ulState = PID_TUNE_DONE;
+
+        for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+        {
+            if(param_Tune->fKu[ulLoop] <= 0.0f)
+            {
+                param_Tune->ulState = PID_TUNE_FAIL;
+            }
+        }
+    }
+}
+
+/*Bumpless return to the bank: each integrator starts from its relay bias*/
+static void PidTuneFinish(PidTune *param_Tune, PidBank *param_Bank, float32_t *param_Out)
+{
+    uint32_t ulLoop;
+
+    for(ulLoop = 0u; ulLoop < PID_BANK_NUMBER; ulLoop++)
+    {
+        param_Bank->fIntegral[ulLoop] = param_Tune->fBias[ulLoop];
+        param_Bank->fOut[ulLoop]      = param_Tune->fBias[ulLoop];
+        param_Out[ulLoop]             = param_Tune->fBias[ulLoop];
+    }
+
+    param_Bank->bFirst = TRUE;
+}
@@ -0,0 +1,82 @@
+#ifndef PIDTUNE_H
+#define PIDTUNE_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+#include "Pid.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+/*Gains from the ultimate gain Ku and period Tu*/
+typedef enum
+{
+    PID_TUNE_ZN_PI = 0u,                /*Ziegler-Nichols*/
+    PID_TUNE_ZN_PID,
+    PID_TUNE_TL_PI,                     /*Tyreus-Luyben, less overshoot than ZN*/
+    PID_TUNE_TL_PID,
+    PID_TUNE_NO_OVERSHOOT_PID,
+    PID_TUNE_RULE_NUMBER
+}E_PID_TUNE_RULE;
+
+typedef enum
+{
+    PID_TUNE_IDLE = 0u,
+    PID_TUNE_SETTLE,                    /*Closed loop at the reference, the mean output is the relay bias*/
+    PID_TUNE_RELAY,                     /*Relay oscillation around the reference*/
+    PID_TUNE_DONE,                      /*fKu/fTu valid for all loops*/
+    PID_TUNE_FAIL                       /*No stable oscillation before ulTimeoutStep*/
+}E_PID_TUNE_STATE;
+
+typedef struct
+{
+    float32_t fAmplitude;               /*Relay output step d around the bias*/
+    float32_t fHysteresis;              /*Relay switches at +/- this error, above the measurement noise*/
+    uint32_t ulSettleStep;              /*Steps closed loop, the mean output of the second half is the bias*/
+    uint32_t ulSkipCycle;               /*First relay cycles not measured*/
+    uint32_t ulMeasureCycle;            /*Cycles averaged for Ku and Tu*/
+    uint32_t ulTimeoutStep;             /*Whole experiment*/
+}PidTuneConfig;
+
+/*
+ * Relay experiment on the PID_BANK_NUMBER loops of a PidBank at the same
+ * time. Each loop has its own relay and measures its own Ku and Tu.
+ */
+typedef struct
+{
+    PidTuneConfig stCfg;
+    uint32_t ulState;                   /*E_PID_TUNE_STATE*/
+    uint32_t ulStep;
+    float32_t fBias[PID_BANK_NUMBER];
+    boolean bHigh[PID_BANK_NUMBER];
+    uint32_t ulCycle[PID_BANK_NUMBER];  /*Rising switches so far*/
+    uint32_t ulRiseStep[PID_BANK_NUMBER];
+    float32_t fMax[PID_BANK_NUMBER];    /*Measurement peaks of the running cycle*/
+    float32_t fMin[PID_BANK_NUMBER];
+    float32_t fPeriodSum[PID_BANK_NUMBER];
+    float32_t fPeakSum[PID_BANK_NUMBER];
+    float32_t fKu[PID_BANK_NUMBER];
+    float32_t fTu[PID_BANK_NUMBER];     /*s*/
+}PidTune;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void PidTuneStart(PidTune *param_Tune, const PidTuneConfig *param_Cfg);
+void PidTuneStop(PidTune *param_Tune);
+uint32_t PidTuneRun(PidTune *param_Tune, PidBank *param_Bank, const float32_t *param_Ref, const float32_t *param_Meas, float32_t *param_Out);
+boolean PidTuneGains(const float32_t *param_Ku, const float32_t *param_Tu, uint32_t param_Rule, PidBank *param_Bank);
+#endif
@@ -0,0 +1,185 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <math.h>
+#include "Rls.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void RlsBankInit(RlsBank *param_Bank, const RlsConfig *param_Cfg)
+{
+    param_Bank->stCfg = *param_Cfg;
+
+    RlsBankReset(param_Bank);
+}
+
+/*Forgets the models, P back to fCovInit*/
+void RlsBankReset(RlsBank *param_Bank)
+{
+    const float32_t fCovInit = param_Bank->stCfg.fCovInit;
+    uint32_t ulLoop;
+
+    for(ulLoop = 0u; ulLoop < RLS_BANK_NUMBER; ulLoop++)
+    {
+        param_Bank->fTheta[ulLoop][0] = 0.0f;
+        param_Bank->fTheta[ulLoop][1] = 0.0f;
+        param_Bank->fTheta[ulLoop][2] = 0.0f;
+        param_Bank->fCov[ulLoop][0]   = fCovInit;
+        param_Bank->fCov[ulLoop][1]   = 0.0f;
+        param_Bank->fCov[ulLoop][2]   = 0.0f;
+        param_Bank->fCov[ulLoop][3]   = fCovInit;
+        param_Bank->fCov[ulLoop][4]   = 0.0f;
+        param_Bank->fCov[ulLoop][5]   = fCovInit;
+        param_Bank->fErrVar[ulLoop]   = 0.0f;
+        param_Bank->fInOld[ulLoop]    = 0.0f;
+        param_Bank->fMeasOld[ulLoop]  = 0.0f;
+        param_Bank->ulUpdateCnt[ulLoop] = 0u;
+    }
+}
+
+/*---------------------Estimator--------------------------*/
+/*
+ * One step of every loop, param_In being the input applied since the last
+ * call and param_Meas the measurement now. With phi = (y[k-1], u[k-1], 1),
+ * g = P*phi and d = lambda + phi'*g:
+ *   theta += g*e/d,  P = (P - g*g'/d)/lambda
+ * Only the upper triangle of P is kept, which keeps it symmetric. Loops with
+ * no input or a measurement below fMeasMin are not updated.
+ */
+void RlsBankRun(RlsBank *param_Bank, const float32_t *param_In, const float32_t *param_Meas)
+{
+    const float32_t fLambda    = param_Bank->stCfg.fForgetting;
+    const float32_t fInvLambda = 1.0f / fLambda;
+    const float32_t fTraceMax  = param_Bank->stCfg.fTraceMax;
+    const float32_t fMeasMin   = param_Bank->stCfg.fMeasMin;
+    uint32_t ulLoop;
+
+    for(ulLoop = 0u; ulLoop < RLS_BANK_NUMBER; ulLoop++)
+    {
+        float32_t fY  = param_Meas[ulLoop];
+        float32_t fY1 = param_Bank->fMeasOld[ulLoop];
+        float32_t fU1 = param_Bank->fInOld[ulLoop];
+
+        param_Bank->fInOld[ulLoop]   = param_In[ulLoop];
+        param_Bank->fMeasOld[ulLoop] = fY;
+
+        if((fY1 >= fMeasMin) && (fU1 > 0.0f))
+        {
+            float32_t *pTheta = param_Bank->fTheta[ulLoop];
+            float32_t *pCov   = param_Bank->fCov[ulLoop];
+            float32_t fG0 = (pCov[0] * fY1) + (pCov[1] * fU1) + pCov[2];
+            float32_t fG1 = (pCov[1] * fY1) + (pCov[3] * fU1) + pCov[4];
+            float32_t fG2 = (pCov[2] * fY1) + (pCov[4] * fU1) + pCov[5];
+            float32_t fErr = fY - ((pTheta[0] * fY1) + (pTheta[1] * fU1) + pTheta[2]);
+            float32_t fLam = fLambda;
+            float32_t fInvLam = fInvLambda;
+            float32_t fInvDen;
+            float32_t fGain;
+
+            if((pCov[0] + pCov[3] + pCov[5]) > fTraceMax)
+            {
+                fLam    = 1.0f;
+                fInvLam = 1.0f;
+            }
+
+            fInvDen = 1.0f / (fLam + (fY1 * fG0) + (fU1 * fG1) + fG2);
+            fGain   = fErr * fInvDen;
+
+            pTheta[0] += fG0 * fGain;
+            pTheta[1] += fG1 * fGain;
+            pTheta[2] += fG2 * fGain;
+
+            pCov[0] = (pCov[0] - (fG0 * fG0 * fInvDen)) * fInvLam;
+            pCov[1] = (pCov[1] - (fG0 * fG1 * fInvDen)) * fInvLam;
+            pCov[2] = (pCov[2] - (fG0 * fG2 * fInvDen)) * fInvLam;
+            pCov[3] = (pCov[3] - (fG1 * fG1 * fInvDen)) * fInvLam;
+            pCov[4] = (pCov[4] - (fG1 * fG2 * fInvDen)) * fInvLam;
+            pCov[5] = (pCov[5] - (fG2 * fG2 * fInvDen)) * fInvLam;
+
+            /*e*lambda/d: the part of the error not explained by the uncertainty of theta*/
+            param_Bank->fErrVar[ulLoop] = (fLambda * param_Bank->fErrVar[ulLoop]) + ((1.0f - fLambda) * fErr * fErr * fLam * fInvDen);
+            param_Bank->ulUpdateCnt[ulLoop]++;
+        }
+    }
+}
+
+/*---------------------Model--------------------------*/
+/*
+ * K = b/(1 - a), tau = -Ts/ln(a). The covariance of theta is about
+ * fErrVar*P/(1 + lambda) with forgetting. Converged once the loop was
+ * updated over one memory length and both relative deviations are below
+ * fConfidence. FALSE while a and b give no stable model of positive gain.
+ */
+boolean RlsBankGetModel(const RlsBank *param_Bank, uint32_t param_Loop, RlsModel *param_Model)
+{
+    const float32_t fLambda = param_Bank->stCfg.fForgetting;
+    const float32_t *pTheta;
+    const float32_t *pCov;
+    float32_t fA;
+    float32_t fB;
+    float32_t fLnA;
+    float32_t fVar;
+    float32_t fDkDa;
+    float32_t fDkDb;
+
+    if(param_Loop >= RLS_BANK_NUMBER)
+    {
+        return FALSE;
+    }
+
+    pTheta = param_Bank->fTheta[param_Loop];
+    pCov   = param_Bank->fCov[param_Loop];
+    fA     = pTheta[0];
+    fB     = pTheta[1];
+
+    param_Model->ulUpdateCnt = param_Bank->ulUpdateCnt[param_Loop];
+    param_Model->fErrStd     = sqrtf(param_Bank->fErrVar[param_Loop]);
+    param_Model->bConverged  = FALSE;
+
+    if((fA <= 0.0f) || (fA >= 1.0f) || (fB <= 0.0f))
+    {
+        return FALSE;
+    }
+
+    fLnA  = logf(fA);
+    fVar  = param_Bank->fErrVar[param_Loop] / (1.0f + fLambda);
+    fDkDb = 1.0f / (1.0f - fA);
+    fDkDa = fB * fDkDb * fDkDb;
+
+    param_Model->fGain         = fB * fDkDb;
+    param_Model->fTimeConst    = -param_Bank->stCfg.fSampleTime / fLnA;
+    param_Model->fInDead       = -pTheta[2] / fB;
+    param_Model->fGainStd      = sqrtf(fVar * ((fDkDa * fDkDa * pCov[0]) + (2.0f * fDkDa * fDkDb * pCov[1]) + (fDkDb * fDkDb * pCov[3]))) / param_Model->fGain;
+    param_Model->fTimeConstStd = sqrtf(fVar * pCov[0]) / (fA * -fLnA);
+
+    if((((float32_t)param_Model->ulUpdateCnt * (1.0f - fLambda)) >= 1.0f) &&
+       (param_Model->fGainStd < param_Bank->stCfg.fConfidence) && (param_Model->fTimeConstStd < param_Bank->stCfg.fConfidence))
+    {
+        param_Model->bConverged = TRUE;
+    }
+
+    return TRUE;
+}
@@ -0,0 +1,78 @@
+#ifndef RLS_H
+#define RLS_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define RLS_BANK_NUMBER             4u      /*Loops of a RlsBank*/
+#define RLS_PARAM_NUMBER            3u      /*a, b, c of the model*/
+#define RLS_COV_NUMBER              6u      /*Upper triangle of P*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+/*Input and measurement in the units of the loop, times in s*/
+typedef struct
+{
+    float32_t fForgetting;              /*lambda, memory of about fSampleTime/(1 - lambda)*/
+    float32_t fCovInit;                 /*P at the start, large : fast first estimate*/
+    float32_t fTraceMax;                /*No forgetting while trace(P) is above, no wind-up without excitation*/
+    float32_t fMeasMin;                 /*No update below: stiction and standstill are not first order*/
+    float32_t fConfidence;              /*Converged below this relative standard deviation of gain and time constant*/
+    float32_t fSampleTime;              /*Period of RlsBankRun*/
+}RlsConfig;
+
+/*
+ * First order model of RLS_BANK_NUMBER loops identified together, each
+ *   y[k] = a*y[k-1] + b*u[k-1] + c
+ * by recursive least squares with exponential forgetting. Fixed size, no
+ * matrix library: about 40 multiply-adds and one division per loop.
+ */
+typedef struct
+{
+    RlsConfig stCfg;
+    float32_t fTheta[RLS_BANK_NUMBER][RLS_PARAM_NUMBER];   /*a, b, c*/
+    float32_t fCov[RLS_BANK_NUMBER][RLS_COV_NUMBER];       /*P00, P01, P02, P11, P12, P22*/
+    float32_t fErrVar[RLS_BANK_NUMBER];                    /*Forgetting mean of the squared a priori error*/
+    float32_t fInOld[RLS_BANK_NUMBER];
+    float32_t fMeasOld[RLS_BANK_NUMBER];
+    uint32_t ulUpdateCnt[RLS_BANK_NUMBER];
+}RlsBank;
+
+/*
+ * Continuous model of a loop: K/(1 + s*tau) from fInDead on. The standard
+ * deviations come from P times the error variance, through the first order
+ * derivatives of K and tau in a and b.
+ */
+typedef struct
+{
+    float32_t fGain;                    /*K, measurement per input*/
+    float32_t fTimeConst;               /*tau, s*/
+    float32_t fInDead;                  /*-c/b, input at which the measurement leaves 0*/
+    float32_t fGainStd;                 /*Relative standard deviation of K*/
+    float32_t fTimeConstStd;            /*Relative standard deviation of tau*/
+    float32_t fErrStd;                  /*One step prediction error, measurement unit*/
+    uint32_t ulUpdateCnt;
+    boolean bConverged;
+}RlsModel;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void RlsBankInit(RlsBank *param_Bank, const RlsConfig *param_Cfg);
+void RlsBankReset(RlsBank *param_Bank);
+void RlsBankRun(RlsBank *param_Bank, const float32_t *param_In, const float32_t *param_Meas);
+boolean RlsBankGetModel(const RlsBank *param_Bank, uint32_t param_Loop, RlsModel *param_Model);
+#endif
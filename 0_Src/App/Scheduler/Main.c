@@ -6,6 +6,7 @@
 #include "Scheduler.h"
 #include "TftMain.h"
 #include "DrvAsc.h"
+#include "MotorControl.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
@@ -34,6 +35,9 @@ int main(void)
     /*System Initialization*/
     DrvSys();
 
+    /*Application Initialization*/
+    MotorControlInit();
+
     /*Register Callback Function*/
     Scheduler_Init();
 
@@ -3,41 +3,39 @@
 /*----------------------------------------------------------------*/
 #include "Scheduler.h"
 #include "MidStm.h"
+#include "MidSwTimer.h"
+#include "MidGpsr.h"
+#include "IfxCpu.h"
+#include "DrvSys.h"
 #include "Common.h"
 #include "DrvDio.h"
 #include "ExeVerification.h"
+#include "ExeTrace.h"
 #include "tft_app.h"
 #include "Configuration.h"
 #include "Perf_Meas.h"
 #include "DrvGtm.h"
 #include "DrvAsc.h"
 #include "MotorControl.h"
+#include "BgJob.h"
+#include "SigBus.h"
+#include "MidTom.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
-
+#define SCHEDULER_TICK_CNT          (SCHEDULER_TICK_MS * 1000u * MID_TIMER_CNT_PER_US)
+#define SCHEDULER_ALL_GROUP_MASK    ((0x1u << SCHEDULER_RATE_GROUP_NUMBER) - 1u)
 
 /*----------------------------------------------------------------*/
 /*                        Typedefs                                    */
 /*----------------------------------------------------------------*/
-typedef struct
-{
-    uint8_t ucScheduler1msFlag;
-    uint8_t ucScheduler5msFlag;
-    uint8_t ucScheduler10msFlag;
-    uint8_t ucScheduler50msFlag;
-    uint8_t ucScheduler100msFlag;
-    uint8_t ucScheduler200msFlag;
-    uint8_t ucScheduler500msFlag;
-    uint8_t ucScheduler1sFlag;    
-}AppTask;
 
 
 /*----------------------------------------------------------------*/
 /*                        Static Function Prototype                  */
 /*----------------------------------------------------------------*/
-static void AppNoTimeTask(void);
+static boolean AppNoTimeTask(void);
 static void AppTask1ms(void);
 static void AppTask5ms(void);
 static void AppTask10ms(void);
@@ -47,40 +45,80 @@ static void AppTask200ms(void);
 static void AppTask500ms(void);
 static void AppTask1s(void);
 
+static E_BG_JOB_STATE AppJobProfDump(void *param_Ctx);
+
 static void TaskSchedulerCallbackFnc(void);
+static uint32_t SchedulerNextReleaseCnt(void);
+static uint32_t SchedulerTakeReadyTask(uint32_t param_GroupMask);
+static void SchedulerRunTask(uint32_t param_TaskIdx);
+static void SchedulerRunGroup(uint32_t param_Group);
+static void SchedulerRateGroup0Fnc(void);
+static void SchedulerRateGroup1Fnc(void);
+static void SchedulerRateGroup2Fnc(void);
+#if (SCHEDULER_TICKLESS == ON)
+static void SchedulerSetNextEvent(void);
+static void SchedulerIdle(void);
+#endif
 
 
 /*----------------------------------------------------------------*/
 /*                        Variables                                    */
 /*----------------------------------------------------------------*/
-AppTask stAppTaskInfo;
-uint32_t ulScheduler1msCounter = 0u;
+/*
+ * Task table. The offsets put every task except the 1ms one on its own tick
+ * (5ms on x1/x6, 10ms on x2, 50ms on x3, 100ms on x4, 200ms on x5, 500ms on
+ * x10, 1s on x15), so the motor loop and the TFT work never stack up.
+ * Adding a task only needs an enum entry and a line here.
+ * In preemptive mode the rate group selects the software interrupt; tasks of
+ * one group run to completion in priority order and never preempt each other.
+ */
+static const SchedulerTaskCfg stSchedulerTaskCfg[SCHEDULER_TASK_NUMBER] =
+{
+    /*pTaskFnc      ulPeriodMs  ulOffsetMs  ucPriority  ulBudgetUs  ucRateGroup*/
+    {AppTask1ms,    1u,         0u,         8u,         100u,       0u},
+    {AppTask5ms,    5u,         1u,         7u,         200u,       0u},
+    {AppTask10ms,   10u,        2u,         6u,         300u,       0u},
+    {AppTask50ms,   50u,        3u,         5u,         500u,       1u},
+    {AppTask100ms,  100u,       4u,         4u,         1000u,      1u},
+    {AppTask200ms,  200u,       5u,         3u,         2000u,      2u},
+    {AppTask500ms,  500u,       10u,        2u,         1000u,      2u},
+    {AppTask1s,     1000u,      15u,        1u,         1000u,      2u},
+};
+
+static void (* const pSchedulerRateGroupFnc[SCHEDULER_RATE_GROUP_NUMBER])(void) =
+{
+    SchedulerRateGroup0Fnc,
+    SchedulerRateGroup1Fnc,
+    SchedulerRateGroup2Fnc
+};
 
-extern uint32_t ulPulseCnt;
-extern uint32_t gu32nuAscRxData;
+SchedulerTaskStat stSchedulerTaskStat[SCHEDULER_TASK_NUMBER];
+uint32_t ulSchedulerTickMs = 0u;
+uint32_t ulSchedulerTickCnt = 0u;      /*Timer count of ulSchedulerTickMs*/
 
 /*----------------------------------------------------------------*/
 /*                        Functions                                    */
 /*----------------------------------------------------------------*/
 
 /*---------------------Application Task Function--------------------------*/
-/*NoTime Taksing*/
-static void AppNoTimeTask(void)
+/*NoTime Taksing : background jobs until the next release, TRUE if a job did some work*/
+static boolean AppNoTimeTask(void)
 {
-    //perf_meas_idle();
+    return BgJobRun(Scheduler_GetNextReleaseCnt());
 }
 
 /*AppTask 1ms*/
 static void AppTask1ms(void)
 {
-    CYCLE_CHECK(TASK_1MS);
+    /*Software timers with a task context callback*/
+    MidSwTimerDispatch();
 }
 
 
 /*AppTask 5ms*/
 static void AppTask5ms(void)
 {
-    CYCLE_CHECK(TASK_5MS);
+    /*Motor control : ADC DMA interrupt, see MotorFeedbackController*/
     //DrvAsc_Test1();
 }
 
@@ -88,21 +126,25 @@ static void AppTask5ms(void)
 /*AppTask 10ms*/
 static void AppTask10ms(void)
 {
-    CYCLE_CHECK(TASK_10MS);
+    /*Steering servo : slew step, the pulse of the next frame*/
+    MidTomServoUpdate();
 }
 
 /*AppTask 50ms*/
 static void AppTask50ms(void)
 {
-    CYCLE_CHECK(TASK_50MS);
 }
 
 /*AppTask 100ms*/
 static void AppTask100ms(void)
 {
-    CYCLE_CHECK(TASK_100MS);
+    /*'p' on the UART streams the profiles until the next command*/
+    if(SigBusReadWord(SIG_UART_RX) == 'p')
+    {
+        ExeProfDumpStart();
+        (void)BgJobSubmit(AppJobProfDump, NULL_PTR, 50u);
+    }
 
-    MotorFeedbackController();
     Unit_WirelessControl();
     //DrvAsc_Test1()
 }
@@ -110,131 +152,349 @@ static void AppTask100ms(void)
 /*AppTask 200ms*/
 static void AppTask200ms(void)
 {
-    CYCLE_CHECK(TASK_200MS);
     //IfxSrc_setRequest(&TFT_UPDATE_IRQ);    /*trigger the tft lib*/
 }
 
 /*AppTask 500ms*/
 static void AppTask500ms(void)
 {
-    CYCLE_CHECK(TASK_500MS);
 }
 
 /*AppTask 1s*/
 static void AppTask1s(void)
-{    
-    CYCLE_CHECK(TASK_1S);
+{
+    BgJobUpdateLoad();
+}
+
+
+/*---------------------Background Job--------------------------*/
+/*Profile dump on the UART, waits while the TX buffer is full*/
+static E_BG_JOB_STATE AppJobProfDump(void *param_Ctx)
+{
+    (void)param_Ctx;
+
+    if(ExeProfDumpStep() != 0u)
+    {
+        return BG_JOB_PENDING;
+    }
+
+    return (ExeProfDumpActive() != FALSE) ? BG_JOB_WAIT : BG_JOB_DONE;
 }
 
 
 /*---------------------CallbackFunc--------------------------*/
 static void TaskSchedulerCallbackFnc(void)
 {
-    ulScheduler1msCounter++;
+    uint32_t ulTaskIdx;
+    uint32_t ulNowCnt = MidGetTimerCnt();
+    uint32_t ulGroupMask = 0u;
 
-    stAppTaskInfo.ucScheduler1msFlag = ON;
+#if (SCHEDULER_TICKLESS == ON)
+    {
+        /*Woken at a release time: count the ticks elapsed since the last event*/
+        uint32_t ulElapsedTick = (ulNowCnt - ulSchedulerTickCnt) / SCHEDULER_TICK_CNT;
+
+        ulSchedulerTickCnt += ulElapsedTick * SCHEDULER_TICK_CNT;
+        ulSchedulerTickMs  += ulElapsedTick * SCHEDULER_TICK_MS;
+    }
+#else
+    ulSchedulerTickCnt += SCHEDULER_TICK_CNT;
+    ulSchedulerTickMs  += SCHEDULER_TICK_MS;
+#endif
 
-    if((ulScheduler1msCounter % 1u) == 0u)
+    for(ulTaskIdx = 0u; ulTaskIdx < SCHEDULER_TASK_NUMBER; ulTaskIdx++)
     {
-        stAppTaskInfo.ucScheduler1msFlag = ON;
+        SchedulerTaskStat *pStat = &stSchedulerTaskStat[ulTaskIdx];
+
+        /*Wrap safe : release when the tick reached the next release time*/
+        while((int32_t)(ulSchedulerTickMs - pStat->ulNextReleaseMs) >= 0)
+        {
+            pStat->ulIdealReleaseCnt = ulSchedulerTickCnt -
+                                       (((ulSchedulerTickMs - pStat->ulNextReleaseMs) / SCHEDULER_TICK_MS) * SCHEDULER_TICK_CNT);
+            pStat->ulNextReleaseMs += stSchedulerTaskCfg[ulTaskIdx].ulPeriodMs;
+            pStat->ulReleaseCnt++;
+
+            /*Previous release never started, a running one is checked by SchedulerRunTask*/
+            if(pStat->ucReady == ON)
+            {
+                pStat->ulDeadlineMissCnt++;
+            }
+
+            pStat->ucReady = ON;
+            pStat->ulReleaseTimeCnt = ulNowCnt;
+            ulGroupMask |= (0x1u << stSchedulerTaskCfg[ulTaskIdx].ucRateGroup);
+        }
     }
 
-    if((ulScheduler1msCounter % 5u) == 0u)
+#if (SCHEDULER_PREEMPTIVE == ON)
+    for(ulTaskIdx = 0u; ulTaskIdx < SCHEDULER_RATE_GROUP_NUMBER; ulTaskIdx++)
     {
-        stAppTaskInfo.ucScheduler5msFlag = ON;
+        if((ulGroupMask & (0x1u << ulTaskIdx)) != 0u)
+        {
+            MidTriggerGpsr(ulTaskIdx);
+        }
     }
+#else
+    (void)ulGroupMask;
+#endif
 
-    if((ulScheduler1msCounter % 10u) == 0u)
+#if (SCHEDULER_TICKLESS == ON)
+    SchedulerSetNextEvent();
+#endif
+}
+
+/*Timer count of the earliest release, from the tick context or locked*/
+static uint32_t SchedulerNextReleaseCnt(void)
+{
+    uint32_t ulTaskIdx;
+    uint32_t ulNextMs = stSchedulerTaskCfg[0].ulPeriodMs;
+
+    for(ulTaskIdx = 0u; ulTaskIdx < SCHEDULER_TASK_NUMBER; ulTaskIdx++)
     {
-        stAppTaskInfo.ucScheduler10msFlag = ON;
+        uint32_t ulDeltaMs = stSchedulerTaskStat[ulTaskIdx].ulNextReleaseMs - ulSchedulerTickMs;
+
+        if((ulTaskIdx == 0u) || (ulDeltaMs < ulNextMs))
+        {
+            ulNextMs = ulDeltaMs;
+        }
     }
 
-    if((ulScheduler1msCounter % 50u) == 0u)
+    return ulSchedulerTickCnt + ((ulNextMs / SCHEDULER_TICK_MS) * SCHEDULER_TICK_CNT);
+}
+
+#if (SCHEDULER_TICKLESS == ON)
+/*Tickless : next timer event at the earliest release*/
+static void SchedulerSetNextEvent(void)
+{
+    MidSetTimerEvent(SchedulerNextReleaseCnt());
+}
+
+/*
+ * Idle request with the interrupts disabled, so a release between the check
+ * and the request still wakes the CPU; it is served on the exit of the lock.
+ */
+static void SchedulerIdle(void)
+{
+    uint32_t ulTaskIdx;
+    uint8_t ucReady = OFF;
+    boolean bEnabled = Scheduler_EnterCritical();
+
+    for(ulTaskIdx = 0u; ulTaskIdx < SCHEDULER_TASK_NUMBER; ulTaskIdx++)
+    {
+        if(stSchedulerTaskStat[ulTaskIdx].ucReady == ON)
+        {
+            ucReady = ON;
+        }
+    }
+
+    if(ucReady == OFF)
+    {
+        DrvSysCpuIdle();
+    }
+
+    Scheduler_ExitCritical(bEnabled);
+}
+#endif
+
+/*---------------------Static Function--------------------------*/
+/*
+ * Highest priority ready task of the groups in param_GroupMask, marked as
+ * running. SCHEDULER_TASK_NUMBER if none. Locked against the tick release.
+ */
+static uint32_t SchedulerTakeReadyTask(uint32_t param_GroupMask)
+{
+    uint32_t ulTaskIdx;
+    uint32_t ulReadyIdx = SCHEDULER_TASK_NUMBER;
+    boolean bEnabled = Scheduler_EnterCritical();
+
+    for(ulTaskIdx = 0u; ulTaskIdx < SCHEDULER_TASK_NUMBER; ulTaskIdx++)
     {
-        stAppTaskInfo.ucScheduler50msFlag = ON;
+        if((stSchedulerTaskStat[ulTaskIdx].ucReady == ON) &&
+           ((param_GroupMask & (0x1u << stSchedulerTaskCfg[ulTaskIdx].ucRateGroup)) != 0u))
+        {
+            if((ulReadyIdx == SCHEDULER_TASK_NUMBER) ||
+               (stSchedulerTaskCfg[ulTaskIdx].ucPriority > stSchedulerTaskCfg[ulReadyIdx].ucPriority))
+            {
+                ulReadyIdx = ulTaskIdx;
+            }
+        }
     }
 
-    if((ulScheduler1msCounter % 100u) == 0u)
+    if(ulReadyIdx < SCHEDULER_TASK_NUMBER)
     {
-        stAppTaskInfo.ucScheduler100msFlag = ON;
+        stSchedulerTaskStat[ulReadyIdx].ucReady = OFF;
+        stSchedulerTaskStat[ulReadyIdx].ucRunning = ON;
     }
 
-    if((ulScheduler1msCounter % 200u) == 0u)
+    Scheduler_ExitCritical(bEnabled);
+
+    return ulReadyIdx;
+}
+
+static void SchedulerRunTask(uint32_t param_TaskIdx)
+{
+    const SchedulerTaskCfg *pCfg = &stSchedulerTaskCfg[param_TaskIdx];
+    SchedulerTaskStat *pStat = &stSchedulerTaskStat[param_TaskIdx];
+    ExeProfCtx stProfCtx;
+    uint32_t ulExecCnt;
+    uint32_t ulIdealReleaseCnt = pStat->ulIdealReleaseCnt;  /*A release during the run moves pStat's*/
+
+    ExeProfStart(&stProfCtx);
+    pStat->ulLastLatencyCnt = (uint32_t)stProfCtx.ullStartCnt - pStat->ulReleaseTimeCnt;
+
+    if(pStat->ulLastLatencyCnt > pStat->ulMaxLatencyCnt)
     {
-        stAppTaskInfo.ucScheduler200msFlag = ON;
+        pStat->ulMaxLatencyCnt = pStat->ulLastLatencyCnt;
     }
 
-    if((ulScheduler1msCounter % 500u) == 0u)
+    EXE_TRACE(EXE_TRACE_TASK_BEGIN, param_TaskIdx, pStat->ulRunCnt);
+    pCfg->pTaskFnc();
+    EXE_TRACE(EXE_TRACE_TASK_END, param_TaskIdx, pStat->ulRunCnt);
+
+    /*Without the preempting ISRs and rate groups*/
+    ulExecCnt = ExeProfStopRelease((E_EXE_PROF_ID)(EXE_PROF_TASK_1MS + param_TaskIdx), &stProfCtx, ulIdealReleaseCnt);
+
+    /*Deadline at the next release, as in the response time analysis*/
+    if((MidGetTimerCnt() - ulIdealReleaseCnt) > (pCfg->ulPeriodMs * 1000u * MID_TIMER_CNT_PER_US))
     {
-        stAppTaskInfo.ucScheduler500msFlag = ON;
+        pStat->ulDeadlineMissCnt++;
     }
 
-    if((ulScheduler1msCounter % 1000u) == 0u)
+    pStat->ucRunning = OFF;
+    pStat->ulRunCnt++;
+    pStat->ulLastExecCnt = ulExecCnt;
+
+    if(ulExecCnt > pStat->ulMaxExecCnt)
     {
-        stAppTaskInfo.ucScheduler1sFlag = ON;        
+        pStat->ulMaxExecCnt = ulExecCnt;
     }
 
-    if(ulScheduler1msCounter >= 3000u) /*Reset at 3Sec*/ 
+    if(ulExecCnt > (pCfg->ulBudgetUs * MID_TIMER_CNT_PER_US))
     {
-        ulScheduler1msCounter = 0u;
+        pStat->ulOverrunCnt++;
     }
 }
+
+/*Software interrupt of one rate group: drain the ready tasks of the group*/
+static void SchedulerRunGroup(uint32_t param_Group)
+{
+    uint32_t ulTaskIdx;
+
+    /*The tick and the faster groups may preempt from here*/
+    IfxCpu_enableInterrupts();
+
+    ulTaskIdx = SchedulerTakeReadyTask(0x1u << param_Group);
+
+    while(ulTaskIdx < SCHEDULER_TASK_NUMBER)
+    {
+        SchedulerRunTask(ulTaskIdx);
+        ulTaskIdx = SchedulerTakeReadyTask(0x1u << param_Group);
+    }
+}
+
+static void SchedulerRateGroup0Fnc(void)
+{
+    SchedulerRunGroup(0u);
+}
+
+static void SchedulerRateGroup1Fnc(void)
+{
+    SchedulerRunGroup(1u);
+}
+
+static void SchedulerRateGroup2Fnc(void)
+{
+    SchedulerRunGroup(2u);
+}
+
+/*---------------------Critical Section--------------------------*/
+/*Data shared between the rate groups, or with the tick, is accessed here*/
+boolean Scheduler_EnterCritical(void)
+{
+    return IfxCpu_disableInterrupts();
+}
+
+void Scheduler_ExitCritical(boolean param_Enabled)
+{
+    IfxCpu_restoreInterrupts(param_Enabled);
+}
+
+/*STM0 lower count of the next task release, end of the background slice*/
+uint32_t Scheduler_GetNextReleaseCnt(void)
+{
+    uint32_t ulNextCnt;
+    boolean bEnabled = Scheduler_EnterCritical();
+
+    ulNextCnt = SchedulerNextReleaseCnt();
+
+    Scheduler_ExitCritical(bEnabled);
+
+    return ulNextCnt;
+}
+
 /*---------------------Register CallbackFunc--------------------------*/
 void Scheduler_Init(void)
 {
+    uint32_t ulTaskIdx;
+
+    ExeTraceInit();
+
+    for(ulTaskIdx = 0u; ulTaskIdx < SCHEDULER_TASK_NUMBER; ulTaskIdx++)
+    {
+        stSchedulerTaskStat[ulTaskIdx].ulNextReleaseMs = ulSchedulerTickMs + SCHEDULER_TICK_MS + stSchedulerTaskCfg[ulTaskIdx].ulOffsetMs;
+    }
+
+#if (SCHEDULER_PREEMPTIVE == ON)
+    for(ulTaskIdx = 0u; ulTaskIdx < SCHEDULER_RATE_GROUP_NUMBER; ulTaskIdx++)
+    {
+        MidRegGpsrCallbackFnc(ulTaskIdx, pSchedulerRateGroupFnc[ulTaskIdx]);
+    }
+#else
+    (void)pSchedulerRateGroupFnc;
+#endif
+
     MidRegTimerCallbackFnc(TaskSchedulerCallbackFnc);
+
+    ulSchedulerTickCnt = MidGetTimerCnt();
+
+#if (SCHEDULER_TICKLESS == ON)
+    MidSetTimerEvent(ulSchedulerTickCnt + SCHEDULER_TICK_CNT);
+#else
+    MidStartTimer(SCHEDULER_TICK_MS * 1000u);
+#endif
 }
 
 /*---------------------Scheduler--------------------------*/
+/*
+ * One task per call, so a task released meanwhile is ranked again. The
+ * background jobs only get the time left before the next release.
+ */
 void Scheduler(void)
 {
-    AppNoTimeTask();
-    
-    if(stAppTaskInfo.ucScheduler1msFlag == ON)
-    {
-        stAppTaskInfo.ucScheduler1msFlag = OFF;
-        AppTask1ms();
-
-        if(stAppTaskInfo.ucScheduler5msFlag == ON)
-        {
-            stAppTaskInfo.ucScheduler5msFlag = OFF;
-            AppTask5ms();
-        }
-
-        if(stAppTaskInfo.ucScheduler10msFlag == ON)
-        {
-            stAppTaskInfo.ucScheduler10msFlag = OFF;
-            AppTask10ms();
-        }
-
-        if(stAppTaskInfo.ucScheduler50msFlag == ON)
-        {
-            stAppTaskInfo.ucScheduler50msFlag = OFF;
-            AppTask50ms();
-        }
+    uint32_t ulTaskIdx = SCHEDULER_TASK_NUMBER;
+    boolean bWorked;
 
-        if(stAppTaskInfo.ucScheduler100msFlag == ON)
-        {
-            stAppTaskInfo.ucScheduler100msFlag = OFF;
-            AppTask100ms();
-        }
+#if (SCHEDULER_PREEMPTIVE == OFF)
+    ulTaskIdx = SchedulerTakeReadyTask(SCHEDULER_ALL_GROUP_MASK);
 
-        if(stAppTaskInfo.ucScheduler200msFlag == ON)
-        {
-            stAppTaskInfo.ucScheduler200msFlag = OFF;
-            AppTask200ms();            
-        }
+    if(ulTaskIdx < SCHEDULER_TASK_NUMBER)
+    {
+        SchedulerRunTask(ulTaskIdx);
+        return;
+    }
+#else
+    (void)ulTaskIdx;
+#endif
 
-        if(stAppTaskInfo.ucScheduler500msFlag == ON)
-        {
-            stAppTaskInfo.ucScheduler500msFlag = OFF;
-            AppTask500ms();
-        }
+    bWorked = AppNoTimeTask();
 
-        if(stAppTaskInfo.ucScheduler1sFlag == ON)
-        {
-            stAppTaskInfo.ucScheduler1sFlag = OFF;
-            AppTask1s();
-        }
+#if (SCHEDULER_TICKLESS == ON)
+    /*Nothing to run before the next interrupt*/
+    if(bWorked == FALSE)
+    {
+        SchedulerIdle();
     }
+#else
+    (void)bWorked;
+#endif
 }
@@ -5,25 +5,84 @@
 /*                        Include Header File                          */
 /*----------------------------------------------------------------*/
 #include "Ifx_Types.h"
+#include "Common.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
+#define SCHEDULER_TICK_MS           1u      /*Scheduler time base, the STM compare period is derived from it*/
 
+/*
+ * ON  : every rate group runs in its own software interrupt, a faster group
+ *       preempts a slower one and the background loop only runs AppNoTimeTask
+ * OFF : all tasks run to completion in the background loop
+ */
+#define SCHEDULER_PREEMPTIVE        OFF
+
+/*
+ * ON  : no periodic tick, the STM compare is set to the next release and the
+ *       CPU is put in idle mode when there is nothing to run
+ * OFF : STM compare interrupt every SCHEDULER_TICK_MS
+ */
+#define SCHEDULER_TICKLESS          OFF
+#define SCHEDULER_RATE_GROUP_NUMBER 3u      /*One software interrupt per group, group 0 is the fastest*/
 
 /*----------------------------------------------------------------*/
 /*                        Typedefs                                    */
 /*----------------------------------------------------------------*/
+typedef enum
+{
+    SCHEDULER_TASK_1MS = 0u,
+    SCHEDULER_TASK_5MS,
+    SCHEDULER_TASK_10MS,
+    SCHEDULER_TASK_50MS,
+    SCHEDULER_TASK_100MS,
+    SCHEDULER_TASK_200MS,
+    SCHEDULER_TASK_500MS,
+    SCHEDULER_TASK_1S,
+    SCHEDULER_TASK_NUMBER
+}E_SCHEDULER_TASK;
+
+/*Task descriptor, one entry of the scheduler table*/
+typedef struct
+{
+    void (*pTaskFnc)(void);
+    uint32_t ulPeriodMs;            /*Release period*/
+    uint32_t ulOffsetMs;            /*Phase of the first release, spreads the tasks over the ticks*/
+    uint8_t ucPriority;             /*Higher value runs first when several tasks are ready*/
+    uint32_t ulBudgetUs;            /*Allowed execution time per release*/
+    uint8_t ucRateGroup;            /*Software interrupt of the task in preemptive mode*/
+}SchedulerTaskCfg;
 
+/*Task run time information, one entry per descriptor*/
+typedef struct
+{
+    uint32_t ulNextReleaseMs;       /*Tick of the next release*/
+    uint8_t ucReady;                /*Released and not yet started*/
+    uint8_t ucRunning;
+    uint32_t ulReleaseTimeCnt;      /*STM count at the last release*/
+    uint32_t ulIdealReleaseCnt;     /*STM count of the tick of the last release*/
+    uint32_t ulReleaseCnt;
+    uint32_t ulRunCnt;
+    uint32_t ulOverrunCnt;          /*Execution time above ulBudgetUs*/
+    uint32_t ulDeadlineMissCnt;     /*Not completed within one period of the release, deadline == period*/
+    uint32_t ulLastExecCnt;         /*Execution time of the last run without preemption, STM count*/
+    uint32_t ulMaxExecCnt;
+    uint32_t ulLastLatencyCnt;      /*Release to start of the last run, STM count*/
+    uint32_t ulMaxLatencyCnt;
+}SchedulerTaskStat;
 
 /*----------------------------------------------------------------*/
 /*                        Variables                                    */
 /*----------------------------------------------------------------*/
-
+extern SchedulerTaskStat stSchedulerTaskStat[SCHEDULER_TASK_NUMBER];
 
 /*----------------------------------------------------------------*/
 /*                        Global Function Prototype                  */
 /*----------------------------------------------------------------*/
 void Scheduler_Init(void);
 void Scheduler(void);
+boolean Scheduler_EnterCritical(void);
+void Scheduler_ExitCritical(boolean param_Enabled);
+uint32_t Scheduler_GetNextReleaseCnt(void);
 #endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "SigBus.h"
+#include "IfxStm.h"
+#include "IfxCpu.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define SIG_BUS_WORDS_OF(type)      ((uint8_t)((sizeof(type) + 3u) / 4u))
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+/*Same order as E_SIG_ID*/
+static const uint8_t ucSigBusWordNumber[SIG_NUMBER] =
+{
+    SIG_BUS_WORDS_OF(SigWheelSpeed),
+    SIG_BUS_WORDS_OF(SigWheelSpeed),
+    SIG_BUS_WORDS_OF(SigWheelSpeed),
+    SIG_BUS_WORDS_OF(SigWheelSpeed),
+    SIG_BUS_WORDS_OF(SigUartRx)
+};
+
+static SigBusSignal stSigBusSignal[SIG_NUMBER];
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Producer--------------------------*/
+/*Sample produced now*/
+void SigBusPublish(E_SIG_ID param_Id, const void *param_Data)
+{
+    SigBusPublishAt(param_Id, param_Data, IfxStm_getLower(&MODULE_STM0));
+}
+
+/*
+ * Publishes one sample produced at param_StampCnt (STM0 lower count). One
+ * producer per signal. The producer never waits and never disables the
+ * interrupts: it fills the sample not published, then ulSeq makes it the
+ * published one with a single store.
+ */
+void SigBusPublishAt(E_SIG_ID param_Id, const void *param_Data, uint32_t param_StampCnt)
+{
+    SigBusSignal *pSignal = &stSigBusSignal[param_Id];
+    const uint32_t *pData = (const uint32_t *)param_Data;
+    uint32_t ulSeq = pSignal->ulSeq + 1u;
+    volatile SigBusSample *pSample;
+    uint32_t ulIdx;
+
+    /*0 stays "none yet", 2 keeps the alternation of the samples*/
+    if(ulSeq == 0u)
+    {
+        ulSeq = 2u;
+    }
+
+    pSample = &pSignal->stSample[ulSeq & 1u];
+    pSample->ulStampCnt = param_StampCnt;
+
+    for(ulIdx = 0u; ulIdx < ucSigBusWordNumber[param_Id]; ulIdx++)
+    {
+        pSample->ulData[ulIdx] = pData[ulIdx];
+    }
+
+    __dsync();
+    pSignal->ulSeq = ulSeq;
+}
+
+/*---------------------Consumer--------------------------*/
+/*
+ * Consistent copy of the last sample, from any task or ISR, without disabling
+ * the interrupts. A consumer preempted by the producer retries the copy, a
+ * consumer preempting the producer reads the previous sample.
+ * Returns the publish sequence, 0 if nothing was published (the outputs are
+ * then left as they are). A sequence different from the previous read means
+ * new samples.
+ */
+uint32_t SigBusRead(E_SIG_ID param_Id, void *param_Data, uint32_t *param_StampCnt)
+{
+    const SigBusSignal *pSignal = &stSigBusSignal[param_Id];
+    uint32_t *pData = (uint32_t *)param_Data;
+    uint32_t ulSeq;
+    uint32_t ulIdx;
+
+    do
+    {
+        const volatile SigBusSample *pSample;
+
+        ulSeq = pSignal->ulSeq;
+
+        if(ulSeq == 0u)
+        {
+            return 0u;
+        }
+
+        __dsync();
+        pSample = &pSignal->stSample[ulSeq & 1u];
+
+        for(ulIdx = 0u; ulIdx < ucSigBusWordNumber[param_Id]; ulIdx++)
+        {
+            pData[ulIdx] = pSample->ulData[ulIdx];
+        }
+
+        if(param_StampCnt != NULL_PTR)
+        {
+            *param_StampCnt = pSample->ulStampCnt;
+        }
+
+        __dsync();
+    } while(pSignal->ulSeq != ulSeq);
+
+    return ulSeq;
+}
+
+/*
+ * First word of the last sample without the time stamp, for the single word
+ * signals. The word is written with one store so it is never torn, no retry.
+ * 0 if nothing was published.
+ */
+uint32_t SigBusReadWord(E_SIG_ID param_Id)
+{
+    const SigBusSignal *pSignal = &stSigBusSignal[param_Id];
+
+    return pSignal->stSample[pSignal->ulSeq & 1u].ulData[0];
+}
+
+/*Time since a sample was produced*/
+uint32_t SigBusGetAgeUs(uint32_t param_StampCnt)
+{
+    return (IfxStm_getLower(&MODULE_STM0) - param_StampCnt) / SIG_BUS_TIME_CNT_PER_US;
+}
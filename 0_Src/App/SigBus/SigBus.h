@@ -0,0 +1,73 @@
+#ifndef SIGBUS_H
+#define SIGBUS_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+#include "MidStm.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define SIG_BUS_WORD_NUMBER         3u      /*Largest sample, 32 bit words*/
+#define SIG_BUS_TIME_CNT_PER_US     MID_TIMER_CNT_PER_US    /*STM0 count of the time stamps*/
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef enum
+{
+    SIG_WHEEL_SPEED_RL = 0u,            /*SigWheelSpeed, MidTimUpdate, same order as E_MID_TIM_WHEEL*/
+    SIG_WHEEL_SPEED_RR,
+    SIG_WHEEL_SPEED_FL,
+    SIG_WHEEL_SPEED_FR,
+    SIG_UART_RX,                        /*SigUartRx, ASCRxInt0Handler*/
+    SIG_NUMBER
+}E_SIG_ID;
+
+/*Stamped with the time of the last encoder edge*/
+typedef struct
+{
+    float32_t fRpm;
+    uint32_t ulPulseCnt;                /*Encoder pulses since the start, wraps*/
+    uint32_t ulMethod;                  /*E_MID_TIM_METHOD*/
+}SigWheelSpeed;
+
+typedef struct
+{
+    uint32_t ulData;                    /*Last byte received, first word for SigBusReadWord*/
+    uint32_t ulRxCnt;                   /*Bytes received since the start*/
+}SigUartRx;
+
+typedef struct
+{
+    uint32_t ulStampCnt;                /*STM0 lower count when the sample was produced*/
+    uint32_t ulData[SIG_BUS_WORD_NUMBER];
+}SigBusSample;
+
+/*
+ * One signal: two samples, the producer writes the one not published and
+ * then flips ulSeq. ulSeq & 1 is the published sample.
+ */
+typedef struct
+{
+    volatile uint32_t ulSeq;            /*Samples published, 0 : none yet*/
+    volatile SigBusSample stSample[2];
+}SigBusSignal;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void SigBusPublish(E_SIG_ID param_Id, const void *param_Data);
+void SigBusPublishAt(E_SIG_ID param_Id, const void *param_Data, uint32_t param_StampCnt);
+uint32_t SigBusRead(E_SIG_ID param_Id, void *param_Data, uint32_t *param_StampCnt);
+uint32_t SigBusReadWord(E_SIG_ID param_Id);
+uint32_t SigBusGetAgeUs(uint32_t param_StampCnt);
+#endif
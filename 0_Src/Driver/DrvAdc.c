@@ -4,10 +4,20 @@
 #include "DrvAdc.h"
 #include <Vadc/Std/IfxVadc.h>
 #include <Vadc/Adc/IfxVadc_Adc.h>
+#include <Dma/Dma/IfxDma_Dma.h>
+#include "IfxCpu.h"
+#include "Common.h"
+#include "ExeVerification.h"
+#include "ExeTrace.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
+#define ISR_PRIORITY_ADC_DMA        170     /*Above the other ISRs: the duties are staged before the period end*/
+#define ISR_PRIORITY_ADC_LIMIT      200     /*Above the control step: the bridges are switched off first*/
+#define ADC_DMA_CH                  IfxDma_ChannelId_2          /*0 and 1 : TFT QSPI*/
+#define ADC_TRIG_SOURCE             IfxVadc_TriggerSource_9     /*REQTR0J : GTM ADC trigger 1 of group 0*/
+#define ADC_RESULT_MASK             0x0FFFu
 
 
 /*----------------------------------------------------------------*/
@@ -17,7 +27,7 @@ typedef struct
 {
     IfxVadc_Adc vadc; /* VADC handle */
     IfxVadc_Adc_Group adcGroup;
-} App_VadcAutoScan;
+} App_VadcTriggerScan;
 
 typedef struct
 {
@@ -31,50 +41,99 @@ typedef struct
 /*----------------------------------------------------------------*/
 static void DrvAdc0Init(void);
 static void DrvAdc1Init(void);
+static void DrvAdc0DmaInit(void);
 
 /*----------------------------------------------------------------*/
 /*                        Variables                                    */
 /*----------------------------------------------------------------*/
-App_VadcAutoScan g_VadcAutoScan;
+App_VadcTriggerScan g_VadcTriggerScan;
 App_VadcBackgroundScan g_VadcBackgroundScan;
 
-IfxVadc_Adc_Channel adc0Channel[5];
+IfxVadc_Adc_Channel adc0Channel[DRV_ADC_CH_NUMBER];
 IfxVadc_Adc_Channel adc1Channel[2];
 
-uint32_t g_Vadc0Result[5] = {0u,};
 uint32_t g_Vadc1Result[2] = {0u,};
 
+/*G0 RES0..7 of the last trigger, circular buffer of the DMA*/
+static volatile uint32_t ulAdcDmaBuf[DRV_ADC_RESULT_NUMBER] IFX_ALIGN(32);
+void (*DrvAdcCallbackFnc)(void);
+void (*DrvAdcLimitCallbackFnc)(uint32_t param_ChMask);
+
 /*----------------------------------------------------------------*/
 /*                        Functions                                    */
 /*----------------------------------------------------------------*/
 
 /*---------------------Interrupt Define--------------------------*/
+IFX_INTERRUPT(ADC_DmaHandler, 0, ISR_PRIORITY_ADC_DMA);
+IFX_INTERRUPT(ADC_LimitHandler, 0, ISR_PRIORITY_ADC_LIMIT);
 
+/*---------------------Interrupt Service Routine--------------------------*/
+/*End of a DMA transaction: the scan of the last trigger is in ulAdcDmaBuf*/
+void ADC_DmaHandler(void)
+{
+    EXE_PROF_ISR_ENTER();
+    EXE_TRACE(EXE_TRACE_ISR_ENTER, EXE_PROF_ISR_ADC_DMA, 0u);
 
+    IfxDma_clearChannelInterrupt(&MODULE_DMA, ADC_DMA_CH);
 
-/*---------------------Test Code--------------------------*/
-void VadcAutoScanDemo_run(void)
+    DrvAdcCallbackFnc();
+
+    EXE_TRACE(EXE_TRACE_ISR_EXIT, EXE_PROF_ISR_ADC_DMA, 0u);
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_ADC_DMA);
+}
+
+/*Channel event of the limit check: a bridge current of the scan was above the limit*/
+void ADC_LimitHandler(void)
 {
-    uint32    chnIx;
+    uint32_t ulChMask;
 
-    for (chnIx = 0; chnIx < 5; ++chnIx)
-    {
-        //unsigned     group   = adc0Channel[chnIx].group->groupId;
-        //unsigned     channel = adc0Channel[chnIx].channel;
+    EXE_PROF_ISR_ENTER();
+    EXE_TRACE(EXE_TRACE_ISR_ENTER, EXE_PROF_ISR_ADC_LIMIT, 0u);
 
-        /* wait for valid result */
-        Ifx_VADC_RES conversionResult;
+    ulChMask = MODULE_VADC.G[0].CEFLAG.U & DRV_ADC_LIMIT_CH_MASK;
+    MODULE_VADC.G[0].CEFCLR.U = ulChMask;
 
-        do
-        {
-            conversionResult = IfxVadc_Adc_getResult(&adc0Channel[chnIx]);
-        } while (!conversionResult.B.VF);
+    DrvAdcLimitCallbackFnc(ulChMask);
+
+    EXE_TRACE(EXE_TRACE_ISR_EXIT, EXE_PROF_ISR_ADC_LIMIT, ulChMask);
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_ADC_LIMIT);
+}
 
-        g_Vadc0Result[chnIx] = conversionResult.B.RESULT;
+/*---------------------Callback Function--------------------------*/
+void DrvRegAdcCallbackFnc(void (*pDrvRegCallbackFnc)(void))
+{
+    DrvAdcCallbackFnc = pDrvRegCallbackFnc;
+}
+
+/*Called with the CH0..3 above the limit, bit n : CHn*/
+void DrvRegAdcLimitCallbackFnc(void (*pDrvRegCallbackFnc)(uint32_t param_ChMask))
+{
+    DrvAdcLimitCallbackFnc = pDrvRegCallbackFnc;
+}
+
+/*---------------------Driver API--------------------------*/
+/*12 bit counts of G0 CH0..DRV_ADC_CH_NUMBER-1, from the callback until the next trigger*/
+void DrvAdcGetSample(uint32_t *param_Cnt)
+{
+    uint32_t ulCh;
+
+    for(ulCh = 0u; ulCh < DRV_ADC_CH_NUMBER; ulCh++)
+    {
+        param_Cnt[ulCh] = ulAdcDmaBuf[ulCh] & ADC_RESULT_MASK;
     }
+}
 
+/*
+ * Limit of CH0..3 in counts: a conversion above it raises the channel event
+ * by itself, no result is read. The full scale (the value at init) never
+ * does. Register the callback first.
+ */
+void DrvAdcSetLimit(uint32_t param_Cnt)
+{
+    MODULE_VADC.G[0].BOUND.B.BOUNDARY1 = (param_Cnt < ADC_RESULT_MASK) ? param_Cnt : ADC_RESULT_MASK;
 }
 
+/*---------------------Test Code--------------------------*/
 void VadcBackgroundScanDemo_run(void)
 {
     uint32    chnIx;
@@ -104,10 +163,17 @@ void DrvAdcInit(void)
     DrvAdc1Init();
 }
 
+/*
+ * Group 0 scans CH0..4 once per rising edge of the GTM ADC trigger 1 (TOM1
+ * CH8, see DrvGtm), each channel in its own RES. The scan converts from the
+ * highest channel down: the result of CH0 ends it and requests the DMA.
+ * CH0..3 are limit checked against the band BOUNDARY0 (0) to BOUNDARY1 (see
+ * DrvAdcSetLimit): a result out of it sets the channel event on node 1.
+ */
 static void DrvAdc0Init(void)
 {
     uint32    chnIx;
-    IfxVadc_Adc_ChannelConfig adcChannelConfig[5];    /* create channel config */
+    IfxVadc_Adc_ChannelConfig adcChannelConfig[DRV_ADC_CH_NUMBER];    /* create channel config */
 
     /* VADC Configuration */
 
@@ -116,11 +182,11 @@ static void DrvAdc0Init(void)
     IfxVadc_Adc_initModuleConfig(&adcConfig, &MODULE_VADC);
 
     /* initialize module */
-    IfxVadc_Adc_initModule(&g_VadcAutoScan.vadc, &adcConfig);
+    IfxVadc_Adc_initModule(&g_VadcTriggerScan.vadc, &adcConfig);
 
     /* create group config */
     IfxVadc_Adc_GroupConfig adcGroupConfig;
-    IfxVadc_Adc_initGroupConfig(&adcGroupConfig, &g_VadcAutoScan.vadc);
+    IfxVadc_Adc_initGroupConfig(&adcGroupConfig, &g_VadcTriggerScan.vadc);
 
     /* with group 0 */
     adcGroupConfig.groupId = IfxVadc_GroupId_0;
@@ -129,34 +195,95 @@ static void DrvAdc0Init(void)
     /* enable scan source */
     adcGroupConfig.arbiter.requestSlotScanEnabled = TRUE;
 
-    /* enable auto scan */
-    adcGroupConfig.scanRequest.autoscanEnabled = TRUE;
-
-    /* enable all gates in "always" mode (no edge detection) */
-    adcGroupConfig.scanRequest.triggerConfig.gatingMode = IfxVadc_GatingMode_always;
+    /* one scan per trigger */
+    adcGroupConfig.scanRequest.autoscanEnabled = FALSE;
+    adcGroupConfig.scanRequest.triggerConfig.gatingMode    = IfxVadc_GatingMode_always;
+    adcGroupConfig.scanRequest.triggerConfig.triggerSource = ADC_TRIG_SOURCE;
+    adcGroupConfig.scanRequest.triggerConfig.triggerMode   = IfxVadc_TriggerMode_uponRisingEdge;
 
     /* initialize the group */
-    /*IfxVadc_Adc_Group adcGroup;*/    //declared globally
-    IfxVadc_Adc_initGroup(&g_VadcAutoScan.adcGroup, &adcGroupConfig);
+    IfxVadc_Adc_initGroup(&g_VadcTriggerScan.adcGroup, &adcGroupConfig);
+
+    /* limit check band : no event until DrvAdcSetLimit */
+    MODULE_VADC.G[0].BOUND.B.BOUNDARY0 = 0u;
+    MODULE_VADC.G[0].BOUND.B.BOUNDARY1 = ADC_RESULT_MASK;
 
-    for (chnIx = 0; chnIx < 5; ++chnIx)
+    for (chnIx = 0; chnIx < DRV_ADC_CH_NUMBER; ++chnIx)
     {
-        IfxVadc_Adc_initChannelConfig(&adcChannelConfig[chnIx], &g_VadcAutoScan.adcGroup);
+        IfxVadc_Adc_initChannelConfig(&adcChannelConfig[chnIx], &g_VadcTriggerScan.adcGroup);
 
         adcChannelConfig[chnIx].channelId      = (IfxVadc_ChannelId)(chnIx);
         adcChannelConfig[chnIx].resultRegister = (IfxVadc_ChannelResult)(chnIx);  /* use dedicated result register */
 
-        /* initialize the channel */
+        /* last result of the scan: service request to the DMA channel */
+        if (chnIx == 0u)
+        {
+            adcChannelConfig[chnIx].resultPriority     = ADC_DMA_CH;
+            adcChannelConfig[chnIx].resultServProvider = IfxSrc_Tos_dma;
+            adcChannelConfig[chnIx].resultSrcNr        = IfxVadc_SrcNr_group0;
+        }
+
+        /* bridge currents: channel event above BOUNDARY1 to the CPU */
+        if (((DRV_ADC_LIMIT_CH_MASK >> chnIx) & 0x1u) != 0u)
+        {
+            adcChannelConfig[chnIx].lowerBoundary       = IfxVadc_BoundarySelection_group0;
+            adcChannelConfig[chnIx].upperBoundary       = IfxVadc_BoundarySelection_group1;
+            adcChannelConfig[chnIx].limitCheck          = IfxVadc_LimitCheck_eventIfOutsideArea;
+            adcChannelConfig[chnIx].channelPriority     = ISR_PRIORITY_ADC_LIMIT;
+            adcChannelConfig[chnIx].channelServProvider = IfxSrc_Tos_cpu0;
+            adcChannelConfig[chnIx].channelSrcNr        = IfxVadc_SrcNr_group1;
+        }
+
+        /* initialize the channel (the iLLD sets the event node pointer of the handle's channel before it fills the handle) */
+        adc0Channel[chnIx].channel = (IfxVadc_ChannelId)(chnIx);
         IfxVadc_Adc_initChannel(&adc0Channel[chnIx], &adcChannelConfig[chnIx]);
 
         /* add to scan */
         unsigned channels = (1 << adcChannelConfig[chnIx].channelId);
         unsigned mask     = channels;
-        IfxVadc_Adc_setScan(&g_VadcAutoScan.adcGroup, channels, mask);
+        IfxVadc_Adc_setScan(&g_VadcTriggerScan.adcGroup, channels, mask);
     }
 
-    /* start autoscan */
-    IfxVadc_Adc_startScan(&g_VadcAutoScan.adcGroup);
+    DrvAdc0DmaInit();
+}
+
+/*
+ * One transfer per scan: RES0..7 to ulAdcDmaBuf, both as 32 byte circular
+ * buffers so every transfer starts again at RES0 and ulAdcDmaBuf[0]. The
+ * transaction of DRV_ADC_CTRL_PERIOD_NUMBER transfers ends with the channel
+ * interrupt, the channel stays enabled for the next one.
+ */
+static void DrvAdc0DmaInit(void)
+{
+    IfxDma_Dma_Config dmaConfig;
+    IfxDma_Dma dma;
+    IfxDma_Dma_ChannelConfig dmaChConfig;
+    IfxDma_Dma_Channel dmaCh;
+
+    IfxDma_Dma_initModuleConfig(&dmaConfig, &MODULE_DMA);
+    IfxDma_Dma_initModule(&dma, &dmaConfig);
+    IfxDma_Dma_initChannelConfig(&dmaChConfig, &dma);
+
+    dmaChConfig.channelId                        = ADC_DMA_CH;
+    dmaChConfig.sourceAddress                    = (uint32)&MODULE_VADC.G[0].RES[0];
+    dmaChConfig.destinationAddress               = IFXCPU_GLB_ADDR_DSPR(IfxCpu_getCoreId(), &ulAdcDmaBuf[0]);
+    dmaChConfig.transferCount                    = DRV_ADC_CTRL_PERIOD_NUMBER;
+    dmaChConfig.blockMode                        = IfxDma_ChannelMove_8;
+    dmaChConfig.requestMode                      = IfxDma_ChannelRequestMode_oneTransferPerRequest;
+    dmaChConfig.operationMode                    = IfxDma_ChannelOperationMode_continuous;
+    dmaChConfig.moveSize                         = IfxDma_ChannelMoveSize_32bit;
+    dmaChConfig.hardwareRequestEnabled           = TRUE;
+    dmaChConfig.sourceAddressCircularRange       = IfxDma_ChannelIncrementCircular_32;
+    dmaChConfig.sourceCircularBufferEnabled      = TRUE;
+    dmaChConfig.destinationAddressCircularRange  = IfxDma_ChannelIncrementCircular_32;
+    dmaChConfig.destinationCircularBufferEnabled = TRUE;
+    dmaChConfig.channelInterruptEnabled          = TRUE;
+    dmaChConfig.channelInterruptControl          = IfxDma_ChannelInterruptControl_thresholdLimitMatch;
+    dmaChConfig.interruptRaiseThreshold          = 0u;
+    dmaChConfig.channelInterruptPriority         = ISR_PRIORITY_ADC_DMA;
+    dmaChConfig.channelInterruptTypeOfService    = IfxSrc_Tos_cpu0;
+
+    IfxDma_Dma_initChannel(&dmaCh, &dmaChConfig);
 }
 
 static void DrvAdc1Init(void)
@@ -9,6 +9,12 @@
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
+#define DRV_ADC_CH_NUMBER           5u      /*VADC G0 CH0..4 : bridge current RL, RR, FL, FR, battery*/
+#define DRV_ADC_CH_BATTERY          4u
+#define DRV_ADC_RESULT_NUMBER       8u      /*RES0..7 moved per trigger*/
+#define DRV_ADC_CTRL_PERIOD_NUMBER  100u    /*PWM periods per DMA interrupt, 5ms*/
+#define DRV_ADC_FULL_SCALE_CNT      4096u   /*12 bit*/
+#define DRV_ADC_LIMIT_CH_MASK       0x0Fu   /*CH0..3 limit checked, bit n : CHn*/
 
 
 /*----------------------------------------------------------------*/
@@ -26,11 +32,14 @@
 /*----------------------------------------------------------------*/
 
 /*---------------------Test Code--------------------------*/
-void VadcAutoScanDemo_run(void);
 void VadcBackgroundScanDemo_run(void);
 
 /*---------------------Init Function--------------------------*/
 void DrvAdcInit(void);
+void DrvRegAdcCallbackFnc(void (*pDrvRegCallbackFnc)(void));
+void DrvAdcGetSample(uint32_t *param_Cnt);
+void DrvAdcSetLimit(uint32_t param_Cnt);
+void DrvRegAdcLimitCallbackFnc(void (*pDrvRegCallbackFnc)(uint32_t param_ChMask));
 
 
 #endif
@@ -3,6 +3,9 @@
 /*----------------------------------------------------------------*/
 #include "DrvAsc.h"
 #include "DrvAscTypes.h"
+#include "ExeVerification.h"
+#include "ExeTrace.h"
+#include "SigBus.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
@@ -24,7 +27,7 @@ static void DrvAsc0Init(void);
 /*                        Variables                                    */
 /*----------------------------------------------------------------*/
 App_AsclinAsc g_AsclinAsc; /**< \brief Demo information */
-uint32_t gu32nuAscRxData = 0u;
+static SigUartRx stAscRx;
 
 /*----------------------------------------------------------------*/
 /*                        Functions                                    */
@@ -37,24 +40,41 @@ IFX_INTERRUPT(ASCExInt0Handler, 0, ISR_PRIORITY_ASC_0_EX);
 /*---------------------Interrupt Service Routine--------------------------*/
 void ASCTxInt0Handler(void)
 {
+    EXE_PROF_ISR_ENTER();
+
     IfxAsclin_Asc_isrTransmit(&g_AsclinAsc.drivers.asc0);
+
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_ASC0_TX);
 }
 
 void ASCRxInt0Handler(void)
 {
+    EXE_PROF_ISR_ENTER();
+    EXE_TRACE(EXE_TRACE_ISR_ENTER, EXE_PROF_ISR_ASC0_RX, 0u);
+
     IfxAsclin_Asc_isrReceive(&g_AsclinAsc.drivers.asc0);
     IfxAsclin_Asc_read(&g_AsclinAsc.drivers.asc0, g_AsclinAsc.rxData, &g_AsclinAsc.count, TIME_INFINITE);    
-    gu32nuAscRxData = g_AsclinAsc.rxData[0];
+    stAscRx.ulData = g_AsclinAsc.rxData[0];
+    stAscRx.ulRxCnt++;
+    SigBusPublish(SIG_UART_RX, &stAscRx);
 
     #if 0
-    g_AsclinAsc.txData[0] = gu32nuAscRxData;    
+    g_AsclinAsc.txData[0] = g_AsclinAsc.rxData[0];    
     IfxAsclin_Asc_write(&g_AsclinAsc.drivers.asc0, g_AsclinAsc.txData, &g_AsclinAsc.count, TIME_INFINITE);
     #endif
+
+    /*The received byte as data*/
+    EXE_TRACE(EXE_TRACE_ISR_EXIT, EXE_PROF_ISR_ASC0_RX, stAscRx.ulData);
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_ASC0_RX);
 }
 
 void ASCExInt0Handler(void)
 {
+    EXE_PROF_ISR_ENTER();
+
     IfxAsclin_Asc_isrError(&g_AsclinAsc.drivers.asc0);
+
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_ASC0_EX);
 }
 
 /*---------------------Init Function--------------------------*/
@@ -104,6 +124,16 @@ static void DrvAsc0Init(void)
 }
 
 /*---------------------Driver API--------------------------*/
+/*Non blocking write, returns the number of bytes queued for transmission*/
+uint32_t DrvAscWrite(const uint8_t *param_Data, uint32_t param_Size)
+{
+    Ifx_SizeT count = (Ifx_SizeT)param_Size;
+
+    (void)IfxAsclin_Asc_write(&g_AsclinAsc.drivers.asc0, (void *)param_Data, &count, TIME_NULL);
+
+    return (uint32_t)count;
+}
+
 #if 1
 
 extern float32_t testrpm;
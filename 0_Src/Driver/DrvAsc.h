@@ -26,6 +26,7 @@
 /*----------------------------------------------------------------*/
 extern void DrvAscInit(void);
 extern void DrvAsc_Test1(void);
+extern uint32_t DrvAscWrite(const uint8_t *param_Data, uint32_t param_Size);
 #endif
 
 
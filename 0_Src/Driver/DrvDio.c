@@ -41,6 +41,12 @@ void DrvDio_SetPinHigh(IfxPort_Pin param_PortPin)
     IfxPort_setPinHigh(param_PortPin.port, param_PortPin.pinIndex);
 }
 
+/*Several pins of one port in one store, param_Omr from DRV_DIO_OMR*/
+void DrvDio_WriteGroup(Ifx_P *param_Port, uint32_t param_Omr)
+{
+    param_Port->OMR.U = param_Omr;
+}
+
 /*---------------------Init Function--------------------------*/
 void DrvDioInit(void)
 {
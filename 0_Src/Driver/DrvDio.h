@@ -11,6 +11,9 @@
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
+/*OMR word driving the pins of param_Mask to param_Pattern: PSx for the 1s, PCLx for the 0s*/
+#define DRV_DIO_OMR(param_Mask, param_Pattern)  \
+    ((((uint32_t)(param_Mask) & ~(uint32_t)(param_Pattern)) << 16) | ((uint32_t)(param_Mask) & (uint32_t)(param_Pattern)))
 
 
 /*----------------------------------------------------------------*/
@@ -28,6 +31,7 @@
 /*----------------------------------------------------------------*/
 extern void DrvDio_SetPinLow(IfxPort_Pin param_PortPin);
 extern void DrvDio_SetPinHigh(IfxPort_Pin param_PortPin);
+extern void DrvDio_WriteGroup(Ifx_P *param_Port, uint32_t param_Omr);
 extern void DrvDioInit(void);
 
 
@@ -0,0 +1,77 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "DrvFlash.h"
+#include "IfxScuWdt.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define DRV_FLASH_ERROR_MASK        0x06003800u     /*FSR OPER, SQER, PROER, PVER, EVER*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Data Flash--------------------------*/
+/*
+ * The commands only start the operation and return, the flash stays busy
+ * for the page program or the sector erase (ms). Poll DrvFlashIsBusy before
+ * the next command or before reading the range back. The safety ENDINIT is
+ * cleared around the command sequences, as in the iLLD flash examples.
+ */
+void DrvFlashEraseSector(uint32_t param_Addr)
+{
+    uint16 usPassword = IfxScuWdt_getSafetyWatchdogPassword();
+
+    IfxFlash_clearStatus(0u);
+
+    IfxScuWdt_clearSafetyEndinit(usPassword);
+    IfxFlash_eraseSector(param_Addr);
+    IfxScuWdt_setSafetyEndinit(usPassword);
+}
+
+void DrvFlashWritePage(uint32_t param_Addr, uint32_t param_WordL, uint32_t param_WordU)
+{
+    uint16 usPassword = IfxScuWdt_getSafetyWatchdogPassword();
+
+    IfxFlash_clearStatus(0u);
+
+    if(IfxFlash_enterPageMode(param_Addr) == 0u)
+    {
+        /*Page mode is entered at once, DFPAGE only tells it is active*/
+        (void)IfxFlash_waitUnbusy(0u, IfxFlash_FlashType_D0);
+        IfxFlash_loadPage2X32(param_Addr, param_WordL, param_WordU);
+
+        IfxScuWdt_clearSafetyEndinit(usPassword);
+        IfxFlash_writePage(param_Addr);
+        IfxScuWdt_setSafetyEndinit(usPassword);
+    }
+}
+
+boolean DrvFlashIsBusy(void)
+{
+    return (FLASH0_FSR.B.D0BUSY != 0u) ? TRUE : FALSE;
+}
+
+/*Sequence, protection or verify error of the last command*/
+boolean DrvFlashHasError(void)
+{
+    return ((FLASH0_FSR.U & DRV_FLASH_ERROR_MASK) != 0u) ? TRUE : FALSE;
+}
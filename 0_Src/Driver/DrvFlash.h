@@ -0,0 +1,40 @@
+#ifndef DRVFLASH_H
+#define DRVFLASH_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "IfxFlash.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*Data flash 0, EEPROM part: 16 logical sectors, erased reads as 0*/
+#define DRV_FLASH_DFLASH_START      IFXFLASH_DFLASH_START
+#define DRV_FLASH_SECTOR_SIZE       0x2000u
+#define DRV_FLASH_SECTOR_NUMBER     IFXFLASH_DFLASH_NUM_LOG_SECTORS
+#define DRV_FLASH_PAGE_SIZE         IFXFLASH_DFLASH_PAGE_LENGTH     /*Two words programmed together*/
+
+#define DRV_FLASH_SECTOR_ADDR(sector)   (DRV_FLASH_DFLASH_START + ((sector) * DRV_FLASH_SECTOR_SIZE))
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void DrvFlashEraseSector(uint32_t param_Addr);
+void DrvFlashWritePage(uint32_t param_Addr, uint32_t param_WordL, uint32_t param_WordU);
+boolean DrvFlashIsBusy(void);
+boolean DrvFlashHasError(void);
+
+
+#endif
@@ -0,0 +1,117 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "DrvGpsr.h"
+#include "IfxSrc.h"
+#include "IfxCpu_Irq.h"
+#include "Common.h"
+#include "ExeVerification.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*Below the STM tick (40) so that the tick always preempts the software requests*/
+#define ISR_PRIORITY_GPSR_CH1       36
+#define ISR_PRIORITY_GPSR_CH2       24
+#define ISR_PRIORITY_GPSR_CH3       20
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static void DrvGpsrCallback(E_DRV_GPSR_CH param_Ch);
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static volatile Ifx_SRC_SRCR * const pGpsrSrc[DRV_GPSR_CH_NUMBER] =
+{
+    &SRC_GPSR01,
+    &SRC_GPSR02,
+    &SRC_GPSR03
+};
+
+static const uint16_t usGpsrPriority[DRV_GPSR_CH_NUMBER] =
+{
+    ISR_PRIORITY_GPSR_CH1,
+    ISR_PRIORITY_GPSR_CH2,
+    ISR_PRIORITY_GPSR_CH3
+};
+
+void (*DrvGpsrCallbackFnc[DRV_GPSR_CH_NUMBER])(void);
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Interrupt Define--------------------------*/
+IFX_INTERRUPT(GPSR_Ch1Handler, 0, ISR_PRIORITY_GPSR_CH1);
+IFX_INTERRUPT(GPSR_Ch2Handler, 0, ISR_PRIORITY_GPSR_CH2);
+IFX_INTERRUPT(GPSR_Ch3Handler, 0, ISR_PRIORITY_GPSR_CH3);
+
+/*---------------------Interrupt Service Routine--------------------------*/
+void GPSR_Ch1Handler(void)
+{
+    EXE_PROF_ISR_ENTER();
+
+    DrvGpsrCallback(DRV_GPSR_CH1);
+
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_GPSR_CH1);
+}
+
+void GPSR_Ch2Handler(void)
+{
+    EXE_PROF_ISR_ENTER();
+
+    DrvGpsrCallback(DRV_GPSR_CH2);
+
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_GPSR_CH2);
+}
+
+void GPSR_Ch3Handler(void)
+{
+    EXE_PROF_ISR_ENTER();
+
+    DrvGpsrCallback(DRV_GPSR_CH3);
+
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_GPSR_CH3);
+}
+
+static void DrvGpsrCallback(E_DRV_GPSR_CH param_Ch)
+{
+    if(DrvGpsrCallbackFnc[param_Ch] != NULL_PTR)
+    {
+        DrvGpsrCallbackFnc[param_Ch]();
+    }
+}
+
+/*---------------------Callback Function--------------------------*/
+void DrvRegGpsrCallbackFnc(E_DRV_GPSR_CH param_Ch, void (*pDrvRegCallbackFnc)(void))
+{
+    DrvGpsrCallbackFnc[param_Ch] = pDrvRegCallbackFnc;
+}
+
+/*---------------------Driver API--------------------------*/
+void DrvGpsrTrigger(E_DRV_GPSR_CH param_Ch)
+{
+    IfxSrc_setRequest(pGpsrSrc[param_Ch]);
+}
+
+/*---------------------Init Function--------------------------*/
+void DrvGpsrInit(void)
+{
+    uint32_t ulCh;
+
+    for(ulCh = 0u; ulCh < DRV_GPSR_CH_NUMBER; ulCh++)
+    {
+        IfxSrc_init(pGpsrSrc[ulCh], IfxSrc_Tos_cpu0, usGpsrPriority[ulCh]);
+        IfxSrc_enable(pGpsrSrc[ulCh]);
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef DRVGPSR_H
+#define DRVGPSR_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+/*General purpose service requests of CPU0, GPSR00 is kept for the TFT update*/
+typedef enum
+{
+    DRV_GPSR_CH1 = 0u,
+    DRV_GPSR_CH2,
+    DRV_GPSR_CH3,
+    DRV_GPSR_CH_NUMBER
+}E_DRV_GPSR_CH;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void DrvGpsrInit(void);
+void DrvRegGpsrCallbackFnc(E_DRV_GPSR_CH param_Ch, void (*pDrvRegCallbackFnc)(void));
+void DrvGpsrTrigger(E_DRV_GPSR_CH param_Ch);
+
+
+
+#endif
@@ -3,17 +3,22 @@
 /*----------------------------------------------------------------*/
 #include "DrvGtm.h"
 #include "SysSe/Bsp/Bsp.h"
+#include "IfxStm.h"
 #include "Gtm/Tom/Timer/IfxGtm_Tom_Timer.h"
 #include "Gtm/Tom/PwmHl/IfxGtm_Tom_PwmHl.h"
+#include "Gtm/Trig/IfxGtm_Trig.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
 
-#define TOM_BASE_FREQ    (100000000.0f/256.0f)
-//#define TOM_BASE_FREQ    (100000000.0f)
-#define PWM_HZ           (100.0f)
-#define PWM_PERIOD_CNT   TOM_BASE_FREQ/PWM_HZ
+#define TIM_CAP_MASK     0x00FFFFFFu        /*24 bit GPR values*/
+#define TOM_UPEN_SHIFT   IFX_GTM_TOM_TGC0_GLB_CTRL_UPEN_CTRL4_OFF   /*UPEN_CTRL of TOM1 CH4, 2 bits per channel*/
+#define TOM_UPEN_OFF     0x1u
+#define TOM_UPEN_ON      0x2u
+#define TOM_OUTEN_PWM_ON    0xAA00u         /*OUTEN_CTRL4..7 : enable*/
+#define TOM_OUTEN_PWM_OFF   0x5500u         /*OUTEN_CTRL4..7 : disable*/
+#define TOM_HOST_TRIG       (1u << IFX_GTM_TOM_TGC0_GLB_CTRL_HOST_TRIG_OFF)   /*UPEN_CTRL and RST_CH left as they are*/
 
 
 /*----------------------------------------------------------------*/
@@ -41,6 +46,8 @@ typedef struct
 /*----------------------------------------------------------------*/
 static void GtmTom1Init(void);
 static void GtmTim0Init(void);
+static void GtmTom1AdcTrigInit(void);
+static void GtmTom0ServoInit(void);
 
 
 /*----------------------------------------------------------------*/
@@ -48,46 +55,164 @@ static void GtmTim0Init(void);
 /*----------------------------------------------------------------*/
 App_GtmTomTimer g_GtmTomTimer; /**< \brief Demo information */
 
+/*Rear Left, Rear Right, Front Left, Front Right as TOM1 CH4..7*/
+static Ifx_GTM_TIM_CH * const pGtmTimCh[DRV_GTM_TIM_CH_NUMBER] =
+{
+    &MODULE_GTM.TIM[0].CH0,
+    &MODULE_GTM.TIM[0].CH1,
+    &MODULE_GTM.TIM[0].CH2,
+    &MODULE_GTM.TIM[0].CH3
+};
+
+static Ifx_GTM_TOM_CH * const pGtmPwmCh[DRV_GTM_PWM_CH_NUMBER] =
+{
+    &MODULE_GTM.TOM[1].CH4,
+    &MODULE_GTM.TOM[1].CH5,
+    &MODULE_GTM.TOM[1].CH6,
+    &MODULE_GTM.TOM[1].CH7
+};
+
+static IfxGtm_Tim_TinMap * const pGtmTimPin[DRV_GTM_TIM_CH_NUMBER] =
+{
+    &IfxGtm_TIM0_0_TIN32_P33_10_IN,
+    &IfxGtm_TIM0_1_TIN31_P33_9_IN,
+    &IfxGtm_TIM0_2_TIN33_P33_11_IN,
+    &IfxGtm_TIM0_3_TIN29_P33_7_IN
+};
+
+DrvGtmPwmStage stGtmPwmStage = {0u, 0u, 0u, 0u};
+
 uint32_t u32nuMyTestPwmDuty = 500u; /*Unit: 0.1%, 500 -> 50.0% duty*/
 float32_t fMyTestPwmDuty = 0.5f;
-uint32_t ulPulseCnt = 0u;
 
 
 /*----------------------------------------------------------------*/
 /*                        Functions                                    */
 /*----------------------------------------------------------------*/
 
-/*---------------------Interrupt Define--------------------------*/
-IFX_INTERRUPT(TIM0_IntHandler, 0, 200);
+/*---------------------Driver API--------------------------*/
+/*
+ * Last capture of the encoder channels and the time bases, no interrupt
+ * involved. GPR0 and GPR1 carry the edge counter of their capture: read
+ * again until both come from the same edge.
+ */
+void DrvGtmGetTimCapture(DrvGtmTimCapture *param_Capture)
+{
+    uint32_t ulCh;
+    uint32_t ulGpr0[DRV_GTM_TIM_CH_NUMBER];
+    uint32_t ulGpr1[DRV_GTM_TIM_CH_NUMBER];
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    for(ulCh = 0u; ulCh < DRV_GTM_TIM_CH_NUMBER; ulCh++)
+    {
+        Ifx_GTM_TIM_CH *pCh = pGtmTimCh[ulCh];
+
+        do
+        {
+            ulGpr0[ulCh] = pCh->GPR0.U;
+            ulGpr1[ulCh] = pCh->GPR1.U;
+        } while((ulGpr0[ulCh] >> 24) != (ulGpr1[ulCh] >> 24));
+
+        param_Capture->ulEdgeCnt[ulCh] = pCh->ECNT.B.ECNT;
+    }
+
+    param_Capture->ulTbuNowCnt = GTM_TBU_CH0_BASE.B.BASE & TIM_CAP_MASK;
+    param_Capture->ulStmNowCnt = IfxStm_getLower(&MODULE_STM0);
+
+    IfxCpu_restoreInterrupts(bEnabled);
 
-/*---------------------Interrupt Service Routine--------------------------*/
-void TIM0_IntHandler(void)
+    for(ulCh = 0u; ulCh < DRV_GTM_TIM_CH_NUMBER; ulCh++)
+    {
+        param_Capture->ulCapEdgeCnt[ulCh] = ulGpr0[ulCh] >> 24;
+        param_Capture->ulCapTbuCnt[ulCh]  = ulGpr0[ulCh] & TIM_CAP_MASK;
+        param_Capture->ulPeriodCnt[ulCh]  = ulGpr1[ulCh] & TIM_CAP_MASK;
+    }
+}
+
+/*
+ * Duty of the channels of param_ChMask, param_DutyCnt[n] for TOM1 CH(4+n) in
+ * 0..DRV_GTM_PWM_PERIOD_CNT. The update of the channels is off while their
+ * SR1 are written and is switched on again by one GLB_CTRL write: all of
+ * them take the new duty at the same period end, CH5..7 being reset by CH4.
+ * The position in the period at that write is kept in stGtmPwmStage.
+ */
+void DrvGtmPwmUpdate(uint32_t param_ChMask, const uint32_t *param_DutyCnt)
 {
-    IfxCpu_enableInterrupts();
-    ulPulseCnt++;
+    uint32_t ulUpdateOff = 0u;
+    uint32_t ulUpdateOn = 0u;
+    uint32_t ulCh;
+    uint32_t ulCn0;
+
+    for(ulCh = 0u; ulCh < DRV_GTM_PWM_CH_NUMBER; ulCh++)
+    {
+        if((param_ChMask & (1u << ulCh)) != 0u)
+        {
+            ulUpdateOff |= TOM_UPEN_OFF << (TOM_UPEN_SHIFT + (2u * ulCh));
+            ulUpdateOn  |= TOM_UPEN_ON << (TOM_UPEN_SHIFT + (2u * ulCh));
+        }
+    }
+
+    GTM_TOM1_TGC0_GLB_CTRL.U = ulUpdateOff;
+
+    for(ulCh = 0u; ulCh < DRV_GTM_PWM_CH_NUMBER; ulCh++)
+    {
+        if((param_ChMask & (1u << ulCh)) != 0u)
+        {
+            pGtmPwmCh[ulCh]->SR1.U = param_DutyCnt[ulCh];
+        }
+    }
+
+    GTM_TOM1_TGC0_GLB_CTRL.U = ulUpdateOn;
+    ulCn0 = GTM_TOM1_CH4_CN0.B.CN0;
+
+    stGtmPwmStage.ulUpdateCnt++;
+
+    if(ulCn0 >= DRV_GTM_ADC_TRIG_CNT)
+    {
+        stGtmPwmStage.ulLastCnt = ulCn0 - DRV_GTM_ADC_TRIG_CNT;
+        stGtmPwmStage.ulMaxCnt  = (stGtmPwmStage.ulLastCnt > stGtmPwmStage.ulMaxCnt) ? stGtmPwmStage.ulLastCnt : stGtmPwmStage.ulMaxCnt;
+    }
+    else
+    {
+        stGtmPwmStage.ulLateCnt++;
+    }
 }
 
-/*---------------------Test Code--------------------------*/
-void DrvGtmPwmTest(float32_t param_Ch4Duty, float32_t param_Ch5Duty, float32_t param_Ch6Duty, float32_t param_Ch7Duty)
+void DrvGtmGetPwmStage(DrvGtmPwmStage *param_Stage)
 {
-    float32_t fPeriodCnt = PWM_PERIOD_CNT;
-    uint32_t ulPeriodCnt = (uint32_t)fPeriodCnt;
-    
-    GTM_TOM1_TGC0_GLB_CTRL.U = 0xAA000000u; 
-    
-    GTM_TOM1_CH4_SR0.B.SR0 = ulPeriodCnt;
-    GTM_TOM1_CH4_SR1.B.SR1 = (uint32_t)(fPeriodCnt*param_Ch4Duty);
+    boolean bEnabled = IfxCpu_disableInterrupts();
 
-    GTM_TOM1_CH5_SR0.B.SR0 = ulPeriodCnt;
-    GTM_TOM1_CH5_SR1.B.SR1 = (uint32_t)(fPeriodCnt*param_Ch5Duty);
+    *param_Stage = stGtmPwmStage;
 
-    GTM_TOM1_CH6_SR0.B.SR0 = ulPeriodCnt;
-    GTM_TOM1_CH6_SR1.B.SR1 = (uint32_t)(fPeriodCnt*param_Ch6Duty);
+    IfxCpu_restoreInterrupts(bEnabled);
+}
 
-    GTM_TOM1_CH7_SR0.B.SR0 = ulPeriodCnt;
-    GTM_TOM1_CH7_SR1.B.SR1 = (uint32_t)(fPeriodCnt*param_Ch7Duty);
-    
-    GTM_TOM1_TGC0_GLB_CTRL.U = 0xAA000000u;
+/*
+ * TOM1 CH4..7 outputs off at once: the host trigger takes OUTEN_CTRL without
+ * waiting for the period end. A disabled output is the inverse of SL, the
+ * enables go low and the bridges coast. The channels keep counting and take
+ * their duties, DrvGtmPwmOutputOn gives the pins back.
+ */
+void DrvGtmPwmOutputOff(void)
+{
+    GTM_TOM1_TGC0_OUTEN_CTRL.U = TOM_OUTEN_PWM_OFF;
+    GTM_TOM1_TGC0_GLB_CTRL.U = TOM_HOST_TRIG;
+}
+
+void DrvGtmPwmOutputOn(void)
+{
+    GTM_TOM1_TGC0_OUTEN_CTRL.U = TOM_OUTEN_PWM_ON;
+    GTM_TOM1_TGC0_GLB_CTRL.U = TOM_HOST_TRIG;
+}
+
+/*
+ * Servo pulse in CMU_FXCLK1 counts, below DRV_GTM_SERVO_SHOT_CNT. Only the
+ * shadow SR1 is written: CM1 takes it at the end of the shot, so the pulse
+ * running now keeps its width and the next frame has the new one.
+ */
+void DrvGtmServoUpdate(uint32_t param_PulseCnt)
+{
+    GTM_TOM0_CH9_SR1.U = param_PulseCnt;
 }
 
 /*---------------------Init Function--------------------------*/
@@ -110,19 +235,30 @@ void DrvGtmInit(void)
 
     /*setting CMU0 frequency*/
     IfxGtm_Cmu_setClkFrequency(&MODULE_GTM, IfxGtm_Cmu_Clk_0, g_GtmTomTimer.info.gtmFreq);
+    /*setting CMU1 frequency: TIM period count*/
+    IfxGtm_Cmu_setClkFrequency(&MODULE_GTM, IfxGtm_Cmu_Clk_1, DRV_GTM_TIM_CLK_HZ);
+
+    /*TBU channel 0 on CMU0: time stamp of the TIM edges*/
+    GTM_TBU_CH0_CTRL.B.LOW_RES = 0u;
+    GTM_TBU_CH0_CTRL.B.CH_CLK_SRC = (uint32_t)IfxGtm_Cmu_Clk_0;
+    IfxGtm_Tbu_enableChannel(gtm, IfxGtm_Tbu_Ts_0);
     
     GtmTom1Init();
+    GtmTom1AdcTrigInit();
+    GtmTom0ServoInit();
     GtmTim0Init();
 
     /*enable interrupts again*/
     IfxCpu_restoreInterrupts(interruptState);
 
     /*enable Cmu clock*/
-    IfxGtm_Cmu_enableClocks(gtm, IFXGTM_CMU_CLKEN_FXCLK | IFXGTM_CMU_CLKEN_CLK0);
+    IfxGtm_Cmu_enableClocks(gtm, IFXGTM_CMU_CLKEN_FXCLK | IFXGTM_CMU_CLKEN_CLK0 | IFXGTM_CMU_CLKEN_CLK1);
 }
 
 static void GtmTom1Init(void)
 {
+    uint32_t ulCh;
+
     IfxGtm_PinMap_setTomTout(&IfxGtm_TOM1_4_TOUT30_P33_8_OUT, IfxPort_OutputMode_pushPull, IfxPort_PadDriver_cmosAutomotiveSpeed4); /*Rear Left*/
     IfxGtm_PinMap_setTomTout(&IfxGtm_TOM1_5_TOUT28_P33_6_OUT, IfxPort_OutputMode_pushPull, IfxPort_PadDriver_cmosAutomotiveSpeed4); /*Rear Right*/
     IfxGtm_PinMap_setTomTout(&IfxGtm_TOM1_6_TOUT5_P02_5_OUT, IfxPort_OutputMode_pushPull, IfxPort_PadDriver_cmosAutomotiveSpeed4);  /*Front Left*/
@@ -146,37 +282,114 @@ static void GtmTom1Init(void)
 
     GTM_TOM1_TGC0_GLB_CTRL.U = 0xAA000000u; 
     GTM_TOM1_TGC0_ENDIS_CTRL.U = 0xAA00u;    
-    GTM_TOM1_TGC0_OUTEN_CTRL.U = 0xAA00u;  
+    GTM_TOM1_TGC0_OUTEN_CTRL.U = TOM_OUTEN_PWM_ON;
 
-    GTM_TOM1_CH4_CTRL.B.CLK_SRC_SR = IfxGtm_Tom_Ch_ClkSrc_cmuFxclk2;
-    GTM_TOM1_CH5_CTRL.B.CLK_SRC_SR = IfxGtm_Tom_Ch_ClkSrc_cmuFxclk2;    
-    GTM_TOM1_CH6_CTRL.B.CLK_SRC_SR = IfxGtm_Tom_Ch_ClkSrc_cmuFxclk2;
-    GTM_TOM1_CH7_CTRL.B.CLK_SRC_SR = IfxGtm_Tom_Ch_ClkSrc_cmuFxclk2;
+    /*DRV_GTM_PWM_HZ on FXCLK0, the period is not changed by DrvGtmPwmUpdate*/
+    for(ulCh = 0u; ulCh < DRV_GTM_PWM_CH_NUMBER; ulCh++)
+    {
+        pGtmPwmCh[ulCh]->CTRL.B.CLK_SRC_SR = IfxGtm_Tom_Ch_ClkSrc_cmuFxclk0;
+        pGtmPwmCh[ulCh]->SR0.U = DRV_GTM_PWM_PERIOD_CNT;
+        pGtmPwmCh[ulCh]->SR1.U = 0u;
+        pGtmPwmCh[ulCh]->CM0.U = DRV_GTM_PWM_PERIOD_CNT;
+        pGtmPwmCh[ulCh]->CM1.U = 0u;
+    }
 
     GTM_TOM1_TGC0_GLB_CTRL.B.HOST_TRIG = 1u;  
 }
 
-static void GtmTim0Init(void)
+/*
+ * TOM1 CH8 is reset with CH4..7 (CH7 passes the trigger of CH4 on) and goes
+ * high at DRV_GTM_ADC_TRIG_CNT of every PWM period: the rising edge starts
+ * the scan of VADC G0 through GTM ADC trigger 1. No pin.
+ */
+static void GtmTom1AdcTrigInit(void)
 {
-    float32_t temp = 0.0f;
-    
-    IfxGtm_PinMap_setTimTin(&IfxGtm_TIM0_0_TIN32_P33_10_IN, IfxPort_InputMode_pullDown);
+    GTM_TOM1_CH8_CTRL.B.RST_CCU0 = 1u;
+    GTM_TOM1_CH8_CTRL.B.TRIGOUT = 0u;
+    GTM_TOM1_CH8_CTRL.B.SL = 0u;            /*Low from the period start to CM1*/
+    GTM_TOM1_CH8_CTRL.B.CLK_SRC_SR = IfxGtm_Tom_Ch_ClkSrc_cmuFxclk0;
 
-    GTM_TIM0_CH0_CTRL.B.TIM_MODE = 2u; 
-    GTM_TIM0_CH0_CTRL.B.ISL = 0u;
-    GTM_TIM0_CH0_CTRL.B.DSL = 1u;
+    GTM_TOM1_CH8_SR0.U = DRV_GTM_PWM_PERIOD_CNT;
+    GTM_TOM1_CH8_SR1.U = DRV_GTM_ADC_TRIG_CNT;
+    GTM_TOM1_CH8_CM0.U = DRV_GTM_PWM_PERIOD_CNT;
+    GTM_TOM1_CH8_CM1.U = DRV_GTM_ADC_TRIG_CNT;
 
-    GTM_TIM0_CH0_CTRL.B.FLT_EN = 0;
-    //temp = 2.0f * TOM_BASE_FREQ;
+    GTM_TOM1_TGC1_GLB_CTRL.B.UPEN_CTRL0 = TOM_UPEN_ON;
+    GTM_TOM1_TGC1_ENDIS_CTRL.B.ENDIS_CTRL0 = 2u;  /*Enabled by the host trigger*/
 
-    //GTM_TIM0_CH0_FLT_RE.B.FLT_RE = (uint32_t)temp;
-    //GTM_TIM0_CH0_CTRL.B.FLT_MODE_RE = (uint8_t)IfxGtm_Tim_FilterMode_immediateEdgePropagation;
+    (void)IfxGtm_Trig_toVadc(&MODULE_GTM, IfxGtm_Trig_AdcGroup_0, IfxGtm_Trig_AdcTrig_1,
+                             IfxGtm_Trig_AdcTrigSource_tom1, IfxGtm_Trig_AdcTrigChannel_8);
 
-    SRC_GTMTIM00.B.SRE = 1;
-    SRC_GTMTIM00.B.SRPN = 200u;
-    GTM_TIM0_CH0_CNT.U = 0;
-    GTM_TIM0_CH0_IRQ_EN.U = 0x1;
-    GTM_TIM0_CH0_CTRL.B.TIM_EN = 1;
-    GTM_IRQ_MODE.B.IRQ_MODE = 2;
-    GTM_TIM0_CH0_IRQ_MODE.B.IRQ_MODE = 2;    
+    GTM_TOM1_TGC1_GLB_CTRL.B.HOST_TRIG = 1u;
+}
+
+/*
+ * Steering servo on P00.1. TOM0 CH8 only counts the frame and passes its
+ * period end to CH9 (TRIGOUT), no pin. CH9 is in one-shot mode started by
+ * that trigger: high from the start of the shot to CM1, then low until the
+ * next frame. The pulse has the resolution of CMU_FXCLK1, the 16 bit counter
+ * of one channel could not hold a 20ms frame at that rate. Starts at 0 : no
+ * pulse until the first DrvGtmServoUpdate.
+ */
+static void GtmTom0ServoInit(void)
+{
+    IfxGtm_PinMap_setTomTout(&IfxGtm_TOM0_9_TOUT10_P00_1_OUT, IfxPort_OutputMode_pushPull, IfxPort_PadDriver_cmosAutomotiveSpeed4);
+
+    GTM_TOM0_CH8_CTRL.B.RST_CCU0 = 0u;
+    GTM_TOM0_CH8_CTRL.B.TRIGOUT = 1u;
+    GTM_TOM0_CH8_CTRL.B.CLK_SRC_SR = IfxGtm_Tom_Ch_ClkSrc_cmuFxclk2;
+    GTM_TOM0_CH8_SR0.U = DRV_GTM_SERVO_FRAME_CNT;
+    GTM_TOM0_CH8_SR1.U = 0u;
+    GTM_TOM0_CH8_CM0.U = DRV_GTM_SERVO_FRAME_CNT;
+    GTM_TOM0_CH8_CM1.U = 0u;
+
+    GTM_TOM0_CH9_CTRL.B.SL = 1u;
+    GTM_TOM0_CH9_CTRL.B.OSM = 1u;
+    GTM_TOM0_CH9_CTRL.B.OSM_TRIG = 1u;     /*Shot started by TRIG_8*/
+    GTM_TOM0_CH9_CTRL.B.CLK_SRC_SR = IfxGtm_Tom_Ch_ClkSrc_cmuFxclk1;
+    GTM_TOM0_CH9_SR0.U = DRV_GTM_SERVO_SHOT_CNT;
+    GTM_TOM0_CH9_SR1.U = 0u;
+    GTM_TOM0_CH9_CM0.U = DRV_GTM_SERVO_SHOT_CNT;
+    GTM_TOM0_CH9_CM1.U = 0u;
+
+    GTM_TOM0_TGC1_GLB_CTRL.B.UPEN_CTRL0 = TOM_UPEN_ON;
+    GTM_TOM0_TGC1_GLB_CTRL.B.UPEN_CTRL1 = TOM_UPEN_ON;
+    GTM_TOM0_TGC1_ENDIS_CTRL.B.ENDIS_CTRL0 = 2u;
+    GTM_TOM0_TGC1_ENDIS_CTRL.B.ENDIS_CTRL1 = 2u;
+    GTM_TOM0_TGC1_OUTEN_CTRL.B.OUTEN_CTRL1 = 2u;
+
+    GTM_TOM0_TGC1_GLB_CTRL.B.HOST_TRIG = 1u;
+}
+
+/*
+ * Encoder inputs in TPWM mode: at every rising edge GPR1 takes the period
+ * since the previous rising edge (CMU1 ticks) and GPR0 the TBU_TS0 time of
+ * the edge. ECNT counts both edges. No interrupt.
+ */
+static void GtmTim0Init(void)
+{
+    uint32_t ulCh;
+
+    for(ulCh = 0u; ulCh < DRV_GTM_TIM_CH_NUMBER; ulCh++)
+    {
+        Ifx_GTM_TIM_CH *pCh = pGtmTimCh[ulCh];
+
+        IfxGtm_PinMap_setTimTin(pGtmTimPin[ulCh], IfxPort_InputMode_pullDown);
+
+        pCh->CTRL.B.TIM_MODE = 0u;          /*TPWM*/
+        pCh->CTRL.B.ISL = 0u;
+        pCh->CTRL.B.DSL = 1u;               /*Period from rising edge to rising edge*/
+        pCh->CTRL.B.TBU0x_SEL = 0u;         /*TBU_TS0 [23:0]*/
+        pCh->CTRL.B.EGPR0_SEL = 0u;
+        pCh->CTRL.B.GPR0_SEL = 0u;          /*GPR0 : TBU_TS0*/
+        pCh->CTRL.B.EGPR1_SEL = 0u;
+        pCh->CTRL.B.GPR1_SEL = 3u;          /*GPR1 : CNT*/
+        pCh->CTRL.B.CLK_SEL = 1u;           /*CMU_CLK1*/
+        pCh->CTRL.B.FLT_EN = 0u;
+
+        pCh->IRQ_EN.U = 0x0u;
+        pCh->CTRL.B.TIM_EN = 1u;
+    }
+
+    SRC_GTMTIM00.B.SRE = 0u;
 }
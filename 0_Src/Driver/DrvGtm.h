@@ -5,15 +5,54 @@
 /*						Include Header File						  */
 /*----------------------------------------------------------------*/
 #include "Ifx_Types.h"
+#include "DrvStm.h"
 
 /*----------------------------------------------------------------*/
 /*						Define						  			  */
 /*----------------------------------------------------------------*/
+#define DRV_GTM_TIM_CLK_HZ          1000000.0f  /*CMU_CLK1, TIM0 period count*/
+#define DRV_GTM_TBU_CNT_PER_US      DRV_STM_CNT_PER_US  /*TBU_TS0 on CMU_CLK0, same rate as STM0*/
+#define DRV_GTM_TIM_CH_NUMBER       4u          /*Encoders on TIM0 CH0..3, same order as TOM1 CH4..7*/
+
+#define DRV_GTM_PWM_CLK_HZ          100000000u  /*CMU_FXCLK0 : GCLK not divided*/
+#define DRV_GTM_PWM_HZ              20000u
+#define DRV_GTM_PWM_PERIOD_CNT      (DRV_GTM_PWM_CLK_HZ / DRV_GTM_PWM_HZ)   /*Duty count of 100%*/
+#define DRV_GTM_PWM_CH_NUMBER       4u          /*TOM1 CH4..7 : RL, RR, FL, FR*/
+#define DRV_GTM_PWM_CH_ALL          0x0Fu       /*Mask of DrvGtmPwmUpdate, bit n : TOM1 CH(4+n)*/
+#define DRV_GTM_PWM_PERMILLE_TO_CNT(x)  (((uint32_t)(x) * DRV_GTM_PWM_PERIOD_CNT) / 1000u)   /*0.1% unit*/
+#define DRV_GTM_ADC_TRIG_CNT        250u        /*TOM1 CH8 : VADC G0 trigger 2.5us into the PWM period, in the high phase*/
+
+#define DRV_GTM_SERVO_FRAME_CNT     7813u       /*TOM0 CH8 on CMU_FXCLK2 (GCLK/256) : 20ms servo frame*/
+#define DRV_GTM_SERVO_CNT_PER_US    6.25f       /*TOM0 CH9 on CMU_FXCLK1 (GCLK/16) : 160ns per count*/
+#define DRV_GTM_SERVO_SHOT_CNT      18750u      /*One-shot period of TOM0 CH9, 3ms : longer than any pulse*/
 
 
 /*----------------------------------------------------------------*/
 /*						Typedefs						  		  */
 /*----------------------------------------------------------------*/
+/*Encoder captures of TIM0 CH0..3, index : channel*/
+typedef struct
+{
+    uint32_t ulEdgeCnt[DRV_GTM_TIM_CH_NUMBER];      /*ECNT now, both edges, 16 bit*/
+    uint32_t ulCapEdgeCnt[DRV_GTM_TIM_CH_NUMBER];   /*ECNT [7:0] at the last rising edge*/
+    uint32_t ulCapTbuCnt[DRV_GTM_TIM_CH_NUMBER];    /*TBU_TS0 [23:0] at the last rising edge*/
+    uint32_t ulPeriodCnt[DRV_GTM_TIM_CH_NUMBER];    /*Last full period, CMU_CLK1 ticks*/
+    uint32_t ulTbuNowCnt;                           /*TBU_TS0 [23:0] now*/
+    uint32_t ulStmNowCnt;                           /*STM0 lower count, read with ulTbuNowCnt*/
+}DrvGtmTimCapture;
+
+/*
+ * When DrvGtmPwmUpdate enabled the update, CN0 of TOM1 CH4 less
+ * DRV_GTM_ADC_TRIG_CNT. Late : CN0 was below the trigger, the period of the
+ * trigger had ended and the duties came one period later.
+ */
+typedef struct
+{
+    uint32_t ulUpdateCnt;
+    uint32_t ulLastCnt;                             /*FXCLK0 ticks after the trigger*/
+    uint32_t ulMaxCnt;
+    uint32_t ulLateCnt;
+}DrvGtmPwmStage;
 
 
 /*----------------------------------------------------------------*/
@@ -29,7 +68,12 @@
 
 /*---------------------Init Function--------------------------*/
 extern void DrvGtmInit(void);
-extern void DrvGtmPwmTest(float32_t param_Ch4Duty, float32_t param_Ch5Duty, float32_t param_Ch6Duty, float32_t param_Ch7Duty);
+extern void DrvGtmGetTimCapture(DrvGtmTimCapture *param_Capture);
+extern void DrvGtmPwmUpdate(uint32_t param_ChMask, const uint32_t *param_DutyCnt);
+extern void DrvGtmGetPwmStage(DrvGtmPwmStage *param_Stage);
+extern void DrvGtmPwmOutputOff(void);
+extern void DrvGtmPwmOutputOn(void);
+extern void DrvGtmServoUpdate(uint32_t param_PulseCnt);
 
 
 
@@ -5,12 +5,15 @@
 #include "IfxStm.h"
 #include "IfxCpu_Irq.h"
 #include "Common.h"
+#include "ExeVerification.h"
+#include "ExeTrace.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
 #define ISR_PRIORITY_STM_INT0       40 /**< \brief Define the System Timer Interrupt priority.  */
-#define STM_TIME_1MS                100000u
+#define STM_MIN_COMPARE_CNT         DRV_STM_CNT_PER_US  /*1us, a compare closer than this is moved out*/
+#define STM_PARKED_COMPARE_CNT      0x7FFFFFFFu /*Compare far away until the timer is started*/
 
 
 /*----------------------------------------------------------------*/
@@ -20,6 +23,7 @@ typedef struct stm_info
 {
     Ifx_STM             *stmSfr;            /**< \brief Pointer to Stm register base */
     IfxStm_CompareConfig stmConfig;         /**< \brief Stm Configuration structure */
+    uint32_t             ulPeriodCnt;       /**< \brief Compare reload, 0 for one shot compare */
 }STM_INFO;
 
 
@@ -47,11 +51,24 @@ IFX_INTERRUPT(STM_Int0Handler, 0, ISR_PRIORITY_STM_INT0);
 /*---------------------Interrupt Service Routine--------------------------*/
 void STM_Int0Handler(void)
 {
+    uint32_t ulCompareCnt = IfxStm_getCompare(gstnuStmInfo.stmSfr, gstnuStmInfo.stmConfig.comparator);
+    EXE_PROF_ISR_ENTER();
+    EXE_TRACE(EXE_TRACE_ISR_ENTER, EXE_PROF_ISR_STM0, 0u);
+
     IfxStm_clearCompareFlag(gstnuStmInfo.stmSfr, gstnuStmInfo.stmConfig.comparator);
-    IfxStm_increaseCompare(gstnuStmInfo.stmSfr, gstnuStmInfo.stmConfig.comparator, STM_TIME_1MS);
+
+    if(gstnuStmInfo.ulPeriodCnt != 0u)
+    {
+        IfxStm_increaseCompare(gstnuStmInfo.stmSfr, gstnuStmInfo.stmConfig.comparator, gstnuStmInfo.ulPeriodCnt);
+    }
 
     /*Stm Collback Function*/
     DrvStm0CallbackFnc();
+
+    EXE_TRACE(EXE_TRACE_ISR_EXIT, EXE_PROF_ISR_STM0, 0u);
+
+    /*The compare value is the ideal release of this interrupt*/
+    EXE_PROF_ISR_EXIT_RELEASE(EXE_PROF_ISR_STM0, ulCompareCnt);
 }
 
 /*---------------------Callback Function--------------------------*/
@@ -60,6 +77,35 @@ void DrvRegStm0CallbackFnc(void (*pDrvRegCallbackFnc)(void))
     DrvStm0CallbackFnc = pDrvRegCallbackFnc;
 }
 
+/*---------------------Driver API--------------------------*/
+uint32_t DrvStm0GetLowerCnt(void)
+{
+    return IfxStm_getLower(&MODULE_STM0);
+}
+
+/*Periodic compare interrupt, the first one param_PeriodCnt from now*/
+void DrvStm0StartPeriodic(uint32_t param_PeriodCnt)
+{
+    gstnuStmInfo.ulPeriodCnt = param_PeriodCnt;
+    IfxStm_updateCompare(gstnuStmInfo.stmSfr, gstnuStmInfo.stmConfig.comparator,
+                         IfxStm_getLower(gstnuStmInfo.stmSfr) + param_PeriodCnt);
+}
+
+/*One shot compare interrupt at the absolute lower count param_Cnt*/
+void DrvStm0SetCompare(uint32_t param_Cnt)
+{
+    uint32_t ulNow = IfxStm_getLower(gstnuStmInfo.stmSfr);
+
+    /*Already passed or too close: the match would only come after a wrap*/
+    if((int32_t)(param_Cnt - ulNow) < (int32_t)STM_MIN_COMPARE_CNT)
+    {
+        param_Cnt = ulNow + STM_MIN_COMPARE_CNT;
+    }
+
+    gstnuStmInfo.ulPeriodCnt = 0u;
+    IfxStm_updateCompare(gstnuStmInfo.stmSfr, gstnuStmInfo.stmConfig.comparator, param_Cnt);
+}
+
 /*---------------------Init Function--------------------------*/
 void DrvStmInit(void)
 {
@@ -75,7 +121,7 @@ static void DrvStm0Init(void)
 
     gstnuStmInfo.stmConfig.triggerPriority = ISR_PRIORITY_STM_INT0;
     gstnuStmInfo.stmConfig.typeOfService   = IfxSrc_Tos_cpu0;
-    gstnuStmInfo.stmConfig.ticks           = STM_TIME_1MS*10u;            /*1ms*10 = 10ms*/
+    gstnuStmInfo.stmConfig.ticks           = STM_PARKED_COMPARE_CNT;  /*The user of the timer sets the period*/
 
     IfxStm_initCompare(gstnuStmInfo.stmSfr, &gstnuStmInfo.stmConfig);
 }
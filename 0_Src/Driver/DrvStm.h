@@ -9,7 +9,7 @@
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
-
+#define DRV_STM_CNT_PER_US          100u    /*STM0 on fSTM 100MHz, 10ns*/
 
 /*----------------------------------------------------------------*/
 /*                        Typedefs                                    */
@@ -26,6 +26,9 @@
 /*----------------------------------------------------------------*/
 void DrvStmInit(void);
 void DrvRegStm0CallbackFnc(void (*pDrvRegCallbackFnc)(void));
+uint32_t DrvStm0GetLowerCnt(void);
+void DrvStm0StartPeriodic(uint32_t param_PeriodCnt);
+void DrvStm0SetCompare(uint32_t param_Cnt);
 
 
 
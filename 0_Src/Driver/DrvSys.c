@@ -8,6 +8,8 @@
 #include "DrvAdc.h"
 #include "DrvAsc.h"
 #include "DrvGtm.h"
+#include "DrvGpsr.h"
+#include "IfxCpu.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
@@ -46,5 +48,16 @@ void DrvSys(void)
     DrvAscInit();
     /*GTM Init*/
     DrvGtmInit();
+    /*Software Interrupt Init*/
+    DrvGpsrInit();
+}
+
+/*
+ * Idle mode request of CPU0. A pending service request ends the idle mode even
+ * with the interrupts disabled, the caller takes it when it enables them.
+ */
+void DrvSysCpuIdle(void)
+{
+    (void)IfxCpu_setCoreMode(&MODULE_CPU0, IfxCpu_CoreMode_idle);
 }
 
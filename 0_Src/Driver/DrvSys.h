@@ -25,6 +25,7 @@
 /*                        Global Function Prototype                  */
 /*----------------------------------------------------------------*/
 extern void DrvSys(void);
+extern void DrvSysCpuIdle(void);
 
 
 #endif
@@ -5,10 +5,33 @@
 /*                        Include Header File                          */
 /*----------------------------------------------------------------*/
 #include "Ifx_Types.h"
+#include "DrvDio.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
+/*Front L298N IN1..4 on P33*/
+#define MID_DIO_FRONT_IN1_BIT       5u
+#define MID_DIO_FRONT_IN2_BIT       3u
+#define MID_DIO_FRONT_IN3_BIT       1u
+#define MID_DIO_FRONT_IN4_BIT       4u
+
+/*Rear L298N IN1..4 on P02*/
+#define MID_DIO_REAR_IN1_BIT        0u
+#define MID_DIO_REAR_IN2_BIT        2u
+#define MID_DIO_REAR_IN3_BIT        4u
+#define MID_DIO_REAR_IN4_BIT        3u
+
+#define MID_DIO_FRONT_PINS(in1, in2, in3, in4)  \
+    (((uint32_t)(in1) << MID_DIO_FRONT_IN1_BIT) | ((uint32_t)(in2) << MID_DIO_FRONT_IN2_BIT) | \
+     ((uint32_t)(in3) << MID_DIO_FRONT_IN3_BIT) | ((uint32_t)(in4) << MID_DIO_FRONT_IN4_BIT))
+#define MID_DIO_REAR_PINS(in1, in2, in3, in4)   \
+    (((uint32_t)(in1) << MID_DIO_REAR_IN1_BIT) | ((uint32_t)(in2) << MID_DIO_REAR_IN2_BIT) | \
+     ((uint32_t)(in3) << MID_DIO_REAR_IN3_BIT) | ((uint32_t)(in4) << MID_DIO_REAR_IN4_BIT))
+
+/*Pattern of the 4 inputs of a bridge for MidDio_SetFrontBridge/MidDio_SetRearBridge*/
+#define MID_DIO_FRONT_PATTERN(in1, in2, in3, in4)   DRV_DIO_OMR(MID_DIO_FRONT_PINS(1u, 1u, 1u, 1u), MID_DIO_FRONT_PINS(in1, in2, in3, in4))
+#define MID_DIO_REAR_PATTERN(in1, in2, in3, in4)    DRV_DIO_OMR(MID_DIO_REAR_PINS(1u, 1u, 1u, 1u), MID_DIO_REAR_PINS(in1, in2, in3, in4))
 
 
 /*----------------------------------------------------------------*/
@@ -24,14 +47,8 @@
 /*----------------------------------------------------------------*/
 /*                        Global Function Prototype                  */
 /*----------------------------------------------------------------*/
-extern void MidDio_SetFrontIn1(uint8_t param_SetIn1);
-extern void MidDio_SetFrontIn2(uint8_t param_SetIn2);
-extern void MidDio_SetFrontIn3(uint8_t param_SetIn3);
-extern void MidDio_SetFrontIn4(uint8_t param_SetIn4);
-extern void MidDio_SetRearIn1(uint8_t param_SetIn1);
-extern void MidDio_SetRearIn2(uint8_t param_SetIn2);
-extern void MidDio_SetRearIn3(uint8_t param_SetIn3);
-extern void MidDio_SetRearIn4(uint8_t param_SetIn4);
+extern void MidDio_SetFrontBridge(uint32_t param_Pattern);
+extern void MidDio_SetRearBridge(uint32_t param_Pattern);
 
 
 
@@ -0,0 +1,51 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "MidGpsr.h"
+#include "DrvGpsr.h"
+
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+
+
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Callback Function--------------------------*/
+void MidRegGpsrCallbackFnc(uint32_t param_Ch, void (*pMidRegCallbackFnc)(void))
+{
+    if(param_Ch < MID_GPSR_CH_NUMBER)
+    {
+        DrvRegGpsrCallbackFnc((E_DRV_GPSR_CH)param_Ch, pMidRegCallbackFnc);
+    }
+}
+
+/*---------------------Trigger--------------------------*/
+void MidTriggerGpsr(uint32_t param_Ch)
+{
+    if(param_Ch < MID_GPSR_CH_NUMBER)
+    {
+        DrvGpsrTrigger((E_DRV_GPSR_CH)param_Ch);
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef MIDGPSR_H
+#define MIDGPSR_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define MID_GPSR_CH_NUMBER          3u      /*Software interrupts, channel 0 has the highest priority*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void MidRegGpsrCallbackFnc(uint32_t param_Ch, void (*pMidRegCallbackFnc)(void));
+void MidTriggerGpsr(uint32_t param_Ch);
+
+
+
+
+
+#endif
@@ -0,0 +1,325 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <string.h>
+#include "MidNvm.h"
+#include "DrvFlash.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define MID_NVM_MAGIC               0xA55Bu /*Header, sequence, data, checksum*/
+#define MID_NVM_PAGE_WORDS          (DRV_FLASH_PAGE_SIZE / 4u)
+#define MID_NVM_SECTOR_WORDS        (DRV_FLASH_SECTOR_SIZE / 4u)
+#define MID_NVM_RECORD_WORDS_MAX    ((MID_NVM_DATA_SIZE_MAX / 4u) + 3u)
+#define MID_NVM_SECTOR_PAIR         2u      /*Sectors of a block, written in turn*/
+
+#define MID_NVM_HEADER(words)       ((MID_NVM_MAGIC << 16) | (words))
+#define MID_NVM_RECORD_WORDS(words) ((((words) + 3u) + (MID_NVM_PAGE_WORDS - 1u)) & ~(MID_NVM_PAGE_WORDS - 1u))
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef enum
+{
+    MID_NVM_IDLE = 0u,
+    MID_NVM_ERASE,                      /*Other sector not blank: erase, then write from its start*/
+    MID_NVM_PROGRAM,                    /*One page per step, then read back*/
+    MID_NVM_RETIRE                      /*Record read back in the other sector: erase the full one*/
+}E_MID_NVM_STATE;
+
+/*Newest valid record of a block*/
+typedef struct
+{
+    uint32_t ulPair;                    /*Index in ucMidNvmSector of its sector*/
+    uint32_t ulPos;                     /*Header word, MID_NVM_SECTOR_WORDS if there is none*/
+    uint32_t ulSeq;
+    uint32_t ulFree;                    /*First free word of its sector*/
+}MidNvmLast;
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static void MidNvmFind(uint32_t param_Block, uint32_t param_Words, MidNvmLast *param_Last);
+static uint32_t MidNvmScan(uint32_t param_Sector, uint32_t param_Words, uint32_t *param_Last);
+static boolean MidNvmIsBlank(uint32_t param_Sector);
+static uint32_t MidNvmChecksum(const volatile uint32_t *param_Record, uint32_t param_Words);
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static const uint8_t ucMidNvmSector[MID_NVM_BLOCK_NUMBER][MID_NVM_SECTOR_PAIR] =
+{
+    {0u, 1u}                            /*MID_NVM_BLOCK_MOTOR_TUNE*/
+};
+
+static uint32_t ulMidNvmRecord[MID_NVM_RECORD_WORDS_MAX + 1u];
+static uint32_t ulMidNvmState = MID_NVM_IDLE;
+static uint32_t ulMidNvmAddr;           /*Sector being written*/
+static uint32_t ulMidNvmRetireAddr;     /*Sector erased after the read back, 0 : none*/
+static boolean bMidNvmRetireStarted;
+static uint32_t ulMidNvmPos;            /*Next word of the record in the sector*/
+static uint32_t ulMidNvmDone;           /*Words of ulMidNvmRecord written*/
+static uint32_t ulMidNvmRecordWords;
+static uint32_t ulMidNvmErrorCnt = 0u;
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Records--------------------------*/
+/*
+ * Each block is a log of records in one of its two sectors, appended page
+ * by page:
+ *   MID_NVM_HEADER(data words), sequence, data words, ~sum of the words before, 0 pad
+ * The record with the right size and checksum and the highest sequence is
+ * the valid one. A record cut by a reset fails its checksum and the one
+ * before stays valid. A record that does not fit goes to the start of the
+ * other sector. The full sector is erased only after the new record has been
+ * read back, so a reset at any point leaves a valid record.
+ */
+boolean MidNvmRead(uint32_t param_Block, void *param_Data, uint32_t param_Size)
+{
+    uint32_t ulWords = param_Size / 4u;
+    MidNvmLast stLast;
+
+    if((param_Block >= MID_NVM_BLOCK_NUMBER) || (param_Size > MID_NVM_DATA_SIZE_MAX) || ((param_Size % 4u) != 0u))
+    {
+        return FALSE;
+    }
+
+    MidNvmFind(param_Block, ulWords, &stLast);
+
+    if(stLast.ulPos >= MID_NVM_SECTOR_WORDS)
+    {
+        return FALSE;
+    }
+
+    memcpy(param_Data, (const void *)(DRV_FLASH_SECTOR_ADDR(ucMidNvmSector[param_Block][stLast.ulPair]) + ((stLast.ulPos + 2u) * 4u)), param_Size);
+
+    return TRUE;
+}
+
+/*Copies the data and starts the write, FALSE while the previous one runs. Done by MidNvmWriteStep*/
+boolean MidNvmWrite(uint32_t param_Block, const void *param_Data, uint32_t param_Size)
+{
+    uint32_t ulWords = param_Size / 4u;
+    uint32_t ulOther;
+    MidNvmLast stLast;
+
+    if((ulMidNvmState != MID_NVM_IDLE) || (param_Block >= MID_NVM_BLOCK_NUMBER) ||
+       (param_Size > MID_NVM_DATA_SIZE_MAX) || ((param_Size % 4u) != 0u))
+    {
+        return FALSE;
+    }
+
+    MidNvmFind(param_Block, ulWords, &stLast);
+
+    ulMidNvmRecordWords = MID_NVM_RECORD_WORDS(ulWords);
+    memset(ulMidNvmRecord, 0, sizeof(ulMidNvmRecord));
+    ulMidNvmRecord[0] = MID_NVM_HEADER(ulWords);
+    ulMidNvmRecord[1] = stLast.ulSeq + 1u;
+    memcpy(&ulMidNvmRecord[2], param_Data, param_Size);
+    ulMidNvmRecord[ulWords + 2u] = MidNvmChecksum(ulMidNvmRecord, ulWords + 2u);
+    ulMidNvmDone = 0u;
+
+    if((stLast.ulFree + ulMidNvmRecordWords) <= MID_NVM_SECTOR_WORDS)
+    {
+        ulMidNvmAddr       = DRV_FLASH_SECTOR_ADDR(ucMidNvmSector[param_Block][stLast.ulPair]);
+        ulMidNvmRetireAddr = 0u;
+        ulMidNvmPos        = stLast.ulFree;
+        ulMidNvmState      = MID_NVM_PROGRAM;
+    }
+    else
+    {
+        ulOther = ucMidNvmSector[param_Block][(stLast.ulPair + 1u) % MID_NVM_SECTOR_PAIR];
+
+        ulMidNvmAddr         = DRV_FLASH_SECTOR_ADDR(ulOther);
+        ulMidNvmRetireAddr   = DRV_FLASH_SECTOR_ADDR(ucMidNvmSector[param_Block][stLast.ulPair]);
+        bMidNvmRetireStarted = FALSE;
+        ulMidNvmPos          = 0u;
+        ulMidNvmState        = (MidNvmIsBlank(ulOther) != FALSE) ? MID_NVM_PROGRAM : MID_NVM_ERASE;
+    }
+
+    return TRUE;
+}
+
+/*
+ * Non blocking: one flash command, or the read back at the end. FALSE when
+ * nothing could be done, the flash being busy or no write pending.
+ */
+boolean MidNvmWriteStep(void)
+{
+    if((ulMidNvmState == MID_NVM_IDLE) || (DrvFlashIsBusy() != FALSE))
+    {
+        return FALSE;
+    }
+
+    if(ulMidNvmState == MID_NVM_ERASE)
+    {
+        DrvFlashEraseSector(ulMidNvmAddr);
+        ulMidNvmState = MID_NVM_PROGRAM;
+    }
+    else if(ulMidNvmState == MID_NVM_RETIRE)
+    {
+        if(bMidNvmRetireStarted == FALSE)
+        {
+            DrvFlashEraseSector(ulMidNvmRetireAddr);
+            bMidNvmRetireStarted = TRUE;
+        }
+        else
+        {
+            ulMidNvmErrorCnt += (DrvFlashHasError() != FALSE) ? 1u : 0u;
+            ulMidNvmState = MID_NVM_IDLE;
+        }
+    }
+    else if((ulMidNvmDone != 0u) && (DrvFlashHasError() != FALSE))
+    {
+        ulMidNvmErrorCnt++;
+        ulMidNvmState = MID_NVM_IDLE;
+    }
+    else if(ulMidNvmDone < ulMidNvmRecordWords)
+    {
+        DrvFlashWritePage(ulMidNvmAddr + ((ulMidNvmPos + ulMidNvmDone) * 4u), ulMidNvmRecord[ulMidNvmDone], ulMidNvmRecord[ulMidNvmDone + 1u]);
+        ulMidNvmDone += MID_NVM_PAGE_WORDS;
+    }
+    else if(memcmp((const void *)(ulMidNvmAddr + (ulMidNvmPos * 4u)), ulMidNvmRecord, ulMidNvmRecordWords * 4u) != 0)
+    {
+        /*The full sector keeps the valid record*/
+        ulMidNvmErrorCnt++;
+        ulMidNvmState = MID_NVM_IDLE;
+    }
+    else
+    {
+        ulMidNvmState = (ulMidNvmRetireAddr != 0u) ? MID_NVM_RETIRE : MID_NVM_IDLE;
+    }
+
+    return TRUE;
+}
+
+boolean MidNvmIsBusy(void)
+{
+    return (ulMidNvmState != MID_NVM_IDLE) ? TRUE : FALSE;
+}
+
+/*Writes failed or not read back as written*/
+uint32_t MidNvmGetErrorCnt(void)
+{
+    return ulMidNvmErrorCnt;
+}
+
+/*---------------------Static Function--------------------------*/
+/*
+ * Newest valid record of param_Words data words in the two sectors of the
+ * block, sequences compared modulo 2^32. Without one: the first sector,
+ * sequence 0.
+ */
+static void MidNvmFind(uint32_t param_Block, uint32_t param_Words, MidNvmLast *param_Last)
+{
+    uint32_t ulPair;
+    uint32_t ulPos;
+    uint32_t ulFree;
+    uint32_t ulSeq;
+
+    param_Last->ulPair = 0u;
+    param_Last->ulPos  = MID_NVM_SECTOR_WORDS;
+    param_Last->ulSeq  = 0u;
+    param_Last->ulFree = MID_NVM_SECTOR_WORDS;
+
+    for(ulPair = 0u; ulPair < MID_NVM_SECTOR_PAIR; ulPair++)
+    {
+        uint32_t ulSector = ucMidNvmSector[param_Block][ulPair];
+
+        ulFree = MidNvmScan(ulSector, param_Words, &ulPos);
+
+        if(ulPair == 0u)
+        {
+            param_Last->ulFree = ulFree;
+        }
+
+        if(ulPos < MID_NVM_SECTOR_WORDS)
+        {
+            ulSeq = ((const volatile uint32_t *)DRV_FLASH_SECTOR_ADDR(ulSector))[ulPos + 1u];
+
+            if((param_Last->ulPos >= MID_NVM_SECTOR_WORDS) || ((int32_t)(ulSeq - param_Last->ulSeq) > 0))
+            {
+                param_Last->ulPair = ulPair;
+                param_Last->ulPos  = ulPos;
+                param_Last->ulSeq  = ulSeq;
+                param_Last->ulFree = ulFree;
+            }
+        }
+    }
+}
+
+/*
+ * Walks the records of a sector. Returns the first free word (the sector
+ * size once a header is not readable), param_Last the header of the newest
+ * valid record of param_Words data words, the sector size if there is none.
+ */
+static uint32_t MidNvmScan(uint32_t param_Sector, uint32_t param_Words, uint32_t *param_Last)
+{
+    const volatile uint32_t *pSector = (const volatile uint32_t *)DRV_FLASH_SECTOR_ADDR(param_Sector);
+    uint32_t ulPos = 0u;
+
+    *param_Last = MID_NVM_SECTOR_WORDS;
+
+    while(ulPos < MID_NVM_SECTOR_WORDS)
+    {
+        uint32_t ulHeader = pSector[ulPos];
+        uint32_t ulWords  = ulHeader & 0xFFFFu;
+
+        if(ulHeader == 0u)
+        {
+            return ulPos;
+        }
+
+        if(((ulHeader >> 16) != MID_NVM_MAGIC) || ((ulPos + MID_NVM_RECORD_WORDS(ulWords)) > MID_NVM_SECTOR_WORDS))
+        {
+            break;
+        }
+
+        if((ulWords == param_Words) && (pSector[ulPos + ulWords + 2u] == MidNvmChecksum(&pSector[ulPos], ulWords + 2u)))
+        {
+            *param_Last = ulPos;
+        }
+
+        ulPos += MID_NVM_RECORD_WORDS(ulWords);
+    }
+
+    return MID_NVM_SECTOR_WORDS;
+}
+
+/*Erased reads as 0*/
+static boolean MidNvmIsBlank(uint32_t param_Sector)
+{
+    const volatile uint32_t *pSector = (const volatile uint32_t *)DRV_FLASH_SECTOR_ADDR(param_Sector);
+    uint32_t ulPos;
+
+    for(ulPos = 0u; ulPos < MID_NVM_SECTOR_WORDS; ulPos++)
+    {
+        if(pSector[ulPos] != 0u)
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+static uint32_t MidNvmChecksum(const volatile uint32_t *param_Record, uint32_t param_Words)
+{
+    uint32_t ulSum = 0u;
+    uint32_t ulIdx;
+
+    for(ulIdx = 0u; ulIdx < param_Words; ulIdx++)
+    {
+        ulSum += param_Record[ulIdx];
+    }
+
+    return ~ulSum;
+}
@@ -0,0 +1,41 @@
+#ifndef MIDNVM_H
+#define MIDNVM_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define MID_NVM_DATA_SIZE_MAX       240u    /*Bytes of one record, multiple of 4*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+/*Stored data sets, two data flash logical sectors each*/
+typedef enum
+{
+    MID_NVM_BLOCK_MOTOR_TUNE = 0u,      /*Speed loop gains of the auto-tune*/
+    MID_NVM_BLOCK_NUMBER
+}E_MID_NVM_BLOCK;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+boolean MidNvmRead(uint32_t param_Block, void *param_Data, uint32_t param_Size);
+boolean MidNvmWrite(uint32_t param_Block, const void *param_Data, uint32_t param_Size);
+boolean MidNvmWriteStep(void);
+boolean MidNvmIsBusy(void);
+uint32_t MidNvmGetErrorCnt(void);
+
+
+
+#endif
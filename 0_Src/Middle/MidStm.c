@@ -3,6 +3,9 @@
 /*----------------------------------------------------------------*/
 #include "MidStm.h"
 #include "DrvStm.h"
+#include "MidSwTimer.h"
+#include "IfxCpu.h"
+#include "Common.h"
 
 
 /*----------------------------------------------------------------*/
@@ -18,6 +21,8 @@
 /*----------------------------------------------------------------*/
 /*                        Static Function Prototype                  */
 /*----------------------------------------------------------------*/
+static void MidTimerIsrFnc(void);
+static void MidTimerArmEvent(void);
 
 
 
@@ -25,6 +30,10 @@
 /*----------------------------------------------------------------*/
 /*                        Variables                                    */
 /*----------------------------------------------------------------*/
+static void (*pMidTimerCallbackFnc)(void) = NULL_PTR;
+static uint8_t ucMidTimerOneShot = OFF;        /*MidSetTimerEvent mode, the compare is shared with the software timers*/
+static uint8_t ucMidTimerEventArmed = OFF;
+static uint32_t ulMidTimerEventCnt = 0u;
 
 
 
@@ -33,7 +42,96 @@
 /*----------------------------------------------------------------*/
 
 /*---------------------Callback Function--------------------------*/
+/*The software timers (MidSwTimer) share the STM0 compare interrupt with this callback*/
 void MidRegTimerCallbackFnc(void (*pMidRegCallbackFnc)(void))
 {
-    DrvRegStm0CallbackFnc(pMidRegCallbackFnc);
+    pMidTimerCallbackFnc = pMidRegCallbackFnc;
+    MidSwTimerRegWakeFnc(MidTimerArmEvent);
+    DrvRegStm0CallbackFnc(MidTimerIsrFnc);
+}
+
+static void MidTimerIsrFnc(void)
+{
+    uint32_t ulNowCnt = DrvStm0GetLowerCnt();
+
+    if((ucMidTimerOneShot == OFF) ||
+       ((ucMidTimerEventArmed == ON) && ((int32_t)(ulNowCnt - ulMidTimerEventCnt) >= 0)))
+    {
+        ucMidTimerEventArmed = OFF;
+
+        if(pMidTimerCallbackFnc != NULL_PTR)
+        {
+            pMidTimerCallbackFnc();
+        }
+    }
+
+    MidSwTimerProcess(ulNowCnt);
+
+    if(ucMidTimerOneShot == ON)
+    {
+        MidTimerArmEvent();
+    }
+}
+
+/*---------------------Timer Count--------------------------*/
+uint32_t MidGetTimerCnt(void)
+{
+    return DrvStm0GetLowerCnt();
+}
+
+/*---------------------Timer Event--------------------------*/
+/*Periodic callback every param_PeriodUs*/
+void MidStartTimer(uint32_t param_PeriodUs)
+{
+    ucMidTimerOneShot = OFF;
+    DrvStm0StartPeriodic(param_PeriodUs * MID_TIMER_CNT_PER_US);
+}
+
+/*Single callback when the timer count reaches param_Cnt*/
+void MidSetTimerEvent(uint32_t param_Cnt)
+{
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    ucMidTimerOneShot    = ON;
+    ucMidTimerEventArmed = ON;
+    ulMidTimerEventCnt   = param_Cnt;
+    MidTimerArmEvent();
+
+    IfxCpu_restoreInterrupts(bEnabled);
+}
+
+/*
+ * One shot mode: compare at the callback event or at the next software timer
+ * tick, whichever comes first. The periodic mode already interrupts every
+ * tick.
+ */
+static void MidTimerArmEvent(void)
+{
+    uint32_t ulSwTimerCnt;
+    boolean bSwTimer;
+    boolean bEnabled;
+
+    if(ucMidTimerOneShot == OFF)
+    {
+        return;
+    }
+
+    bEnabled = IfxCpu_disableInterrupts();
+    bSwTimer = MidSwTimerGetNextCnt(&ulSwTimerCnt);
+
+    if((ucMidTimerEventArmed == ON) &&
+       ((bSwTimer == FALSE) || ((int32_t)(ulMidTimerEventCnt - ulSwTimerCnt) <= 0)))
+    {
+        DrvStm0SetCompare(ulMidTimerEventCnt);
+    }
+    else if(bSwTimer != FALSE)
+    {
+        DrvStm0SetCompare(ulSwTimerCnt);
+    }
+    else
+    {
+        /*Nothing pending, the compare stays where it is*/
+    }
+
+    IfxCpu_restoreInterrupts(bEnabled);
 }
@@ -5,10 +5,12 @@
 /*                        Include Header File                          */
 /*----------------------------------------------------------------*/
 #include "Ifx_Types.h"
+#include "DrvStm.h"
 
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
+#define MID_TIMER_CNT_PER_US        DRV_STM_CNT_PER_US  /*Free running STM0 count*/
 
 
 /*----------------------------------------------------------------*/
@@ -25,6 +27,9 @@
 /*                        Global Function Prototype                  */
 /*----------------------------------------------------------------*/
 void MidRegTimerCallbackFnc(void (*pMidRegCallbackFnc)(void));
+uint32_t MidGetTimerCnt(void);
+void MidStartTimer(uint32_t param_PeriodUs);
+void MidSetTimerEvent(uint32_t param_Cnt);
 
 
 
@@ -0,0 +1,417 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "MidSwTimer.h"
+#include "MidStm.h"
+#include "IfxCpu.h"
+
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * Hierarchical timer wheel. Level n slot s holds the timers expiring in
+ * [64^n, 64^(n+1)) ticks whose tick bits [6n+5:6n] are s. When the level 0
+ * index wraps, the current slot of level 1 is moved down (and level 2 when
+ * level 1 wraps ...), so start, stop and expiry are O(1) and every timer
+ * is moved at most once per level.
+ */
+#define MID_SW_TIMER_TICK_CNT       (MID_SW_TIMER_TICK_US * MID_TIMER_CNT_PER_US)
+#define MID_SW_TIMER_SLOT_MASK      (MID_SW_TIMER_SLOT_NUMBER - 1u)
+#define MID_SW_TIMER_LEVEL_WORK     0xFFu   /*ucLevel of the timers expiring in this tick*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static MidSwTimer **MidSwTimerListHead(const MidSwTimer *param_Timer);
+static void MidSwTimerLink(MidSwTimer *param_Timer, uint8_t param_Level, uint8_t param_Slot);
+static void MidSwTimerUnlink(MidSwTimer *param_Timer);
+static void MidSwTimerInsert(MidSwTimer *param_Timer);
+static void MidSwTimerCascade(uint32_t param_Level);
+static void MidSwTimerExpire(MidSwTimer *param_Timer);
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static MidSwTimer *pMidSwTimerSlot[MID_SW_TIMER_LEVEL_NUMBER][MID_SW_TIMER_SLOT_NUMBER];
+static MidSwTimer *pMidSwTimerWork = NULL_PTR;             /*Timers expiring in the tick being processed*/
+static uint32_t ulMidSwTimerSlotMask[MID_SW_TIMER_SLOT_NUMBER / 32u];  /*Non empty level 0 slots*/
+static MidSwTimer *pMidSwTimerQueueHead = NULL_PTR;
+static MidSwTimer *pMidSwTimerQueueTail = NULL_PTR;
+static void (*pMidSwTimerWakeFnc)(void) = NULL_PTR;
+static uint32_t ulMidSwTimerTick = 0u;         /*Next tick to process*/
+static uint32_t ulMidSwTimerTickCnt = 0u;      /*STM count of ulMidSwTimerTick*/
+static uint32_t ulMidSwTimerArmedNumber = 0u;
+static boolean bMidSwTimerRunning = FALSE;
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Timer API--------------------------*/
+void MidSwTimerInit(MidSwTimer *param_Timer, void (*param_CallbackFnc)(void *param_Ctx), void *param_Ctx, E_MID_SW_TIMER_CONTEXT param_Context)
+{
+    param_Timer->pNext        = NULL_PTR;
+    param_Timer->pPrev        = NULL_PTR;
+    param_Timer->pQueueNext   = NULL_PTR;
+    param_Timer->pCallbackFnc = param_CallbackFnc;
+    param_Timer->pCtx         = param_Ctx;
+    param_Timer->ulExpireTick = 0u;
+    param_Timer->ulPeriodTick = 0u;
+    param_Timer->ucContext    = (uint8_t)param_Context;
+    param_Timer->ucArmed      = OFF;
+    param_Timer->ucQueued     = OFF;
+    param_Timer->ucFire       = OFF;
+    param_Timer->ulLateCnt    = 0u;
+}
+
+/*
+ * (Re)start: first expiry at least param_DelayMs from now, then every
+ * param_PeriodMs (0 : one shot). A callback still owed to the task context
+ * is cancelled. Callable from tasks and ISRs.
+ */
+void MidSwTimerStart(MidSwTimer *param_Timer, uint32_t param_DelayMs, uint32_t param_PeriodMs)
+{
+    uint32_t ulDelayTick  = (uint32_t)((((uint64)param_DelayMs * 1000u) + MID_SW_TIMER_TICK_US - 1u) / MID_SW_TIMER_TICK_US);
+    uint32_t ulPeriodTick = (uint32_t)((((uint64)param_PeriodMs * 1000u) + MID_SW_TIMER_TICK_US - 1u) / MID_SW_TIMER_TICK_US);
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    if(param_Timer->ucArmed == ON)
+    {
+        MidSwTimerUnlink(param_Timer);
+        ulMidSwTimerArmedNumber--;
+    }
+
+    param_Timer->ulExpireTick = ulMidSwTimerTick + ulDelayTick;
+    param_Timer->ulPeriodTick = ulPeriodTick;
+    param_Timer->ucFire       = OFF;
+    param_Timer->ucArmed      = ON;
+    ulMidSwTimerArmedNumber++;
+    MidSwTimerInsert(param_Timer);
+
+    IfxCpu_restoreInterrupts(bEnabled);
+
+    /*Tickless: the next timer event may have to come earlier*/
+    if(pMidSwTimerWakeFnc != NULL_PTR)
+    {
+        pMidSwTimerWakeFnc();
+    }
+}
+
+void MidSwTimerStop(MidSwTimer *param_Timer)
+{
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    if(param_Timer->ucArmed == ON)
+    {
+        MidSwTimerUnlink(param_Timer);
+        ulMidSwTimerArmedNumber--;
+        param_Timer->ucArmed = OFF;
+    }
+
+    param_Timer->ucFire = OFF;
+
+    IfxCpu_restoreInterrupts(bEnabled);
+}
+
+boolean MidSwTimerIsArmed(const MidSwTimer *param_Timer)
+{
+    return (param_Timer->ucArmed == ON) ? TRUE : FALSE;
+}
+
+/*Callbacks of the expired MID_SW_TIMER_TASK timers, in expiry order*/
+void MidSwTimerDispatch(void)
+{
+    while(pMidSwTimerQueueHead != NULL_PTR)
+    {
+        MidSwTimer *pTimer;
+        uint8_t ucFire;
+        boolean bEnabled = IfxCpu_disableInterrupts();
+
+        pTimer = pMidSwTimerQueueHead;
+        pMidSwTimerQueueHead = pTimer->pQueueNext;
+
+        if(pMidSwTimerQueueHead == NULL_PTR)
+        {
+            pMidSwTimerQueueTail = NULL_PTR;
+        }
+
+        pTimer->ucQueued = OFF;
+        ucFire = pTimer->ucFire;
+        pTimer->ucFire = OFF;
+
+        IfxCpu_restoreInterrupts(bEnabled);
+
+        if(ucFire == ON)
+        {
+            pTimer->pCallbackFnc(pTimer->pCtx);
+        }
+    }
+}
+
+/*---------------------Timer Interrupt--------------------------*/
+/*
+ * Processes every tick up to param_NowCnt. Called from the STM compare
+ * interrupt; the MID_SW_TIMER_ISR callbacks run here without the lock, so
+ * they and the higher ISRs may start and stop timers.
+ */
+void MidSwTimerProcess(uint32_t param_NowCnt)
+{
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    if(bMidSwTimerRunning == FALSE)
+    {
+        bMidSwTimerRunning  = TRUE;
+        ulMidSwTimerTickCnt = param_NowCnt;
+    }
+
+    while((int32_t)(param_NowCnt - ulMidSwTimerTickCnt) >= 0)
+    {
+        uint32_t ulIdx = ulMidSwTimerTick & MID_SW_TIMER_SLOT_MASK;
+        MidSwTimer *pTimer;
+
+        if(ulIdx == 0u)
+        {
+            MidSwTimerCascade(1u);
+        }
+
+        /*Moved to the work list: a periodic timer may go back to the same slot*/
+        pMidSwTimerWork = pMidSwTimerSlot[0][ulIdx];
+        pMidSwTimerSlot[0][ulIdx] = NULL_PTR;
+        ulMidSwTimerSlotMask[ulIdx >> 5] &= ~(0x1u << (ulIdx & 31u));
+
+        for(pTimer = pMidSwTimerWork; pTimer != NULL_PTR; pTimer = pTimer->pNext)
+        {
+            pTimer->ucLevel = MID_SW_TIMER_LEVEL_WORK;
+        }
+
+        ulMidSwTimerTick++;
+        ulMidSwTimerTickCnt += MID_SW_TIMER_TICK_CNT;
+
+        while(pMidSwTimerWork != NULL_PTR)
+        {
+            pTimer = pMidSwTimerWork;
+            MidSwTimerUnlink(pTimer);
+            pTimer->ucArmed = OFF;
+            ulMidSwTimerArmedNumber--;
+
+            if(pTimer->ulPeriodTick != 0u)
+            {
+                pTimer->ulExpireTick += pTimer->ulPeriodTick;
+                pTimer->ucArmed = ON;
+                ulMidSwTimerArmedNumber++;
+                MidSwTimerInsert(pTimer);
+            }
+
+            if(pTimer->ucContext == MID_SW_TIMER_ISR)
+            {
+                IfxCpu_restoreInterrupts(bEnabled);
+                pTimer->pCallbackFnc(pTimer->pCtx);
+                bEnabled = IfxCpu_disableInterrupts();
+            }
+            else
+            {
+                MidSwTimerExpire(pTimer);
+            }
+        }
+    }
+
+    IfxCpu_restoreInterrupts(bEnabled);
+}
+
+/*
+ * STM count of the next tick that has to be processed: the next non empty
+ * level 0 slot, or the end of the level 0 round when only the upper levels
+ * hold timers. FALSE if no timer is armed.
+ */
+boolean MidSwTimerGetNextCnt(uint32_t *param_Cnt)
+{
+    boolean bArmed = FALSE;
+    boolean bEnabled = IfxCpu_disableInterrupts();
+
+    if(ulMidSwTimerArmedNumber != 0u)
+    {
+        uint32_t ulIdx = ulMidSwTimerTick & MID_SW_TIMER_SLOT_MASK;
+        uint32_t ulNext = ulIdx;
+
+        while((ulNext < MID_SW_TIMER_SLOT_NUMBER) &&
+              ((ulMidSwTimerSlotMask[ulNext >> 5] & (0x1u << (ulNext & 31u))) == 0u))
+        {
+            ulNext++;
+        }
+
+        *param_Cnt = ulMidSwTimerTickCnt + ((ulNext - ulIdx) * MID_SW_TIMER_TICK_CNT);
+        bArmed = TRUE;
+    }
+
+    IfxCpu_restoreInterrupts(bEnabled);
+
+    return bArmed;
+}
+
+/*Called after a start, MidStm moves its compare if the timer comes first*/
+void MidSwTimerRegWakeFnc(void (*pMidRegWakeFnc)(void))
+{
+    pMidSwTimerWakeFnc = pMidRegWakeFnc;
+}
+
+/*---------------------Static Function--------------------------*/
+/*All list operations below run locked*/
+static MidSwTimer **MidSwTimerListHead(const MidSwTimer *param_Timer)
+{
+    if(param_Timer->ucLevel == MID_SW_TIMER_LEVEL_WORK)
+    {
+        return &pMidSwTimerWork;
+    }
+
+    return &pMidSwTimerSlot[param_Timer->ucLevel][param_Timer->ucSlot];
+}
+
+static void MidSwTimerLink(MidSwTimer *param_Timer, uint8_t param_Level, uint8_t param_Slot)
+{
+    MidSwTimer **ppHead = &pMidSwTimerSlot[param_Level][param_Slot];
+
+    param_Timer->ucLevel = param_Level;
+    param_Timer->ucSlot  = param_Slot;
+    param_Timer->pPrev   = NULL_PTR;
+    param_Timer->pNext   = *ppHead;
+
+    if(*ppHead != NULL_PTR)
+    {
+        (*ppHead)->pPrev = param_Timer;
+    }
+
+    *ppHead = param_Timer;
+
+    if(param_Level == 0u)
+    {
+        ulMidSwTimerSlotMask[param_Slot >> 5] |= (0x1u << (param_Slot & 31u));
+    }
+}
+
+static void MidSwTimerUnlink(MidSwTimer *param_Timer)
+{
+    MidSwTimer **ppHead = MidSwTimerListHead(param_Timer);
+
+    if(param_Timer->pPrev != NULL_PTR)
+    {
+        param_Timer->pPrev->pNext = param_Timer->pNext;
+    }
+    else
+    {
+        *ppHead = param_Timer->pNext;
+    }
+
+    if(param_Timer->pNext != NULL_PTR)
+    {
+        param_Timer->pNext->pPrev = param_Timer->pPrev;
+    }
+
+    if((param_Timer->ucLevel == 0u) && (*ppHead == NULL_PTR))
+    {
+        ulMidSwTimerSlotMask[param_Timer->ucSlot >> 5] &= ~(0x1u << (param_Timer->ucSlot & 31u));
+    }
+
+    param_Timer->pNext = NULL_PTR;
+    param_Timer->pPrev = NULL_PTR;
+}
+
+/*Slot from the ticks left; a timer already due goes to the next tick processed*/
+static void MidSwTimerInsert(MidSwTimer *param_Timer)
+{
+    int32_t slDelta = (int32_t)(param_Timer->ulExpireTick - ulMidSwTimerTick);
+    uint32_t ulExpire = param_Timer->ulExpireTick;
+    uint32_t ulLevel;
+
+    if(slDelta < 0)
+    {
+        ulExpire = ulMidSwTimerTick;
+        slDelta  = 0;
+    }
+    else if((uint32_t)slDelta > MID_SW_TIMER_MAX_TICK)
+    {
+        /*Beyond the wheel: parked at its end, placed again on the way down*/
+        ulExpire = ulMidSwTimerTick + MID_SW_TIMER_MAX_TICK;
+        slDelta  = (int32_t)MID_SW_TIMER_MAX_TICK;
+    }
+    else
+    {
+        /*In the wheel range*/
+    }
+
+    for(ulLevel = 0u; ulLevel < (MID_SW_TIMER_LEVEL_NUMBER - 1u); ulLevel++)
+    {
+        if((uint32_t)slDelta < (0x1u << (MID_SW_TIMER_SLOT_BITS * (ulLevel + 1u))))
+        {
+            break;
+        }
+    }
+
+    MidSwTimerLink(param_Timer, (uint8_t)ulLevel,
+                   (uint8_t)((ulExpire >> (MID_SW_TIMER_SLOT_BITS * ulLevel)) & MID_SW_TIMER_SLOT_MASK));
+}
+
+/*Current slot of param_Level down to the lower levels, then the next level if this one wrapped*/
+static void MidSwTimerCascade(uint32_t param_Level)
+{
+    uint32_t ulIdx;
+    MidSwTimer *pTimer;
+
+    if(param_Level >= MID_SW_TIMER_LEVEL_NUMBER)
+    {
+        return;
+    }
+
+    ulIdx  = (ulMidSwTimerTick >> (MID_SW_TIMER_SLOT_BITS * param_Level)) & MID_SW_TIMER_SLOT_MASK;
+    pTimer = pMidSwTimerSlot[param_Level][ulIdx];
+    pMidSwTimerSlot[param_Level][ulIdx] = NULL_PTR;
+
+    while(pTimer != NULL_PTR)
+    {
+        MidSwTimer *pNext = pTimer->pNext;
+
+        MidSwTimerInsert(pTimer);
+        pTimer = pNext;
+    }
+
+    if(ulIdx == 0u)
+    {
+        MidSwTimerCascade(param_Level + 1u);
+    }
+}
+
+/*MID_SW_TIMER_TASK expiry: queued once, further expiries before the dispatch are counted*/
+static void MidSwTimerExpire(MidSwTimer *param_Timer)
+{
+    if(param_Timer->ucFire == ON)
+    {
+        param_Timer->ulLateCnt++;
+    }
+
+    param_Timer->ucFire = ON;
+
+    if(param_Timer->ucQueued == OFF)
+    {
+        param_Timer->ucQueued   = ON;
+        param_Timer->pQueueNext = NULL_PTR;
+
+        if(pMidSwTimerQueueTail != NULL_PTR)
+        {
+            pMidSwTimerQueueTail->pQueueNext = param_Timer;
+        }
+        else
+        {
+            pMidSwTimerQueueHead = param_Timer;
+        }
+
+        pMidSwTimerQueueTail = param_Timer;
+    }
+}
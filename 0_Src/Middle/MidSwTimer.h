@@ -0,0 +1,68 @@
+#ifndef MIDSWTIMER_H
+#define MIDSWTIMER_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "Common.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define MID_SW_TIMER_TICK_US        1000u   /*Resolution of the timers*/
+#define MID_SW_TIMER_SLOT_BITS      6u      /*64 slots per level*/
+#define MID_SW_TIMER_LEVEL_NUMBER   4u      /*2^24 ticks, 4.6h at 1ms*/
+#define MID_SW_TIMER_SLOT_NUMBER    (0x1u << MID_SW_TIMER_SLOT_BITS)
+#define MID_SW_TIMER_MAX_TICK       ((0x1u << (MID_SW_TIMER_SLOT_BITS * MID_SW_TIMER_LEVEL_NUMBER)) - 1u)
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef enum
+{
+    MID_SW_TIMER_ISR = 0u,              /*Callback in the STM compare interrupt*/
+    MID_SW_TIMER_TASK                   /*Callback from MidSwTimerDispatch*/
+}E_MID_SW_TIMER_CONTEXT;
+
+/*
+ * One timer, owned by the user (static storage). The links are only used by
+ * the timer service.
+ */
+typedef struct MidSwTimer
+{
+    struct MidSwTimer *pNext;           /*Slot list*/
+    struct MidSwTimer *pPrev;
+    struct MidSwTimer *pQueueNext;      /*Task dispatch queue*/
+    uint8_t ucLevel;                    /*List the timer is in*/
+    uint8_t ucSlot;
+    void (*pCallbackFnc)(void *param_Ctx);
+    void *pCtx;
+    uint32_t ulExpireTick;
+    uint32_t ulPeriodTick;              /*0 : one shot*/
+    uint8_t ucContext;                  /*E_MID_SW_TIMER_CONTEXT*/
+    uint8_t ucArmed;
+    uint8_t ucQueued;                   /*In the dispatch queue*/
+    uint8_t ucFire;                     /*Expired, callback not called yet*/
+    uint32_t ulLateCnt;                 /*Expiries merged before a task dispatch*/
+}MidSwTimer;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void MidSwTimerInit(MidSwTimer *param_Timer, void (*param_CallbackFnc)(void *param_Ctx), void *param_Ctx, E_MID_SW_TIMER_CONTEXT param_Context);
+void MidSwTimerStart(MidSwTimer *param_Timer, uint32_t param_DelayMs, uint32_t param_PeriodMs);
+void MidSwTimerStop(MidSwTimer *param_Timer);
+boolean MidSwTimerIsArmed(const MidSwTimer *param_Timer);
+void MidSwTimerDispatch(void);
+
+/*Used by MidStm*/
+void MidSwTimerProcess(uint32_t param_NowCnt);
+boolean MidSwTimerGetNextCnt(uint32_t *param_Cnt);
+void MidSwTimerRegWakeFnc(void (*pMidRegWakeFnc)(void));
+#endif
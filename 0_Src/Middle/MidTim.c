@@ -0,0 +1,149 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "MidTim.h"
+#include "DrvGtm.h"
+#include "SigBus.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define MID_TIM_TBU_MASK            0x00FFFFFFu
+#define MID_TIM_EDGE_MASK           0x0000FFFFu
+#define MID_TIM_STM_CNT_PER_S       ((float32_t)SIG_BUS_TIME_CNT_PER_US * 1000000.0f)
+#define MID_TIM_STOP_CNT            (MID_TIM_STOP_US * SIG_BUS_TIME_CNT_PER_US)
+
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static void MidTimUpdateWheel(uint32_t param_Wheel, const DrvGtmTimCapture *param_Capture);
+
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static boolean bMidTimStarted = FALSE;
+static uint32_t ulMidTimCapEdgeOld[MID_TIM_WHEEL_NUMBER];  /*ECNT of the last captured edge*/
+static uint32_t ulMidTimStampOld[MID_TIM_WHEEL_NUMBER];    /*STM0 count of the last captured edge*/
+static uint32_t ulMidTimEdgeOdd[MID_TIM_WHEEL_NUMBER];     /*Edge not yet a whole pulse in ulPulseCnt*/
+static SigWheelSpeed stMidTimSpeed[MID_TIM_WHEEL_NUMBER];
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Wheel Speed--------------------------*/
+/*
+ * Polls the TIM0 captures and publishes SIG_WHEEL_SPEED_RL..FR, each stamped
+ * with the time of the last edge of its encoder. With many pulses since the
+ * previous update the speed is the pulse count over the time between the
+ * last captured edges (M method, averaged over the update period). With few
+ * pulses it is the last period measured by the TIM (T method, one pulse old
+ * at most). Without a new pulse the speed can only be lower than one pulse
+ * over the time since the last edge.
+ */
+void MidTimUpdate(void)
+{
+    DrvGtmTimCapture stCapture;
+    uint32_t ulWheel;
+
+    DrvGtmGetTimCapture(&stCapture);
+
+    if(bMidTimStarted == FALSE)
+    {
+        for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+        {
+            ulMidTimCapEdgeOld[ulWheel] = stCapture.ulEdgeCnt[ulWheel] & MID_TIM_EDGE_MASK;
+            ulMidTimStampOld[ulWheel]   = stCapture.ulStmNowCnt;
+            stMidTimSpeed[ulWheel].ulMethod = MID_TIM_STOP;
+        }
+
+        bMidTimStarted = TRUE;
+    }
+
+    for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+    {
+        MidTimUpdateWheel(ulWheel, &stCapture);
+        SigBusPublishAt((E_SIG_ID)(SIG_WHEEL_SPEED_RL + ulWheel), &stMidTimSpeed[ulWheel], ulMidTimStampOld[ulWheel]);
+    }
+}
+
+static void MidTimUpdateWheel(uint32_t param_Wheel, const DrvGtmTimCapture *param_Capture)
+{
+    SigWheelSpeed *pSpeed = &stMidTimSpeed[param_Wheel];
+    uint32_t ulEdgeCnt = param_Capture->ulEdgeCnt[param_Wheel];
+    uint32_t ulCapEdge;
+    uint32_t ulStampCnt;
+    uint32_t ulEdge;
+    uint32_t ulPulse;
+
+    /*Less than 256 edges since the capture: the 16 bit count of the captured edge*/
+    ulCapEdge  = (ulEdgeCnt - ((ulEdgeCnt - param_Capture->ulCapEdgeCnt[param_Wheel]) & 0xFFu)) & MID_TIM_EDGE_MASK;
+    ulStampCnt = param_Capture->ulStmNowCnt - ((((param_Capture->ulTbuNowCnt - param_Capture->ulCapTbuCnt[param_Wheel]) & MID_TIM_TBU_MASK) * SIG_BUS_TIME_CNT_PER_US) / DRV_GTM_TBU_CNT_PER_US);
+
+    /*ECNT counts both edges, a pulse is one rising edge*/
+    ulEdge  = (ulCapEdge - ulMidTimCapEdgeOld[param_Wheel]) & MID_TIM_EDGE_MASK;
+    ulPulse = ulEdge / 2u;
+
+    if(ulPulse != 0u)
+    {
+        if((pSpeed->ulMethod == MID_TIM_STOP) && (ulPulse < 2u))
+        {
+            /*First pulse after a standstill: its period spans the stop*/
+            pSpeed->ulMethod = MID_TIM_T;
+        }
+        else if((ulPulse >= MID_TIM_M_ENTER_PULSE) || ((pSpeed->ulMethod == MID_TIM_M) && (ulPulse >= MID_TIM_M_LEAVE_PULSE)))
+        {
+            float32_t fTime = (float32_t)(ulStampCnt - ulMidTimStampOld[param_Wheel]) / MID_TIM_STM_CNT_PER_S;
+
+            pSpeed->fRpm     = ((float32_t)ulPulse * 60.0f) / (fTime * MID_TIM_PULSE_PER_REV);
+            pSpeed->ulMethod = MID_TIM_M;
+        }
+        else if(param_Capture->ulPeriodCnt[param_Wheel] != 0u)
+        {
+            pSpeed->fRpm     = (DRV_GTM_TIM_CLK_HZ * 60.0f) / ((float32_t)param_Capture->ulPeriodCnt[param_Wheel] * MID_TIM_PULSE_PER_REV);
+            pSpeed->ulMethod = MID_TIM_T;
+        }
+        else
+        {
+            /*No Code*/
+        }
+
+        /*An odd edge count would lose half a pulse per update from the distance*/
+        ulEdge += ulMidTimEdgeOdd[param_Wheel];
+        pSpeed->ulPulseCnt += ulEdge / 2u;
+        ulMidTimEdgeOdd[param_Wheel] = ulEdge & 1u;
+        ulMidTimCapEdgeOld[param_Wheel] = ulCapEdge;
+        ulMidTimStampOld[param_Wheel]   = ulStampCnt;
+    }
+    else
+    {
+        uint32_t ulAgeCnt = param_Capture->ulStmNowCnt - ulMidTimStampOld[param_Wheel];
+
+        if(ulAgeCnt >= MID_TIM_STOP_CNT)
+        {
+            pSpeed->fRpm     = 0.0f;
+            pSpeed->ulMethod = MID_TIM_STOP;
+        }
+        else if(ulAgeCnt != 0u)
+        {
+            float32_t fRpmMax = (MID_TIM_STM_CNT_PER_S * 60.0f) / ((float32_t)ulAgeCnt * MID_TIM_PULSE_PER_REV);
+
+            if(pSpeed->fRpm > fRpmMax)
+            {
+                pSpeed->fRpm = fRpmMax;
+            }
+        }
+        else
+        {
+            /*No Code*/
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef MIDTIM_H
+#define MIDTIM_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define MID_TIM_PULSE_PER_REV       (8.0f*120.0f)   /*Encoder rising edges per wheel turn*/
+#define MID_TIM_M_ENTER_PULSE       4u      /*Pulses per update to switch to the M method*/
+#define MID_TIM_M_LEAVE_PULSE       2u      /*Pulses per update to go back to the T method*/
+#define MID_TIM_STOP_US             500000u /*No edge for this long : standstill*/
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+/*TIM0 CH0..3*/
+typedef enum
+{
+    MID_TIM_WHEEL_RL = 0u,              /*Rear Left*/
+    MID_TIM_WHEEL_RR,                   /*Rear Right*/
+    MID_TIM_WHEEL_FL,                   /*Front Left*/
+    MID_TIM_WHEEL_FR,                   /*Front Right*/
+    MID_TIM_WHEEL_NUMBER
+}E_MID_TIM_WHEEL;
+
+typedef enum
+{
+    MID_TIM_STOP = 0u,                  /*No edge since MID_TIM_STOP_US*/
+    MID_TIM_T,                          /*Period of the last pulse*/
+    MID_TIM_M                           /*Pulses between the last edges of two updates over their time*/
+}E_MID_TIM_METHOD;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+void MidTimUpdate(void);
+#endif
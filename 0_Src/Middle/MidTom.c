@@ -2,6 +2,7 @@
 /*                        Include Header File                          */
 /*----------------------------------------------------------------*/
 #include "MidTom.h"
+#include "DrvGtm.h"
 
 
 /*----------------------------------------------------------------*/
@@ -17,18 +18,87 @@
 /*----------------------------------------------------------------*/
 /*                        Static Function Prototype                  */
 /*----------------------------------------------------------------*/
-
-
+static uint32_t MidTomServoPulseCnt(float32_t param_AngleDeg);
 
 
 /*----------------------------------------------------------------*/
 /*                        Variables                                    */
 /*----------------------------------------------------------------*/
+/*1.1..1.9ms over +-30deg of the steering linkage*/
+static const MidTomServoCal stMidTomServoCal =
+{
+    1500.0f,                /*fPulseCentreUs*/
+    1900.0f,                /*fPulseLeftUs*/
+    1100.0f,                /*fPulseRightUs*/
+    30.0f,                  /*fAngleMaxDeg*/
+    300.0f                  /*fSlewDegPerS : about the 0.1s/60deg of the servo*/
+};
 
+static float32_t fMidTomServoTarget = 0.0f;
+float32_t fMidTomServoAngle = 0.0f;                 /*Sent to the servo*/
 
 
 /*----------------------------------------------------------------*/
 /*                        Functions                                    */
 /*----------------------------------------------------------------*/
 
+/*---------------------Steering Servo--------------------------*/
+/*Straight ahead from the first frame on*/
+void MidTomServoInit(void)
+{
+    fMidTomServoTarget = 0.0f;
+    fMidTomServoAngle  = 0.0f;
+
+    DrvGtmServoUpdate(MidTomServoPulseCnt(0.0f));
+}
+
+/*Reached at fSlewDegPerS by MidTomServoUpdate*/
+void MidTomServoSetAngle(float32_t param_AngleDeg)
+{
+    const float32_t fMax = stMidTomServoCal.fAngleMaxDeg;
+
+    param_AngleDeg = (param_AngleDeg > fMax) ? fMax : param_AngleDeg;
+    param_AngleDeg = (param_AngleDeg < -fMax) ? -fMax : param_AngleDeg;
+
+    fMidTomServoTarget = param_AngleDeg;
+}
+
+/*
+ * Every MID_TOM_SERVO_PERIOD_S: one slew step towards the target. Two
+ * updates within a frame only leave the last pulse, which is at most
+ * two steps from the one of the frame before.
+ */
+void MidTomServoUpdate(void)
+{
+    const float32_t fStep = stMidTomServoCal.fSlewDegPerS * MID_TOM_SERVO_PERIOD_S;
+    float32_t fDelta = fMidTomServoTarget - fMidTomServoAngle;
+
+    fDelta = (fDelta > fStep) ? fStep : fDelta;
+    fDelta = (fDelta < -fStep) ? -fStep : fDelta;
+    fMidTomServoAngle += fDelta;
+
+    DrvGtmServoUpdate(MidTomServoPulseCnt(fMidTomServoAngle));
+}
+
+float32_t MidTomServoGetAngle(void)
+{
+    return fMidTomServoAngle;
+}
+
+/*Last MidTomServoSetAngle, within the end stops*/
+float32_t MidTomServoGetTarget(void)
+{
+    return fMidTomServoTarget;
+}
+
+/*---------------------Static Function--------------------------*/
+/*Angle within the end stops to CMU_FXCLK1 counts, rounded*/
+static uint32_t MidTomServoPulseCnt(float32_t param_AngleDeg)
+{
+    const MidTomServoCal *pCal = &stMidTomServoCal;
+    float32_t fEndUs = (param_AngleDeg >= 0.0f) ? pCal->fPulseLeftUs : pCal->fPulseRightUs;
+    float32_t fRatio = ((param_AngleDeg >= 0.0f) ? param_AngleDeg : -param_AngleDeg) / pCal->fAngleMaxDeg;
+    float32_t fPulseUs = pCal->fPulseCentreUs + ((fEndUs - pCal->fPulseCentreUs) * fRatio);
 
+    return (uint32_t)((fPulseUs * DRV_GTM_SERVO_CNT_PER_US) + 0.5f);
+}
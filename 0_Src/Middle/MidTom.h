@@ -9,11 +9,25 @@
 /*----------------------------------------------------------------*/
 /*                        Define                                        */
 /*----------------------------------------------------------------*/
+#define MID_TOM_SERVO_PERIOD_S      0.01f   /*MidTomServoUpdate in AppTask10ms*/
 
 
 /*----------------------------------------------------------------*/
 /*                        Typedefs                                    */
 /*----------------------------------------------------------------*/
+/*
+ * Steering servo, angles in degrees, + to the left. The pulse is linear in
+ * the angle on each side of the centre, between the pulses measured at the
+ * end stops. Angles beyond fAngleMaxDeg are limited to it.
+ */
+typedef struct
+{
+    float32_t fPulseCentreUs;           /*Straight ahead*/
+    float32_t fPulseLeftUs;             /*At fAngleMaxDeg to the left*/
+    float32_t fPulseRightUs;            /*At fAngleMaxDeg to the right*/
+    float32_t fAngleMaxDeg;             /*End stop of each side*/
+    float32_t fSlewDegPerS;             /*Of the angle sent to the servo*/
+}MidTomServoCal;
 
 
 /*----------------------------------------------------------------*/
@@ -24,9 +38,9 @@
 /*----------------------------------------------------------------*/
 /*                        Global Function Prototype                  */
 /*----------------------------------------------------------------*/
-
-
-
-
-
+void MidTomServoInit(void);
+void MidTomServoSetAngle(float32_t param_AngleDeg);
+void MidTomServoUpdate(void);
+float32_t MidTomServoGetAngle(void);
+float32_t MidTomServoGetTarget(void);
 #endif
@@ -11,6 +11,7 @@
 #include <Cpu/Std/Ifx_Types.h>
 #include "Configuration.h"
 #include "Qspi0.h"
+#include "ExeVerification.h"
 
 
 /******************************************************************************/
@@ -123,6 +124,7 @@ IFX_INTERRUPT(ISR_qspi0_Er, 0, ISR_PRIORITY_QSPI0_ER);
  */
 void ISR_qspi0_Tx(void)
 {
+    EXE_PROF_ISR_ENTER();
     IfxCpu_enableInterrupts();
 #ifdef QSPI0_USE_DMA
     IfxQspi_SpiMaster_isrDmaTransmit(&spi0Master);
@@ -133,6 +135,7 @@ void ISR_qspi0_Tx(void)
 #ifdef QSPI0_TRANSMIT_CALLBACK
     QSPI0_TRANSMIT_CALLBACK();
 #endif
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_QSPI0_TX);
 }
 
 
@@ -144,6 +147,7 @@ void ISR_qspi0_Tx(void)
  */
 void ISR_qspi0_Rx(void)
 {
+    EXE_PROF_ISR_ENTER();
     IfxCpu_enableInterrupts();
 #ifdef QSPI0_USE_DMA
     IfxQspi_SpiMaster_isrDmaReceive(&spi0Master);
@@ -153,6 +157,7 @@ void ISR_qspi0_Rx(void)
 #ifdef QSPI0_RECEIVE_CALLBACK
     QSPI0_RECEIVE_CALLBACK();
 #endif
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_QSPI0_RX);
 }
 
 /** \brief Handle qspi0_Er interrupt.
@@ -163,8 +168,10 @@ void ISR_qspi0_Rx(void)
  */
 void ISR_qspi0_Er(void)
 {
+    EXE_PROF_ISR_ENTER();
     IfxCpu_enableInterrupts();
     IfxQspi_SpiMaster_isrError(&spi0Master);
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_QSPI0_ER);
 }
 
 /** \brief QSPI0 initialisation
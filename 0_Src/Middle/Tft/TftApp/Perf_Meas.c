@@ -14,6 +14,7 @@
 #include <Gtm/Tom/Timer/IfxGtm_Tom_Timer.h>
 #include "Main.h"
 #include "ExeVerification.h"
+#include "MidStm.h"
 
 /******************************************************************************/
 /*------------------------Inline Function Prototypes--------------------------*/
@@ -198,6 +199,10 @@ void ISR_perf_meas_call(void)
 #endif
     uint32 counter_diff;
     float32 cpu_load;
+    static const char * const task_name[EXE_PROF_TASK_1S + 1] =
+        {"Task1Ms", "Task5Ms", "Task10Ms", "Task50Ms", "Task100Ms", "Task200Ms", "Task500Ms", "Task1s"};
+    ExeProfStat prof_stat;
+    uint32 prof_id;
 
     /* now we go to a lower priotity than our OS_TICK that we don't have an overflow */
     __bisr(ISR_PRIORITY_OS_TICK-1);
@@ -210,14 +215,12 @@ void ISR_perf_meas_call(void)
     {
         if (cpu_load < 0.0f) cpu_load = 0.0f;
         conio_ascii_printfxy (DISPLAY_IO1, 1,  2, (uint8 *)"CPU0 Load %.3f %c ", cpu_load, 0x25);
-        conio_ascii_printfxy (DISPLAY_IO1, 1,  3, (uint8 *)"Task1Ms Cycle : %.3f ms", stCycleInfo.fCycleTaskMs[TASK_1MS]);
-        conio_ascii_printfxy (DISPLAY_IO1, 1,  4, (uint8 *)"Task5Ms Cycle : %.3f ms", stCycleInfo.fCycleTaskMs[TASK_5MS]);
-        conio_ascii_printfxy (DISPLAY_IO1, 1,  5, (uint8 *)"Task10Ms Cycle : %.3f ms", stCycleInfo.fCycleTaskMs[TASK_10MS]);
-        conio_ascii_printfxy (DISPLAY_IO1, 1,  6, (uint8 *)"Task50Ms Cycle : %.3f ms", stCycleInfo.fCycleTaskMs[TASK_50MS]);
-        conio_ascii_printfxy (DISPLAY_IO1, 1,  7, (uint8 *)"Task100Ms Cycle : %.3f ms", stCycleInfo.fCycleTaskMs[TASK_100MS]);
-        conio_ascii_printfxy (DISPLAY_IO1, 1,  8, (uint8 *)"Task200Ms Cycle : %.3f ms", stCycleInfo.fCycleTaskMs[TASK_200MS]);
-        conio_ascii_printfxy (DISPLAY_IO1, 1,  9, (uint8 *)"Task500Ms Cycle : %.3f ms", stCycleInfo.fCycleTaskMs[TASK_500MS]);
-        conio_ascii_printfxy (DISPLAY_IO1, 1,  10, (uint8 *)"Task1s Cycle : %.3f ms", stCycleInfo.fCycleTaskMs[TASK_1S]);
+        for (prof_id = EXE_PROF_TASK_1MS; prof_id <= EXE_PROF_TASK_1S; prof_id++)
+        {
+            ExeProfGetSnapshot((E_EXE_PROF_ID)prof_id, &prof_stat);
+            conio_ascii_printfxy (DISPLAY_IO1, 1, 3 + prof_id, (uint8 *)"%s WCET : %.3f ms", task_name[prof_id],
+                                  (float32)prof_stat.ulMaxExecCnt / ((float32)MID_TIMER_CNT_PER_US * 1000.0f));
+        }
 
         CpuLoad0.counter_diff = counter_diff;
         CpuLoad0.cpu_load = cpu_load;
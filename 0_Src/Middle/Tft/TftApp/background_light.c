@@ -9,6 +9,7 @@
 #include "Configuration.h"
 #include <Tft/touch.h>
 #include "background_light.h"
+#include "ExeVerification.h"
 #include <Gtm/Tom/Timer/IfxGtm_Tom_Timer.h>
 
 /******************************************************************************/
@@ -128,6 +129,7 @@ IFX_INTERRUPT (ISR_BACKLIGHT, 0, ISR_PRIORITY_BACKLIGHT);
 
 void ISR_BACKLIGHT(void)
 {
+    EXE_PROF_ISR_ENTER();
 
     IfxGtm_Tom_Timer_acknowledgeTimerIrq(&driverBacklight);
     if((touch_event.status != TOUCH_UP) && (touch_event.status != TOUCH_UNINIT))
@@ -153,5 +155,6 @@ void ISR_BACKLIGHT(void)
         }
     }
     IfxGtm_Tom_Timer_applyUpdate(&driverBacklight);
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_BACKLIGHT);
 }
 
@@ -7,6 +7,7 @@
 #include <Tft/touch.h>
 #include "tft_app.h"
 #include "Configuration.h"
+#include "ExeVerification.h"
 
 #include <stdio.h>
 
@@ -171,10 +172,14 @@ void tft_appl_init (uint8 RtcRunning)
  */
 IFX_INTERRUPT (cpu_service0Irq, 0, ISR_PRIORITY_CPUSRV0)
 {
+    EXE_PROF_ISR_ENTER();
 
     __enable();
-    if (tft_ready == 0) return;
-    touch_periodic ();
-    conio_periodic (touch_driver.xdisp, touch_driver.ydisp, conio_driver.pmenulist, conio_driver.pstdlist);
-    conio_driver.blinky += 1;
+    if (tft_ready != 0)
+    {
+        touch_periodic ();
+        conio_periodic (touch_driver.xdisp, touch_driver.ydisp, conio_driver.pmenulist, conio_driver.pstdlist);
+        conio_driver.blinky += 1;
+    }
+    EXE_PROF_ISR_EXIT(EXE_PROF_ISR_TFT_UPDATE);
 }
@@ -0,0 +1,80 @@
+/**
+ * \file CompilerHostSim.h
+ *
+ * \brief Compiler abstraction for the host-native simulation build (x86-64 Linux, gcc).
+ *
+ * Selected by Compilers.h when IFX_HOST_SIM is defined. Interrupt service routines
+ * declared with IFX_INTERRUPT are registered to the emulated interrupt router at
+ * start-up instead of being placed into an .intvec section.
+ */
+
+#ifndef COMPILERHOSTSIM_H
+#define COMPILERHOSTSIM_H 1
+
+/******************************************************************************/
+
+#include <stddef.h>
+
+#ifndef IFX_CFG_USE_COMPILER_DEFAULT_LINKER
+#define IFX_CFG_USE_COMPILER_DEFAULT_LINKER
+#endif
+
+/******************************************************************************/
+#ifndef IFX_INLINE
+#define IFX_INLINE         static inline __attribute__ ((always_inline))
+#endif
+
+#define IFX_PACKED         __attribute__ ((packed))
+
+#define COMPILER_NAME      "HOSTSIM"
+#define COMPILER_VERSION   __VERSION__
+
+#define COMPILER_REVISION  0
+
+/** \brief Register an ISR to the emulated interrupt router (see HostSimIrq.c) */
+IFX_EXTERN void HostSimIrq_RegisterIsr(void (*isr)(void), unsigned int vectabNum, unsigned int prio);
+
+#define IFX_INTERRUPT_FAST IFX_INTERRUPT
+
+#ifndef IFX_INTERRUPT
+#define IFX_INTERRUPT(isr, vectabNum, prio)                                       \
+    IFX_EXTERN void isr(void);                                                    \
+    static void __attribute__ ((constructor)) HostSimIrq_Register_##isr(void)    \
+    {                                                                             \
+        HostSimIrq_RegisterIsr(isr, (vectabNum), (prio));                         \
+    }                                                                             \
+    void isr(void)
+#endif
+
+/******************************************************************************/
+
+#define IFX_ALIGN(n) __attribute__ ((aligned(n)))
+
+/******************************************************************************/
+/*Memory qualifiers*/
+#ifndef IFX_FAR_ABS
+#define IFX_FAR_ABS
+#endif
+
+#ifndef IFX_NEAR_ABS
+#define IFX_NEAR_ABS
+#endif
+
+#ifndef IFX_REL_A0
+#define IFX_REL_A0
+#endif
+
+#ifndef IFX_REL_A1
+#define IFX_REL_A1
+#endif
+
+#ifndef IFX_REL_A8
+#define IFX_REL_A8
+#endif
+
+#ifndef IFX_REL_A9
+#define IFX_REL_A9
+#endif
+/******************************************************************************/
+
+#endif /* COMPILERHOSTSIM_H */
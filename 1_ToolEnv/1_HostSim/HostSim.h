@@ -0,0 +1,86 @@
+#ifndef HOSTSIM_H
+#define HOSTSIM_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+#include "IfxSrc_reg.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+#define HOSTSIM_STM_FREQ_HZ             100000000u  /*fSTM = 100MHz, same as the TC237 board*/
+#define HOSTSIM_STM_TICKS_PER_MS        (HOSTSIM_STM_FREQ_HZ/1000u)
+
+#define HOSTSIM_IRQ_PRIO_NUMBER         256u
+
+/*Backdoor access to an emulated SFR for the simulator thread (never traps)*/
+#define HOSTSIM_SFR(type, addr)         (*(volatile type *)HostSimSfr_Backdoor((uint32)(addr)))
+#define HOSTSIM_SFR_OF(sfr)             (*(__typeof__(sfr) *)HostSimSfr_Backdoor((uint32)(size_t)&(sfr)))
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+/*Access hook of a trapped SFR range, called on the firmware thread*/
+typedef void (*HostSimSfr_HookFnc)(uint32 ulAddr, boolean bWrite);
+
+typedef struct
+{
+    uint64 ullIsrCount;             /*Number of ISR activations*/
+    uint64 ullLatencySum;           /*Sum of request-to-entry latency in STM ticks*/
+    uint64 ullLatencyMax;           /*Max request-to-entry latency in STM ticks*/
+}HostSimIrq_Stat;
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+/*Register file*/
+extern void HostSimSfr_Init(void);
+extern void *HostSimSfr_Backdoor(uint32 ulAddr);
+extern void HostSimSfr_RegisterHook(uint32 ulAddr, uint32 ulSize, HostSimSfr_HookFnc pHookFnc);
+extern void HostSimSfr_Poll(void);
+extern void HostSimSfr_LoadDflash(const char *pFile);
+extern void HostSimSfr_SaveDflash(const char *pFile);
+
+/*Interrupt router*/
+extern void HostSimIrq_Init(void);
+extern void HostSimIrq_AttachCpu(void);
+extern void HostSimIrq_Raise(volatile Ifx_SRC_SRCR *pSrc);
+extern void HostSimIrq_Poll(void);
+extern uint64 HostSimIrq_GetIsrCount(uint32 ulPrio);
+extern const HostSimIrq_Stat *HostSimIrq_GetStat(uint32 ulPrio);
+extern boolean HostSimIrq_IsIdle(void);
+extern boolean HostSimIrq_WaitIdle(uint32 ulTimeoutUs);
+extern boolean HostSimIrq_IsCpuSleeping(void);
+extern void HostSimIrq_WaitForInterrupt(void);
+
+/*Virtual STM clock*/
+extern void HostSimStm_Init(void);
+extern uint64 HostSimStm_Now(void);
+extern void HostSimStm_Set(uint64 ullTicks);
+extern uint64 HostSimStm_NextEvent(uint64 ullLimit);
+extern void HostSimStm_Fire(void);
+
+/*Drivetrain plant*/
+extern void HostSimPlant_Init(void);
+extern boolean HostSimPlant_SetParam(const char *pName, double dValue);
+extern uint64 HostSimPlant_Run(uint64 ullUntil);
+extern uint64 HostSimPlant_NextAdcEvent(uint64 ullLimit);
+extern double HostSimPlant_GetRpm(uint32 ulWheel);
+extern void HostSimPlant_Report(void);
+
+/*VADC trigger scan and its DMA channel*/
+extern void HostSimAdc_Init(void);
+extern uint32 HostSimAdc_GetTrigTicks(void);
+extern void HostSimAdc_Convert(const double *pdChV, uint64 ullNow);
+extern uint64 HostSimAdc_NextEvent(uint64 ullLimit, uint64 ullNextTrig, uint64 ullPeriod);
+extern boolean HostSimAdc_Fire(uint64 ullNow);
+extern void HostSimAdc_Report(void);
+
+#endif
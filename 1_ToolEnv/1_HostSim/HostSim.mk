@@ -0,0 +1,165 @@
+##################################################################
+#											                     #
+# 				  Host Sim Config Version 1.0.0 		         #
+#                                                                #
+##################################################################
+#-----------------------------------------------------------------
+#		Host native simulation build (x86-64 Linux, gcc)
+#		The firmware and the used iLLD drivers are built unchanged,
+#		SFRs are backed by an emulated register file (HostSimSfr.c)
+#-----------------------------------------------------------------
+HOSTSIM_CC			= gcc
+HOSTSIM_LD			= gcc
+
+HOSTSIM_DIR			= ./1_ToolEnv/1_HostSim
+HOSTSIM_OUT_DIR		= ./Debug/HostSim
+HOSTSIM_OBJ_DIR		= $(HOSTSIM_OUT_DIR)/Obj
+HOSTSIM_TARGET		= $(HOSTSIM_OUT_DIR)/$(TARGET)_sim
+
+#-----------------------------------------------------------------
+#		Gcc compiler option
+#-----------------------------------------------------------------
+HOSTSIM_CFLAGS		= -DIFX_HOST_SIM
+HOSTSIM_CFLAGS		+= -g
+HOSTSIM_CFLAGS		+= -O1
+HOSTSIM_CFLAGS		+= -fno-common
+HOSTSIM_CFLAGS		+= -fno-pie
+HOSTSIM_CFLAGS		+= -fno-strict-aliasing
+HOSTSIM_CFLAGS		+= -fstrict-volatile-bitfields
+HOSTSIM_CFLAGS		+= -ffunction-sections
+HOSTSIM_CFLAGS		+= -fdata-sections
+HOSTSIM_CFLAGS		+= -pthread
+HOSTSIM_CFLAGS		+= -MMD -MP
+HOSTSIM_CFLAGS		+= -Wall
+HOSTSIM_CFLAGS		+= -Wno-pointer-to-int-cast
+HOSTSIM_CFLAGS		+= -Wno-int-to-pointer-cast
+HOSTSIM_CFLAGS		+= -Wno-address-of-packed-member
+HOSTSIM_CFLAGS		+= -std=gnu99
+HOSTSIM_CFLAGS		+= -fgnu89-inline
+HOSTSIM_CFLAGS		+= -I$(HOSTSIM_DIR)
+HOSTSIM_CFLAGS		+= $(patsubst %,-I%,$(INCLUDE))
+
+#-----------------------------------------------------------------
+#		Gcc Linker option
+#		-no-pie keeps all firmware objects below 4GB, the iLLD
+#		stores addresses in uint32 in several places
+#-----------------------------------------------------------------
+HOSTSIM_LDFLAGS		= -no-pie
+HOSTSIM_LDFLAGS		+= -pthread
+HOSTSIM_LDFLAGS		+= -Wl,--gc-sections
+HOSTSIM_LIBS		= -lm
+
+#-----------------------------------------------------------------
+#		iLLD Source files used by the firmware
+#-----------------------------------------------------------------
+HOSTSIM_ILLD_SOURCE		+= 	IfxCpu_cfg.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxCpu_Irq.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxCpu.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxPort_cfg.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxPort_PinMap.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxPort.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxScu_cfg.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxScuCcu.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxScuWdt.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxStm_cfg.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxStm.c
+HOSTSIM_ILLD_SOURCE		+= 	Bsp.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxSrc_cfg.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxSrc.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxVadc_cfg.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxVadc_PinMap.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxVadc_Adc.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxVadc.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxAsclin_cfg.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxAsclin_PinMap.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxAsclin_Asc.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxAsclin.c
+HOSTSIM_ILLD_SOURCE		+= 	Ifx_Fifo.c
+HOSTSIM_ILLD_SOURCE		+= 	Ifx_CircularBuffer.c
+HOSTSIM_ILLD_SOURCE		+= 	Ifx_LowPassPt1F32.c
+HOSTSIM_ILLD_SOURCE		+= 	Ifx_LutSincosF32.c
+HOSTSIM_ILLD_SOURCE		+= 	Ifx_LutSincosF32_Table.c
+HOSTSIM_ILLD_SOURCE		+= 	Ifx_RampF32.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxStdIf_DPipe.c
+HOSTSIM_ILLD_SOURCE		+= 	Assert.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxGtm_cfg.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxGtm_PinMap.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxGtm.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxGtm_Cmu.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxGtm_Dpll.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxGtm_Tim.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxGtm_Tom.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxGtm_Tom_Timer.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxGtm_Tom_PwmHl.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxGtm_Trig.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxStdIf_PwmHl.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxStdIf_Timer.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxQspi_cfg.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxQspi_PinMap.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxQspi_SpiMaster.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxQspi.c
+HOSTSIM_ILLD_SOURCE		+= 	SpiIf.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxDma_cfg.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxDma_Dma.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxDma.c
+HOSTSIM_ILLD_SOURCE		+= 	IfxScu_PinMap.c
+
+#-----------------------------------------------------------------
+#		Host Sim Source files
+#-----------------------------------------------------------------
+HOSTSIM_SOURCE			+= 	HostSimMain.c
+HOSTSIM_SOURCE			+= 	HostSimSfr.c
+HOSTSIM_SOURCE			+= 	HostSimIrq.c
+HOSTSIM_SOURCE			+= 	HostSimStm.c
+HOSTSIM_SOURCE			+= 	HostSimPlant.c
+HOSTSIM_SOURCE			+= 	HostSimAdc.c
+
+HOSTSIM_ALL_SOURCE		= $(APP_SOURCE) $(HOSTSIM_ILLD_SOURCE) $(HOSTSIM_SOURCE)
+HOSTSIM_OBJECTS			= $(addprefix $(HOSTSIM_OBJ_DIR)/, $(addsuffix .o, $(basename $(notdir $(HOSTSIM_ALL_SOURCE)))))
+
+#-----------------------------------------------------------------
+#		Define Rules (make objects)
+#-----------------------------------------------------------------
+vpath %.c $(HOSTSIM_DIR)
+
+# The firmware entry point is started by the simulator on its own thread
+$(HOSTSIM_OBJ_DIR)/Main.o: HOSTSIM_CFLAGS += -Dmain=HostSim_FirmwareMain
+
+# Vendor sources kept as delivered, warnings of the host compiler only:
+# TFT demo '#pragma section' places data for the TriCore linker
+HOSTSIM_TFT_PRAGMA_OBJ	= Qspi0.o conio_tft.o fifo.o libtft_ascii.o libtft_graphics.o tfthw.o touch.o
+HOSTSIM_TFT_PRAGMA_OBJ	+= Perf_Meas.o background_light.o tft_app.o
+$(addprefix $(HOSTSIM_OBJ_DIR)/, $(HOSTSIM_TFT_PRAGMA_OBJ)): HOSTSIM_CFLAGS += -Wno-unknown-pragmas
+# Three key labels are a UTF-8 U+FFFD, the char keeps its last byte as on the target
+$(HOSTSIM_OBJ_DIR)/keyboard.o: HOSTSIM_CFLAGS += -Wno-multichar -Wno-overflow
+# Unbraced if of the TFT demo, the indentation only
+$(HOSTSIM_OBJ_DIR)/menu.o: HOSTSIM_CFLAGS += -Wno-misleading-indentation
+# iLLD error flag checks compare a masked bit with 1
+$(HOSTSIM_OBJ_DIR)/IfxQspi_SpiMaster.o: HOSTSIM_CFLAGS += -Wno-tautological-compare
+# TestCnt2 of the original UART test code, never used
+$(HOSTSIM_OBJ_DIR)/DrvAsc.o: HOSTSIM_CFLAGS += -Wno-unused-variable
+
+$(HOSTSIM_OBJ_DIR)/%.o: %.c
+	@$(HOSTSIM_CC) -c -o $@ $(HOSTSIM_CFLAGS) $<
+	@echo $(notdir $@)
+
+#-----------------------------------------------------------------
+#		Build targets
+#-----------------------------------------------------------------
+.PHONY: host-sim host-sim-dir host-sim-clean
+
+host-sim: host-sim-dir $(HOSTSIM_TARGET)
+
+host-sim-dir:
+	@if test ! -d $(HOSTSIM_OBJ_DIR); then mkdir -p $(HOSTSIM_OBJ_DIR);fi
+
+$(HOSTSIM_TARGET): $(HOSTSIM_OBJECTS)
+	@echo /****Host Sim Linking Start****/
+	@$(HOSTSIM_LD) -o $@ $^ $(HOSTSIM_LDFLAGS) $(HOSTSIM_LIBS)
+	@echo /****Host Sim Linking Success****/
+
+host-sim-clean:
+	@if test -d $(HOSTSIM_OUT_DIR); then rm -r $(HOSTSIM_OUT_DIR);fi
+
+# Header dependencies written by -MMD
+-include $(HOSTSIM_OBJECTS:.o=.d)
@@ -0,0 +1,358 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "HostSim.h"
+#include "IfxGtm_reg.h"
+#include "IfxVadc_reg.h"
+#include "IfxDma_reg.h"
+#include "IfxSrc_reg.h"
+#include "IfxSrc_cfg.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * GTM ADC trigger 1 -> VADC group 0 scan -> DMA, as set up by the registers.
+ * The plant calls HostSimAdc_Convert at the rising edge of TOM1 CH8 when it
+ * is routed to the group (ADCTRIG1OUT0.SEL0). A scan triggered by REQTR0J
+ * converts every selected channel into its RES, the result events with SRGEN
+ * request SRC_VADCG0SR0; with TOS = DMA its SRPN is the DMA channel that
+ * makes one transfer (circular buffers and address increment of ADICR).
+ * When TCOUNT reaches IRDV the channel interrupt is raised once the scan is
+ * done, HOSTSIM_ADC_SCAN_TICKS after the trigger: the ISR then sees the
+ * conversion latency of the target, not the one of the host.
+ * The limit check of a channel (CHEVMODE, band of BNDSELL/BNDSELU) sets its
+ * CEFLAG bit and requests the group node of CEVNP0 once the channel is
+ * converted, the channels going from the highest down. The events of a scan
+ * are raised together at the first one. CEFCLR is applied at the next scan.
+ * Only what the firmware uses is modelled: one scan source, 32 bit moves,
+ * positive increments, threshold interrupt.
+ */
+#define HOSTSIM_ADC_TRIG_SEL            8u          /*ADCTRIG1OUT0.SEL0 of TOM1 CH8, IfxGtm_Trig_toVadc*/
+#define HOSTSIM_ADC_XTSEL_GTM           9u          /*REQTR0J : GTM ADC trigger 1*/
+#define HOSTSIM_ADC_CH_NUMBER           8u
+#define HOSTSIM_ADC_REF_V               5.0
+#define HOSTSIM_ADC_FULL_SCALE          4095u
+#define HOSTSIM_ADC_CONV_TICKS          100u        /*1us per channel: sample, 12 bit conversion, arbitration*/
+#define HOSTSIM_ADC_SCAN_TICKS          (5u * HOSTSIM_ADC_CONV_TICKS)
+#define HOSTSIM_ADC_DMA_CH_NUMBER       16u
+#define HOSTSIM_ADC_SFR_BASE            0xF0000000u
+#define HOSTSIM_ADC_INTCT_THRESHOLD     2u          /*ADICR.INTCT : enabled (bit 1), on TCOUNT == IRDV (bit 0 clear)*/
+#define HOSTSIM_ADC_CHEV_IN_BAND        1u          /*CHCTR.CHEVMODE*/
+#define HOSTSIM_ADC_CHEV_OUT_BAND       2u
+#define HOSTSIM_ADC_CHEV_ALWAYS         3u
+#define HOSTSIM_ADC_GROUP_NODE_NUMBER   4u          /*CEVNP0 values of SRC_VADCG0SR0..3*/
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static void HostSimAdc_DmaTransfer(uint32 ulCh, uint64 ullNow);
+static volatile uint32 *HostSimAdc_Word(uint32 ulAddr);
+static uint32 HostSimAdc_Next(uint32 ulAddr, uint32 ulCbl, boolean bCircular);
+static boolean HostSimAdc_LimitEvent(volatile Ifx_VADC_G *pG, uint32 ulCh, uint32 ulCnt);
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static const uint32 ulAdcBlockMoves[8] = {1u, 2u, 4u, 8u, 16u, 3u, 5u, 9u};   /*CHCFGR.BLKM*/
+
+static uint64 ullAdcIrqTime = 0u;               /*Channel interrupt to raise, 0 if none*/
+static uint32 ulAdcIrqCh = 0u;
+static uint64 ullAdcScanCnt = 0u;
+static uint64 ullAdcTransferCnt = 0u;
+static uint64 ullAdcIrqCnt = 0u;
+static uint64 ullAdcLimitTime = 0u;             /*Channel events to raise, 0 if none*/
+static uint32 ulAdcLimitMask = 0u;              /*Their channels*/
+static uint64 ullAdcLimitCnt = 0u;
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void HostSimAdc_Init(void)
+{
+    ullAdcIrqTime     = 0u;
+    ullAdcScanCnt     = 0u;
+    ullAdcTransferCnt = 0u;
+    ullAdcIrqCnt      = 0u;
+    ullAdcLimitTime   = 0u;
+    ulAdcLimitMask    = 0u;
+    ullAdcLimitCnt    = 0u;
+}
+
+/*---------------------Trigger--------------------------*/
+/*Position of the trigger edge in the PWM period, 0 while nothing is routed to group 0*/
+uint32 HostSimAdc_GetTrigTicks(void)
+{
+    uint32 ulSel = HOSTSIM_SFR_OF(GTM_ADCTRIG1OUT0).B.SEL0;
+    uint32 ulCm0 = HOSTSIM_SFR_OF(GTM_TOM1_CH8_CM0).U;
+    uint32 ulCm1 = HOSTSIM_SFR_OF(GTM_TOM1_CH8_CM1).U;
+
+    return ((ulSel == HOSTSIM_ADC_TRIG_SEL) && (ulCm1 != 0u) && (ulCm1 < ulCm0)) ? ulCm1 : 0u;
+}
+
+/*
+ * Trigger edge at ullNow with pdChV[] volts on the channels of group 0. The
+ * channel interrupt, if any, is left for HostSimAdc_Fire.
+ */
+void HostSimAdc_Convert(const double *pdChV, uint64 ullNow)
+{
+    volatile Ifx_VADC_G *pG = &HOSTSIM_SFR_OF(MODULE_VADC).G[0];
+    volatile Ifx_SRC_SRCR *pSrc = &HOSTSIM_SFR_OF(SRC_VADCG0SR0);
+    uint32 ulSel = pG->ASSEL.U;
+    boolean bEvent = FALSE;
+    uint32 ulConv = 0u;
+    uint32 ulCh;
+
+    if((pG->ASMR.B.ENTR == 0u) || (pG->ASCTRL.B.XTSEL != HOSTSIM_ADC_XTSEL_GTM) || (ulSel == 0u))
+    {
+        return;
+    }
+
+    ullAdcScanCnt++;
+    pG->CEFLAG.U &= ~pG->CEFCLR.U;
+    pG->CEFCLR.U  = 0u;
+
+    for(ulCh = HOSTSIM_ADC_CH_NUMBER; ulCh-- > 0u;)
+    {
+        uint32 ulRes = pG->CHCTR[ulCh].B.RESREG;
+        double dCnt = (pdChV[ulCh] * (double)(HOSTSIM_ADC_FULL_SCALE + 1u)) / HOSTSIM_ADC_REF_V;
+        uint32 ulCnt;
+
+        if((ulSel & (0x1u << ulCh)) == 0u)
+        {
+            continue;
+        }
+
+        dCnt  = (dCnt > 0.0) ? dCnt : 0.0;
+        ulCnt = (dCnt < (double)HOSTSIM_ADC_FULL_SCALE) ? (uint32)dCnt : HOSTSIM_ADC_FULL_SCALE;
+
+        pG->RES[ulRes].U = 0x80000000u | (ulCh << 20) | ulCnt;      /*VF, CHNR, RESULT*/
+        bEvent = (pG->RCR[ulRes].B.SRGEN != 0u) ? TRUE : bEvent;
+        ulConv++;
+
+        if(HostSimAdc_LimitEvent(pG, ulCh, ulCnt) != FALSE)
+        {
+            ullAdcLimitTime = (ullAdcLimitTime == 0u) ? (ullNow + ((uint64)ulConv * HOSTSIM_ADC_CONV_TICKS)) : ullAdcLimitTime;
+            ulAdcLimitMask |= 0x1u << ulCh;
+        }
+    }
+
+    /*Result event on node 0 of the group routed to the DMA*/
+    if((bEvent != FALSE) && (pSrc->B.SRE != 0u) && (pSrc->B.TOS == (uint32)IfxSrc_Tos_dma) &&
+       (pSrc->B.SRPN < HOSTSIM_ADC_DMA_CH_NUMBER))
+    {
+        HostSimAdc_DmaTransfer(pSrc->B.SRPN, ullNow);
+    }
+}
+
+/*
+ * Time of the next channel interrupt: the pending one, else the scan end of
+ * the trigger that brings the running transaction to IRDV. ullNextTrig is the
+ * next trigger edge of the plant, ullPeriod the PWM period.
+ */
+uint64 HostSimAdc_NextEvent(uint64 ullLimit, uint64 ullNextTrig, uint64 ullPeriod)
+{
+    volatile Ifx_SRC_SRCR *pSrc = &HOSTSIM_SFR_OF(SRC_VADCG0SR0);
+    volatile Ifx_DMA_CH *pCh;
+    uint64 ullNext;
+    uint32 ulLeft;
+
+    if((ullAdcLimitTime != 0u) && (ullAdcLimitTime < ullLimit))
+    {
+        ullLimit = ullAdcLimitTime;
+    }
+
+    if(ullAdcIrqTime != 0u)
+    {
+        return (ullAdcIrqTime < ullLimit) ? ullAdcIrqTime : ullLimit;
+    }
+
+    if((ullNextTrig == 0u) || (pSrc->B.SRE == 0u) || (pSrc->B.TOS != (uint32)IfxSrc_Tos_dma) ||
+       (pSrc->B.SRPN >= HOSTSIM_ADC_DMA_CH_NUMBER))
+    {
+        return ullLimit;
+    }
+
+    pCh = &HOSTSIM_SFR_OF(MODULE_DMA).CH[pSrc->B.SRPN];
+
+    if((HOSTSIM_SFR_OF(MODULE_DMA).TSR[pSrc->B.SRPN].B.ECH == 0u) || (pCh->ADICR.B.INTCT != HOSTSIM_ADC_INTCT_THRESHOLD))
+    {
+        return ullLimit;
+    }
+
+    ulLeft = (pCh->CHCSR.B.TCOUNT != 0u) ? pCh->CHCSR.B.TCOUNT : pCh->CHCFGR.B.TREL;
+
+    if(ulLeft <= pCh->ADICR.B.IRDV)
+    {
+        return ullLimit;
+    }
+
+    ullNext = ullNextTrig + ((uint64)(ulLeft - pCh->ADICR.B.IRDV - 1u) * ullPeriod) + HOSTSIM_ADC_SCAN_TICKS;
+
+    return (ullNext < ullLimit) ? ullNext : ullLimit;
+}
+
+/*Raises the channel events and the DMA channel interrupt once their time is reached, TRUE if one was raised*/
+boolean HostSimAdc_Fire(uint64 ullNow)
+{
+    volatile Ifx_VADC_G *pG = &HOSTSIM_SFR_OF(MODULE_VADC).G[0];
+    boolean bRaised = FALSE;
+    uint32 ulCh;
+
+    if((ullAdcLimitTime != 0u) && (ullAdcLimitTime <= ullNow))
+    {
+        for(ulCh = 0u; ulCh < HOSTSIM_ADC_CH_NUMBER; ulCh++)
+        {
+            uint32 ulNode = (pG->CEVNP0.U >> (4u * ulCh)) & 0xFu;
+
+            if(((ulAdcLimitMask >> ulCh) & 0x1u) == 0u)
+            {
+                continue;
+            }
+
+            pG->CEFLAG.U |= 0x1u << ulCh;
+            ullAdcLimitCnt++;
+
+            if((ulNode < HOSTSIM_ADC_GROUP_NODE_NUMBER) && ((&HOSTSIM_SFR_OF(SRC_VADCG0SR0))[ulNode].B.SRE != 0u) &&
+               ((&HOSTSIM_SFR_OF(SRC_VADCG0SR0))[ulNode].B.TOS == (uint32)IfxSrc_Tos_cpu0))
+            {
+                HostSimIrq_Raise(&(&SRC_VADCG0SR0)[ulNode]);
+                bRaised = TRUE;
+            }
+        }
+
+        ullAdcLimitTime = 0u;
+        ulAdcLimitMask  = 0u;
+    }
+
+    if((ullAdcIrqTime != 0u) && (ullAdcIrqTime <= ullNow))
+    {
+        ullAdcIrqTime = 0u;
+        ullAdcIrqCnt++;
+        HOSTSIM_SFR_OF(MODULE_DMA).CH[ulAdcIrqCh].CHCSR.B.ICH = 1u;
+        HostSimIrq_Raise(&(&SRC_DMACH0)[ulAdcIrqCh]);
+        bRaised = TRUE;
+    }
+
+    return bRaised;
+}
+
+void HostSimAdc_Report(void)
+{
+    if(ullAdcScanCnt != 0u)
+    {
+        printf("adc: scans %llu  dma transfers %llu  interrupts %llu  limit events %llu\n",
+               (unsigned long long)ullAdcScanCnt, (unsigned long long)ullAdcTransferCnt, (unsigned long long)ullAdcIrqCnt,
+               (unsigned long long)ullAdcLimitCnt);
+    }
+}
+
+/*---------------------Static Function--------------------------*/
+/*One transfer of the channel, a new transaction from TREL once the last one ended*/
+static void HostSimAdc_DmaTransfer(uint32 ulCh, uint64 ullNow)
+{
+    volatile Ifx_DMA_CH *pCh = &HOSTSIM_SFR_OF(MODULE_DMA).CH[ulCh];
+    uint32 ulSrc = pCh->SADR.U;
+    uint32 ulDst = pCh->DADR.U;
+    uint32 ulMoves = ulAdcBlockMoves[pCh->CHCFGR.B.BLKM];
+    uint32 ulCount = pCh->CHCSR.B.TCOUNT;
+    uint32 ulMove;
+
+    if((HOSTSIM_SFR_OF(MODULE_DMA).TSR[ulCh].B.ECH == 0u) || (pCh->CHCFGR.B.CHDW != 2u))
+    {
+        return;
+    }
+
+    if(ulCount == 0u)
+    {
+        ulCount = pCh->CHCFGR.B.TREL;
+    }
+
+    for(ulMove = 0u; ulMove < ulMoves; ulMove++)
+    {
+        *HostSimAdc_Word(ulDst) = *HostSimAdc_Word(ulSrc);
+
+        ulSrc = HostSimAdc_Next(ulSrc, pCh->ADICR.B.CBLS, pCh->ADICR.B.SCBE);
+        ulDst = HostSimAdc_Next(ulDst, pCh->ADICR.B.CBLD, pCh->ADICR.B.DCBE);
+    }
+
+    pCh->SADR.U = ulSrc;
+    pCh->DADR.U = ulDst;
+    ulCount--;
+    pCh->CHCSR.B.TCOUNT = ulCount;
+    ullAdcTransferCnt++;
+
+    if((pCh->ADICR.B.INTCT == HOSTSIM_ADC_INTCT_THRESHOLD) && (ulCount == pCh->ADICR.B.IRDV))
+    {
+        ullAdcIrqTime = ullNow + HOSTSIM_ADC_SCAN_TICKS;
+        ulAdcIrqCh    = ulCh;
+    }
+}
+
+/*SFRs through the backdoor, RAM of the firmware is host memory below 4GB*/
+static volatile uint32 *HostSimAdc_Word(uint32 ulAddr)
+{
+    if(ulAddr >= HOSTSIM_ADC_SFR_BASE)
+    {
+        return (volatile uint32 *)HostSimSfr_Backdoor(ulAddr);
+    }
+
+    return (volatile uint32 *)(size_t)ulAddr;
+}
+
+/*Address after a 32 bit move: the low CBL bits wrap in a circular buffer*/
+static uint32 HostSimAdc_Next(uint32 ulAddr, uint32 ulCbl, boolean bCircular)
+{
+    uint32 ulMask = (0x1u << ulCbl) - 1u;
+
+    if(bCircular == FALSE)
+    {
+        return ulAddr + 4u;
+    }
+
+    return (ulAddr & ~ulMask) | ((ulAddr + 4u) & ulMask);
+}
+
+/*Result ulCnt of the channel against its band: event of CHEVMODE*/
+static boolean HostSimAdc_LimitEvent(volatile Ifx_VADC_G *pG, uint32 ulCh, uint32 ulCnt)
+{
+    const volatile Ifx_VADC *pVadc = &HOSTSIM_SFR_OF(MODULE_VADC);
+    uint32 ulMode = pG->CHCTR[ulCh].B.CHEVMODE;
+    uint32 ulBound[4];
+    uint32 ulLower;
+    uint32 ulUpper;
+    boolean bInside;
+
+    ulBound[0] = pG->BOUND.B.BOUNDARY0;
+    ulBound[1] = pG->BOUND.B.BOUNDARY1;
+    ulBound[2] = pVadc->GLOBBOUND.B.BOUNDARY0;
+    ulBound[3] = pVadc->GLOBBOUND.B.BOUNDARY1;
+    ulLower = ulBound[pG->CHCTR[ulCh].B.BNDSELL];
+    ulUpper = ulBound[pG->CHCTR[ulCh].B.BNDSELU];
+    bInside = ((ulCnt >= ulLower) && (ulCnt <= ulUpper)) ? TRUE : FALSE;
+
+    if(ulMode == HOSTSIM_ADC_CHEV_IN_BAND)
+    {
+        return bInside;
+    }
+    else if(ulMode == HOSTSIM_ADC_CHEV_OUT_BAND)
+    {
+        return (bInside == FALSE) ? TRUE : FALSE;
+    }
+    else if(ulMode == HOSTSIM_ADC_CHEV_ALWAYS)
+    {
+        return TRUE;
+    }
+    else
+    {
+        return FALSE;
+    }
+}
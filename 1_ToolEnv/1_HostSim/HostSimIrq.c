@@ -0,0 +1,453 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "HostSim.h"
+#include "IfxCpu_reg.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * The interrupt router of CPU0. The simulator thread raises service requests
+ * and kicks the firmware thread with SIGUSR1; the arbitration and the ISR
+ * call run on the firmware thread inside the signal handler, so an ISR
+ * preempts the background loop like on the target.
+ */
+#define HOSTSIM_IRQ_SIGNAL              SIGUSR1
+#define HOSTSIM_SRC_BASE                0xF0038000u
+#define HOSTSIM_SRC_SIZE                0x2000u
+
+#define HOSTSIM_SRC_SRPN_MASK           0x000000FFu
+#define HOSTSIM_SRC_SRE                 0x00000400u
+#define HOSTSIM_SRC_TOS                 0x00000800u
+#define HOSTSIM_SRC_SRR                 0x01000000u
+#define HOSTSIM_SRC_CLRR                0x02000000u
+#define HOSTSIM_SRC_SETR                0x04000000u
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef void (*HostSimIrq_IsrFnc)(void);
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static uint32 HostSimIrq_ApplyRequestBits(volatile uint32 *pulSrc);
+static uint32 HostSimIrq_Arbitrate(boolean bAcknowledge);
+static void HostSimIrq_Dispatch(void);
+static void HostSimIrq_Resume(void);
+static void HostSimIrq_SignalHandler(int sig);
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static HostSimIrq_IsrFnc pIrqIsrTable[HOSTSIM_IRQ_PRIO_NUMBER];
+static HostSimIrq_Stat stIrqStat[HOSTSIM_IRQ_PRIO_NUMBER];
+static volatile uint64 ullIrqRequestTime[HOSTSIM_IRQ_PRIO_NUMBER];
+
+static pthread_t stIrqCpuThread;
+static volatile uint32 ulIrqCpuAttached = 0u;
+static volatile uint32 ulIrqSignalPending = 0u;
+static volatile uint32 ulIrqArbitrating = 0u;
+static volatile uint32 ulIrqRepoll = 0u;
+static volatile uint32 ulIrqActiveDepth = 0u;
+static volatile uint32 ulIrqDeferred = 0u;  /*A request was held back by ICR.IE = 0*/
+static volatile uint32 ulIrqEnabledOnce = 0u;
+static volatile uint32 ulIrqCpuSleeping = 0u;  /*Idle mode requested, left with the next interrupt*/
+static sem_t stIrqDoneSem;                  /*Posted when the CPU ran out of ISRs to take*/
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void HostSimIrq_Init(void)
+{
+    struct sigaction stAction;
+
+    sem_init(&stIrqDoneSem, 0, 0u);
+
+    memset(&stAction, 0, sizeof(stAction));
+    stAction.sa_handler = HostSimIrq_SignalHandler;
+    stAction.sa_flags   = SA_NODEFER | SA_RESTART;
+    sigaction(HOSTSIM_IRQ_SIGNAL, &stAction, NULL);
+}
+
+/*Called on the firmware thread before the firmware entry point*/
+void HostSimIrq_AttachCpu(void)
+{
+    stIrqCpuThread = pthread_self();
+    __atomic_store_n(&ulIrqCpuAttached, 1u, __ATOMIC_RELEASE);
+}
+
+/*Filled by IFX_INTERRUPT() before main()*/
+void HostSimIrq_RegisterIsr(void (*isr)(void), unsigned int vectabNum, unsigned int prio)
+{
+    (void)vectabNum;
+
+    if((prio == 0u) || (prio >= HOSTSIM_IRQ_PRIO_NUMBER) || (pIrqIsrTable[prio] != NULL_PTR))
+    {
+        fprintf(stderr, "hostsim: invalid or duplicated interrupt priority %u\n", prio);
+        return;
+    }
+
+    pIrqIsrTable[prio] = isr;
+}
+
+/*---------------------Simulator Thread API--------------------------*/
+void HostSimIrq_Raise(volatile Ifx_SRC_SRCR *pSrc)
+{
+    volatile Ifx_SRC_SRCR *pBackdoor = &HOSTSIM_SFR(Ifx_SRC_SRCR, (size_t)pSrc);
+    uint32 ulPrio = HostSimIrq_ApplyRequestBits(&pBackdoor->U) & HOSTSIM_SRC_SRPN_MASK;
+
+    ullIrqRequestTime[ulPrio] = HostSimStm_Now();
+    __atomic_or_fetch(&pBackdoor->U, HOSTSIM_SRC_SRR, __ATOMIC_SEQ_CST);
+
+    HostSimIrq_Poll();
+}
+
+/*Kick the firmware thread when an enabled request can be taken, or wakes it up*/
+void HostSimIrq_Poll(void)
+{
+    if((__atomic_load_n(&ulIrqCpuAttached, __ATOMIC_ACQUIRE) != 0u) &&
+       (__atomic_load_n(&ulIrqSignalPending, __ATOMIC_ACQUIRE) == 0u) &&
+       ((HostSimIrq_Arbitrate(FALSE) != 0u) ||
+        ((__atomic_load_n(&ulIrqCpuSleeping, __ATOMIC_ACQUIRE) != 0u) &&
+         (__atomic_load_n(&ulIrqDeferred, __ATOMIC_ACQUIRE) != 0u))))
+    {
+        __atomic_store_n(&ulIrqSignalPending, 1u, __ATOMIC_RELEASE);
+        pthread_kill(stIrqCpuThread, HOSTSIM_IRQ_SIGNAL);
+    }
+}
+
+/*
+ * No request to take and the CPU either in the background loop or in an ISR
+ * that enabled the interrupts again: such an ISR runs in virtual time like the
+ * background loop, so it can be preempted by the next timer event.
+ * A request held back by a critical section of the firmware (ICR.IE = 0 after
+ * the first enable) keeps the time still, like the ISRs it takes no time.
+ */
+boolean HostSimIrq_IsIdle(void)
+{
+    return (boolean)(((__atomic_load_n(&ulIrqActiveDepth, __ATOMIC_ACQUIRE) == 0u) ||
+                      (HOSTSIM_SFR_OF(CPU0_ICR).B.IE != 0u)) &&
+                     (__atomic_load_n(&ulIrqSignalPending, __ATOMIC_ACQUIRE) == 0u) &&
+                     (HostSimIrq_Arbitrate(FALSE) == 0u) &&
+                     ((__atomic_load_n(&ulIrqDeferred, __ATOMIC_ACQUIRE) == 0u) ||
+                      (__atomic_load_n(&ulIrqEnabledOnce, __ATOMIC_ACQUIRE) == 0u)));
+}
+
+/*Block the simulator thread until the firmware thread left its ISRs*/
+boolean HostSimIrq_WaitIdle(uint32 ulTimeoutUs)
+{
+    struct timespec stTimeout;
+
+    for(;;)
+    {
+        HostSimIrq_Poll();
+
+        if(HostSimIrq_IsIdle() != FALSE)
+        {
+            return TRUE;
+        }
+
+        clock_gettime(CLOCK_REALTIME, &stTimeout);
+        stTimeout.tv_nsec += (long)ulTimeoutUs * 1000l;
+        stTimeout.tv_sec  += stTimeout.tv_nsec / 1000000000l;
+        stTimeout.tv_nsec %= 1000000000l;
+
+        if(sem_timedwait(&stIrqDoneSem, &stTimeout) != 0)
+        {
+            return HostSimIrq_IsIdle();
+        }
+    }
+}
+
+boolean HostSimIrq_IsCpuSleeping(void)
+{
+    return (boolean)(__atomic_load_n(&ulIrqCpuSleeping, __ATOMIC_ACQUIRE) != 0u);
+}
+
+uint64 HostSimIrq_GetIsrCount(uint32 ulPrio)
+{
+    return stIrqStat[ulPrio].ullIsrCount;
+}
+
+const HostSimIrq_Stat *HostSimIrq_GetStat(uint32 ulPrio)
+{
+    return &stIrqStat[ulPrio];
+}
+
+/*---------------------Firmware Thread API--------------------------*/
+void HostSimIrq_Enable(void)
+{
+    HOSTSIM_SFR_OF(CPU0_ICR).B.IE = 1u;
+    HostSimIrq_Resume();
+}
+
+void HostSimIrq_Disable(void)
+{
+    HOSTSIM_SFR_OF(CPU0_ICR).B.IE = 0u;
+}
+
+sint32 HostSimIrq_DisableAndSave(void)
+{
+    sint32 bEnabled = (sint32)HOSTSIM_SFR_OF(CPU0_ICR).B.IE;
+
+    HOSTSIM_SFR_OF(CPU0_ICR).B.IE = 0u;
+
+    return bEnabled;
+}
+
+void HostSimIrq_Restore(sint32 bEnabled)
+{
+    HOSTSIM_SFR_OF(CPU0_ICR).B.IE = (bEnabled != 0) ? 1u : 0u;
+
+    if(bEnabled != 0)
+    {
+        HostSimIrq_Resume();
+    }
+}
+
+void HostSimIrq_Bisr(uint32 ulPrio)
+{
+    HOSTSIM_SFR_OF(CPU0_ICR).B.CCPN = ulPrio;
+    HostSimIrq_Enable();
+}
+
+/*
+ * CPU idle mode (SCU PMCSR.REQSLP): block the firmware thread until an
+ * interrupt is taken, or a request is pending while ICR.IE = 0.
+ */
+void HostSimIrq_WaitForInterrupt(void)
+{
+    sigset_t stIrqMask;
+    sigset_t stOldMask;
+    sigset_t stWaitMask;
+    int lValue = 0;
+
+    sigemptyset(&stIrqMask);
+    sigaddset(&stIrqMask, HOSTSIM_IRQ_SIGNAL);
+    pthread_sigmask(SIG_BLOCK, &stIrqMask, &stOldMask);
+
+    __atomic_store_n(&ulIrqCpuSleeping, 1u, __ATOMIC_RELEASE);
+
+    /*A request raised meanwhile wakes the CPU at once*/
+    HostSimIrq_Poll();
+
+    if((sem_getvalue(&stIrqDoneSem, &lValue) == 0) && (lValue == 0))
+    {
+        sem_post(&stIrqDoneSem);
+    }
+
+    stWaitMask = stOldMask;
+    sigdelset(&stWaitMask, HOSTSIM_IRQ_SIGNAL);
+
+    while(__atomic_load_n(&ulIrqCpuSleeping, __ATOMIC_ACQUIRE) != 0u)
+    {
+        sigsuspend(&stWaitMask);
+    }
+
+    pthread_sigmask(SIG_SETMASK, &stOldMask, NULL);
+}
+
+/*---------------------Static Function--------------------------*/
+/*SETR and CLRR are write-only: move them to SRR, returns the new SRC value*/
+static uint32 HostSimIrq_ApplyRequestBits(volatile uint32 *pulSrc)
+{
+    uint32 ulSrc = *pulSrc;
+    uint32 ulNew;
+
+    do
+    {
+        if((ulSrc & (HOSTSIM_SRC_SETR | HOSTSIM_SRC_CLRR)) == 0u)
+        {
+            break;
+        }
+
+        ulNew = ulSrc & ~(HOSTSIM_SRC_SETR | HOSTSIM_SRC_CLRR);
+
+        if((ulSrc & HOSTSIM_SRC_CLRR) != 0u)
+        {
+            ulNew &= ~HOSTSIM_SRC_SRR;
+        }
+        else
+        {
+            ulNew |= HOSTSIM_SRC_SRR;
+            ullIrqRequestTime[ulSrc & HOSTSIM_SRC_SRPN_MASK] = HostSimStm_Now();
+        }
+    } while(__atomic_compare_exchange_n(pulSrc, &ulSrc, ulNew, FALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) == FALSE);
+
+    return *pulSrc;
+}
+
+/*
+ * Returns the SRPN of the highest pending request above ICR.CCPN, 0 if none.
+ * With bAcknowledge the winning request is cleared like on the target.
+ */
+static uint32 HostSimIrq_Arbitrate(boolean bAcknowledge)
+{
+    volatile uint32 *pulSrc = (volatile uint32 *)HostSimSfr_Backdoor(HOSTSIM_SRC_BASE);
+    volatile uint32 *pulWinner = NULL_PTR;
+    Ifx_CPU_ICR stIcr;
+    uint32 ulWinnerPrio = 0u;
+    uint32 ulIdx;
+
+    stIcr.U = HOSTSIM_SFR_OF(CPU0_ICR).U;
+
+    for(ulIdx = 0u; ulIdx < (HOSTSIM_SRC_SIZE / 4u); ulIdx++)
+    {
+        uint32 ulSrc = pulSrc[ulIdx];
+
+        if((ulSrc & (HOSTSIM_SRC_SETR | HOSTSIM_SRC_CLRR)) != 0u)
+        {
+            ulSrc = HostSimIrq_ApplyRequestBits(&pulSrc[ulIdx]);
+        }
+
+        if(((ulSrc & (HOSTSIM_SRC_SRE | HOSTSIM_SRC_SRR | HOSTSIM_SRC_TOS)) == (HOSTSIM_SRC_SRE | HOSTSIM_SRC_SRR)) &&
+           ((ulSrc & HOSTSIM_SRC_SRPN_MASK) > ulWinnerPrio))
+        {
+            ulWinnerPrio = ulSrc & HOSTSIM_SRC_SRPN_MASK;
+            pulWinner    = &pulSrc[ulIdx];
+        }
+    }
+
+    if(stIcr.B.IE == 0u)
+    {
+        if(ulWinnerPrio > stIcr.B.CCPN)
+        {
+            __atomic_store_n(&ulIrqDeferred, 1u, __ATOMIC_RELEASE);
+        }
+        return 0u;
+    }
+
+    /*Seen with IE = 1, nothing is held back any more*/
+    __atomic_store_n(&ulIrqDeferred, 0u, __ATOMIC_RELEASE);
+
+    if(ulWinnerPrio <= stIcr.B.CCPN)
+    {
+        return 0u;
+    }
+
+    if(bAcknowledge != FALSE)
+    {
+        __atomic_and_fetch(pulWinner, ~HOSTSIM_SRC_SRR, __ATOMIC_SEQ_CST);
+    }
+
+    return ulWinnerPrio;
+}
+
+static void HostSimIrq_Dispatch(void)
+{
+    if(ulIrqArbitrating != 0u)
+    {
+        /*Signal arrived while the interrupted context was arbitrating*/
+        ulIrqRepoll = 1u;
+        return;
+    }
+
+    for(;;)
+    {
+        Ifx_CPU_ICR stSavedIcr;
+        uint32 ulPrio;
+        uint64 ullLatency;
+
+        ulIrqArbitrating = 1u;
+        ulIrqRepoll = 0u;
+        ulPrio = HostSimIrq_Arbitrate(TRUE);
+        stSavedIcr.U = HOSTSIM_SFR_OF(CPU0_ICR).U;
+
+        if(ulPrio != 0u)
+        {
+            HOSTSIM_SFR_OF(CPU0_ICR).B.CCPN = ulPrio;
+            HOSTSIM_SFR_OF(CPU0_ICR).B.IE   = 0u;
+        }
+        ulIrqArbitrating = 0u;
+
+        if(ulPrio == 0u)
+        {
+            if(ulIrqRepoll != 0u)
+            {
+                continue;
+            }
+            break;
+        }
+
+        __atomic_store_n(&ulIrqCpuSleeping, 0u, __ATOMIC_RELEASE);
+
+        ullLatency = HostSimStm_Now() - ullIrqRequestTime[ulPrio];
+        stIrqStat[ulPrio].ullIsrCount++;
+        stIrqStat[ulPrio].ullLatencySum += ullLatency;
+        if(ullLatency > stIrqStat[ulPrio].ullLatencyMax)
+        {
+            stIrqStat[ulPrio].ullLatencyMax = ullLatency;
+        }
+
+        __atomic_add_fetch(&ulIrqActiveDepth, 1u, __ATOMIC_SEQ_CST);
+
+        if(pIrqIsrTable[ulPrio] != NULL_PTR)
+        {
+            pIrqIsrTable[ulPrio]();
+        }
+        else
+        {
+            fprintf(stderr, "hostsim: no ISR for priority %u\n", ulPrio);
+        }
+
+        /*RFE: restore the interrupted context*/
+        HOSTSIM_SFR_OF(CPU0_ICR).U = stSavedIcr.U;
+        __atomic_sub_fetch(&ulIrqActiveDepth, 1u, __ATOMIC_SEQ_CST);
+    }
+}
+
+/*
+ * ICR.IE set again by the firmware: take the requests held back meanwhile.
+ * Without one the SRC scan is skipped, the firmware toggles IE very often.
+ */
+static void HostSimIrq_Resume(void)
+{
+    __atomic_store_n(&ulIrqEnabledOnce, 1u, __ATOMIC_RELEASE);
+
+    if(__atomic_exchange_n(&ulIrqDeferred, 0u, __ATOMIC_ACQ_REL) != 0u)
+    {
+        HostSimIrq_Dispatch();
+    }
+
+    if(ulIrqActiveDepth != 0u)
+    {
+        int lValue = 0;
+
+        /*An ISR opened itself to preemption, the simulator may move time*/
+        if((sem_getvalue(&stIrqDoneSem, &lValue) == 0) && (lValue == 0))
+        {
+            sem_post(&stIrqDoneSem);
+        }
+    }
+}
+
+static void HostSimIrq_SignalHandler(int sig)
+{
+    (void)sig;
+
+    __atomic_store_n(&ulIrqSignalPending, 0u, __ATOMIC_RELEASE);
+    HostSimIrq_Dispatch();
+
+    if(__atomic_load_n(&ulIrqDeferred, __ATOMIC_ACQUIRE) != 0u)
+    {
+        /*Request held back by ICR.IE = 0 still ends the idle mode*/
+        __atomic_store_n(&ulIrqCpuSleeping, 0u, __ATOMIC_RELEASE);
+    }
+
+    if((ulIrqActiveDepth == 0u) || (HOSTSIM_SFR_OF(CPU0_ICR).B.IE != 0u))
+    {
+        sem_post(&stIrqDoneSem);
+    }
+}
@@ -0,0 +1,705 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sys/prctl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "HostSim.h"
+#include "IfxAsclin_reg.h"
+#include "IfxGtm_reg.h"
+#include "IfxPort_reg.h"
+#include "IfxCpu_reg.h"
+#include "MidStm.h"
+#include "Scheduler.h"
+#include "ExeTrace.h"
+#include "BgJob.h"
+#include "Rls.h"
+#include "DrvGtm.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * Host simulation entry point.
+ *
+ * The firmware main() runs unchanged on its own thread. This thread owns the
+ * virtual time: between two events (STM compare, injected UART byte, trace
+ * sample) the background loop gets a real-time slice of (delta / speed), then
+ * the STM is moved to the event and the requested ISRs run to completion
+ * before time moves again. ISRs therefore take no virtual time.
+ * Until the firmware enables the interrupts the first time (end of the
+ * initialisation) the clock runs at HOSTSIM_STARTUP_SPEED instead: trapped
+ * SFR accesses make the host init much slower than on the target.
+ * While the CPU is in idle mode nothing but an event can happen, so the time
+ * jumps straight to the next event.
+ * A byte written to ASCLIN0 TXDATA is printed once its line is complete and
+ * the TX interrupt follows one character time later (9600 baud, 8N1).
+ * The drivetrain plant (HostSimPlant.c) is moved along with the STM, it
+ * triggers the VADC scans and their DMA transfers (HostSimAdc.c); the DMA
+ * channel interrupt is an event like the STM compare. So is a limit event of
+ * the scan: the plant stops there and the time does not go further before
+ * its interrupt has run.
+ * With --flash the data flash is read from FILE at the start and written
+ * back at the end, as it would be kept over a power cycle.
+ *
+ * A scenario file has one entry per line, '#' starts a comment:
+ *   MS C            receive character C on ASCLIN0 at MS (as --uart MS:C)
+ *   end MS          simulated time (as --time-ms)
+ *   set NAME VALUE  plant parameter
+ *
+ * usage: TC237_SMARTCAR_sim [--time-ms N] [--speed X] [--trace-ms N] [--uart MS:C]... [--scenario FILE] [--exe-trace FILE] [--flash FILE]
+ */
+#define HOSTSIM_DEFAULT_TIME_MS         3000u
+#define HOSTSIM_DEFAULT_SPEED           1000.0
+#define HOSTSIM_STARTUP_SPEED           0.1
+#define HOSTSIM_UART_EVENT_NUMBER       64u
+#define HOSTSIM_SLICE_TICKS             (HOSTSIM_STM_TICKS_PER_MS/10u)  /*TIM refresh period while running*/
+#define HOSTSIM_SLICE_MIN_NS            20000ll                         /*Shortest real-time slice*/
+#define HOSTSIM_ISR_TIMEOUT_NS          2000000000ll
+#define HOSTSIM_ISR_POLL_US             100u
+#define HOSTSIM_UART_CHAR_TICKS         (HOSTSIM_STM_FREQ_HZ / 960u)    /*10 bits at 9600 baud*/
+#define HOSTSIM_UART_TX_EMPTY           0xFFFFFFFFu                     /*TXDATA value while no byte is pending*/
+#define HOSTSIM_UART_LINE_SIZE          256u
+#define HOSTSIM_SCENARIO_LINE_SIZE      256u
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef struct
+{
+    uint64 ullTime;                 /*STM ticks*/
+    uint8 ucData;
+}HostSim_UartEvent;
+
+typedef struct
+{
+    uint64 ullEndTime;
+    uint64 ullTraceTime;
+    double dSpeed;
+    HostSim_UartEvent stUart[HOSTSIM_UART_EVENT_NUMBER];
+    uint32 ulUartNumber;
+    const char *pExeTraceFile;
+    const char *pFlashFile;
+}HostSim_Config;
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static void HostSim_ParseArgs(int argc, char *argv[]);
+static void HostSim_LoadScenario(const char *pFile);
+static void HostSim_AddUart(uint64 ullTimeMs, uint8 ucData);
+static void *HostSim_FirmwareThread(void *pArg);
+static sint64 HostSim_RealTimeNs(void);
+static void HostSim_SleepUntil(sint64 llRealNs);
+static uint64 HostSim_RunUntil(uint64 ullTarget);
+static void HostSim_WaitIsrDone(void);
+static uint64 HostSim_MovePlant(uint64 ullTime);
+static void HostSim_InjectUart(uint8 ucData);
+static uint64 HostSim_NextEvent(uint64 ullLimit);
+static void HostSim_PollUartTx(void);
+static void HostSim_UartTxDone(void);
+static void HostSim_Trace(void);
+static void HostSim_Report(sint64 llRealNs);
+static void HostSim_SaveExeTrace(const char *pFile);
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+extern int HostSim_FirmwareMain(void);
+extern float32 fSenseMotorRpm[4];
+extern float32 fSenseMotorCurrent[4];
+extern float32 fSenseBatteryV;
+extern RlsBank stMotorRls;
+extern DrvGtmPwmStage stGtmPwmStage;
+extern uint32_t ulMotorOcTripCnt[4];
+
+static HostSim_Config stSimConfig =
+{
+    (uint64)HOSTSIM_DEFAULT_TIME_MS * HOSTSIM_STM_TICKS_PER_MS,
+    0u,
+    HOSTSIM_DEFAULT_SPEED,
+    {{0u, 0u}},
+    0u,
+    NULL,
+    NULL
+};
+
+static sint64 llSimRealStart;
+static uint64 ullSimStmStart;
+static boolean bSimStartup = TRUE;
+static uint64 ullSimIdleTicks = 0u;
+static uint64 ullSimUartTxTime = 0u;            /*End of the byte in transmission, 0 if none*/
+static char cSimUartLine[HOSTSIM_UART_LINE_SIZE];
+static uint32 ulSimUartLineLen = 0u;
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Main Function--------------------------*/
+int main(int argc, char *argv[])
+{
+    pthread_t stFirmware;
+    uint64 ullNextTrace = 0u;
+    uint32 ulUartIdx = 0u;
+    sint64 llRealStart;
+
+    HostSim_ParseArgs(argc, argv);
+
+    /*Short sleeps of this thread must not be rounded up by the kernel*/
+    (void)prctl(PR_SET_TIMERSLACK, 1ul, 0ul, 0ul, 0ul);
+
+    HostSimSfr_Init();
+
+    if(stSimConfig.pFlashFile != NULL)
+    {
+        HostSimSfr_LoadDflash(stSimConfig.pFlashFile);
+    }
+
+    HostSimIrq_Init();
+    HostSimStm_Init();
+    HostSimAdc_Init();
+    HostSimPlant_Init();
+    HOSTSIM_SFR_OF(MODULE_ASCLIN0).TXDATA.U = HOSTSIM_UART_TX_EMPTY;
+
+    llRealStart = HostSim_RealTimeNs();
+    llSimRealStart = llRealStart;
+    ullSimStmStart = 0u;
+
+    if(pthread_create(&stFirmware, NULL, HostSim_FirmwareThread, NULL) != 0)
+    {
+        perror("hostsim: firmware thread");
+        return 1;
+    }
+
+    while(HostSimStm_Now() < stSimConfig.ullEndTime)
+    {
+        uint64 ullLimit = stSimConfig.ullEndTime;
+        uint64 ullNext;
+
+        if((stSimConfig.ullTraceTime != 0u) && (ullNextTrace < ullLimit))
+        {
+            ullLimit = ullNextTrace;
+        }
+
+        if((ulUartIdx < stSimConfig.ulUartNumber) && (stSimConfig.stUart[ulUartIdx].ullTime < ullLimit))
+        {
+            ullLimit = stSimConfig.stUart[ulUartIdx].ullTime;
+        }
+
+        ullNext = HostSim_NextEvent(ullLimit);
+
+        ullNext = HostSim_RunUntil(ullNext);
+        ullNext = HostSim_MovePlant(ullNext);
+        HostSimStm_Set(ullNext);
+        HostSimStm_Fire();
+        HostSim_WaitIsrDone();
+
+        if(HostSimAdc_Fire(ullNext) != FALSE)
+        {
+            HostSim_WaitIsrDone();
+        }
+
+        HostSim_PollUartTx();
+
+        if((ullSimUartTxTime != 0u) && (ullSimUartTxTime <= ullNext))
+        {
+            HostSim_UartTxDone();
+        }
+
+        while((ulUartIdx < stSimConfig.ulUartNumber) && (stSimConfig.stUart[ulUartIdx].ullTime <= ullNext))
+        {
+            HostSim_InjectUart(stSimConfig.stUart[ulUartIdx].ucData);
+            ulUartIdx++;
+        }
+
+        if((stSimConfig.ullTraceTime != 0u) && (ullNextTrace <= ullNext))
+        {
+            HostSim_Trace();
+            ullNextTrace += stSimConfig.ullTraceTime;
+        }
+    }
+
+    HostSim_Report(HostSim_RealTimeNs() - llRealStart);
+
+    if(stSimConfig.pExeTraceFile != NULL)
+    {
+        HostSim_SaveExeTrace(stSimConfig.pExeTraceFile);
+    }
+
+    if(stSimConfig.pFlashFile != NULL)
+    {
+        HostSimSfr_SaveDflash(stSimConfig.pFlashFile);
+    }
+
+    /*The firmware never returns from main()*/
+    return 0;
+}
+
+/*---------------------Static Function--------------------------*/
+static void HostSim_ParseArgs(int argc, char *argv[])
+{
+    int lIdx;
+
+    for(lIdx = 1; lIdx < argc; lIdx++)
+    {
+        const char *pArg = argv[lIdx];
+        const char *pValue = ((lIdx + 1) < argc) ? argv[lIdx + 1] : NULL;
+
+        if((strcmp(pArg, "--time-ms") == 0) && (pValue != NULL))
+        {
+            stSimConfig.ullEndTime = strtoull(pValue, NULL, 0) * HOSTSIM_STM_TICKS_PER_MS;
+            lIdx++;
+        }
+        else if((strcmp(pArg, "--speed") == 0) && (pValue != NULL))
+        {
+            stSimConfig.dSpeed = strtod(pValue, NULL);
+            lIdx++;
+        }
+        else if((strcmp(pArg, "--trace-ms") == 0) && (pValue != NULL))
+        {
+            stSimConfig.ullTraceTime = strtoull(pValue, NULL, 0) * HOSTSIM_STM_TICKS_PER_MS;
+            lIdx++;
+        }
+        else if((strcmp(pArg, "--uart") == 0) && (pValue != NULL))
+        {
+            char *pEnd;
+            uint64 ullTimeMs = strtoull(pValue, &pEnd, 0);
+
+            HostSim_AddUart(ullTimeMs, (*pEnd == ':') ? (uint8)pEnd[1] : 0u);
+            lIdx++;
+        }
+        else if((strcmp(pArg, "--scenario") == 0) && (pValue != NULL))
+        {
+            HostSim_LoadScenario(pValue);
+            lIdx++;
+        }
+        else if((strcmp(pArg, "--exe-trace") == 0) && (pValue != NULL))
+        {
+            stSimConfig.pExeTraceFile = pValue;
+            lIdx++;
+        }
+        else if((strcmp(pArg, "--flash") == 0) && (pValue != NULL))
+        {
+            stSimConfig.pFlashFile = pValue;
+            lIdx++;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--time-ms N] [--speed X] [--trace-ms N] [--uart MS:C]... [--scenario FILE] [--exe-trace FILE] [--flash FILE]\n", argv[0]);
+            exit(2);
+        }
+    }
+
+    if(stSimConfig.dSpeed <= 0.0)
+    {
+        stSimConfig.dSpeed = HOSTSIM_DEFAULT_SPEED;
+    }
+}
+
+static void HostSim_LoadScenario(const char *pFile)
+{
+    FILE *pIn = fopen(pFile, "r");
+    char cLine[HOSTSIM_SCENARIO_LINE_SIZE];
+    uint32 ulLine = 0u;
+
+    if(pIn == NULL)
+    {
+        perror("hostsim: scenario");
+        exit(2);
+    }
+
+    while(fgets(cLine, sizeof(cLine), pIn) != NULL)
+    {
+        char cName[64];
+        char cData;
+        unsigned long long ullValue;
+        double dValue;
+        char *pComment = strchr(cLine, '#');
+
+        ulLine++;
+
+        if(pComment != NULL)
+        {
+            *pComment = '\0';
+        }
+
+        if(sscanf(cLine, " %63s", cName) != 1)
+        {
+            continue;
+        }
+
+        if(sscanf(cLine, " end %llu", &ullValue) == 1)
+        {
+            stSimConfig.ullEndTime = (uint64)ullValue * HOSTSIM_STM_TICKS_PER_MS;
+        }
+        else if(sscanf(cLine, " set %63s %lf", cName, &dValue) == 2)
+        {
+            if(HostSimPlant_SetParam(cName, dValue) == FALSE)
+            {
+                fprintf(stderr, "hostsim: %s:%u: unknown plant parameter %s\n", pFile, (unsigned)ulLine, cName);
+                exit(2);
+            }
+        }
+        else if(sscanf(cLine, " %llu %c", &ullValue, &cData) == 2)
+        {
+            HostSim_AddUart((uint64)ullValue, (uint8)cData);
+        }
+        else
+        {
+            fprintf(stderr, "hostsim: %s:%u: cannot parse '%s'\n", pFile, (unsigned)ulLine, cName);
+            exit(2);
+        }
+    }
+
+    fclose(pIn);
+}
+
+/*Kept sorted by time, the main loop injects them in order*/
+static void HostSim_AddUart(uint64 ullTimeMs, uint8 ucData)
+{
+    uint64 ullTime = ullTimeMs * HOSTSIM_STM_TICKS_PER_MS;
+    uint32 ulIdx = stSimConfig.ulUartNumber;
+
+    if(ulIdx >= HOSTSIM_UART_EVENT_NUMBER)
+    {
+        fprintf(stderr, "hostsim: more than %u uart events\n", (unsigned)HOSTSIM_UART_EVENT_NUMBER);
+        exit(2);
+    }
+
+    while((ulIdx > 0u) && (stSimConfig.stUart[ulIdx - 1u].ullTime > ullTime))
+    {
+        stSimConfig.stUart[ulIdx] = stSimConfig.stUart[ulIdx - 1u];
+        ulIdx--;
+    }
+
+    stSimConfig.stUart[ulIdx].ullTime = ullTime;
+    stSimConfig.stUart[ulIdx].ucData  = ucData;
+    stSimConfig.ulUartNumber++;
+}
+
+static void *HostSim_FirmwareThread(void *pArg)
+{
+    (void)pArg;
+
+    HostSimIrq_AttachCpu();
+    (void)HostSim_FirmwareMain();
+
+    return NULL;
+}
+
+static sint64 HostSim_RealTimeNs(void)
+{
+    struct timespec stNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &stNow);
+
+    return ((sint64)stNow.tv_sec * 1000000000ll) + stNow.tv_nsec;
+}
+
+/*Block this thread so that the firmware thread gets the CPU*/
+static void HostSim_SleepUntil(sint64 llRealNs)
+{
+    struct timespec stWake;
+
+    stWake.tv_sec  = (time_t)(llRealNs / 1000000000ll);
+    stWake.tv_nsec = (long)(llRealNs % 1000000000ll);
+
+    (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &stWake, NULL);
+}
+
+/*
+ * Let the background loop run, the STM follows the real time scaled by the
+ * speed. Returns the time reached, earlier than ullTarget if a compare event
+ * was programmed meanwhile.
+ */
+static uint64 HostSim_RunUntil(uint64 ullTarget)
+{
+    while(HostSimStm_Now() < ullTarget)
+    {
+        uint64 ullStep;
+        uint64 ullSlice;
+        double dSpeed = stSimConfig.dSpeed;
+        double dNsPerTick;
+        sint64 llDeadline;
+
+        if(HostSimIrq_IsCpuSleeping() != FALSE)
+        {
+            ullTarget = HostSim_NextEvent(ullTarget);
+            ullSimIdleTicks += ullTarget - HostSimStm_Now();
+            break;
+        }
+
+        if(bSimStartup != FALSE)
+        {
+            if(HOSTSIM_SFR_OF(CPU0_ICR).B.IE != 0u)
+            {
+                bSimStartup    = FALSE;
+                llSimRealStart = HostSim_RealTimeNs();
+                ullSimStmStart = HostSimStm_Now();
+            }
+            else
+            {
+                dSpeed = HOSTSIM_STARTUP_SPEED;
+            }
+        }
+
+        dNsPerTick = 1.0e9 / ((double)HOSTSIM_STM_FREQ_HZ * dSpeed);
+        ullSlice   = (uint64)((double)HOSTSIM_SLICE_MIN_NS / dNsPerTick);
+        ullStep    = HostSimStm_Now() + ((ullSlice > HOSTSIM_SLICE_TICKS) ? ullSlice : HOSTSIM_SLICE_TICKS);
+
+        if(ullStep > ullTarget)
+        {
+            ullStep = ullTarget;
+        }
+
+        llDeadline = llSimRealStart + (sint64)((double)(ullStep - ullSimStmStart) * dNsPerTick);
+
+        do
+        {
+            HostSimSfr_Poll();
+            HostSimIrq_Poll();
+            HostSim_PollUartTx();
+            HostSim_SleepUntil(llDeadline);
+        } while(HostSim_RealTimeNs() < llDeadline);
+
+        /*The firmware may have moved a compare value or started a transmission during the slice*/
+        ullTarget = HostSim_NextEvent(ullTarget);
+
+        if(ullStep < ullTarget)
+        {
+            uint64 ullReached = HostSim_MovePlant(ullStep);
+
+            HostSimStm_Set(ullReached);
+
+            if(ullReached < ullStep)
+            {
+                ullTarget = ullReached;
+                break;
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return ullTarget;
+}
+
+static void HostSim_WaitIsrDone(void)
+{
+    sint64 llStart = HostSim_RealTimeNs();
+
+    while(HostSimIrq_WaitIdle(HOSTSIM_ISR_POLL_US) == FALSE)
+    {
+        HostSimSfr_Poll();
+
+        if((HostSim_RealTimeNs() - llStart) > HOSTSIM_ISR_TIMEOUT_NS)
+        {
+            fprintf(stderr, "hostsim: interrupts not served at %.3f ms (disabled or stuck)\n",
+                    (double)HostSimStm_Now() / HOSTSIM_STM_TICKS_PER_MS);
+            llStart = HostSim_RealTimeNs();
+        }
+    }
+
+    /*Time spent in ISRs is not virtual time: restart the real-time reference*/
+    llSimRealStart = HostSim_RealTimeNs();
+    ullSimStmStart = HostSimStm_Now();
+}
+
+/*The plant computation is not virtual time either. Returns the time reached, see HostSimPlant_Run*/
+static uint64 HostSim_MovePlant(uint64 ullTime)
+{
+    sint64 llStart = HostSim_RealTimeNs();
+    uint64 ullReached;
+
+    ullReached = HostSimPlant_Run(ullTime);
+
+    llSimRealStart += HostSim_RealTimeNs() - llStart;
+
+    return ullReached;
+}
+
+/*One received byte in the ASCLIN0 RX FIFO*/
+static void HostSim_InjectUart(uint8 ucData)
+{
+    volatile Ifx_ASCLIN *pAsc = &HOSTSIM_SFR_OF(MODULE_ASCLIN0);
+
+    pAsc->RXDATA.U         = ucData;
+    pAsc->RXFIFOCON.B.FILL = 1u;
+    pAsc->FLAGS.B.RFL      = 1u;
+
+    HostSimIrq_Raise(&SRC_ASCLIN0RX);
+    HostSim_WaitIsrDone();
+
+    pAsc->RXFIFOCON.B.FILL = 0u;
+}
+
+/*Earliest of the STM compare, the ADC DMA interrupt and the end of the UART byte*/
+static uint64 HostSim_NextEvent(uint64 ullLimit)
+{
+    ullLimit = HostSimStm_NextEvent(ullLimit);
+    ullLimit = HostSimPlant_NextAdcEvent(ullLimit);
+
+    if((ullSimUartTxTime != 0u) && (ullSimUartTxTime < ullLimit))
+    {
+        ullLimit = ullSimUartTxTime;
+    }
+
+    return ullLimit;
+}
+
+/*Byte written to ASCLIN0 TXDATA: start its transmission*/
+static void HostSim_PollUartTx(void)
+{
+    volatile Ifx_ASCLIN *pAsc = &HOSTSIM_SFR_OF(MODULE_ASCLIN0);
+    uint32 ulData;
+
+    if(ullSimUartTxTime != 0u)
+    {
+        return;
+    }
+
+    ulData = pAsc->TXDATA.U;
+
+    if(ulData == HOSTSIM_UART_TX_EMPTY)
+    {
+        return;
+    }
+
+    pAsc->TXDATA.U   = HOSTSIM_UART_TX_EMPTY;
+    ullSimUartTxTime = HostSimStm_Now() + HOSTSIM_UART_CHAR_TICKS;
+
+    if((uint8)ulData == '\n')
+    {
+        printf("%10.3f ms  uart: %.*s\n", (double)HostSimStm_Now() / HOSTSIM_STM_TICKS_PER_MS,
+               (int)ulSimUartLineLen, cSimUartLine);
+        ulSimUartLineLen = 0u;
+    }
+    else if(((uint8)ulData != '\r') && (ulSimUartLineLen < HOSTSIM_UART_LINE_SIZE))
+    {
+        cSimUartLine[ulSimUartLineLen] = (char)ulData;
+        ulSimUartLineLen++;
+    }
+}
+
+/*Byte sent: TX interrupt, the driver writes the next one*/
+static void HostSim_UartTxDone(void)
+{
+    ullSimUartTxTime = 0u;
+
+    HostSimIrq_Raise(&SRC_ASCLIN0TX);
+    HostSim_WaitIsrDone();
+    HostSim_PollUartTx();
+}
+
+static void HostSim_Trace(void)
+{
+    volatile Ifx_P *pP33 = &HOSTSIM_SFR_OF(MODULE_P33);
+
+    printf("%10.3f ms  P33.OUT=0x%04X  TOM1 CH4 SR0=%u SR1=%u  CH5 SR1=%u  CH6 SR1=%u  CH7 SR1=%u  rpm=%.1f/%.1f/%.1f/%.1f  plant=%.1f/%.1f/%.1f/%.1f  A=%.2f/%.2f/%.2f/%.2f  bat=%.2fV\n",
+           (double)HostSimStm_Now() / HOSTSIM_STM_TICKS_PER_MS,
+           (unsigned)(pP33->OUT.U & 0xFFFFu),
+           (unsigned)HOSTSIM_SFR_OF(GTM_TOM1_CH4_SR0).U,
+           (unsigned)HOSTSIM_SFR_OF(GTM_TOM1_CH4_SR1).U,
+           (unsigned)HOSTSIM_SFR_OF(GTM_TOM1_CH5_SR1).U,
+           (unsigned)HOSTSIM_SFR_OF(GTM_TOM1_CH6_SR1).U,
+           (unsigned)HOSTSIM_SFR_OF(GTM_TOM1_CH7_SR1).U,
+           (double)fSenseMotorRpm[0], (double)fSenseMotorRpm[1],
+           (double)fSenseMotorRpm[2], (double)fSenseMotorRpm[3],
+           HostSimPlant_GetRpm(0u), HostSimPlant_GetRpm(1u), HostSimPlant_GetRpm(2u), HostSimPlant_GetRpm(3u),
+           (double)fSenseMotorCurrent[0], (double)fSenseMotorCurrent[1],
+           (double)fSenseMotorCurrent[2], (double)fSenseMotorCurrent[3], (double)fSenseBatteryV);
+}
+
+static void HostSim_Report(sint64 llRealNs)
+{
+    double dSimMs = (double)HostSimStm_Now() / HOSTSIM_STM_TICKS_PER_MS;
+    uint32 ulPrio;
+    uint32 ulWheel;
+
+    printf("hostsim: %.3f ms simulated in %.3f ms real (x%.1f), cpu idle %.1f %%\n",
+           dSimMs, (double)llRealNs / 1.0e6, dSimMs / ((double)llRealNs / 1.0e6),
+           ((double)ullSimIdleTicks * 100.0) / (double)HostSimStm_Now());
+
+    printf("hostsim: firmware cpu load %.1f %%  bg steps %u  deferred %u  late %u  rejected %u\n",
+           (double)BgJobGetCpuLoad() / 10.0, stBgJobStat.ulStepCnt, stBgJobStat.ulDeferCnt,
+           stBgJobStat.ulLateCnt, stBgJobStat.ulRejectCnt);
+
+    for(ulPrio = 1u; ulPrio < HOSTSIM_IRQ_PRIO_NUMBER; ulPrio++)
+    {
+        const HostSimIrq_Stat *pStat = HostSimIrq_GetStat(ulPrio);
+
+        if(pStat->ullIsrCount != 0u)
+        {
+            printf("hostsim: prio %3u  isr %10llu  latency avg %.1f max %llu ticks\n",
+                   ulPrio, (unsigned long long)pStat->ullIsrCount,
+                   (double)pStat->ullLatencySum / (double)pStat->ullIsrCount,
+                   (unsigned long long)pStat->ullLatencyMax);
+        }
+    }
+
+    for(ulPrio = 0u; ulPrio < SCHEDULER_TASK_NUMBER; ulPrio++)
+    {
+        const SchedulerTaskStat *pTask = &stSchedulerTaskStat[ulPrio];
+
+        printf("hostsim: task %u  release %7u  run %7u  overrun %5u  miss %5u  exec max %8.1f us  latency max %8.1f us\n",
+               ulPrio, pTask->ulReleaseCnt, pTask->ulRunCnt, pTask->ulOverrunCnt, pTask->ulDeadlineMissCnt,
+               (double)pTask->ulMaxExecCnt / MID_TIMER_CNT_PER_US, (double)pTask->ulMaxLatencyCnt / MID_TIMER_CNT_PER_US);
+    }
+
+    for(ulWheel = 0u; ulWheel < RLS_BANK_NUMBER; ulWheel++)
+    {
+        RlsModel stModel;
+
+        if(RlsBankGetModel(&stMotorRls, ulWheel, &stModel) != FALSE)
+        {
+            printf("rls: wheel %u  K %7.3f rpm/%%  tau %6.1f ms  dead %5.2f %%  sd K %5.1f %%  tau %5.1f %%  err %6.3f rpm  updates %6u %s\n",
+                   ulWheel, (double)stModel.fGain, (double)stModel.fTimeConst * 1000.0, (double)stModel.fInDead,
+                   (double)stModel.fGainStd * 100.0, (double)stModel.fTimeConstStd * 100.0, (double)stModel.fErrStd,
+                   stModel.ulUpdateCnt, (stModel.bConverged != FALSE) ? "converged" : "");
+        }
+        else
+        {
+            printf("rls: wheel %u  no model  updates %6u\n", ulWheel, stModel.ulUpdateCnt);
+        }
+    }
+
+    HostSimAdc_Report();
+    printf("pipeline: pwm updates %u  staged %.2f us after the trigger, max %.2f us  late %u\n",
+           stGtmPwmStage.ulUpdateCnt,
+           ((double)stGtmPwmStage.ulLastCnt * 1.0e6) / (double)HOSTSIM_STM_FREQ_HZ,
+           ((double)stGtmPwmStage.ulMaxCnt * 1.0e6) / (double)HOSTSIM_STM_FREQ_HZ, stGtmPwmStage.ulLateCnt);
+    printf("overcurrent: trips RL %u  RR %u  FL %u  FR %u\n",
+           ulMotorOcTripCnt[0], ulMotorOcTripCnt[1], ulMotorOcTripCnt[2], ulMotorOcTripCnt[3]);
+
+    HostSimPlant_Report();
+}
+
+/*Raw ExeTrace ring as a debugger would save it, input of 2_TraceDecode*/
+static void HostSim_SaveExeTrace(const char *pFile)
+{
+    FILE *pOut = fopen(pFile, "wb");
+
+    if(pOut == NULL)
+    {
+        perror("hostsim: exe trace");
+        return;
+    }
+
+    stExeTraceBuffer.ulFreeze = ON;
+
+    if(fwrite(&stExeTraceBuffer, sizeof(stExeTraceBuffer), 1u, pOut) != 1u)
+    {
+        perror("hostsim: exe trace");
+    }
+
+    fclose(pOut);
+    printf("hostsim: exe trace %u records written to %s\n", (unsigned)stExeTraceBuffer.ulHead, pFile);
+}
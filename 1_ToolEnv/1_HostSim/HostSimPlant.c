@@ -0,0 +1,1051 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "HostSim.h"
+#include "IfxGtm_reg.h"
+#include "IfxPort_reg.h"
+#include "DrvGtm.h"
+#include "MidDio.h"
+#include "MidTim.h"
+#include "MotionProfile.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * Drivetrain of the four wheels: L298N half bridges, brushed DC motors,
+ * gearbox, wheel with a quarter of the car and load torque. Each TOM1 CH4..7
+ * period the plant latches the duty (SR1, the shadow the TOM would take at
+ * the period end) and the IN pins of its bridge. During the high phase the
+ * enable is on: IN1 != IN2 drives the motor from the supply less the bridge
+ * drop, IN1 == IN2 brakes it through the bridge (the sense resistor only
+ * sees the low side short). During the low phase the
+ * bridge is off: the current, if any, returns to the supply through the
+ * external diodes and stops at 0 (coast).
+ * Within a phase the speed is taken constant for the electrical part, which
+ * is then exact (first order from the phase start, zero crossing included);
+ * the speed follows from the mean torque of the phase.
+ * The encoder edges are placed where the wheel angle crosses them and update
+ * the TIM0 registers like the TPWM mode of GtmTim0Init: ECNT on each edge,
+ * GPR0/GPR1 (TBU_TS0 time, period in CMU_CLK1 ticks) on each rising edge.
+ * At the ADC trigger of TOM1 CH8 the bridge currents seen by the L298N sense
+ * resistors (only while the enable is high) and the divided supply go to
+ * HostSimAdc_Convert. CN0 of TOM1 CH4 follows the position in the period.
+ * A host trigger of TOM1 TGC0 (GLB_CTRL write) takes OUTEN_CTRL into
+ * OUTEN_STAT. A disabled output is low, the enable off: the wheel coasts
+ * from that instant to the end of the first period with it enabled again.
+ * The plant stops at a limit event of the scan so that its interrupt comes
+ * before the plant goes on.
+ *
+ * Each change of the target of a side (stMotorProfile[].fTarget) starts a
+ * response segment of its two wheels, measured on the plant speed: 10-90%
+ * rise time, overshoot, mean error over the last HOSTSIM_PLANT_SS_BIN_NUMBER
+ * bins, mean duty, peak current and energy drawn from the supply.
+ * A change to 0 also starts a stop of the wheel: time and distance rolled
+ * until the wheel stands still, or until the next change if it never does.
+ *
+ * The steering servo frames of TOM0 CH8 start a shot of CH9 with CM1, which
+ * CH9 took from SR1 at the end of the shot before. The plant keeps the
+ * pulses at the PWM period boundaries: count, range and the largest change
+ * from one frame to the next.
+ */
+#define HOSTSIM_PLANT_PERIOD_TICKS      (HOSTSIM_STM_FREQ_HZ / DRV_GTM_PWM_HZ)     /*FXCLK0 counts = STM ticks*/
+#define HOSTSIM_PLANT_TICK_S            (1.0 / (double)HOSTSIM_STM_FREQ_HZ)
+#define HOSTSIM_PLANT_SIDE_NUMBER       2u
+#define HOSTSIM_PLANT_EDGE_PER_RAD      ((2.0 * (double)MID_TIM_PULSE_PER_REV) / (2.0 * IFX_PI))   /*Both edges per wheel rad*/
+#define HOSTSIM_PLANT_RAD_S_TO_RPM      (60.0 / (2.0 * IFX_PI))
+#define HOSTSIM_PLANT_TIM_TICKS         (HOSTSIM_STM_FREQ_HZ / (uint32)DRV_GTM_TIM_CLK_HZ)     /*STM ticks per CMU_CLK1 tick*/
+#define HOSTSIM_PLANT_CAP_MASK          0x00FFFFFFu
+#define HOSTSIM_PLANT_SS_BIN_TICKS      (10u * HOSTSIM_STM_TICKS_PER_MS)
+#define HOSTSIM_PLANT_SS_BIN_NUMBER     50u         /*Steady state : last 500ms of a segment*/
+#define HOSTSIM_PLANT_SEG_NUMBER        128u
+#define HOSTSIM_PLANT_STOP_NUMBER       64u
+#define HOSTSIM_PLANT_STEP_MIN_RPM      1.0         /*Smaller target changes have no rise time or overshoot*/
+#define HOSTSIM_PLANT_TOM_CH_FIRST      4u          /*TOM1 CH4 : E_MID_TIM_WHEEL 0*/
+#define HOSTSIM_PLANT_OUTEN_DISABLE     0x1u        /*OUTEN_CTRL written, per channel*/
+#define HOSTSIM_PLANT_OUTEN_ENABLE      0x2u
+#define HOSTSIM_PLANT_OUTEN_ON          0x3u        /*OUTEN_STAT read back*/
+#define HOSTSIM_PLANT_SERVO_FRAME_TICKS ((uint64)DRV_GTM_SERVO_FRAME_CNT * 256u)  /*CMU_FXCLK2 counts*/
+#define HOSTSIM_PLANT_SERVO_CNT_TICKS   16u         /*STM ticks per CMU_FXCLK1 count*/
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef enum
+{
+    HOSTSIM_PLANT_COAST = 0u,           /*Enable low*/
+    HOSTSIM_PLANT_DRIVE,                /*Enable high, IN1 != IN2*/
+    HOSTSIM_PLANT_BRAKE                 /*Enable high, IN1 == IN2*/
+}E_HOSTSIM_PLANT_MODE;
+
+typedef struct
+{
+    double dSupplyV;                    /*Battery*/
+    double dBridgeDropV;                /*L298N VCEsat(H) + VCEsat(L) ...*/
+    double dBridgeDropR;                /*... + this times the current: 1.8V at 1A*/
+    double dDiodeV;                     /*External recirculation diodes*/
+    double dR;                          /*Armature, Ohm*/
+    double dL;                          /*Armature, H*/
+    double dKe;                         /*V per rad/s, also Kt in Nm/A*/
+    double dJm;                         /*Rotor, kg.m2*/
+    double dGear;                       /*Motor turns per wheel turn*/
+    double dGearEff;
+    double dWheelJ;                     /*Wheel and a quarter of the car at the wheel radius, kg.m2*/
+    double dViscous;                    /*Motor, Nm per rad/s*/
+    double dFriction;                   /*Motor Coulomb friction, Nm*/
+    double dStiction;                   /*Motor breakaway torque, Nm*/
+    double dLoad;                       /*Wheel torque against the motion (rolling, slope), Nm*/
+    double dSenseR;                     /*L298N SENSE to ground, Ohm: measurement only*/
+    double dBatteryDiv;                 /*Supply to the ADC input*/
+    double dWheelD;                     /*Wheel diameter, m: distances only*/
+}HostSimPlant_Param;
+
+typedef struct
+{
+    const char *pName;
+    double *pValue;
+}HostSimPlant_ParamName;
+
+typedef struct
+{
+    uint32 ulFrontBridge;               /*Front or rear L298N*/
+    uint32 ulInABit;                    /*IN1 or IN3: high with the other low is forward*/
+    uint32 ulInBBit;
+    uint32 ulSide;                      /*Index of stMotorProfile*/
+}HostSimPlant_Wiring;
+
+typedef struct
+{
+    uint32 ulWheel;
+    uint64 ullStart;                    /*STM ticks*/
+    uint64 ullEnd;
+    double dFromRpm;                    /*Plant speed at the start*/
+    double dToRpm;                      /*Target of the side*/
+    double dRiseMs;                     /*< 0 : not reached*/
+    double dOvershoot;                  /*% of the change*/
+    double dSsErrRpm;                   /*Target - speed*/
+    double dDuty;                       /*Mean, %*/
+    double dPeakA;
+    double dEnergyJ;
+}HostSimPlant_Result;
+
+typedef struct
+{
+    uint32 ulWheel;
+    uint64 ullStart;                    /*STM ticks of the change to 0*/
+    uint64 ullEnd;                      /*Standstill, 0 : not reached*/
+    double dFromRpm;
+    double dStartPos;                   /*dEdgePos at the start*/
+    double dDistMm;
+}HostSimPlant_StopResult;
+
+typedef struct
+{
+    uint64 ullFrameNext;                /*STM ticks of the next frame start*/
+    uint64 ullShotEnd;                  /*0 : CM1 taken*/
+    uint32 ulCm1;                       /*CMU_FXCLK1 counts*/
+    uint32 ulFrameCnt;                  /*Frames with a pulse*/
+    uint32 ulMinCnt;
+    uint32 ulMaxCnt;
+    uint32 ulLastCnt;
+    uint32 ulStepMaxCnt;                /*Largest change between two frames*/
+}HostSimPlant_Servo;
+
+typedef struct
+{
+    /*State*/
+    double dCurrent;                    /*A, + forward*/
+    double dOmega;                      /*Motor rad/s, + forward*/
+    double dEdgePos;                    /*Encoder edges since the start, both directions count*/
+    double dAngle;                      /*Wheel rad since the start, + forward*/
+    uint32 ulEdgeCnt;
+    uint64 ullRiseTime;                 /*STM ticks of the last rising edge*/
+    boolean bRise;                      /*A rising edge was seen*/
+
+    /*Latched at the period start*/
+    uint32 ulOnTicks;
+    uint32 ulOnMode;                    /*E_HOSTSIM_PLANT_MODE of the high phase*/
+    double dDriveSign;
+    boolean bSense;                     /*The current of the high phase flows through SENSE*/
+
+    /*Response segment*/
+    HostSimPlant_Result stSeg;
+    boolean bSeg;
+    float32 fTarget;
+    uint64 ullT10;                      /*0 : not yet*/
+    double dPeak;                       /*Largest excursion past the target, rpm*/
+    double dDutySum;
+    uint64 ullDutyCnt;
+    double dSsSum[HOSTSIM_PLANT_SS_BIN_NUMBER];
+    uint32 ulSsCnt[HOSTSIM_PLANT_SS_BIN_NUMBER];
+    uint64 ullSsBin;                    /*Bin of the last sample*/
+
+    /*Stop*/
+    HostSimPlant_StopResult stStop;
+    boolean bStop;
+}HostSimPlant_Wheel;
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static void HostSimPlant_Latch(void);
+static void HostSimPlant_TgcHook(uint32 ulAddr, boolean bWrite);
+static boolean HostSimPlant_OutputOn(uint32 ulWheel);
+static void HostSimPlant_AdcTrigger(void);
+static void HostSimPlant_StepWheel(uint32 ulWheel, uint64 ullStart, uint64 ullTicks, uint32 ulMode);
+static double HostSimPlant_Electrical(HostSimPlant_Wheel *pWheel, uint32 ulMode, double dDt, double *pdEnergy);
+static void HostSimPlant_Edges(uint32 ulWheel, double dOldPos, uint64 ullStart, uint64 ullTicks);
+static void HostSimPlant_Measure(uint32 ulWheel, uint64 ullNow);
+static void HostSimPlant_CloseSegment(HostSimPlant_Wheel *pWheel, uint64 ullNow);
+static void HostSimPlant_CloseStop(HostSimPlant_Wheel *pWheel, uint64 ullEnd);
+static void HostSimPlant_ServoFrame(void);
+static double HostSimPlant_Sign(double dValue);
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+extern MotionProfile stMotorProfile[HOSTSIM_PLANT_SIDE_NUMBER];
+
+/*Geared 6V motor on a 2S battery, 0.4kg per wheel of 65mm, about 120rpm at full duty*/
+static HostSimPlant_Param stPlantParam =
+{
+    7.4,            /*dSupplyV*/
+    1.0,            /*dBridgeDropV*/
+    0.8,            /*dBridgeDropR*/
+    0.5,            /*dDiodeV*/
+    2.0,            /*dR*/
+    1.5e-4,         /*dL*/
+    4.0e-3,         /*dKe*/
+    4.0e-7,         /*dJm*/
+    120.0,          /*dGear : MID_TIM_PULSE_PER_REV = 8 pulses per motor turn*/
+    0.65,           /*dGearEff*/
+    4.4e-4,         /*dWheelJ*/
+    2.0e-7,         /*dViscous*/
+    3.0e-4,         /*dFriction*/
+    6.0e-4,         /*dStiction*/
+    2.6e-3,         /*dLoad : rolling resistance 0.02*/
+    0.5,            /*dSenseR*/
+    3.0,            /*dBatteryDiv*/
+    0.065           /*dWheelD*/
+};
+
+static const HostSimPlant_ParamName stPlantParamName[] =
+{
+    {"supply_v",        &stPlantParam.dSupplyV},
+    {"bridge_drop_v",   &stPlantParam.dBridgeDropV},
+    {"bridge_drop_r",   &stPlantParam.dBridgeDropR},
+    {"diode_v",         &stPlantParam.dDiodeV},
+    {"motor_r",         &stPlantParam.dR},
+    {"motor_l",         &stPlantParam.dL},
+    {"motor_ke",        &stPlantParam.dKe},
+    {"motor_j",         &stPlantParam.dJm},
+    {"gear",            &stPlantParam.dGear},
+    {"gear_eff",        &stPlantParam.dGearEff},
+    {"wheel_j",         &stPlantParam.dWheelJ},
+    {"viscous",         &stPlantParam.dViscous},
+    {"friction",        &stPlantParam.dFriction},
+    {"stiction",        &stPlantParam.dStiction},
+    {"load",            &stPlantParam.dLoad},
+    {"sense_r",         &stPlantParam.dSenseR},
+    {"battery_div",     &stPlantParam.dBatteryDiv},
+    {"wheel_d",         &stPlantParam.dWheelD},
+};
+
+/*E_MID_TIM_WHEEL order: rear bridge RL/RR, front bridge FL/FR, IN1/IN2 left*/
+static const HostSimPlant_Wiring stPlantWiring[MID_TIM_WHEEL_NUMBER] =
+{
+    {FALSE, MID_DIO_REAR_IN1_BIT,  MID_DIO_REAR_IN2_BIT,  0u},
+    {FALSE, MID_DIO_REAR_IN3_BIT,  MID_DIO_REAR_IN4_BIT,  1u},
+    {TRUE,  MID_DIO_FRONT_IN1_BIT, MID_DIO_FRONT_IN2_BIT, 0u},
+    {TRUE,  MID_DIO_FRONT_IN3_BIT, MID_DIO_FRONT_IN4_BIT, 1u},
+};
+
+static volatile Ifx_GTM_TOM_CH *pPlantTomCh[MID_TIM_WHEEL_NUMBER];   /*Backdoor of TOM1 CH4..7*/
+static volatile Ifx_GTM_TIM_CH *pPlantTimCh[MID_TIM_WHEEL_NUMBER];   /*Backdoor of TIM0 CH0..3*/
+static volatile Ifx_GTM_TOM_CH *pPlantServoCh;                   /*Backdoor of TOM0 CH9*/
+static HostSimPlant_Wheel stPlantWheel[MID_TIM_WHEEL_NUMBER];
+static HostSimPlant_Servo stPlantServo;
+static HostSimPlant_Result stPlantResult[HOSTSIM_PLANT_SEG_NUMBER];
+static uint32 ulPlantResultNumber = 0u;
+static uint32 ulPlantResultLost = 0u;
+static HostSimPlant_StopResult stPlantStop[HOSTSIM_PLANT_STOP_NUMBER];
+static uint32 ulPlantStopNumber = 0u;
+static uint64 ullPlantTime = 0u;
+static uint64 ullPlantPeriodStart = 0u;
+static uint32 ulPlantOutOffCnt = 0u;            /*Host triggers that switched an output off*/
+static uint64 ullPlantOutOffTicks = 0u;         /*Time with all outputs off*/
+static uint64 ullPlantOutOffStart = 0u;         /*0 : outputs on*/
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void HostSimPlant_Init(void)
+{
+    memset(stPlantWheel, 0, sizeof(stPlantWheel));
+    memset(&stPlantServo, 0, sizeof(stPlantServo));
+    stPlantServo.ullFrameNext = HOSTSIM_PLANT_SERVO_FRAME_TICKS;
+    ulPlantResultNumber = 0u;
+    ulPlantStopNumber   = 0u;
+    ullPlantTime        = 0u;
+    ullPlantPeriodStart = 0u;
+    ulPlantOutOffCnt    = 0u;
+    ullPlantOutOffTicks = 0u;
+    ullPlantOutOffStart = 0u;
+
+    pPlantTomCh[MID_TIM_WHEEL_RL] = &HOSTSIM_SFR_OF(MODULE_GTM.TOM[1].CH4);
+    pPlantTomCh[MID_TIM_WHEEL_RR] = &HOSTSIM_SFR_OF(MODULE_GTM.TOM[1].CH5);
+    pPlantTomCh[MID_TIM_WHEEL_FL] = &HOSTSIM_SFR_OF(MODULE_GTM.TOM[1].CH6);
+    pPlantTomCh[MID_TIM_WHEEL_FR] = &HOSTSIM_SFR_OF(MODULE_GTM.TOM[1].CH7);
+    pPlantTimCh[MID_TIM_WHEEL_RL] = &HOSTSIM_SFR_OF(MODULE_GTM.TIM[0].CH0);
+    pPlantTimCh[MID_TIM_WHEEL_RR] = &HOSTSIM_SFR_OF(MODULE_GTM.TIM[0].CH1);
+    pPlantTimCh[MID_TIM_WHEEL_FL] = &HOSTSIM_SFR_OF(MODULE_GTM.TIM[0].CH2);
+    pPlantTimCh[MID_TIM_WHEEL_FR] = &HOSTSIM_SFR_OF(MODULE_GTM.TIM[0].CH3);
+    pPlantServoCh = &HOSTSIM_SFR_OF(MODULE_GTM.TOM[0].CH9);
+
+    HostSimSfr_RegisterHook((uint32)(size_t)&GTM_TOM1_TGC0_GLB_CTRL, 4u, HostSimPlant_TgcHook);
+    HostSimPlant_Latch();
+}
+
+/*Scenario "set NAME VALUE", before HostSimPlant_Init*/
+boolean HostSimPlant_SetParam(const char *pName, double dValue)
+{
+    uint32 ulIdx;
+
+    for(ulIdx = 0u; ulIdx < (sizeof(stPlantParamName) / sizeof(stPlantParamName[0])); ulIdx++)
+    {
+        if(strcmp(pName, stPlantParamName[ulIdx].pName) == 0)
+        {
+            *stPlantParamName[ulIdx].pValue = dValue;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/*---------------------Simulation--------------------------*/
+/*
+ * Moves the plant to ullUntil, phase by phase of the PWM periods, stopping at
+ * the ADC trigger. Returns the time reached, earlier at a limit event.
+ */
+uint64 HostSimPlant_Run(uint64 ullUntil)
+{
+    while(ullPlantTime < ullUntil)
+    {
+        uint64 ullPos = ullPlantTime - ullPlantPeriodStart;
+        uint64 ullStop = ullUntil;
+        uint64 ullTrig;
+        uint64 ullEnd;
+        uint32 ulWheel;
+
+        if(ullPos >= HOSTSIM_PLANT_PERIOD_TICKS)
+        {
+            for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+            {
+                HostSimPlant_Measure(ulWheel, ullPlantTime);
+            }
+
+            ullPlantPeriodStart += HOSTSIM_PLANT_PERIOD_TICKS;
+            ullPos -= HOSTSIM_PLANT_PERIOD_TICKS;
+            HostSimPlant_Latch();
+            HostSimPlant_ServoFrame();
+        }
+
+        for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+        {
+            if(HostSimPlant_OutputOn(ulWheel) == FALSE)
+            {
+                stPlantWheel[ulWheel].ulOnTicks = 0u;
+            }
+        }
+
+        ullTrig = HostSimAdc_GetTrigTicks();
+
+        if((ullTrig != 0u) && (ullPos < ullTrig) && ((ullPlantPeriodStart + ullTrig) < ullStop))
+        {
+            ullStop = ullPlantPeriodStart + ullTrig;
+        }
+
+        for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+        {
+            HostSimPlant_Wheel *pWheel = &stPlantWheel[ulWheel];
+            uint64 ullPhaseEnd = (ullPos < pWheel->ulOnTicks) ? pWheel->ulOnTicks : HOSTSIM_PLANT_PERIOD_TICKS;
+
+            ullEnd = ullPlantPeriodStart + ullPhaseEnd;
+            ullEnd = (ullEnd < ullStop) ? ullEnd : ullStop;
+            HostSimPlant_StepWheel(ulWheel, ullPlantTime, ullEnd - ullPlantTime,
+                                   (ullPos < pWheel->ulOnTicks) ? pWheel->ulOnMode : (uint32)HOSTSIM_PLANT_COAST);
+        }
+
+        /*Wheels with a shorter high phase ran it out and went on low*/
+        ullEnd = ullPlantPeriodStart + HOSTSIM_PLANT_PERIOD_TICKS;
+        ullEnd = (ullEnd < ullStop) ? ullEnd : ullStop;
+
+        for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+        {
+            HostSimPlant_Wheel *pWheel = &stPlantWheel[ulWheel];
+            uint64 ullDone = ullPlantPeriodStart + ((ullPos < pWheel->ulOnTicks) ? pWheel->ulOnTicks : HOSTSIM_PLANT_PERIOD_TICKS);
+
+            if(ullDone < ullEnd)
+            {
+                HostSimPlant_StepWheel(ulWheel, ullDone, ullEnd - ullDone, HOSTSIM_PLANT_COAST);
+            }
+        }
+
+        ullPlantTime = ullEnd;
+
+        if((ullTrig != 0u) && (ullPlantTime == (ullPlantPeriodStart + ullTrig)))
+        {
+            HostSimPlant_AdcTrigger();
+            ullUntil = HostSimAdc_NextEvent(ullUntil, 0u, HOSTSIM_PLANT_PERIOD_TICKS);
+        }
+    }
+
+    /*TBU_TS0 runs on CMU_CLK0 at the STM rate from the start*/
+    HOSTSIM_SFR_OF(GTM_TBU_CH0_BASE).U = (uint32)ullPlantTime & 0x07FFFFFFu;
+    HOSTSIM_SFR_OF(GTM_TOM1_CH4_CN0).U = (uint32)((ullPlantTime - ullPlantPeriodStart) % HOSTSIM_PLANT_PERIOD_TICKS);
+
+    return ullPlantTime;
+}
+
+/*Next ADC channel interrupt of the DMA, see HostSimAdc_NextEvent*/
+uint64 HostSimPlant_NextAdcEvent(uint64 ullLimit)
+{
+    uint64 ullTrig = HostSimAdc_GetTrigTicks();
+    uint64 ullNext = 0u;
+
+    if(ullTrig != 0u)
+    {
+        ullNext = ullPlantPeriodStart + ullTrig;
+        ullNext += (ullPlantTime >= ullNext) ? HOSTSIM_PLANT_PERIOD_TICKS : 0u;
+    }
+
+    return HostSimAdc_NextEvent(ullLimit, ullNext, HOSTSIM_PLANT_PERIOD_TICKS);
+}
+
+/*Wheel speed, rpm, + forward*/
+double HostSimPlant_GetRpm(uint32 ulWheel)
+{
+    return (stPlantWheel[ulWheel].dOmega / stPlantParam.dGear) * HOSTSIM_PLANT_RAD_S_TO_RPM;
+}
+
+/*Response of every segment, at the end of the run*/
+void HostSimPlant_Report(void)
+{
+    static const char * const pWheelName[MID_TIM_WHEEL_NUMBER] = {"RL", "RR", "FL", "FR"};
+    uint32 ulIdx;
+
+    for(ulIdx = 0u; ulIdx < MID_TIM_WHEEL_NUMBER; ulIdx++)
+    {
+        if(stPlantWheel[ulIdx].bSeg != FALSE)
+        {
+            HostSimPlant_CloseSegment(&stPlantWheel[ulIdx], ullPlantTime);
+        }
+
+        if(stPlantWheel[ulIdx].bStop != FALSE)
+        {
+            HostSimPlant_CloseStop(&stPlantWheel[ulIdx], 0u);
+        }
+    }
+
+    if(ulPlantStopNumber != 0u)
+    {
+        printf("plant: stop  start ms  from rpm   time ms  distance mm\n");
+    }
+
+    for(ulIdx = 0u; ulIdx < ulPlantStopNumber; ulIdx++)
+    {
+        const HostSimPlant_StopResult *pStop = &stPlantStop[ulIdx];
+
+        if(pStop->ullEnd != 0u)
+        {
+            printf("plant: %-4s %9.1f %9.2f %9.1f %12.1f\n", pWheelName[pStop->ulWheel],
+                   (double)pStop->ullStart / HOSTSIM_STM_TICKS_PER_MS, pStop->dFromRpm,
+                   (double)(pStop->ullEnd - pStop->ullStart) / HOSTSIM_STM_TICKS_PER_MS, pStop->dDistMm);
+        }
+        else
+        {
+            printf("plant: %-4s %9.1f %9.2f %9s %12.1f\n", pWheelName[pStop->ulWheel],
+                   (double)pStop->ullStart / HOSTSIM_STM_TICKS_PER_MS, pStop->dFromRpm, "-", pStop->dDistMm);
+        }
+    }
+
+    if(ulPlantOutOffCnt != 0u)
+    {
+        uint64 ullOff = ullPlantOutOffTicks + ((ullPlantOutOffStart != 0u) ? (ullPlantTime - ullPlantOutOffStart) : 0u);
+
+        printf("plant: outputs off %u times, %.1f ms in all\n", (unsigned)ulPlantOutOffCnt, (double)ullOff / HOSTSIM_STM_TICKS_PER_MS);
+    }
+
+    if(stPlantWheel[MID_TIM_WHEEL_RL].dEdgePos != 0.0)
+    {
+        double dMm[MID_TIM_WHEEL_NUMBER];
+
+        for(ulIdx = 0u; ulIdx < MID_TIM_WHEEL_NUMBER; ulIdx++)
+        {
+            dMm[ulIdx] = stPlantWheel[ulIdx].dAngle * stPlantParam.dWheelD * 500.0;
+        }
+
+        printf("plant: position RL %.1f RR %.1f FL %.1f FR %.1f mm, centre %.1f mm\n", dMm[MID_TIM_WHEEL_RL], dMm[MID_TIM_WHEEL_RR],
+               dMm[MID_TIM_WHEEL_FL], dMm[MID_TIM_WHEEL_FR], 0.25 * (dMm[0] + dMm[1] + dMm[2] + dMm[3]));
+    }
+
+    if(stPlantServo.ulFrameCnt != 0u)
+    {
+        printf("plant: servo %u frames, pulse %.2f..%.2f us, last %.2f us, largest step %.2f us\n", (unsigned)stPlantServo.ulFrameCnt,
+               (double)stPlantServo.ulMinCnt / (double)DRV_GTM_SERVO_CNT_PER_US, (double)stPlantServo.ulMaxCnt / (double)DRV_GTM_SERVO_CNT_PER_US,
+               (double)stPlantServo.ulLastCnt / (double)DRV_GTM_SERVO_CNT_PER_US, (double)stPlantServo.ulStepMaxCnt / (double)DRV_GTM_SERVO_CNT_PER_US);
+    }
+
+    if(ulPlantResultNumber == 0u)
+    {
+        return;
+    }
+
+    printf("plant: wheel  start ms   end ms   from rpm     to rpm  rise ms  overshoot %%  ss err rpm  duty %%  peak A  energy J\n");
+
+    for(ulIdx = 0u; ulIdx < ulPlantResultNumber; ulIdx++)
+    {
+        const HostSimPlant_Result *pRes = &stPlantResult[ulIdx];
+        char cRise[16];
+        char cOver[16];
+
+        if(pRes->dRiseMs >= 0.0)
+        {
+            snprintf(cRise, sizeof(cRise), "%8.1f", pRes->dRiseMs);
+        }
+        else
+        {
+            snprintf(cRise, sizeof(cRise), "%8s", "-");
+        }
+
+        if(fabs(pRes->dToRpm - pRes->dFromRpm) >= HOSTSIM_PLANT_STEP_MIN_RPM)
+        {
+            snprintf(cOver, sizeof(cOver), "%12.2f", pRes->dOvershoot);
+        }
+        else
+        {
+            snprintf(cOver, sizeof(cOver), "%12s", "-");
+        }
+
+        printf("plant: %-5s %9.1f %8.1f %10.2f %10.2f %s %s %11.3f %7.1f %7.3f %9.3f\n",
+               pWheelName[pRes->ulWheel],
+               (double)pRes->ullStart / HOSTSIM_STM_TICKS_PER_MS, (double)pRes->ullEnd / HOSTSIM_STM_TICKS_PER_MS,
+               pRes->dFromRpm, pRes->dToRpm, cRise, cOver, pRes->dSsErrRpm, pRes->dDuty, pRes->dPeakA, pRes->dEnergyJ);
+    }
+
+    if(ulPlantResultLost != 0u)
+    {
+        printf("plant: %u segments not recorded\n", (unsigned)ulPlantResultLost);
+    }
+}
+
+/*---------------------Static Function--------------------------*/
+/*Duty and bridge inputs of the period starting now*/
+static void HostSimPlant_Latch(void)
+{
+    uint32 ulFront = HOSTSIM_SFR_OF(MODULE_P33).OUT.U;
+    uint32 ulRear  = HOSTSIM_SFR_OF(MODULE_P02).OUT.U;
+    uint32 ulWheel;
+
+    for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+    {
+        HostSimPlant_Wheel *pWheel = &stPlantWheel[ulWheel];
+        const HostSimPlant_Wiring *pWiring = &stPlantWiring[ulWheel];
+        uint32 ulPins = (pWiring->ulFrontBridge != FALSE) ? ulFront : ulRear;
+        uint32 ulInA  = (ulPins >> pWiring->ulInABit) & 0x1u;
+        uint32 ulInB  = (ulPins >> pWiring->ulInBBit) & 0x1u;
+        uint32 ulSr0  = pPlantTomCh[ulWheel]->SR0.U;
+        uint32 ulSr1  = pPlantTomCh[ulWheel]->SR1.U;
+
+        /*SL = 1: high from the period start to CM1, always high from CM0 on*/
+        pWheel->ulOnTicks = (ulSr0 == 0u) ? 0u : ((ulSr1 < ulSr0) ? ((ulSr1 * HOSTSIM_PLANT_PERIOD_TICKS) / ulSr0) : HOSTSIM_PLANT_PERIOD_TICKS);
+
+        if(ulInA != ulInB)
+        {
+            pWheel->ulOnMode   = HOSTSIM_PLANT_DRIVE;
+            pWheel->dDriveSign = (ulInA != 0u) ? 1.0 : -1.0;
+            pWheel->bSense     = TRUE;
+        }
+        else
+        {
+            pWheel->ulOnMode   = HOSTSIM_PLANT_BRAKE;
+            pWheel->dDriveSign = 0.0;
+            pWheel->bSense     = (ulInA == 0u) ? TRUE : FALSE;
+        }
+    }
+}
+
+/*
+ * Write of TOM1 TGC0 GLB_CTRL on the firmware thread: with HOST_TRIG the
+ * OUTEN_CTRL fields of all channels go to OUTEN_STAT now. HOST_TRIG reads 0.
+ */
+static void HostSimPlant_TgcHook(uint32 ulAddr, boolean bWrite)
+{
+    volatile Ifx_GTM_TOM_TGC0_GLB_CTRL *pGlb = &HOSTSIM_SFR_OF(GTM_TOM1_TGC0_GLB_CTRL);
+    uint32 ulCtrl = HOSTSIM_SFR_OF(GTM_TOM1_TGC0_OUTEN_CTRL).U;
+    uint32 ulStat = HOSTSIM_SFR_OF(GTM_TOM1_TGC0_OUTEN_STAT).U;
+    boolean bWasOn = HostSimPlant_OutputOn(0u);
+    uint32 ulCh;
+
+    if((bWrite == FALSE) || (pGlb->B.HOST_TRIG == 0u))
+    {
+        return;
+    }
+
+    pGlb->B.HOST_TRIG = 0u;
+
+    for(ulCh = 0u; ulCh < 8u; ulCh++)
+    {
+        uint32 ulField = (ulCtrl >> (2u * ulCh)) & 0x3u;
+
+        if(ulField == HOSTSIM_PLANT_OUTEN_DISABLE)
+        {
+            ulStat &= ~(0x3u << (2u * ulCh));
+        }
+        else if(ulField == HOSTSIM_PLANT_OUTEN_ENABLE)
+        {
+            ulStat |= HOSTSIM_PLANT_OUTEN_ON << (2u * ulCh);
+        }
+        else
+        {
+            /*No Code*/
+        }
+    }
+
+    HOSTSIM_SFR_OF(GTM_TOM1_TGC0_OUTEN_STAT).U = ulStat;
+
+    if((bWasOn != FALSE) && (HostSimPlant_OutputOn(0u) == FALSE))
+    {
+        ulPlantOutOffCnt++;
+        ullPlantOutOffStart = HostSimStm_Now();
+    }
+    else if((bWasOn == FALSE) && (HostSimPlant_OutputOn(0u) != FALSE) && (ullPlantOutOffStart != 0u))
+    {
+        ullPlantOutOffTicks += HostSimStm_Now() - ullPlantOutOffStart;
+        ullPlantOutOffStart = 0u;
+    }
+    else
+    {
+        /*No Code*/
+    }
+
+    (void)ulAddr;
+}
+
+/*OUTEN_STAT of the TOM1 channel of the wheel*/
+static boolean HostSimPlant_OutputOn(uint32 ulWheel)
+{
+    uint32 ulStat = HOSTSIM_SFR_OF(GTM_TOM1_TGC0_OUTEN_STAT).U;
+
+    return (((ulStat >> (2u * (HOSTSIM_PLANT_TOM_CH_FIRST + ulWheel))) & 0x3u) == HOSTSIM_PLANT_OUTEN_ON) ? TRUE : FALSE;
+}
+
+/*Inputs of VADC G0 at the trigger: the bridge currents CH0..3 in E_MID_TIM_WHEEL order, the supply CH4*/
+static void HostSimPlant_AdcTrigger(void)
+{
+    double dChV[8] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    uint64 ullPos = ullPlantTime - ullPlantPeriodStart;
+    uint32 ulWheel;
+
+    for(ulWheel = 0u; ulWheel < MID_TIM_WHEEL_NUMBER; ulWheel++)
+    {
+        const HostSimPlant_Wheel *pWheel = &stPlantWheel[ulWheel];
+
+        if((ullPos < pWheel->ulOnTicks) && (pWheel->bSense != FALSE))
+        {
+            dChV[ulWheel] = fabs(pWheel->dCurrent) * stPlantParam.dSenseR;
+        }
+    }
+
+    dChV[MID_TIM_WHEEL_NUMBER] = stPlantParam.dSupplyV / stPlantParam.dBatteryDiv;
+
+    HostSimAdc_Convert(dChV, ullPlantTime);
+}
+
+static void HostSimPlant_StepWheel(uint32 ulWheel, uint64 ullStart, uint64 ullTicks, uint32 ulMode)
+{
+    HostSimPlant_Wheel *pWheel = &stPlantWheel[ulWheel];
+    const HostSimPlant_Param *pPar = &stPlantParam;
+    double dDt = (double)ullTicks * HOSTSIM_PLANT_TICK_S;
+    double dJ = pPar->dJm + (pPar->dWheelJ / (pPar->dGear * pPar->dGear));
+    double dFriction = pPar->dFriction + (pPar->dLoad / (pPar->dGear * pPar->dGearEff));
+    double dOmega = pWheel->dOmega;
+    double dOldPos = pWheel->dEdgePos;
+    double dEnergy = 0.0;
+    double dTorque;
+    double dNext;
+
+    if(ullTicks == 0u)
+    {
+        return;
+    }
+
+    dTorque = (pPar->dKe * HostSimPlant_Electrical(pWheel, ulMode, dDt, &dEnergy)) / dDt;
+
+    if((dOmega == 0.0) && (fabs(dTorque) <= pPar->dStiction))
+    {
+        dNext = 0.0;
+    }
+    else
+    {
+        double dSign = (dOmega != 0.0) ? HostSimPlant_Sign(dOmega) : HostSimPlant_Sign(dTorque);
+
+        dNext = dOmega + (((dTorque - (pPar->dViscous * dOmega) - (dSign * dFriction)) / dJ) * dDt);
+
+        /*Friction stops the motor, it does not turn it back*/
+        if((HostSimPlant_Sign(dNext) != dSign) && (fabs(dTorque) <= pPar->dStiction))
+        {
+            dNext = 0.0;
+        }
+    }
+
+    pWheel->dOmega    = dNext;
+    pWheel->dAngle   += 0.5 * (dOmega + dNext) * dDt / pPar->dGear;
+    pWheel->dEdgePos += fabs(0.5 * (dOmega + dNext) * dDt / pPar->dGear) * HOSTSIM_PLANT_EDGE_PER_RAD;
+    pWheel->stSeg.dEnergyJ += dEnergy;
+
+    if(fabs(pWheel->dCurrent) > pWheel->stSeg.dPeakA)
+    {
+        pWheel->stSeg.dPeakA = fabs(pWheel->dCurrent);
+    }
+
+    HostSimPlant_Edges(ulWheel, dOldPos, ullStart, ullTicks);
+}
+
+/*
+ * Armature current over dDt at the present speed: L di/dt = V - s*Voff - R*i - E
+ * with s the sign of i. Returns the charge, *pdEnergy the energy from the
+ * supply (negative when the diodes return it).
+ */
+static double HostSimPlant_Electrical(HostSimPlant_Wheel *pWheel, uint32 ulMode, double dDt, double *pdEnergy)
+{
+    const HostSimPlant_Param *pPar = &stPlantParam;
+    double dEmf = pPar->dKe * pWheel->dOmega;
+    double dSrc = 0.0;
+    double dOff;
+    double dR = pPar->dR;
+    double dCharge = 0.0;
+    double dLeft = dDt;
+    double dI = pWheel->dCurrent;
+    uint32 ulLoop;
+
+    if(ulMode == HOSTSIM_PLANT_DRIVE)
+    {
+        dSrc = pWheel->dDriveSign * pPar->dSupplyV;
+        dOff = pPar->dBridgeDropV;
+        dR  += pPar->dBridgeDropR;
+    }
+    else if(ulMode == HOSTSIM_PLANT_BRAKE)
+    {
+        dOff = pPar->dBridgeDropV;
+        dR  += pPar->dBridgeDropR;
+    }
+    else
+    {
+        dOff = pPar->dSupplyV + (2.0 * pPar->dDiodeV);
+    }
+
+    /*At most: to 0, then from 0 the other way*/
+    for(ulLoop = 0u; (ulLoop < 3u) && (dLeft > 0.0); ulLoop++)
+    {
+        double dTau = pPar->dL / dR;
+        double dSign;
+        double dEnd;
+        double dT;
+
+        if(dI == 0.0)
+        {
+            if((dSrc - dEmf) > dOff)
+            {
+                dSign = 1.0;
+            }
+            else if((dSrc - dEmf) < -dOff)
+            {
+                dSign = -1.0;
+            }
+            else
+            {
+                break;
+            }
+        }
+        else
+        {
+            dSign = HostSimPlant_Sign(dI);
+        }
+
+        dEnd = (dSrc - (dSign * dOff) - dEmf) / dR;
+        dT   = dLeft;
+
+        /*Heading to the other side of 0: the current stops there*/
+        if((dEnd * dSign) < 0.0)
+        {
+            double dZero = dTau * log((dI - dEnd) / -dEnd);
+
+            dT = (dZero < dLeft) ? dZero : dLeft;
+        }
+
+        {
+            double dDecay = exp(-dT / dTau);
+            double dQ = (dEnd * dT) + ((dI - dEnd) * dTau * (1.0 - dDecay));
+
+            dCharge += dQ;
+            dI = (dT < dLeft) ? 0.0 : (dEnd + ((dI - dEnd) * dDecay));
+
+            if(ulMode == HOSTSIM_PLANT_DRIVE)
+            {
+                *pdEnergy += pWheel->dDriveSign * pPar->dSupplyV * dQ;
+            }
+            else if(ulMode == HOSTSIM_PLANT_COAST)
+            {
+                *pdEnergy -= pPar->dSupplyV * fabs(dQ);
+            }
+            else
+            {
+                /*Brake: into the bridge*/
+            }
+        }
+
+        dLeft -= dT;
+    }
+
+    pWheel->dCurrent = dI;
+
+    return dCharge;
+}
+
+/*TIM0 channel of the wheel: the edges passed between dOldPos and dEdgePos*/
+static void HostSimPlant_Edges(uint32 ulWheel, double dOldPos, uint64 ullStart, uint64 ullTicks)
+{
+    HostSimPlant_Wheel *pWheel = &stPlantWheel[ulWheel];
+    volatile Ifx_GTM_TIM_CH *pCh = pPlantTimCh[ulWheel];
+    double dNewPos = pWheel->dEdgePos;
+
+    while((double)(pWheel->ulEdgeCnt + 1u) <= dNewPos)
+    {
+        double dFrac = ((double)(pWheel->ulEdgeCnt + 1u) - dOldPos) / (dNewPos - dOldPos);
+        uint64 ullEdge = ullStart + (uint64)(dFrac * (double)ullTicks);
+
+        pWheel->ulEdgeCnt++;
+        pCh->ECNT.U = pWheel->ulEdgeCnt & 0xFFFFu;
+
+        /*Odd edges are rising*/
+        if((pWheel->ulEdgeCnt & 0x1u) != 0u)
+        {
+            uint32 ulTag = (pWheel->ulEdgeCnt & 0xFFu) << 24;
+            uint64 ullPeriod = (pWheel->bRise != FALSE) ? ((ullEdge - pWheel->ullRiseTime) / HOSTSIM_PLANT_TIM_TICKS) : HOSTSIM_PLANT_CAP_MASK;
+
+            ullPeriod = (ullPeriod < HOSTSIM_PLANT_CAP_MASK) ? ullPeriod : HOSTSIM_PLANT_CAP_MASK;
+
+            pCh->GPR0.U = ulTag | ((uint32)ullEdge & HOSTSIM_PLANT_CAP_MASK);
+            pCh->GPR1.U = ulTag | (uint32)ullPeriod;
+
+            pWheel->ullRiseTime = ullEdge;
+            pWheel->bRise       = TRUE;
+        }
+    }
+}
+
+/*Sample of the response at the end of a PWM period*/
+static void HostSimPlant_Measure(uint32 ulWheel, uint64 ullNow)
+{
+    HostSimPlant_Wheel *pWheel = &stPlantWheel[ulWheel];
+    HostSimPlant_Result *pSeg = &pWheel->stSeg;
+    float32 fTarget = stMotorProfile[stPlantWiring[ulWheel].ulSide].fTarget;
+    double dRpm = HostSimPlant_GetRpm(ulWheel);
+    double dStep;
+    double dDone;
+    uint64 ullBin;
+
+    if(fTarget != pWheel->fTarget)
+    {
+        if(pWheel->bSeg != FALSE)
+        {
+            HostSimPlant_CloseSegment(pWheel, ullNow);
+        }
+
+        if(pWheel->bStop != FALSE)
+        {
+            HostSimPlant_CloseStop(pWheel, 0u);
+        }
+
+        if((fTarget == 0.0f) && (pWheel->fTarget != 0.0f))
+        {
+            pWheel->stStop.ulWheel   = ulWheel;
+            pWheel->stStop.ullStart  = ullNow;
+            pWheel->stStop.dFromRpm  = dRpm;
+            pWheel->stStop.dStartPos = pWheel->dEdgePos;
+            pWheel->bStop = TRUE;
+        }
+
+        memset(pSeg, 0, sizeof(*pSeg));
+        memset(pWheel->dSsSum, 0, sizeof(pWheel->dSsSum));
+        memset(pWheel->ulSsCnt, 0, sizeof(pWheel->ulSsCnt));
+        pSeg->ulWheel    = ulWheel;
+        pSeg->ullStart   = ullNow;
+        pSeg->dFromRpm   = dRpm;
+        pSeg->dToRpm     = (double)fTarget;
+        pSeg->dRiseMs    = -1.0;
+        pWheel->fTarget  = fTarget;
+        pWheel->bSeg     = TRUE;
+        pWheel->ullT10   = 0u;
+        pWheel->dPeak    = 0.0;
+        pWheel->dDutySum = 0.0;
+        pWheel->ullDutyCnt = 0u;
+        pWheel->ullSsBin = 0u;
+    }
+
+    if((pWheel->bStop != FALSE) && (pWheel->dOmega == 0.0))
+    {
+        HostSimPlant_CloseStop(pWheel, ullNow);
+    }
+
+    if(pWheel->bSeg == FALSE)
+    {
+        return;
+    }
+
+    /*Fraction of the change done*/
+    dStep = pSeg->dToRpm - pSeg->dFromRpm;
+
+    if(fabs(dStep) >= HOSTSIM_PLANT_STEP_MIN_RPM)
+    {
+        dDone = (dRpm - pSeg->dFromRpm) / dStep;
+
+        if((pWheel->ullT10 == 0u) && (dDone >= 0.1))
+        {
+            pWheel->ullT10 = ullNow;
+        }
+
+        if((pSeg->dRiseMs < 0.0) && (dDone >= 0.9))
+        {
+            pSeg->dRiseMs = (double)(ullNow - pWheel->ullT10) / HOSTSIM_STM_TICKS_PER_MS;
+        }
+
+        if(((dDone - 1.0) * fabs(dStep)) > pWheel->dPeak)
+        {
+            pWheel->dPeak = (dDone - 1.0) * fabs(dStep);
+        }
+    }
+
+    pWheel->dDutySum += ((double)pWheel->ulOnTicks * 100.0) / (double)HOSTSIM_PLANT_PERIOD_TICKS;
+    pWheel->ullDutyCnt++;
+
+    /*Error of the last bins of the segment*/
+    ullBin = (ullNow - pSeg->ullStart) / HOSTSIM_PLANT_SS_BIN_TICKS;
+
+    while(pWheel->ullSsBin < ullBin)
+    {
+        pWheel->ullSsBin++;
+        pWheel->dSsSum[pWheel->ullSsBin % HOSTSIM_PLANT_SS_BIN_NUMBER]  = 0.0;
+        pWheel->ulSsCnt[pWheel->ullSsBin % HOSTSIM_PLANT_SS_BIN_NUMBER] = 0u;
+    }
+
+    pWheel->dSsSum[ullBin % HOSTSIM_PLANT_SS_BIN_NUMBER] += pSeg->dToRpm - dRpm;
+    pWheel->ulSsCnt[ullBin % HOSTSIM_PLANT_SS_BIN_NUMBER]++;
+}
+
+static void HostSimPlant_CloseSegment(HostSimPlant_Wheel *pWheel, uint64 ullNow)
+{
+    HostSimPlant_Result *pSeg = &pWheel->stSeg;
+    double dSum = 0.0;
+    uint32 ulCnt = 0u;
+    uint32 ulBin;
+
+    for(ulBin = 0u; ulBin < HOSTSIM_PLANT_SS_BIN_NUMBER; ulBin++)
+    {
+        dSum  += pWheel->dSsSum[ulBin];
+        ulCnt += pWheel->ulSsCnt[ulBin];
+    }
+
+    pSeg->ullEnd     = ullNow;
+    pSeg->dSsErrRpm  = (ulCnt != 0u) ? (dSum / (double)ulCnt) : 0.0;
+    pSeg->dDuty      = (pWheel->ullDutyCnt != 0u) ? (pWheel->dDutySum / (double)pWheel->ullDutyCnt) : 0.0;
+    pSeg->dOvershoot = (fabs(pSeg->dToRpm - pSeg->dFromRpm) >= HOSTSIM_PLANT_STEP_MIN_RPM) ?
+                       ((pWheel->dPeak * 100.0) / fabs(pSeg->dToRpm - pSeg->dFromRpm)) : 0.0;
+    pWheel->bSeg     = FALSE;
+
+    if(ulPlantResultNumber < HOSTSIM_PLANT_SEG_NUMBER)
+    {
+        stPlantResult[ulPlantResultNumber] = *pSeg;
+        ulPlantResultNumber++;
+    }
+    else
+    {
+        ulPlantResultLost++;
+    }
+}
+
+/*Shot end and frame start of the steering servo up to ullPlantPeriodStart*/
+static void HostSimPlant_ServoFrame(void)
+{
+    HostSimPlant_Servo *pServo = &stPlantServo;
+
+    if((pServo->ullShotEnd != 0u) && (ullPlantPeriodStart >= pServo->ullShotEnd))
+    {
+        pServo->ulCm1 = pPlantServoCh->SR1.U;
+        pServo->ullShotEnd = 0u;
+    }
+
+    if(ullPlantPeriodStart < pServo->ullFrameNext)
+    {
+        return;
+    }
+
+    pServo->ullShotEnd = pServo->ullFrameNext + ((uint64)pPlantServoCh->CM0.U * HOSTSIM_PLANT_SERVO_CNT_TICKS);
+    pServo->ullFrameNext += HOSTSIM_PLANT_SERVO_FRAME_TICKS;
+
+    if((pPlantServoCh->CTRL.B.OSM == 0u) || (pServo->ulCm1 == 0u))
+    {
+        return;
+    }
+
+    if(pServo->ulFrameCnt == 0u)
+    {
+        pServo->ulMinCnt  = pServo->ulCm1;
+        pServo->ulMaxCnt  = pServo->ulCm1;
+        pServo->ulLastCnt = pServo->ulCm1;
+    }
+
+    pServo->ulMinCnt = (pServo->ulCm1 < pServo->ulMinCnt) ? pServo->ulCm1 : pServo->ulMinCnt;
+    pServo->ulMaxCnt = (pServo->ulCm1 > pServo->ulMaxCnt) ? pServo->ulCm1 : pServo->ulMaxCnt;
+
+    if(pServo->ulCm1 > pServo->ulLastCnt)
+    {
+        pServo->ulStepMaxCnt = ((pServo->ulCm1 - pServo->ulLastCnt) > pServo->ulStepMaxCnt) ? (pServo->ulCm1 - pServo->ulLastCnt) : pServo->ulStepMaxCnt;
+    }
+    else
+    {
+        pServo->ulStepMaxCnt = ((pServo->ulLastCnt - pServo->ulCm1) > pServo->ulStepMaxCnt) ? (pServo->ulLastCnt - pServo->ulCm1) : pServo->ulStepMaxCnt;
+    }
+
+    pServo->ulLastCnt = pServo->ulCm1;
+    pServo->ulFrameCnt++;
+}
+
+/*ullEnd 0 : the wheel did not stand still*/
+static void HostSimPlant_CloseStop(HostSimPlant_Wheel *pWheel, uint64 ullEnd)
+{
+    HostSimPlant_StopResult *pStop = &pWheel->stStop;
+
+    pStop->ullEnd  = ullEnd;
+    pStop->dDistMm = ((pWheel->dEdgePos - pStop->dStartPos) / HOSTSIM_PLANT_EDGE_PER_RAD) * stPlantParam.dWheelD * 500.0;
+    pWheel->bStop  = FALSE;
+
+    if(ulPlantStopNumber < HOSTSIM_PLANT_STOP_NUMBER)
+    {
+        stPlantStop[ulPlantStopNumber] = *pStop;
+        ulPlantStopNumber++;
+    }
+}
+
+static double HostSimPlant_Sign(double dValue)
+{
+    return (dValue < 0.0) ? -1.0 : 1.0;
+}
@@ -0,0 +1,575 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "HostSim.h"
+#include "IfxPort_reg.h"
+#include "IfxScu_reg.h"
+#include "IfxScu_cfg.h"
+#include "IfxCpu_reg.h"
+#include "IfxAsclin_reg.h"
+#include "IfxFlash_reg.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * The emulated register file is a memfd mapped twice:
+ *  - at the physical SFR addresses used by the iLLD (firmware view). Pages
+ *    with side effects (e.g. Port OMR) are PROT_NONE and every access traps;
+ *  - at an arbitrary address (backdoor) used by the simulator thread.
+ * A trapped access is emulated by unprotecting the page, single stepping the
+ * faulting instruction (EFLAGS.TF) and re-protecting the page in SIGTRAP.
+ *
+ * The EEPROM part of the data flash is a region of the same file. Only the
+ * pages of the command addresses trap: the command sequences are decoded
+ * and the array, kept in ulSfrDflash, is restored under them. Erase and
+ * program take HOSTSIM_DFLASH_*_TICKS of D0BUSY, cleared by HostSimSfr_Poll.
+ */
+#define HOSTSIM_PAGE_SIZE               0x1000u
+#define HOSTSIM_REGION_NUMBER           3u
+#define HOSTSIM_HOOK_NUMBER             32u
+#define HOSTSIM_EFLAGS_TF               0x100
+
+#define HOSTSIM_DFLASH_BASE             0xAF000000u
+#define HOSTSIM_DFLASH_SIZE             0x00020000u         /*16 logical sectors of 8KB*/
+#define HOSTSIM_DFLASH_SECTOR_SIZE      0x2000u
+#define HOSTSIM_DFLASH_PAGE_SIZE        8u
+#define HOSTSIM_DFLASH_ERASE_TICKS      (100u * HOSTSIM_STM_TICKS_PER_MS)
+#define HOSTSIM_DFLASH_PROGRAM_TICKS    (HOSTSIM_STM_TICKS_PER_MS / 20u)
+#define HOSTSIM_FSR_D0BUSY              0x00000002u
+#define HOSTSIM_FSR_PROG                0x00000080u
+#define HOSTSIM_FSR_ERASE               0x00000100u
+#define HOSTSIM_FSR_DFPAGE              0x00000400u
+#define HOSTSIM_FSR_SQER                0x00001000u
+#define HOSTSIM_FSR_PVER                0x02000000u
+#define HOSTSIM_FSR_CLEAR_MASK          0x06007800u         /*OPER, SQER, PROER, PFSBER, PVER, EVER*/
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef struct
+{
+    uint32 ulBase;                  /*SFR address of the region*/
+    uint32 ulSize;                  /*Size in bytes*/
+    uint32 ulOffset;                /*Offset inside the memfd*/
+}HostSimSfr_Region;
+
+typedef struct
+{
+    uint32 ulStart;
+    uint32 ulEnd;
+    HostSimSfr_HookFnc pHookFnc;
+}HostSimSfr_Hook;
+
+typedef struct
+{
+    uint8 ucActive;                 /*Single step in progress*/
+    uint8 ucWrite;                  /*Trapped access is a write*/
+    uint8 ucIrqWasBlocked;          /*SIGUSR1 was blocked before the trap*/
+    uint32 ulAddr;                  /*Trapped SFR address*/
+    uint32 ulPage;                  /*Page unprotected for the single step*/
+}HostSimSfr_Step;
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static const HostSimSfr_Region *HostSimSfr_FindRegion(uint32 ulAddr);
+static void HostSimSfr_CallHooks(uint32 ulAddr, boolean bWrite);
+static boolean HostSimSfr_IsTrapped(uint32 ulAddr);
+static void HostSimSfr_SegvHandler(int sig, siginfo_t *pInfo, void *pContext);
+static void HostSimSfr_TrapHandler(int sig, siginfo_t *pInfo, void *pContext);
+static void HostSimSfr_ResetValues(void);
+static void HostSimSfr_PortHook(uint32 ulAddr, boolean bWrite);
+static void HostSimSfr_PmcsrHook(uint32 ulAddr, boolean bWrite);
+static void HostSimSfr_DflashHook(uint32 ulAddr, boolean bWrite);
+static void HostSimSfr_DflashCommand(void);
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static const HostSimSfr_Region stSfrRegion[HOSTSIM_REGION_NUMBER] =
+{
+    {0xF0000000u, 0x00200000u, 0x00000000u},    /*STM, ASCLIN, QSPI, DMA, VADC, SCU, SRC, Ports, GTM*/
+    {0xF8000000u, 0x00900000u, 0x00200000u},    /*PMU, FLASH, LMU, CPU0 SFR/CSFR*/
+    {HOSTSIM_DFLASH_BASE, HOSTSIM_DFLASH_SIZE, 0x00B00000u},    /*DFLASH0 EEPROM, command addresses*/
+};
+
+static uint8 *pucSfrBackdoor;
+static HostSimSfr_Hook stSfrHook[HOSTSIM_HOOK_NUMBER];
+static uint32 ulSfrHookNumber = 0u;
+static HostSimSfr_Step stSfrStep;
+
+static uint32 ulSfrDflash[HOSTSIM_DFLASH_SIZE / 4u];    /*Array content, 0 : erased*/
+static uint32 ulSfrDflashCmd[4];                        /*Writes of the running sequence at AA50, AA58, AAA8*/
+static uint32 ulSfrDflashCmdCnt = 0u;
+static uint32 ulSfrDflashPage[HOSTSIM_DFLASH_PAGE_SIZE / 4u];
+static uint64 ullSfrDflashBusyEnd = 0u;
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void HostSimSfr_Init(void)
+{
+    uint32 ulTotal = 0u;
+    uint32 ulIdx;
+    int fd;
+    struct sigaction stAction;
+
+    for(ulIdx = 0u; ulIdx < HOSTSIM_REGION_NUMBER; ulIdx++)
+    {
+        ulTotal += stSfrRegion[ulIdx].ulSize;
+    }
+
+    fd = memfd_create("hostsim_sfr", 0);
+    if((fd < 0) || (ftruncate(fd, ulTotal) != 0))
+    {
+        perror("hostsim: register file");
+        exit(1);
+    }
+
+    pucSfrBackdoor = mmap(NULL, ulTotal, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(pucSfrBackdoor == MAP_FAILED)
+    {
+        perror("hostsim: backdoor mapping");
+        exit(1);
+    }
+
+    for(ulIdx = 0u; ulIdx < HOSTSIM_REGION_NUMBER; ulIdx++)
+    {
+        void *pView = mmap((void *)(size_t)stSfrRegion[ulIdx].ulBase, stSfrRegion[ulIdx].ulSize,
+                           PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED_NOREPLACE, fd, stSfrRegion[ulIdx].ulOffset);
+
+        if(pView != (void *)(size_t)stSfrRegion[ulIdx].ulBase)
+        {
+            fprintf(stderr, "hostsim: cannot map SFR region 0x%08X\n", stSfrRegion[ulIdx].ulBase);
+            exit(1);
+        }
+    }
+
+    close(fd);
+
+    memset(&stAction, 0, sizeof(stAction));
+    stAction.sa_sigaction = HostSimSfr_SegvHandler;
+    stAction.sa_flags     = SA_SIGINFO | SA_NODEFER;
+    sigaction(SIGSEGV, &stAction, NULL);
+    stAction.sa_sigaction = HostSimSfr_TrapHandler;
+    sigaction(SIGTRAP, &stAction, NULL);
+
+    HostSimSfr_ResetValues();
+
+    /*Port output modification registers act on OUT*/
+    HostSimSfr_RegisterHook(0xF003A000u, 0x5000u, HostSimSfr_PortHook);
+
+    /*CPU0 idle request*/
+    HostSimSfr_RegisterHook((uint32)(size_t)&SCU_PMCSR0, 4u, HostSimSfr_PmcsrHook);
+
+    /*Data flash command sequences and the busy state they start*/
+    HostSimSfr_RegisterHook(HOSTSIM_DFLASH_BASE | 0x5554u, 4u, HostSimSfr_DflashHook);
+    HostSimSfr_RegisterHook(HOSTSIM_DFLASH_BASE | 0x55F0u, 8u, HostSimSfr_DflashHook);
+    HostSimSfr_RegisterHook(HOSTSIM_DFLASH_BASE | 0xAA50u, 0x5Cu, HostSimSfr_DflashHook);
+}
+
+/*---------------------Register File API--------------------------*/
+void *HostSimSfr_Backdoor(uint32 ulAddr)
+{
+    const HostSimSfr_Region *pRegion = HostSimSfr_FindRegion(ulAddr);
+
+    if(pRegion == NULL_PTR)
+    {
+        fprintf(stderr, "hostsim: access to unmapped SFR 0x%08X\n", ulAddr);
+        abort();
+    }
+
+    return &pucSfrBackdoor[pRegion->ulOffset + (ulAddr - pRegion->ulBase)];
+}
+
+void HostSimSfr_RegisterHook(uint32 ulAddr, uint32 ulSize, HostSimSfr_HookFnc pHookFnc)
+{
+    uint32 ulPage;
+
+    if(ulSfrHookNumber >= HOSTSIM_HOOK_NUMBER)
+    {
+        fprintf(stderr, "hostsim: too many SFR hooks\n");
+        exit(1);
+    }
+
+    stSfrHook[ulSfrHookNumber].ulStart   = ulAddr;
+    stSfrHook[ulSfrHookNumber].ulEnd     = ulAddr + ulSize;
+    stSfrHook[ulSfrHookNumber].pHookFnc  = pHookFnc;
+    ulSfrHookNumber++;
+
+    for(ulPage = ulAddr & ~(HOSTSIM_PAGE_SIZE - 1u); ulPage < (ulAddr + ulSize); ulPage += HOSTSIM_PAGE_SIZE)
+    {
+        mprotect((void *)(size_t)ulPage, HOSTSIM_PAGE_SIZE, PROT_NONE);
+    }
+}
+
+/*Data flash content of a previous run, erased if the file does not exist yet*/
+void HostSimSfr_LoadDflash(const char *pFile)
+{
+    FILE *pIn = fopen(pFile, "rb");
+    size_t ulSize;
+
+    if(pIn == NULL)
+    {
+        printf("hostsim: data flash %s not found, starting erased\n", pFile);
+        return;
+    }
+
+    ulSize = fread(ulSfrDflash, 1u, sizeof(ulSfrDflash), pIn);
+    fclose(pIn);
+    memcpy(HostSimSfr_Backdoor(HOSTSIM_DFLASH_BASE), ulSfrDflash, sizeof(ulSfrDflash));
+    printf("hostsim: data flash %u bytes loaded from %s\n", (unsigned)ulSize, pFile);
+}
+
+void HostSimSfr_SaveDflash(const char *pFile)
+{
+    FILE *pOut = fopen(pFile, "wb");
+
+    if((pOut == NULL) || (fwrite(ulSfrDflash, sizeof(ulSfrDflash), 1u, pOut) != 1u))
+    {
+        perror("hostsim: data flash");
+    }
+
+    if(pOut != NULL)
+    {
+        fclose(pOut);
+    }
+}
+
+/*---------------------Static Function--------------------------*/
+static const HostSimSfr_Region *HostSimSfr_FindRegion(uint32 ulAddr)
+{
+    uint32 ulIdx;
+
+    for(ulIdx = 0u; ulIdx < HOSTSIM_REGION_NUMBER; ulIdx++)
+    {
+        if((ulAddr - stSfrRegion[ulIdx].ulBase) < stSfrRegion[ulIdx].ulSize)
+        {
+            return &stSfrRegion[ulIdx];
+        }
+    }
+
+    return NULL_PTR;
+}
+
+static void HostSimSfr_CallHooks(uint32 ulAddr, boolean bWrite)
+{
+    uint32 ulIdx;
+
+    for(ulIdx = 0u; ulIdx < ulSfrHookNumber; ulIdx++)
+    {
+        if((ulAddr >= stSfrHook[ulIdx].ulStart) && (ulAddr < stSfrHook[ulIdx].ulEnd))
+        {
+            stSfrHook[ulIdx].pHookFnc(ulAddr, bWrite);
+        }
+    }
+}
+
+static boolean HostSimSfr_IsTrapped(uint32 ulAddr)
+{
+    uint32 ulIdx;
+    uint32 ulPage = ulAddr & ~(HOSTSIM_PAGE_SIZE - 1u);
+
+    for(ulIdx = 0u; ulIdx < ulSfrHookNumber; ulIdx++)
+    {
+        if((ulPage < stSfrHook[ulIdx].ulEnd) && ((ulPage + HOSTSIM_PAGE_SIZE) > stSfrHook[ulIdx].ulStart))
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+static void HostSimSfr_SegvHandler(int sig, siginfo_t *pInfo, void *pContext)
+{
+    ucontext_t *pUc = (ucontext_t *)pContext;
+    size_t addr = (size_t)pInfo->si_addr;
+
+    if((addr > 0xFFFFFFFFu) || (stSfrStep.ucActive != 0u) || (HostSimSfr_IsTrapped((uint32)addr) == FALSE))
+    {
+        /*Real fault: let the default action produce the core dump*/
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+
+    stSfrStep.ucActive = 1u;
+    stSfrStep.ucWrite  = ((pUc->uc_mcontext.gregs[REG_ERR] & 0x2) != 0) ? 1u : 0u;
+    stSfrStep.ulAddr   = (uint32)addr;
+    stSfrStep.ulPage   = (uint32)addr & ~(HOSTSIM_PAGE_SIZE - 1u);
+
+    if(stSfrStep.ucWrite == 0u)
+    {
+        HostSimSfr_CallHooks(stSfrStep.ulAddr, FALSE);
+    }
+
+    /*No interrupt may enter while the page is open*/
+    stSfrStep.ucIrqWasBlocked = (uint8)sigismember(&pUc->uc_sigmask, SIGUSR1);
+    sigaddset(&pUc->uc_sigmask, SIGUSR1);
+
+    mprotect((void *)(size_t)stSfrStep.ulPage, HOSTSIM_PAGE_SIZE, PROT_READ | PROT_WRITE);
+    pUc->uc_mcontext.gregs[REG_EFL] |= HOSTSIM_EFLAGS_TF;
+    (void)sig;
+}
+
+static void HostSimSfr_TrapHandler(int sig, siginfo_t *pInfo, void *pContext)
+{
+    ucontext_t *pUc = (ucontext_t *)pContext;
+
+    if(stSfrStep.ucActive == 0u)
+    {
+        signal(SIGTRAP, SIG_DFL);
+        return;
+    }
+
+    mprotect((void *)(size_t)stSfrStep.ulPage, HOSTSIM_PAGE_SIZE, PROT_NONE);
+    pUc->uc_mcontext.gregs[REG_EFL] &= ~HOSTSIM_EFLAGS_TF;
+
+    if(stSfrStep.ucIrqWasBlocked == 0u)
+    {
+        sigdelset(&pUc->uc_sigmask, SIGUSR1);
+    }
+
+    stSfrStep.ucActive = 0u;
+
+    if(stSfrStep.ucWrite != 0u)
+    {
+        HostSimSfr_CallHooks(stSfrStep.ulAddr, TRUE);
+    }
+    (void)sig;
+    (void)pInfo;
+}
+
+/*Registers the iLLD polls after reset or after a request*/
+static void HostSimSfr_ResetValues(void)
+{
+    HOSTSIM_SFR_OF(CPU0_CORE_ID).U = 0u;
+    HOSTSIM_SFR_OF(CPU0_ICR).U     = 0u;
+
+    /*Clock tree as left by the startup code: fOsc0 20MHz, fPll 200MHz*/
+    HOSTSIM_SFR_OF(SCU_PLLCON0).B.PDIV    = 2u - 1u;
+    HOSTSIM_SFR_OF(SCU_PLLCON0).B.NDIV    = 60u - 1u;
+    HOSTSIM_SFR_OF(SCU_PLLCON1).B.K2DIV   = 3u - 1u;
+    HOSTSIM_SFR_OF(SCU_CCUCON0).U         = IFXSCU_CFG_CCUCON0;
+    HOSTSIM_SFR_OF(SCU_CCUCON0).B.CLKSEL  = IfxScu_CCUCON0_CLKSEL_fPll;
+    HOSTSIM_SFR_OF(SCU_CCUCON1).U         = IFXSCU_CFG_CCUCON1;
+    HOSTSIM_SFR_OF(SCU_CCUCON1).B.INSEL   = IfxScu_CCUCON1_INSEL_fOsc0;
+}
+
+/*---------------------Peripheral Model--------------------------*/
+/*Status bits the iLLD polls, updated by the simulator thread*/
+void HostSimSfr_Poll(void)
+{
+    volatile Ifx_ASCLIN *pAsc = &HOSTSIM_SFR_OF(MODULE_ASCLIN0);
+
+    pAsc->CSR.B.CON = (pAsc->CSR.B.CLKSEL != 0u) ? 1u : 0u;
+
+    /*The firmware thread only sets D0BUSY while it is clear*/
+    if(((HOSTSIM_SFR_OF(FLASH0_FSR).U & HOSTSIM_FSR_D0BUSY) != 0u) && (HostSimStm_Now() >= ullSfrDflashBusyEnd))
+    {
+        __atomic_fetch_and(&HOSTSIM_SFR_OF(FLASH0_FSR).U, ~(HOSTSIM_FSR_D0BUSY | HOSTSIM_FSR_PROG | HOSTSIM_FSR_ERASE), __ATOMIC_SEQ_CST);
+    }
+}
+
+static void HostSimSfr_PortHook(uint32 ulAddr, boolean bWrite)
+{
+    uint32 ulPort = ulAddr & ~0xFFu;
+    uint32 ulReg  = ulAddr & 0xFCu;
+    volatile Ifx_P *pPort = &HOSTSIM_SFR(Ifx_P, ulPort);
+    uint32 ulSet = 0u;
+    uint32 ulClr = 0u;
+
+    if(bWrite == FALSE)
+    {
+        return;
+    }
+
+    if(ulReg == 0x04u)                                          /*OMR: PSx in [15:0], PCLx in [31:16]*/
+    {
+        ulSet = pPort->OMR.U & 0xFFFFu;
+        ulClr = pPort->OMR.U >> 16;
+        pPort->OMR.U = 0u;
+    }
+    else if((ulReg >= 0x70u) && (ulReg <= 0x7Cu))               /*OMSR0..12*/
+    {
+        ulSet = *(volatile uint32 *)((volatile uint8 *)pPort + ulReg) & 0xFFFFu;
+        *(volatile uint32 *)((volatile uint8 *)pPort + ulReg) = 0u;
+    }
+    else if((ulReg >= 0x80u) && (ulReg <= 0x8Cu))               /*OMCR0..12*/
+    {
+        ulClr = *(volatile uint32 *)((volatile uint8 *)pPort + ulReg) >> 16;
+        *(volatile uint32 *)((volatile uint8 *)pPort + ulReg) = 0u;
+    }
+    else if(ulReg == 0x90u)                                     /*OMSR*/
+    {
+        ulSet = pPort->OMSR.U & 0xFFFFu;
+        pPort->OMSR.U = 0u;
+    }
+    else if(ulReg == 0x94u)                                     /*OMCR*/
+    {
+        ulClr = pPort->OMCR.U >> 16;
+        pPort->OMCR.U = 0u;
+    }
+    else
+    {
+        /*Plain register*/
+    }
+
+    /*PSx and PCLx both set toggles the pin*/
+    pPort->OUT.U = ((pPort->OUT.U | (ulSet & ~ulClr)) & ~(ulClr & ~ulSet)) ^ (ulSet & ulClr);
+    pPort->IN.U  = pPort->OUT.U;
+}
+
+/*REQSLP = idle stops the CPU until the next interrupt, then reads back run*/
+static void HostSimSfr_PmcsrHook(uint32 ulAddr, boolean bWrite)
+{
+    volatile Ifx_SCU_PMCSR *pPmcsr = &HOSTSIM_SFR(Ifx_SCU_PMCSR, ulAddr);
+
+    if((bWrite == FALSE) || (pPmcsr->B.REQSLP != IfxScu_PMCSR_REQSLP_Idle))
+    {
+        return;
+    }
+
+    pPmcsr->B.PMST = 3u;                                        /*Idle mode*/
+    HostSimIrq_WaitForInterrupt();
+    pPmcsr->B.PMST   = 1u;                                      /*Run mode*/
+    pPmcsr->B.REQSLP = IfxScu_PMCSR_REQSLP_Run;
+}
+
+/*
+ * Command writes of IfxFlash: 5554 enter page mode (5D), reset to read (F0),
+ * clear status (FA); 55F0/55F4 load page; AA50, AA58, AAA8, AAA8 erase
+ * logical sectors (addr, n, 80, 50) or write page (addr, 0, A0, AA).
+ */
+static void HostSimSfr_DflashHook(uint32 ulAddr, boolean bWrite)
+{
+    volatile uint32 *pWord = &HOSTSIM_SFR(uint32, ulAddr & ~3u);
+    volatile Ifx_FLASH_FSR *pFsr = &HOSTSIM_SFR_OF(FLASH0_FSR);
+    uint32 ulOffset = (ulAddr & ~3u) - HOSTSIM_DFLASH_BASE;
+    uint32 ulData;
+
+    if(bWrite == FALSE)
+    {
+        return;
+    }
+
+    /*The array under the command address is not changed by the write*/
+    ulData = *pWord;
+    *pWord = ulSfrDflash[ulOffset / 4u];
+
+    if(ulOffset == 0x5554u)
+    {
+        if(ulData == 0x5Du)
+        {
+            __atomic_fetch_or(&pFsr->U, HOSTSIM_FSR_DFPAGE, __ATOMIC_SEQ_CST);
+        }
+        else if(ulData == 0xF0u)
+        {
+            __atomic_fetch_and(&pFsr->U, ~HOSTSIM_FSR_DFPAGE, __ATOMIC_SEQ_CST);
+            ulSfrDflashCmdCnt = 0u;
+        }
+        else if(ulData == 0xFAu)
+        {
+            __atomic_fetch_and(&pFsr->U, ~HOSTSIM_FSR_CLEAR_MASK, __ATOMIC_SEQ_CST);
+        }
+        else
+        {
+            __atomic_fetch_or(&pFsr->U, HOSTSIM_FSR_SQER, __ATOMIC_SEQ_CST);
+        }
+    }
+    else if((ulOffset == 0x55F0u) || (ulOffset == 0x55F4u))
+    {
+        ulSfrDflashPage[(ulOffset - 0x55F0u) / 4u] = ulData;
+    }
+    else if(ulOffset == 0xAA50u)
+    {
+        ulSfrDflashCmd[0] = ulData;
+        ulSfrDflashCmdCnt = 1u;
+    }
+    else if((ulOffset == 0xAA58u) && (ulSfrDflashCmdCnt == 1u))
+    {
+        ulSfrDflashCmd[1] = ulData;
+        ulSfrDflashCmdCnt = 2u;
+    }
+    else if((ulOffset == 0xAAA8u) && ((ulSfrDflashCmdCnt == 2u) || (ulSfrDflashCmdCnt == 3u)))
+    {
+        ulSfrDflashCmd[ulSfrDflashCmdCnt] = ulData;
+        ulSfrDflashCmdCnt++;
+
+        if(ulSfrDflashCmdCnt == 4u)
+        {
+            HostSimSfr_DflashCommand();
+            ulSfrDflashCmdCnt = 0u;
+        }
+    }
+    else
+    {
+        __atomic_fetch_or(&pFsr->U, HOSTSIM_FSR_SQER, __ATOMIC_SEQ_CST);
+        ulSfrDflashCmdCnt = 0u;
+    }
+}
+
+static void HostSimSfr_DflashCommand(void)
+{
+    volatile Ifx_FLASH_FSR *pFsr = &HOSTSIM_SFR_OF(FLASH0_FSR);
+    uint32 *pArray = (uint32 *)HostSimSfr_Backdoor(HOSTSIM_DFLASH_BASE);
+    uint32 ulOffset = ulSfrDflashCmd[0] - HOSTSIM_DFLASH_BASE;
+    uint32 ulIdx;
+
+    if(((pFsr->U & HOSTSIM_FSR_D0BUSY) != 0u) || (ulOffset >= HOSTSIM_DFLASH_SIZE))
+    {
+        __atomic_fetch_or(&pFsr->U, HOSTSIM_FSR_SQER, __ATOMIC_SEQ_CST);
+    }
+    else if((ulSfrDflashCmd[2] == 0x80u) && (ulSfrDflashCmd[3] == 0x50u))
+    {
+        uint32 ulFirst = ulOffset / HOSTSIM_DFLASH_SECTOR_SIZE;
+        uint32 ulEnd   = ulFirst + ulSfrDflashCmd[1];
+
+        ulEnd = (ulEnd > (HOSTSIM_DFLASH_SIZE / HOSTSIM_DFLASH_SECTOR_SIZE)) ? (HOSTSIM_DFLASH_SIZE / HOSTSIM_DFLASH_SECTOR_SIZE) : ulEnd;
+
+        for(ulIdx = ulFirst * (HOSTSIM_DFLASH_SECTOR_SIZE / 4u); ulIdx < (ulEnd * (HOSTSIM_DFLASH_SECTOR_SIZE / 4u)); ulIdx++)
+        {
+            ulSfrDflash[ulIdx] = 0u;
+            pArray[ulIdx]      = 0u;
+        }
+
+        ullSfrDflashBusyEnd = HostSimStm_Now() + ((uint64)(ulEnd - ulFirst) * HOSTSIM_DFLASH_ERASE_TICKS);
+        __atomic_fetch_or(&pFsr->U, HOSTSIM_FSR_D0BUSY | HOSTSIM_FSR_ERASE, __ATOMIC_SEQ_CST);
+    }
+    else if((ulSfrDflashCmd[2] == 0xA0u) && (ulSfrDflashCmd[3] == 0xAAu) && ((pFsr->U & HOSTSIM_FSR_DFPAGE) != 0u))
+    {
+        ulIdx = (ulOffset & ~(HOSTSIM_DFLASH_PAGE_SIZE - 1u)) / 4u;
+
+        /*Bits can only be set until the next erase*/
+        if((ulSfrDflash[ulIdx] != 0u) || (ulSfrDflash[ulIdx + 1u] != 0u))
+        {
+            fprintf(stderr, "hostsim: data flash page 0x%08X programmed twice\n", HOSTSIM_DFLASH_BASE + (ulIdx * 4u));
+            __atomic_fetch_or(&pFsr->U, HOSTSIM_FSR_PVER, __ATOMIC_SEQ_CST);
+        }
+
+        ulSfrDflash[ulIdx]      |= ulSfrDflashPage[0];
+        ulSfrDflash[ulIdx + 1u] |= ulSfrDflashPage[1];
+        pArray[ulIdx]      = ulSfrDflash[ulIdx];
+        pArray[ulIdx + 1u] = ulSfrDflash[ulIdx + 1u];
+
+        ullSfrDflashBusyEnd = HostSimStm_Now() + HOSTSIM_DFLASH_PROGRAM_TICKS;
+        __atomic_fetch_and(&pFsr->U, ~HOSTSIM_FSR_DFPAGE, __ATOMIC_SEQ_CST);
+        __atomic_fetch_or(&pFsr->U, HOSTSIM_FSR_D0BUSY | HOSTSIM_FSR_PROG, __ATOMIC_SEQ_CST);
+    }
+    else
+    {
+        __atomic_fetch_or(&pFsr->U, HOSTSIM_FSR_SQER, __ATOMIC_SEQ_CST);
+    }
+}
@@ -0,0 +1,162 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "HostSim.h"
+#include "IfxStm_reg.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * Virtual STM0. The 64 bit counter only moves when the simulator thread sets
+ * it; TIM0..TIM6 and CAP are refreshed from it on every update, so the
+ * firmware and the iLLD read the timer like on the target.
+ */
+#define HOSTSIM_STM_COMPARE_NUMBER      2u
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static uint64 HostSimStm_NextMatch(uint32 ulCmp, uint64 ullAfter);
+static void HostSimStm_ClearFlags(void);
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static volatile uint64 ullStmNow = 0u;
+static uint64 ullStmLastFired[HOSTSIM_STM_COMPARE_NUMBER];
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Init Function--------------------------*/
+void HostSimStm_Init(void)
+{
+    HostSimStm_Set(0u);
+}
+
+/*---------------------Counter--------------------------*/
+uint64 HostSimStm_Now(void)
+{
+    return ullStmNow;
+}
+
+void HostSimStm_Set(uint64 ullTicks)
+{
+    volatile Ifx_STM *pStm = &HOSTSIM_SFR_OF(MODULE_STM0);
+
+    ullStmNow = ullTicks;
+
+    pStm->TIM0.U = (uint32)(ullTicks);
+    pStm->TIM1.U = (uint32)(ullTicks >> 4);
+    pStm->TIM2.U = (uint32)(ullTicks >> 8);
+    pStm->TIM3.U = (uint32)(ullTicks >> 16);
+    pStm->TIM4.U = (uint32)(ullTicks >> 20);
+    pStm->TIM5.U = (uint32)(ullTicks >> 24);
+    pStm->TIM6.U = (uint32)(ullTicks >> 32);
+    pStm->CAP.U  = (uint32)(ullTicks >> 32);
+
+    HostSimStm_ClearFlags();
+}
+
+/*---------------------Compare--------------------------*/
+/*Earliest enabled compare match after the current time, or ullLimit*/
+uint64 HostSimStm_NextEvent(uint64 ullLimit)
+{
+    volatile Ifx_STM *pStm = &HOSTSIM_SFR_OF(MODULE_STM0);
+    uint64 ullNext = ullLimit;
+    uint32 ulCmp;
+
+    for(ulCmp = 0u; ulCmp < HOSTSIM_STM_COMPARE_NUMBER; ulCmp++)
+    {
+        uint64 ullAfter = (ullStmLastFired[ulCmp] > ullStmNow) ? ullStmLastFired[ulCmp] : ullStmNow;
+        uint64 ullMatch;
+
+        if((pStm->ICR.U & (0x1u << (ulCmp * 4u))) == 0u)
+        {
+            continue;
+        }
+
+        ullMatch = HostSimStm_NextMatch(ulCmp, ullAfter);
+
+        if(ullMatch < ullNext)
+        {
+            ullNext = ullMatch;
+        }
+    }
+
+    return ullNext;
+}
+
+/*Raise the compare interrupts matching at the current time*/
+void HostSimStm_Fire(void)
+{
+    volatile Ifx_STM *pStm = &HOSTSIM_SFR_OF(MODULE_STM0);
+    uint32 ulCmp;
+
+    for(ulCmp = 0u; ulCmp < HOSTSIM_STM_COMPARE_NUMBER; ulCmp++)
+    {
+        uint64 ullAfter = (ullStmNow > 0u) ? (ullStmNow - 1u) : 0u;
+        uint32 ulIcr;
+
+        if((HostSimStm_NextMatch(ulCmp, ullAfter) != ullStmNow) || (ullStmLastFired[ulCmp] == ullStmNow))
+        {
+            continue;
+        }
+
+        ullStmLastFired[ulCmp] = ullStmNow;
+        ulIcr = pStm->ICR.U;
+
+        /*CMPxIR, and the request on the SRC selected by CMPxOS if CMPxEN*/
+        pStm->ICR.U = ulIcr | (0x2u << (ulCmp * 4u));
+
+        if((ulIcr & (0x1u << (ulCmp * 4u))) != 0u)
+        {
+            boolean bOs = (boolean)((ulIcr >> ((ulCmp * 4u) + 2u)) & 0x1u);
+
+            HostSimIrq_Raise((bOs == FALSE) ? &SRC_STM0SR0 : &SRC_STM0SR1);
+        }
+    }
+}
+
+/*---------------------Static Function--------------------------*/
+/*First time > ullAfter at which STM[MSTART+MSIZE:MSTART] equals CMPx*/
+static uint64 HostSimStm_NextMatch(uint32 ulCmp, uint64 ullAfter)
+{
+    volatile Ifx_STM *pStm = &HOSTSIM_SFR_OF(MODULE_STM0);
+    uint32 ulCmcon = pStm->CMCON.U >> (ulCmp * 16u);
+    uint32 ulMsize = ulCmcon & 0x1Fu;
+    uint32 ulMstart = (ulCmcon >> 8) & 0x1Fu;
+    uint64 ullMask = ((2ull << ulMsize) - 1u) << ulMstart;
+    uint64 ullValue = ((uint64)(ulCmp == 0u ? pStm->CMP[0].U : pStm->CMP[1].U) << ulMstart) & ullMask;
+    uint64 ullMatch = (ullAfter & ~(ullMask | ((1ull << ulMstart) - 1u))) | ullValue;
+
+    if(ullMatch <= ullAfter)
+    {
+        ullMatch += ullMask + (1ull << ulMstart);
+    }
+
+    return ullMatch;
+}
+
+/*ISCR is write only: CMPxIRR / CMPxIRS act on ICR.CMPxIR*/
+static void HostSimStm_ClearFlags(void)
+{
+    volatile Ifx_STM *pStm = &HOSTSIM_SFR_OF(MODULE_STM0);
+    uint32 ulIscr = pStm->ISCR.U;
+
+    if(ulIscr != 0u)
+    {
+        uint32 ulIcr = pStm->ICR.U;
+
+        ulIcr &= ~(((ulIscr & 0x1u) << 1) | ((ulIscr & 0x4u) << 3));
+        ulIcr |= ((ulIscr & 0x2u) << 0) | ((ulIscr & 0x8u) << 2);
+        pStm->ICR.U  = ulIcr;
+        pStm->ISCR.U = 0u;
+    }
+}
@@ -0,0 +1,304 @@
+/**
+ * \file IfxCpu_IntrinsicsHostSim.h
+ *
+ * \brief TriCore intrinsics for the host-native simulation build.
+ *
+ * Arithmetic intrinsics are implemented in portable C. Core special function
+ * registers (__mfcr/__mtcr) are backed by the emulated CPU0 SFR block so that
+ * CPU_ICR, CPU_CORE_ID, ... are visible with the same layout as on the target.
+ * Interrupt enable/disable is forwarded to the emulated interrupt router.
+ */
+
+#ifndef IFXCPU_INTRINSICSHOSTSIM_H
+#define IFXCPU_INTRINSICSHOSTSIM_H
+
+/******************************************************************************/
+/* math.h first: glibc declares __sqrtf, __fabs, ... which are macros here */
+#include <math.h>
+#include "Ifx_Types.h"
+
+/******************************************************************************/
+/* *INDENT-OFF* */
+#define STRINGIFY(x)    #x
+
+/** Base address of the memory mapped core SFRs of CPU0 */
+#define HOSTSIM_CPU0_CSFR_BASE          (0xF8810000u)
+
+IFX_EXTERN void   HostSimIrq_Enable(void);
+IFX_EXTERN void   HostSimIrq_Disable(void);
+IFX_EXTERN sint32 HostSimIrq_DisableAndSave(void);
+IFX_EXTERN void   HostSimIrq_Restore(sint32 ie);
+IFX_EXTERN void   HostSimIrq_Bisr(uint32 intlvl);
+IFX_EXTERN void   HostSimCpu_Wait(void);
+
+#define __non_return_call(fun)          ((void (*)(void))(fun))()
+
+IFX_INLINE void __jump_and_link(void (*fun)(void))
+{
+    fun();
+}
+
+/** \defgroup IfxLld_Cpu_Intrinsics_HostSimmin_smax Minimum and Maximum of (Short) Integers
+ * \{
+ */
+#define __minX(X,Y)                     ( ((X) < (Y)) ? (X) : (Y) )
+#define __maxX(X,Y)                     ( ((X) > (Y)) ? (X) : (Y) )
+#define __saturateX(X,Min,Max)          ( __minX(__maxX(X, Min), Max) )
+#define __checkrangeX(X,Min,Max)        (((X) >= (Min)) && ((X) <= (Max)))
+
+#define __saturate(X,Min,Max)           ( __min(__max(X, Min), Max) )
+#define __saturateu(X,Min,Max)          ( __minu(__maxu(X, Min), Max) )
+
+IFX_INLINE sint32 __max(sint32 a, sint32 b)   { return (a > b) ? a : b; }
+IFX_INLINE sint32 __maxs(sint16 a, sint16 b)  { return (a > b) ? a : b; }
+IFX_INLINE uint32 __maxu(uint32 a, uint32 b)  { return (a > b) ? a : b; }
+IFX_INLINE sint32 __min(sint32 a, sint32 b)   { return (a < b) ? a : b; }
+IFX_INLINE sint16 __mins(sint16 a, sint16 b)  { return (a < b) ? a : b; }
+IFX_INLINE uint32 __minu(uint32 a, uint32 b)  { return (a < b) ? a : b; }
+/** \} */
+
+/** \defgroup IfxLld_Cpu_Intrinsics_HostSimfloat Floating point operation
+ * \{
+ */
+#define __sqrf(X)                       ((X) * (X))
+#define __sqrtf(X)                      sqrtf(X)
+#define __checkrange(X,Min,Max)         (((X) >= (Min)) && ((X) <= (Max)))
+
+#define __roundf(X)                     ((((X) - (sint32)(X)) > 0.5) ? (1 + (sint32)(X)) : ((sint32)(X)))
+#define __absf(X)                       ( ((X) < 0.0) ? -(X) : (X) )
+#define __minf(X,Y)                     ( ((X) < (Y)) ? (X) : (Y) )
+#define __maxf(X,Y)                     ( ((X) > (Y)) ? (X) : (Y) )
+#define __saturatef(X,Min,Max)          ( __minf(__maxf(X, Min), Max) )
+#define __checkrangef(X,Min,Max)        (((X) >= (Min)) && ((X) <= (Max)))
+
+#define __abs_stdreal(X)                ( ((X) > 0.0) ? (X) : -(X) )
+#define __min_stdreal(X,Y)              ( ((X) < (Y)) ? (X) : (Y) )
+#define __max_stdreal(X,Y)              ( ((X) > (Y)) ? (X) : (Y) )
+#define __saturate_stdreal(X,Min,Max)   ( __min_stdreal(__max_stdreal(X, Min), Max) )
+
+#define __neqf(X,Y)                     ( ((X) > (Y)) ||  ((X) < (Y)) )     /**< X != Y */
+#define __leqf(X,Y)                     ( !((X) > (Y)) )     /**< X <= Y */
+#define __geqf(X,Y)                     ( !((X) < (Y)) )     /**< X >= Y */
+
+IFX_INLINE float __fract_to_float(fract a)    { return (float)a / 2147483648.0f; }
+IFX_INLINE fract __float_to_fract(float a)
+{
+    float s = a * 2147483648.0f;
+    return (s >= 2147483647.0f) ? (fract)0x7FFFFFFF : ((s <= -2147483648.0f) ? (fract)0x80000000 : (fract)s);
+}
+#define __fabs(d)                       fabs(d)
+#define __fabsf(f)                      fabsf(f)
+/** \} */
+
+/** \defgroup IfxLld_Cpu_Intrinsics_HostSimbit Bit Operations
+ * \{
+ */
+IFX_INLINE sint32 __extr(sint32 a, uint32 p, uint32 w)
+{
+    return (w == 0u) ? 0 : (sint32)((uint32)a << (32u - p - w)) >> (32u - w);
+}
+
+IFX_INLINE uint32 __extru(uint32 a, uint32 p, uint32 w)
+{
+    return (w == 0u) ? 0u : ((a >> p) & (0xFFFFFFFFu >> (32u - w)));
+}
+
+#define __getbit(address, bitoffset) ((*(address) & (1U << (bitoffset))) != 0)
+
+#define __imaskldmst(address, value, bitoffset, bits) \
+    { *(volatile uint32 *)(address) = (*(volatile uint32 *)(address) & ~(((1u << (bits)) - 1u) << (bitoffset))) \
+                                      | (((uint32)(value) & ((1u << (bits)) - 1u)) << (bitoffset)); }
+
+IFX_INLINE sint32 __insert(sint32 a, sint32 b, sint32 p, const sint32 w)
+{
+    uint32 mask = (w >= 32) ? 0xFFFFFFFFu : (((1u << w) - 1u) << p);
+    return (sint32)(((uint32)a & ~mask) | (((uint32)b << p) & mask));
+}
+
+IFX_INLINE sint32 __ins(sint32 trg, const sint32 trgbit, sint32 src, const sint32 srcbit)
+{
+    return __insert(trg, ((uint32)src >> srcbit) & 1u, trgbit, 1);
+}
+
+IFX_INLINE sint32 __insn(sint32 trg, const sint32 trgbit, sint32 src, const sint32 srcbit)
+{
+    return __insert(trg, (~((uint32)src >> srcbit)) & 1u, trgbit, 1);
+}
+
+#define __putbit(value,address,bitoffset ) __imaskldmst(address, value, bitoffset,1)
+
+#define __abs(a) __builtin_abs(a)
+#define __clz(a) (((a) == 0) ? 32 : __builtin_clz(a))
+
+IFX_INLINE sint32 __absdif(sint32 a, sint32 b) { return (a > b) ? (a - b) : (b - a); }
+IFX_INLINE sint32 __abss(sint32 a)             { return (a == (sint32)0x80000000) ? 0x7FFFFFFF : __builtin_abs(a); }
+IFX_INLINE sint32 __clo(sint32 a)              { return __clz(~(uint32)a); }
+IFX_INLINE sint32 __cls(sint32 a)              { return ((a < 0) ? __clo(a) : __clz(a)) - 1; }
+IFX_INLINE sint32 __parity(sint32 a)           { return __builtin_parity((uint32)a); }
+IFX_INLINE sint32 __popcnt(sint32 a)           { return __builtin_popcount((uint32)a); }
+
+IFX_INLINE uint32 __rol(uint32 operand, uint32 count)
+{
+    count &= 31u;
+    return (count == 0u) ? operand : ((operand << count) | (operand >> (32u - count)));
+}
+
+IFX_INLINE uint32 __ror(uint32 operand, uint32 count)
+{
+    count &= 31u;
+    return (count == 0u) ? operand : ((operand >> count) | (operand << (32u - count)));
+}
+
+IFX_INLINE sint32 __mulsc(sint32 a, sint32 b, sint32 offset)
+{
+    return (sint32)(((sint64)a * (sint64)b) >> (32 - offset));
+}
+/** \} */
+
+/** \defgroup IfxLld_Cpu_Intrinsics_HostSimsaturation Saturation Arithmetic Support
+ * \{
+ */
+IFX_INLINE sint8  __satb(sint32 a)  { return (sint8)__saturateX(a, -128, 127); }
+IFX_INLINE uint8  __satbu(sint32 a) { return (uint8)__saturateX(a, 0, 255); }
+IFX_INLINE sint16 __sath(sint32 a)  { return (sint16)__saturateX(a, -32768, 32767); }
+IFX_INLINE uint16 __sathu(sint32 a) { return (uint16)__saturateX(a, 0, 65535); }
+
+IFX_INLINE sint32 __adds(sint32 a, sint32 b)
+{
+    sint64 r = (sint64)a + (sint64)b;
+    return (sint32)__saturateX(r, (sint64)(-2147483647 - 1), (sint64)2147483647);
+}
+
+IFX_INLINE uint32 __addsu(uint32 a, uint32 b)
+{
+    uint64 r = (uint64)a + (uint64)b;
+    return (r > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (uint32)r;
+}
+
+IFX_INLINE sint32 __subs(sint32 a, sint32 b)
+{
+    sint64 r = (sint64)a - (sint64)b;
+    return (sint32)__saturateX(r, (sint64)(-2147483647 - 1), (sint64)2147483647);
+}
+
+IFX_INLINE uint32 __subsu(uint32 a, uint32 b)
+{
+    return (a > b) ? (a - b) : 0u;
+}
+/** \} */
+
+/** \defgroup IfxLld_Cpu_Intrinsics_HostSimcsfr Core special function registers
+ * \{
+ */
+#define __mfcr(regaddr)       ((sint32)(*(volatile uint32 *)(HOSTSIM_CPU0_CSFR_BASE + (uint32)(regaddr))))
+#define __mtcr(regaddr,val)   (*(volatile uint32 *)(HOSTSIM_CPU0_CSFR_BASE + (uint32)(regaddr)) = (uint32)(val))
+/** \} */
+
+/** \defgroup IfxLld_Cpu_Intrinsics_HostSiminterrupt_handling Interrupt Handling
+ * \{
+ */
+#define __bisr(intlvl)        HostSimIrq_Bisr(intlvl)
+#define __disable()           HostSimIrq_Disable()
+#define __enable()            HostSimIrq_Enable()
+
+IFX_INLINE sint32 __disable_and_save(void)
+{
+    return HostSimIrq_DisableAndSave();
+}
+
+IFX_INLINE void __restore(sint32 ie)
+{
+    HostSimIrq_Restore(ie);
+}
+
+#define __syscall(svcno)
+#define __tric_syscall(svcno)
+/** \} */
+
+/** \defgroup IfxLld_Cpu_Intrinsics_HostSimsingle_assembly Insert Single Assembly Instruction
+ * \{
+ */
+IFX_INLINE void __debug(void)     { }
+IFX_INLINE void __dsync(void)     { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+IFX_INLINE void __isync(void)     { __atomic_signal_fence(__ATOMIC_SEQ_CST); }
+IFX_INLINE void __nop(void)       { __asm__ volatile ("nop" : : : "memory"); }
+IFX_INLINE void __rslcx(void)     { }
+IFX_INLINE void __svlcx(void)     { }
+IFX_INLINE void __cacheawi(uint8 *p) { (void)p; }
+IFX_INLINE void __cacheiwi(uint8 *p) { (void)p; }
+IFX_INLINE void __cacheai(uint8 *p)  { (void)p; }
+IFX_INLINE uint8 *__cacheawi_bo_post_inc(uint8 *p) { return p; }
+
+IFX_INLINE void __nops(void *cnt)
+{
+    volatile uint32 i;
+
+    for (i = 0; i < (uint32)(size_t)cnt; i++)
+    {}
+}
+
+#define NOP(n)   do { uint32 nop_i_; for (nop_i_ = 0; nop_i_ < (uint32)(n); nop_i_++) { __nop(); } } while (0)
+
+IFX_INLINE void __ldmst(volatile void *address, uint32 mask, uint32 value)
+{
+    *(volatile uint32 *)address = (*(volatile uint32 *)address & ~mask) | (mask & value);
+}
+
+IFX_INLINE uint32 __swap(void *place, uint32 value)
+{
+    return __atomic_exchange_n((uint32 *)place, value, __ATOMIC_SEQ_CST);
+}
+
+IFX_INLINE unsigned int __cmpAndSwap(unsigned int volatile *address, unsigned int value, unsigned int condition)
+{
+    unsigned int expected = condition;
+    __atomic_compare_exchange_n((unsigned int *)address, &expected, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return expected;
+}
+
+#define __setareg(areg,val)
+IFX_INLINE void __stopPerfCounters(void) { }
+IFX_INLINE void *__getA11(void)           { return __builtin_return_address(0); }
+
+IFX_INLINE uint32 __crc32(uint32 b, uint32 a)
+{
+    uint32 crc = ~b;
+    uint32 i;
+
+    for (i = 0; i < 32u; i++)
+    {
+        uint32 bit = ((crc ^ (a >> i)) & 1u);
+        crc = (crc >> 1) ^ (bit ? 0xEDB88320u : 0u);
+    }
+
+    return ~crc;
+}
+
+IFX_INLINE uint32 IfxCpu_calculateCrc32(uint32 *startaddress, uint8 length)
+{
+    uint32 returnvalue = 0;
+
+    for ( ; length > 0; length--)
+    {
+        returnvalue = __crc32(returnvalue, *startaddress);
+        startaddress++;
+    }
+
+    return returnvalue;
+}
+
+/* (a * x) mod m, the LCG step of IfxCpu_getRandomValue */
+IFX_INLINE uint32 IfxCpu_getRandomVal(uint32 a, uint32 x, uint32 m)
+{
+    return (uint32)(((uint64)a * x) % m);
+}
+
+IFX_INLINE float32 __fixpoint_to_float32(fract value, sint32 shift)
+{
+    return (float32)value / (float32)(1ULL << (31 - shift));
+}
+/** \} */
+
+/* *INDENT-ON* */
+/******************************************************************************/
+#endif /* IFXCPU_INTRINSICSHOSTSIM_H */
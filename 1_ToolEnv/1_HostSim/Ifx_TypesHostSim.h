@@ -0,0 +1,25 @@
+/**
+ * \file Ifx_TypesHostSim.h
+ *
+ * \brief Compiler specific types for the host-native simulation build.
+ *
+ * The fixed point types keep the TriCore width (32 bit) on the LP64 host.
+ */
+
+#ifndef IFX_TYPESHOSTSIM_H_
+#define IFX_TYPESHOSTSIM_H_
+/******************************************************************************/
+#define FRACT_MAX 0x7fffffff
+
+#define __interrupt(intno)
+
+typedef int                fract;
+typedef short              sfract;
+typedef long long          laccum;
+typedef int                __packb;
+typedef unsigned int       __upackb;
+typedef int                __packhw;
+typedef unsigned int       __upackhw;
+/******************************************************************************/
+
+#endif /* IFX_TYPESHOSTSIM_H_ */
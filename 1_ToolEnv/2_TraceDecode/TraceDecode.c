@@ -0,0 +1,301 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * ExeTrace dump to Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+ *
+ * The input is the raw ExeTraceBuffer (ExeTrace.h) saved from LMU RAM by the
+ * debugger or written by the host sim (--exe-trace FILE). Tasks and ISRs are
+ * nested slices of one CPU0 track, markers are instant events.
+ *
+ * usage: TraceDecode DUMP [OUT.json]
+ */
+#define TRACE_MAGIC                 0x31435254u
+#define TRACE_HEADER_WORDS          6u
+#define TRACE_STACK_DEPTH           32u
+
+#define TRACE_TASK_BEGIN            1u
+#define TRACE_TASK_END              2u
+#define TRACE_ISR_ENTER             3u
+#define TRACE_ISR_EXIT              4u
+#define TRACE_MARKER                5u
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef struct
+{
+    uint64_t ullTime;               /*Unwrapped STM count*/
+    uint32_t ulIndex;               /*Position in the ring, keeps the order of equal times*/
+    uint32_t ulInfo;
+}TraceEvent;
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static uint32_t TraceReadWord(const uint8_t *pData);
+static int TraceCompare(const void *pLeft, const void *pRight);
+static const char *TraceName(uint32_t ulEvent, uint32_t ulId, char *pBuf);
+static void TracePrintEvent(FILE *pOut, const char *pPhase, uint32_t ulEvent, uint32_t ulId, uint32_t ulData, double dTs);
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+/*Same order as E_SCHEDULER_TASK*/
+static const char * const cTraceTaskName[] =
+{
+    "Task1ms", "Task5ms", "Task10ms", "Task50ms", "Task100ms", "Task200ms", "Task500ms", "Task1s"
+};
+
+/*Same order as E_EXE_PROF_ID*/
+static const char * const cTraceIsrName[] =
+{
+    "Task1ms", "Task5ms", "Task10ms", "Task50ms", "Task100ms", "Task200ms", "Task500ms", "Task1s",
+    "STM0", "ASC0 TX", "ASC0 RX", "ASC0 EX", "GPSR CH1", "GPSR CH2", "GPSR CH3",
+    "TFT update", "QSPI0 TX", "QSPI0 RX", "QSPI0 ER", "Backlight",
+    "ADC DMA", "ADC limit"
+};
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Main Function--------------------------*/
+int main(int argc, char *argv[])
+{
+    FILE *pIn;
+    FILE *pOut = stdout;
+    uint8_t *pData;
+    long lSize;
+    uint32_t ulRecordNumber;
+    uint32_t ulCntPerUs;
+    uint32_t ulHead;
+    uint32_t ulCount;
+    uint32_t ulIdx;
+    uint32_t ulEventNumber = 0u;
+    uint32_t ulStack[TRACE_STACK_DEPTH];
+    uint32_t ulDepth = 0u;
+    uint32_t ulPrevCnt = 0u;
+    uint64_t ullTime = 0u;
+    TraceEvent *pEvent;
+
+    if((argc < 2) || (argc > 3))
+    {
+        fprintf(stderr, "usage: %s DUMP [OUT.json]\n", argv[0]);
+        return 2;
+    }
+
+    pIn = fopen(argv[1], "rb");
+
+    if(pIn == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    fseek(pIn, 0, SEEK_END);
+    lSize = ftell(pIn);
+    fseek(pIn, 0, SEEK_SET);
+
+    pData = malloc((size_t)lSize);
+
+    if((pData == NULL) || (fread(pData, 1u, (size_t)lSize, pIn) != (size_t)lSize) || (lSize < (long)(TRACE_HEADER_WORDS * 4u)))
+    {
+        fprintf(stderr, "%s: read error\n", argv[1]);
+        return 1;
+    }
+
+    fclose(pIn);
+
+    ulRecordNumber = TraceReadWord(&pData[4]);
+    ulCntPerUs     = TraceReadWord(&pData[8]);
+    ulHead         = TraceReadWord(&pData[12]);
+
+    if((TraceReadWord(&pData[0]) != TRACE_MAGIC) || (ulRecordNumber == 0u) ||
+       ((ulRecordNumber & (ulRecordNumber - 1u)) != 0u) || (ulCntPerUs == 0u) ||
+       (lSize < (long)((TRACE_HEADER_WORDS * 4u) + (ulRecordNumber * 8u))))
+    {
+        fprintf(stderr, "%s: not an ExeTrace dump\n", argv[1]);
+        return 1;
+    }
+
+    /*Oldest to newest record in ring order, times unwrapped on the way*/
+    ulCount = (ulHead < ulRecordNumber) ? ulHead : ulRecordNumber;
+    pEvent  = calloc(ulCount + 1u, sizeof(TraceEvent));
+
+    for(ulIdx = ulHead - ulCount; ulIdx != ulHead; ulIdx++)
+    {
+        const uint8_t *pRecord = &pData[(TRACE_HEADER_WORDS * 4u) + ((ulIdx & (ulRecordNumber - 1u)) * 8u)];
+        uint32_t ulCnt  = TraceReadWord(&pRecord[0]);
+        uint32_t ulInfo = TraceReadWord(&pRecord[4]);
+
+        /*Reserved but not written yet when the dump was taken*/
+        if(ulInfo == 0u)
+        {
+            continue;
+        }
+
+        if(ulEventNumber == 0u)
+        {
+            ullTime = ulCnt;
+        }
+        else
+        {
+            /*Signed: a preempted writer stores an older time after newer records*/
+            ullTime += (uint64_t)(int64_t)(int32_t)(ulCnt - ulPrevCnt);
+        }
+
+        ulPrevCnt = ulCnt;
+        pEvent[ulEventNumber].ullTime = ullTime;
+        pEvent[ulEventNumber].ulIndex = ulEventNumber;
+        pEvent[ulEventNumber].ulInfo  = ulInfo;
+        ulEventNumber++;
+    }
+
+    qsort(pEvent, ulEventNumber, sizeof(TraceEvent), TraceCompare);
+
+    if(argc == 3)
+    {
+        pOut = fopen(argv[2], "w");
+
+        if(pOut == NULL)
+        {
+            perror(argv[2]);
+            return 1;
+        }
+    }
+
+    fprintf(pOut, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(pOut, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"TC237\"}},\n");
+    fprintf(pOut, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU0\"}}");
+
+    for(ulIdx = 0u; ulIdx < ulEventNumber; ulIdx++)
+    {
+        uint32_t ulEvent = pEvent[ulIdx].ulInfo >> 24;
+        uint32_t ulId    = (pEvent[ulIdx].ulInfo >> 16) & 0xFFu;
+        uint32_t ulData  = pEvent[ulIdx].ulInfo & 0xFFFFu;
+        uint32_t ulKey   = (ulEvent << 8) | ulId;
+        double dTs = (double)(pEvent[ulIdx].ullTime - pEvent[0].ullTime) / (double)ulCntPerUs;
+
+        if((ulEvent == TRACE_TASK_BEGIN) || (ulEvent == TRACE_ISR_ENTER))
+        {
+            if(ulDepth < TRACE_STACK_DEPTH)
+            {
+                ulStack[ulDepth] = ulKey;
+                ulDepth++;
+                TracePrintEvent(pOut, "B", ulEvent, ulId, ulData, dTs);
+            }
+        }
+        else if((ulEvent == TRACE_TASK_END) || (ulEvent == TRACE_ISR_EXIT))
+        {
+            uint32_t ulBegin = (((ulEvent == TRACE_TASK_END) ? TRACE_TASK_BEGIN : TRACE_ISR_ENTER) << 8) | ulId;
+            uint32_t ulLevel = ulDepth;
+
+            while((ulLevel > 0u) && (ulStack[ulLevel - 1u] != ulBegin))
+            {
+                ulLevel--;
+            }
+
+            /*The begin was overwritten by the ring: nothing to close*/
+            if(ulLevel == 0u)
+            {
+                continue;
+            }
+
+            /*Slices whose end was lost are closed with this one*/
+            while(ulDepth >= ulLevel)
+            {
+                ulDepth--;
+                TracePrintEvent(pOut, "E", ulStack[ulDepth] >> 8, ulStack[ulDepth] & 0xFFu, ulData, dTs);
+            }
+        }
+        else if(ulEvent == TRACE_MARKER)
+        {
+            TracePrintEvent(pOut, "i", ulEvent, ulId, ulData, dTs);
+        }
+        else
+        {
+            /*Unknown event, skipped*/
+        }
+    }
+
+    /*Still running at the time of the dump*/
+    while(ulDepth > 0u)
+    {
+        ulDepth--;
+        TracePrintEvent(pOut, "E", ulStack[ulDepth] >> 8, ulStack[ulDepth] & 0xFFu, 0u,
+                        (double)(pEvent[ulEventNumber - 1u].ullTime - pEvent[0].ullTime) / (double)ulCntPerUs);
+    }
+
+    fprintf(pOut, "\n]}\n");
+
+    fprintf(stderr, "%s: %u records, %u events\n", argv[1], (unsigned)ulCount, (unsigned)ulEventNumber);
+
+    if(pOut != stdout)
+    {
+        fclose(pOut);
+    }
+
+    free(pEvent);
+    free(pData);
+
+    return 0;
+}
+
+/*---------------------Static Function--------------------------*/
+/*The dump is little endian, as the TriCore*/
+static uint32_t TraceReadWord(const uint8_t *pData)
+{
+    return (uint32_t)pData[0] | ((uint32_t)pData[1] << 8) | ((uint32_t)pData[2] << 16) | ((uint32_t)pData[3] << 24);
+}
+
+static int TraceCompare(const void *pLeft, const void *pRight)
+{
+    const TraceEvent *pL = (const TraceEvent *)pLeft;
+    const TraceEvent *pR = (const TraceEvent *)pRight;
+
+    if(pL->ullTime != pR->ullTime)
+    {
+        return (pL->ullTime < pR->ullTime) ? -1 : 1;
+    }
+
+    return (pL->ulIndex < pR->ulIndex) ? -1 : ((pL->ulIndex > pR->ulIndex) ? 1 : 0);
+}
+
+static const char *TraceName(uint32_t ulEvent, uint32_t ulId, char *pBuf)
+{
+    if(((ulEvent == TRACE_TASK_BEGIN) || (ulEvent == TRACE_TASK_END)) &&
+       (ulId < (sizeof(cTraceTaskName) / sizeof(cTraceTaskName[0]))))
+    {
+        return cTraceTaskName[ulId];
+    }
+
+    if(((ulEvent == TRACE_ISR_ENTER) || (ulEvent == TRACE_ISR_EXIT)) &&
+       (ulId < (sizeof(cTraceIsrName) / sizeof(cTraceIsrName[0]))))
+    {
+        return cTraceIsrName[ulId];
+    }
+
+    sprintf(pBuf, "%s %u", (ulEvent == TRACE_MARKER) ? "Marker" : "Id", (unsigned)ulId);
+
+    return pBuf;
+}
+
+static void TracePrintEvent(FILE *pOut, const char *pPhase, uint32_t ulEvent, uint32_t ulId, uint32_t ulData, double dTs)
+{
+    char cName[32];
+    const char *pCat = ((ulEvent == TRACE_TASK_BEGIN) || (ulEvent == TRACE_TASK_END)) ? "task" :
+                       ((ulEvent == TRACE_MARKER) ? "marker" : "isr");
+
+    fprintf(pOut, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%.2f,\"pid\":0,\"tid\":0%s,\"args\":{\"data\":%u}}",
+            TraceName(ulEvent, ulId, cName), pCat, pPhase, dTs,
+            (pPhase[0] == 'i') ? ",\"s\":\"t\"" : "", (unsigned)ulData);
+}
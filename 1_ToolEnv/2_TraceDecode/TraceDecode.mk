@@ -0,0 +1,28 @@
+##################################################################
+#											                     #
+# 				  Trace Decode Config Version 1.0.0 	         #
+#                                                                #
+##################################################################
+#-----------------------------------------------------------------
+#		ExeTrace dump to Chrome trace JSON, host tool (gcc)
+#-----------------------------------------------------------------
+TRACEDECODE_CC			= gcc
+TRACEDECODE_DIR			= ./1_ToolEnv/2_TraceDecode
+TRACEDECODE_OUT_DIR		= ./Debug/Tools
+TRACEDECODE_TARGET		= $(TRACEDECODE_OUT_DIR)/TraceDecode
+
+TRACEDECODE_CFLAGS		= -O2
+TRACEDECODE_CFLAGS		+= -Wall
+TRACEDECODE_CFLAGS		+= -std=gnu99
+
+#-----------------------------------------------------------------
+#		Build targets
+#-----------------------------------------------------------------
+.PHONY: trace-decode
+
+trace-decode: $(TRACEDECODE_TARGET)
+
+$(TRACEDECODE_TARGET): $(TRACEDECODE_DIR)/TraceDecode.c
+	@if test ! -d $(TRACEDECODE_OUT_DIR); then mkdir -p $(TRACEDECODE_OUT_DIR);fi
+	@$(TRACEDECODE_CC) -o $@ $(TRACEDECODE_CFLAGS) $<
+	@echo $(notdir $@)
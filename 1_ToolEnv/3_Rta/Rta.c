@@ -0,0 +1,878 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * Offline response time analysis of the scheduler task table.
+ *
+ * Reads the task table and the scheduler mode from Scheduler.c/.h, the ISR
+ * priorities from the driver sources and ConfigurationIsr.h, and the worst
+ * execution times from an ExeVerification dump ('p' lines, the "uart:" prefix
+ * of the host sim is accepted). A task without a measured time is analysed
+ * with its budget, an ISR with the default of the table below.
+ *
+ * Model, all deadlines equal to the period (min inter-arrival for ISRs):
+ *  - ISRs preempt by priority, a lower ISR blocks once (no nesting assumed)
+ *  - cooperative scheduler: tasks run to completion in priority order, a
+ *    lower task blocks once, every ISR preempts
+ *  - preemptive scheduler: a rate group is a software interrupt, the tasks of
+ *    a group behave as in the cooperative case, faster groups and higher ISRs
+ *    preempt, lower ISRs block once
+ * Phase offsets are ignored (critical instant), the per-tick load check below
+ * uses them.
+ *
+ * usage: Rta [--src DIR] [--wcet DUMP] [--isr NAME:PERIOD_US:WCET_US]...
+ */
+#define RTA_TASK_MAX                32u
+#define RTA_LINE_SIZE               512u
+#define RTA_ITERATION_MAX           1000u
+#define RTA_TIME_CNT_PER_US         100.0
+#define RTA_PROF_TASK_NUMBER        8u      /*E_EXE_PROF_ID of the tasks, ISRs follow*/
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef struct
+{
+    char cName[64];
+    uint32_t ulPeriodMs;
+    uint32_t ulOffsetMs;
+    uint32_t ulPriority;
+    uint32_t ulBudgetUs;
+    uint32_t ulRateGroup;
+    double dWcetUs;
+    int bMeasured;
+    double dResponseUs;
+    double dBlockingUs;
+}RtaTask;
+
+typedef struct
+{
+    const char *pName;
+    uint32_t ulProfId;              /*E_EXE_PROF_ID*/
+    const char *pFile;              /*Source with the IFX_INTERRUPT*/
+    const char *pHandler;
+    double dPeriodUs;               /*Min inter-arrival, 0 : not analysed*/
+    double dWcetUs;
+    int lPriority;
+    int bMeasured;
+    double dResponseUs;
+}RtaIsr;
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static char *RtaReadFile(const char *pPath);
+static int RtaFindDefine(const char *pText, const char *pName, char *pValue, size_t ulSize);
+static int RtaIsrPriority(const RtaIsr *pIsr);
+static int RtaReadTaskTable(void);
+static void RtaReadWcet(const char *pPath);
+static void RtaAnalyseIsr(void);
+static void RtaAnalyseTask(void);
+static double RtaIsrInterference(double dWindowUs, int lAbovePriority, double *pBlockingUs);
+static double RtaTickLoad(const uint32_t *pOffsetMs, const int *pPlaced, uint32_t *pPeakTick, double *pSpread);
+static void RtaProposeOffset(void);
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static const char *pRtaSrcDir = ".";
+static const char *pRtaHeaderFile[] =
+{
+    "0_Src/Driver/DrvAscTypes.h",
+    "0_Src/Middle/Tft/Cfg_Illd/ConfigurationIsr.h"
+};
+
+/*
+ * Default rates: STM0 at the scheduler tick, ASCLIN0 one byte per 1.04ms at
+ * 9600 baud, the ADC DMA (motor control) every 100 PWM periods, the ADC limit
+ * (overcurrent) once per hiccup off time at most. The rate groups are
+ * analysed as tasks, the TFT ISRs only if given.
+ */
+static RtaIsr stRtaIsr[] =
+{
+    {"STM0",      8u,  "0_Src/Driver/DrvStm.c",  "STM_Int0Handler",   1000.0, 5.0, 0, 0, 0.0},
+    {"ASC0_TX",   9u,  "0_Src/Driver/DrvAsc.c",  "ASCTxInt0Handler",  1042.0, 5.0, 0, 0, 0.0},
+    {"ASC0_RX",   10u, "0_Src/Driver/DrvAsc.c",  "ASCRxInt0Handler",  1042.0, 5.0, 0, 0, 0.0},
+    {"ASC0_EX",   11u, "0_Src/Driver/DrvAsc.c",  "ASCExInt0Handler",  0.0,    5.0, 0, 0, 0.0},
+    {"GPSR_CH1",  12u, "0_Src/Driver/DrvGpsr.c", "GPSR_Ch1Handler",   0.0,    0.0, 0, 0, 0.0},
+    {"GPSR_CH2",  13u, "0_Src/Driver/DrvGpsr.c", "GPSR_Ch2Handler",   0.0,    0.0, 0, 0, 0.0},
+    {"GPSR_CH3",  14u, "0_Src/Driver/DrvGpsr.c", "GPSR_Ch3Handler",   0.0,    0.0, 0, 0, 0.0},
+    {"TFT",       15u, "0_Src/Middle/Tft/TftApp/tft_app.c",          "cpu_service0Irq", 0.0, 0.0, 0, 0, 0.0},
+    {"QSPI0_TX",  16u, "0_Src/Middle/Tft/CDrv/Tricore/Qspi/Qspi0.c", "ISR_qspi0_Tx",    0.0, 0.0, 0, 0, 0.0},
+    {"QSPI0_RX",  17u, "0_Src/Middle/Tft/CDrv/Tricore/Qspi/Qspi0.c", "ISR_qspi0_Rx",    0.0, 0.0, 0, 0, 0.0},
+    {"QSPI0_ER",  18u, "0_Src/Middle/Tft/CDrv/Tricore/Qspi/Qspi0.c", "ISR_qspi0_Er",    0.0, 0.0, 0, 0, 0.0},
+    {"BACKLIGHT", 19u, "0_Src/Middle/Tft/TftApp/background_light.c", "ISR_BACKLIGHT",   0.0, 0.0, 0, 0, 0.0},
+    {"ADC_DMA",   20u, "0_Src/Driver/DrvAdc.c",  "ADC_DmaHandler",    5000.0, 60.0, 0, 0, 0.0},
+    {"ADC_LIMIT", 21u, "0_Src/Driver/DrvAdc.c",  "ADC_LimitHandler",  100000.0, 3.0, 0, 0, 0.0},
+};
+
+#define RTA_ISR_NUMBER              (sizeof(stRtaIsr) / sizeof(stRtaIsr[0]))
+#define RTA_GPSR_FIRST              4u      /*Index of GPSR_CH1, rate group 0*/
+
+static RtaTask stRtaTask[RTA_TASK_MAX];
+static uint32_t ulRtaTaskNumber = 0u;
+static uint32_t ulRtaTickMs = 1u;
+static int bRtaPreemptive = 0;
+static int bRtaFail = 0;
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Main Function--------------------------*/
+int main(int argc, char *argv[])
+{
+    const char *pWcet = NULL;
+    uint32_t ulIdx;
+    int lArg;
+    double dUtil = 0.0;
+    double dPeakUs;
+    uint32_t ulPeakTick;
+    uint32_t ulOffsetMs[RTA_TASK_MAX];
+
+    for(lArg = 1; lArg < argc; lArg++)
+    {
+        const char *pValue = ((lArg + 1) < argc) ? argv[lArg + 1] : NULL;
+
+        if((strcmp(argv[lArg], "--src") == 0) && (pValue != NULL))
+        {
+            pRtaSrcDir = pValue;
+            lArg++;
+        }
+        else if((strcmp(argv[lArg], "--wcet") == 0) && (pValue != NULL))
+        {
+            pWcet = pValue;
+            lArg++;
+        }
+        else if((strcmp(argv[lArg], "--isr") == 0) && (pValue != NULL))
+        {
+            char cName[32];
+            double dPeriod;
+            double dWcet;
+
+            if(sscanf(pValue, "%31[^:]:%lf:%lf", cName, &dPeriod, &dWcet) != 3)
+            {
+                fprintf(stderr, "rta: bad --isr %s\n", pValue);
+                return 2;
+            }
+
+            for(ulIdx = 0u; ulIdx < RTA_ISR_NUMBER; ulIdx++)
+            {
+                if(strcmp(stRtaIsr[ulIdx].pName, cName) == 0)
+                {
+                    stRtaIsr[ulIdx].dPeriodUs = dPeriod;
+                    stRtaIsr[ulIdx].dWcetUs   = dWcet;
+                    stRtaIsr[ulIdx].bMeasured = 1;
+                    break;
+                }
+            }
+
+            if(ulIdx == RTA_ISR_NUMBER)
+            {
+                fprintf(stderr, "rta: unknown ISR %s\n", cName);
+                return 2;
+            }
+            lArg++;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--src DIR] [--wcet DUMP] [--isr NAME:PERIOD_US:WCET_US]...\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if(RtaReadTaskTable() != 0)
+    {
+        return 2;
+    }
+
+    for(ulIdx = 0u; ulIdx < RTA_ISR_NUMBER; ulIdx++)
+    {
+        stRtaIsr[ulIdx].lPriority = RtaIsrPriority(&stRtaIsr[ulIdx]);
+    }
+
+    /*The scheduler tick sets the STM rate*/
+    stRtaIsr[0].dPeriodUs = (double)ulRtaTickMs * 1000.0;
+
+    if(pWcet != NULL)
+    {
+        RtaReadWcet(pWcet);
+    }
+
+    RtaAnalyseIsr();
+    RtaAnalyseTask();
+
+    printf("rta: %s scheduler, tick %u ms\n\n", (bRtaPreemptive != 0) ? "preemptive" : "cooperative", (unsigned)ulRtaTickMs);
+
+    printf("%-10s %5s %9s %8s %6s %9s  %s\n", "ISR", "prio", "T[us]", "C[us]", "U[%]", "R[us]", "");
+    for(ulIdx = 0u; ulIdx < RTA_ISR_NUMBER; ulIdx++)
+    {
+        const RtaIsr *pIsr = &stRtaIsr[ulIdx];
+
+        if(pIsr->dPeriodUs <= 0.0)
+        {
+            continue;
+        }
+
+        dUtil += pIsr->dWcetUs / pIsr->dPeriodUs;
+        printf("%-10s %5d %9.1f %8.2f %6.2f %9.2f  %s%s\n", pIsr->pName, pIsr->lPriority, pIsr->dPeriodUs, pIsr->dWcetUs,
+               100.0 * pIsr->dWcetUs / pIsr->dPeriodUs, pIsr->dResponseUs,
+               (pIsr->bMeasured != 0) ? "measured" : "assumed",
+               (pIsr->dResponseUs > pIsr->dPeriodUs) ? "  MISS" : "");
+    }
+
+    printf("\n%-12s %4s %3s %6s %5s %8s %6s %9s %9s  %s\n", "Task", "prio", "grp", "T[ms]", "off", "C[us]", "U[%]", "B[us]", "R[us]", "");
+    for(ulIdx = 0u; ulIdx < ulRtaTaskNumber; ulIdx++)
+    {
+        const RtaTask *pTask = &stRtaTask[ulIdx];
+        double dPeriodUs = (double)pTask->ulPeriodMs * 1000.0;
+
+        dUtil += pTask->dWcetUs / dPeriodUs;
+        printf("%-12s %4u %3u %6u %5u %8.2f %6.2f %9.2f %9.2f  %s%s\n", pTask->cName, (unsigned)pTask->ulPriority,
+               (unsigned)pTask->ulRateGroup, (unsigned)pTask->ulPeriodMs, (unsigned)pTask->ulOffsetMs, pTask->dWcetUs,
+               100.0 * pTask->dWcetUs / dPeriodUs, pTask->dBlockingUs, pTask->dResponseUs,
+               (pTask->bMeasured != 0) ? "measured" : "budget",
+               (pTask->dResponseUs > dPeriodUs) ? "  MISS" : "");
+    }
+
+    printf("\ntotal utilization %.2f %%\n", 100.0 * dUtil);
+
+    if(dUtil > 1.0)
+    {
+        bRtaFail = 1;
+    }
+
+    for(ulIdx = 0u; ulIdx < ulRtaTaskNumber; ulIdx++)
+    {
+        ulOffsetMs[ulIdx] = stRtaTask[ulIdx].ulOffsetMs;
+    }
+
+    dPeakUs = RtaTickLoad(ulOffsetMs, NULL, &ulPeakTick, NULL);
+    printf("peak tick load %.2f us of %u us at tick %u (table offsets)%s\n", dPeakUs, (unsigned)(ulRtaTickMs * 1000u),
+           (unsigned)ulPeakTick, (dPeakUs > (double)(ulRtaTickMs * 1000u)) ? "  OVERLOAD" : "");
+
+    RtaProposeOffset();
+
+    printf("\n%s\n", (bRtaFail != 0) ? "rta: NOT schedulable" : "rta: schedulable");
+
+    return (bRtaFail != 0) ? 1 : 0;
+}
+
+/*---------------------Source Parsing--------------------------*/
+static char *RtaReadFile(const char *pPath)
+{
+    char cPath[RTA_LINE_SIZE];
+    FILE *pIn;
+    char *pText;
+    long lSize;
+
+    snprintf(cPath, sizeof(cPath), "%s/%s", pRtaSrcDir, pPath);
+    pIn = fopen(cPath, "rb");
+
+    if(pIn == NULL)
+    {
+        return NULL;
+    }
+
+    fseek(pIn, 0, SEEK_END);
+    lSize = ftell(pIn);
+    fseek(pIn, 0, SEEK_SET);
+    pText = calloc((size_t)lSize + 1u, 1u);
+
+    if((pText != NULL) && (fread(pText, 1u, (size_t)lSize, pIn) != (size_t)lSize))
+    {
+        free(pText);
+        pText = NULL;
+    }
+
+    fclose(pIn);
+
+    return pText;
+}
+
+/*Value of "#define pName value" at the start of a line, not commented out*/
+static int RtaFindDefine(const char *pText, const char *pName, char *pValue, size_t ulSize)
+{
+    const char *pPos = pText;
+    size_t ulLen = strlen(pName);
+
+    while((pPos = strstr(pPos, "#define")) != NULL)
+    {
+        const char *pLine = pPos;
+        const char *pArg = pPos + 7;
+
+        pPos += 7;
+
+        if((pLine != pText) && (pLine[-1] != '\n'))
+        {
+            continue;
+        }
+
+        while((*pArg == ' ') || (*pArg == '\t'))
+        {
+            pArg++;
+        }
+
+        if((strncmp(pArg, pName, ulLen) == 0) && isspace((unsigned char)pArg[ulLen]))
+        {
+            pArg += ulLen;
+            while((*pArg == ' ') || (*pArg == '\t'))
+            {
+                pArg++;
+            }
+
+            snprintf(pValue, ulSize, "%.*s", (int)strcspn(pArg, " \t\r\n/"), pArg);
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/*Priority of IFX_INTERRUPT(handler, vector, priority), the priority a literal or a define*/
+static int RtaIsrPriority(const RtaIsr *pIsr)
+{
+    char *pText = RtaReadFile(pIsr->pFile);
+    const char *pPos;
+    char cValue[64] = "";
+    int lPriority = -1;
+    uint32_t ulIdx;
+
+    if(pText == NULL)
+    {
+        fprintf(stderr, "rta: %s not found\n", pIsr->pFile);
+        return -1;
+    }
+
+    for(pPos = strstr(pText, "IFX_INTERRUPT"); pPos != NULL; pPos = strstr(pPos + 1, "IFX_INTERRUPT"))
+    {
+        const char *pArg = strchr(pPos, '(');
+
+        if(pArg == NULL)
+        {
+            break;
+        }
+
+        pArg++;
+        while(isspace((unsigned char)*pArg))
+        {
+            pArg++;
+        }
+
+        if((strncmp(pArg, pIsr->pHandler, strlen(pIsr->pHandler)) == 0) && (pArg[strlen(pIsr->pHandler)] == ','))
+        {
+            const char *pPrio = strchr(strchr(pArg, ',') + 1, ',');
+
+            if(pPrio != NULL)
+            {
+                pPrio++;
+                while(isspace((unsigned char)*pPrio))
+                {
+                    pPrio++;
+                }
+                snprintf(cValue, sizeof(cValue), "%.*s", (int)strcspn(pPrio, " \t)"), pPrio);
+            }
+            break;
+        }
+    }
+
+    if(isdigit((unsigned char)cValue[0]))
+    {
+        lPriority = atoi(cValue);
+    }
+    else if(cValue[0] != '\0')
+    {
+        char cDefine[64];
+
+        snprintf(cDefine, sizeof(cDefine), "%s", cValue);
+
+        if(RtaFindDefine(pText, cDefine, cValue, sizeof(cValue)) == 0)
+        {
+            lPriority = atoi(cValue);
+        }
+
+        for(ulIdx = 0u; (lPriority < 0) && (ulIdx < (sizeof(pRtaHeaderFile) / sizeof(pRtaHeaderFile[0]))); ulIdx++)
+        {
+            char *pHeader = RtaReadFile(pRtaHeaderFile[ulIdx]);
+
+            if((pHeader != NULL) && (RtaFindDefine(pHeader, cDefine, cValue, sizeof(cValue)) == 0))
+            {
+                lPriority = atoi(cValue);
+            }
+            free(pHeader);
+        }
+    }
+
+    if(lPriority < 0)
+    {
+        fprintf(stderr, "rta: priority of %s not found in %s\n", pIsr->pHandler, pIsr->pFile);
+    }
+
+    free(pText);
+
+    return lPriority;
+}
+
+/*Rows of stSchedulerTaskCfg: {pTaskFnc, ulPeriodMs, ulOffsetMs, ucPriority, ulBudgetUs, ucRateGroup}*/
+static int RtaReadTaskTable(void)
+{
+    char *pText = RtaReadFile("0_Src/App/Scheduler/Scheduler.c");
+    char *pHeader = RtaReadFile("0_Src/App/Scheduler/Scheduler.h");
+    char cValue[64];
+    const char *pPos;
+    const char *pEnd;
+
+    if((pText == NULL) || (pHeader == NULL))
+    {
+        fprintf(stderr, "rta: Scheduler.c/.h not found under %s\n", pRtaSrcDir);
+        return -1;
+    }
+
+    if(RtaFindDefine(pHeader, "SCHEDULER_PREEMPTIVE", cValue, sizeof(cValue)) == 0)
+    {
+        bRtaPreemptive = (strcmp(cValue, "ON") == 0);
+    }
+
+    if(RtaFindDefine(pHeader, "SCHEDULER_TICK_MS", cValue, sizeof(cValue)) == 0)
+    {
+        ulRtaTickMs = (uint32_t)strtoul(cValue, NULL, 0);
+    }
+
+    pPos = strstr(pText, "stSchedulerTaskCfg[SCHEDULER_TASK_NUMBER] =");
+    pEnd = (pPos != NULL) ? strstr(pPos, "};") : NULL;
+
+    if((pPos == NULL) || (pEnd == NULL))
+    {
+        fprintf(stderr, "rta: task table not found in Scheduler.c\n");
+        return -1;
+    }
+
+    while(((pPos = strchr(pPos, '{')) != NULL) && (pPos < pEnd) && (ulRtaTaskNumber < RTA_TASK_MAX))
+    {
+        RtaTask *pTask = &stRtaTask[ulRtaTaskNumber];
+        uint32_t ulValue[5];
+        uint32_t ulIdx;
+        char *pNum;
+
+        pPos++;
+        while(isspace((unsigned char)*pPos))
+        {
+            pPos++;
+        }
+
+        /*The opening brace of the table itself*/
+        if(!isalpha((unsigned char)*pPos))
+        {
+            continue;
+        }
+
+        snprintf(pTask->cName, sizeof(pTask->cName), "%.*s", (int)strcspn(pPos, " ,"), pPos);
+        pNum = (char *)pPos + strcspn(pPos, ",");
+
+        for(ulIdx = 0u; ulIdx < 5u; ulIdx++)
+        {
+            while((*pNum != '\0') && !isdigit((unsigned char)*pNum))
+            {
+                pNum++;
+            }
+            ulValue[ulIdx] = (uint32_t)strtoul(pNum, &pNum, 0);
+            while(isalpha((unsigned char)*pNum))
+            {
+                pNum++;
+            }
+        }
+
+        pTask->ulPeriodMs  = ulValue[0];
+        pTask->ulOffsetMs  = ulValue[1];
+        pTask->ulPriority  = ulValue[2];
+        pTask->ulBudgetUs  = ulValue[3];
+        pTask->ulRateGroup = ulValue[4];
+        pTask->dWcetUs     = (double)pTask->ulBudgetUs;
+        ulRtaTaskNumber++;
+        pPos = pNum;
+    }
+
+    free(pText);
+    free(pHeader);
+
+    return (ulRtaTaskNumber != 0u) ? 0 : -1;
+}
+
+/*'p <id> <runs> <min> <max> ...' lines of the ExeVerification dump*/
+static void RtaReadWcet(const char *pPath)
+{
+    FILE *pIn = fopen(pPath, "r");
+    char cLine[RTA_LINE_SIZE];
+
+    if(pIn == NULL)
+    {
+        perror(pPath);
+        exit(2);
+    }
+
+    while(fgets(cLine, sizeof(cLine), pIn) != NULL)
+    {
+        const char *pPos = strstr(cLine, "uart: ");
+        unsigned long ulId;
+        unsigned long ulRun;
+        unsigned long ulMin;
+        unsigned long ulMax;
+        uint32_t ulIdx;
+
+        pPos = (pPos != NULL) ? (pPos + 6) : cLine;
+
+        if((sscanf(pPos, "p %lu %lu %lu %lu", &ulId, &ulRun, &ulMin, &ulMax) != 4) || (ulRun == 0u))
+        {
+            continue;
+        }
+
+        if(ulId < RTA_PROF_TASK_NUMBER)
+        {
+            if(ulId < ulRtaTaskNumber)
+            {
+                stRtaTask[ulId].dWcetUs   = (double)ulMax / RTA_TIME_CNT_PER_US;
+                stRtaTask[ulId].bMeasured = 1;
+            }
+            continue;
+        }
+
+        for(ulIdx = 0u; ulIdx < RTA_ISR_NUMBER; ulIdx++)
+        {
+            if((stRtaIsr[ulIdx].ulProfId == ulId) && (stRtaIsr[ulIdx].bMeasured == 0))
+            {
+                stRtaIsr[ulIdx].dWcetUs   = (double)ulMax / RTA_TIME_CNT_PER_US;
+                stRtaIsr[ulIdx].bMeasured = 1;
+            }
+        }
+    }
+
+    fclose(pIn);
+}
+
+/*---------------------Analysis--------------------------*/
+/*
+ * Interference in a window of the ISRs above lAbovePriority; the longest ISR
+ * at or below it is returned as blocking.
+ */
+static double RtaIsrInterference(double dWindowUs, int lAbovePriority, double *pBlockingUs)
+{
+    double dSum = 0.0;
+    uint32_t ulIdx;
+
+    *pBlockingUs = 0.0;
+
+    for(ulIdx = 0u; ulIdx < RTA_ISR_NUMBER; ulIdx++)
+    {
+        const RtaIsr *pIsr = &stRtaIsr[ulIdx];
+
+        if(pIsr->dPeriodUs <= 0.0)
+        {
+            continue;
+        }
+
+        if(pIsr->lPriority > lAbovePriority)
+        {
+            dSum += ceil(dWindowUs / pIsr->dPeriodUs) * pIsr->dWcetUs;
+        }
+        else if(pIsr->dWcetUs > *pBlockingUs)
+        {
+            *pBlockingUs = pIsr->dWcetUs;
+        }
+    }
+
+    return dSum;
+}
+
+static void RtaAnalyseIsr(void)
+{
+    uint32_t ulIdx;
+
+    for(ulIdx = 0u; ulIdx < RTA_ISR_NUMBER; ulIdx++)
+    {
+        RtaIsr *pIsr = &stRtaIsr[ulIdx];
+        double dBlocking;
+        double dResponse = pIsr->dWcetUs;
+        double dNext;
+        uint32_t ulIter;
+
+        if(pIsr->dPeriodUs <= 0.0)
+        {
+            continue;
+        }
+
+        for(ulIter = 0u; ulIter < RTA_ITERATION_MAX; ulIter++)
+        {
+            double dHigher = RtaIsrInterference(dResponse, pIsr->lPriority, &dBlocking);
+
+            /*The ISR itself is at its own priority: not a blocking one*/
+            if(dBlocking == pIsr->dWcetUs)
+            {
+                double dOther = 0.0;
+                uint32_t ulOther;
+
+                for(ulOther = 0u; ulOther < RTA_ISR_NUMBER; ulOther++)
+                {
+                    if((ulOther != ulIdx) && (stRtaIsr[ulOther].dPeriodUs > 0.0) &&
+                       (stRtaIsr[ulOther].lPriority <= pIsr->lPriority) && (stRtaIsr[ulOther].dWcetUs > dOther))
+                    {
+                        dOther = stRtaIsr[ulOther].dWcetUs;
+                    }
+                }
+                dBlocking = dOther;
+            }
+
+            dNext = dBlocking + pIsr->dWcetUs + dHigher;
+
+            if((dNext == dResponse) || (dNext > (100.0 * pIsr->dPeriodUs)))
+            {
+                break;
+            }
+            dResponse = dNext;
+        }
+
+        pIsr->dResponseUs = dNext;
+
+        if(pIsr->dResponseUs > pIsr->dPeriodUs)
+        {
+            bRtaFail = 1;
+        }
+    }
+}
+
+/*
+ * R = B + C + sum(hp same group, (floor((R - C) / T) + 1) * C)
+ *           + sum(faster groups and ISRs above, ceil(R / T) * C)
+ */
+static void RtaAnalyseTask(void)
+{
+    uint32_t ulIdx;
+
+    for(ulIdx = 0u; ulIdx < ulRtaTaskNumber; ulIdx++)
+    {
+        RtaTask *pTask = &stRtaTask[ulIdx];
+        int lLevel = (bRtaPreemptive != 0) ? stRtaIsr[RTA_GPSR_FIRST + pTask->ulRateGroup].lPriority : 0;
+        double dPeriodUs = (double)pTask->ulPeriodMs * 1000.0;
+        double dBlocking = 0.0;
+        double dIsrBlocking;
+        double dResponse;
+        double dNext = pTask->dWcetUs;
+        uint32_t ulIter;
+        uint32_t ulOther;
+
+        /*A lower task of the same group started just before the release*/
+        for(ulOther = 0u; ulOther < ulRtaTaskNumber; ulOther++)
+        {
+            const RtaTask *pOther = &stRtaTask[ulOther];
+
+            if((pOther->ulRateGroup == pTask->ulRateGroup) || (bRtaPreemptive == 0))
+            {
+                if((pOther->ulPriority < pTask->ulPriority) && (pOther->dWcetUs > dBlocking))
+                {
+                    dBlocking = pOther->dWcetUs;
+                }
+            }
+        }
+
+        (void)RtaIsrInterference(0.0, lLevel, &dIsrBlocking);
+
+        /*Below every ISR in the cooperative mode*/
+        if(bRtaPreemptive == 0)
+        {
+            dIsrBlocking = 0.0;
+        }
+
+        pTask->dBlockingUs = dBlocking + dIsrBlocking;
+        dResponse = pTask->dBlockingUs + pTask->dWcetUs;
+
+        for(ulIter = 0u; ulIter < RTA_ITERATION_MAX; ulIter++)
+        {
+            dNext = pTask->dBlockingUs + pTask->dWcetUs + RtaIsrInterference(dResponse, lLevel, &dIsrBlocking);
+
+            for(ulOther = 0u; ulOther < ulRtaTaskNumber; ulOther++)
+            {
+                const RtaTask *pOther = &stRtaTask[ulOther];
+                double dOtherUs = (double)pOther->ulPeriodMs * 1000.0;
+
+                if(ulOther == ulIdx)
+                {
+                    continue;
+                }
+
+                if((bRtaPreemptive != 0) && (pOther->ulRateGroup < pTask->ulRateGroup))
+                {
+                    dNext += ceil(dResponse / dOtherUs) * pOther->dWcetUs;
+                }
+                else if(((bRtaPreemptive == 0) || (pOther->ulRateGroup == pTask->ulRateGroup)) &&
+                        (pOther->ulPriority > pTask->ulPriority))
+                {
+                    dNext += (floor((dResponse - pTask->dWcetUs) / dOtherUs) + 1.0) * pOther->dWcetUs;
+                }
+                else
+                {
+                    /*Lower priority or slower group*/
+                }
+            }
+
+            if((dNext == dResponse) || (dNext > (100.0 * dPeriodUs)))
+            {
+                break;
+            }
+            dResponse = dNext;
+        }
+
+        pTask->dResponseUs = dNext;
+
+        if(pTask->dResponseUs > dPeriodUs)
+        {
+            bRtaFail = 1;
+        }
+    }
+}
+
+/*
+ * Peak demand released in one tick over the hyperperiod, ISRs spread at their
+ * rate. pPlaced NULL : all tasks. pSpread : sum of the squared tick loads,
+ * lower when the same peak is reached on fewer ticks.
+ */
+static double RtaTickLoad(const uint32_t *pOffsetMs, const int *pPlaced, uint32_t *pPeakTick, double *pSpread)
+{
+    uint32_t ulHyperMs = 1u;
+    uint32_t ulTick;
+    uint32_t ulIdx;
+    double dIsrUs = 0.0;
+    double dPeak = 0.0;
+
+    for(ulIdx = 0u; ulIdx < ulRtaTaskNumber; ulIdx++)
+    {
+        uint32_t ulA = ulHyperMs;
+        uint32_t ulB = stRtaTask[ulIdx].ulPeriodMs;
+
+        while(ulB != 0u)
+        {
+            uint32_t ulT = ulA % ulB;
+            ulA = ulB;
+            ulB = ulT;
+        }
+        ulHyperMs = (ulHyperMs / ulA) * stRtaTask[ulIdx].ulPeriodMs;
+    }
+
+    for(ulIdx = 0u; ulIdx < RTA_ISR_NUMBER; ulIdx++)
+    {
+        if(stRtaIsr[ulIdx].dPeriodUs > 0.0)
+        {
+            dIsrUs += ceil(((double)ulRtaTickMs * 1000.0) / stRtaIsr[ulIdx].dPeriodUs) * stRtaIsr[ulIdx].dWcetUs;
+        }
+    }
+
+    *pPeakTick = 0u;
+
+    if(pSpread != NULL)
+    {
+        *pSpread = 0.0;
+    }
+
+    for(ulTick = 0u; ulTick < ulHyperMs; ulTick += ulRtaTickMs)
+    {
+        double dLoad = dIsrUs;
+
+        for(ulIdx = 0u; ulIdx < ulRtaTaskNumber; ulIdx++)
+        {
+            if(((pPlaced == NULL) || (pPlaced[ulIdx] != 0)) &&
+               ((ulTick % stRtaTask[ulIdx].ulPeriodMs) == (pOffsetMs[ulIdx] % stRtaTask[ulIdx].ulPeriodMs)))
+            {
+                dLoad += stRtaTask[ulIdx].dWcetUs;
+            }
+        }
+
+        if(dLoad > dPeak)
+        {
+            dPeak = dLoad;
+            *pPeakTick = ulTick;
+        }
+
+        if(pSpread != NULL)
+        {
+            *pSpread += dLoad * dLoad;
+        }
+    }
+
+    return dPeak;
+}
+
+/*Greedy: longest task first, each at the offset with the lowest peak so far*/
+static void RtaProposeOffset(void)
+{
+    uint32_t ulOffsetMs[RTA_TASK_MAX];
+    int bPlaced[RTA_TASK_MAX];
+    uint32_t ulIdx;
+    uint32_t ulPeakTick;
+    uint32_t ulStep;
+    double dPeak;
+
+    for(ulIdx = 0u; ulIdx < ulRtaTaskNumber; ulIdx++)
+    {
+        ulOffsetMs[ulIdx] = 0u;
+        bPlaced[ulIdx] = 0;
+    }
+
+    for(ulStep = 0u; ulStep < ulRtaTaskNumber; ulStep++)
+    {
+        uint32_t ulNext = ulRtaTaskNumber;
+        uint32_t ulOffset;
+        uint32_t ulBest = 0u;
+        double dBest = 0.0;
+        double dBestSpread = 0.0;
+
+        for(ulIdx = 0u; ulIdx < ulRtaTaskNumber; ulIdx++)
+        {
+            if((bPlaced[ulIdx] == 0) && ((ulNext == ulRtaTaskNumber) || (stRtaTask[ulIdx].dWcetUs > stRtaTask[ulNext].dWcetUs)))
+            {
+                ulNext = ulIdx;
+            }
+        }
+
+        bPlaced[ulNext] = 1;
+
+        /*Only the tasks placed so far count, the table offset is kept on a tie*/
+        ulBest = stRtaTask[ulNext].ulOffsetMs % stRtaTask[ulNext].ulPeriodMs;
+        ulOffsetMs[ulNext] = ulBest;
+        dBest = RtaTickLoad(ulOffsetMs, bPlaced, &ulPeakTick, &dBestSpread);
+
+        for(ulOffset = 0u; ulOffset < stRtaTask[ulNext].ulPeriodMs; ulOffset += ulRtaTickMs)
+        {
+            double dLoad;
+            double dSpread;
+
+            ulOffsetMs[ulNext] = ulOffset;
+            dLoad = RtaTickLoad(ulOffsetMs, bPlaced, &ulPeakTick, &dSpread);
+
+            if((dLoad < dBest) || ((dLoad == dBest) && (dSpread < dBestSpread)))
+            {
+                dBest = dLoad;
+                dBestSpread = dSpread;
+                ulBest = ulOffset;
+            }
+        }
+
+        ulOffsetMs[ulNext] = ulBest;
+    }
+
+    dPeak = RtaTickLoad(ulOffsetMs, NULL, &ulPeakTick, NULL);
+    printf("peak tick load %.2f us at tick %u with the proposed offsets:\n", dPeak, (unsigned)ulPeakTick);
+
+    for(ulIdx = 0u; ulIdx < ulRtaTaskNumber; ulIdx++)
+    {
+        printf("    %-12s %4u ms%s\n", stRtaTask[ulIdx].cName, (unsigned)ulOffsetMs[ulIdx],
+               (ulOffsetMs[ulIdx] != stRtaTask[ulIdx].ulOffsetMs) ? "  (changed)" : "");
+    }
+}
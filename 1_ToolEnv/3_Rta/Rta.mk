@@ -0,0 +1,28 @@
+##################################################################
+#											                     #
+# 				  Response Time Analysis Config Version 1.0.0   #
+#                                                                #
+##################################################################
+#-----------------------------------------------------------------
+#		Task table schedulability analysis, host tool (gcc)
+#-----------------------------------------------------------------
+RTA_CC					= gcc
+RTA_DIR					= ./1_ToolEnv/3_Rta
+RTA_OUT_DIR				= ./Debug/Tools
+RTA_TARGET				= $(RTA_OUT_DIR)/Rta
+
+RTA_CFLAGS				= -O2
+RTA_CFLAGS				+= -Wall
+RTA_CFLAGS				+= -std=gnu99
+
+#-----------------------------------------------------------------
+#		Build targets
+#-----------------------------------------------------------------
+.PHONY: rta
+
+rta: $(RTA_TARGET)
+
+$(RTA_TARGET): $(RTA_DIR)/Rta.c
+	@if test ! -d $(RTA_OUT_DIR); then mkdir -p $(RTA_OUT_DIR);fi
+	@$(RTA_CC) -o $@ $(RTA_CFLAGS) $< -lm
+	@echo $(notdir $@)
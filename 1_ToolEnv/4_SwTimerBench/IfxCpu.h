@@ -0,0 +1,22 @@
+#ifndef IFXCPU_H
+#define IFXCPU_H
+
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include "Ifx_Types.h"
+
+/*----------------------------------------------------------------*/
+/*                        Global Function Prototype                  */
+/*----------------------------------------------------------------*/
+/*Benchmark stand-in of the iLLD header: one thread, no interrupt to lock*/
+static inline boolean IfxCpu_disableInterrupts(void)
+{
+    return TRUE;
+}
+
+static inline void IfxCpu_restoreInterrupts(boolean enabled)
+{
+    (void)enabled;
+}
+#endif
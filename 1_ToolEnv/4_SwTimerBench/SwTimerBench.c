@@ -0,0 +1,197 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "MidSwTimer.h"
+#include "MidStm.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * Host benchmark of the MidSwTimer wheel (0_Src/Middle/MidSwTimer.c built
+ * natively, IfxCpu.h of this directory replaces the iLLD locks).
+ *
+ * For each timer count N, N periodic timers with periods spread over
+ * [N/2, 3N/2] ticks give about one expiry per tick whatever N is, so the
+ * cost per tick should stay flat. A sorted-free linear list scanned every
+ * tick (the hand coded way) is measured for comparison, and the start/stop
+ * cost with N timers armed. Every wheel expiry is checked against the tick
+ * it was due at.
+ *
+ * usage: SwTimerBench [TICKS]
+ */
+#define BENCH_DEFAULT_TICKS         200000u
+#define BENCH_TICK_CNT              (MID_SW_TIMER_TICK_US * MID_TIMER_CNT_PER_US)
+#define BENCH_MAX_TIMERS            16384u
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef struct
+{
+    uint32_t ulExpireTick;
+    uint32_t ulPeriodTick;
+}BenchLinearTimer;
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static double BenchNowNs(void);
+static void BenchCallback(void *param_Ctx);
+static uint32_t BenchRandom(void);
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static MidSwTimer stBenchTimer[BENCH_MAX_TIMERS];
+static BenchLinearTimer stBenchLinear[BENCH_MAX_TIMERS];
+static uint32_t ulBenchPeriodMs[BENCH_MAX_TIMERS];
+static uint32_t ulBenchIndex[BENCH_MAX_TIMERS];
+static uint32_t ulBenchDueTick[BENCH_MAX_TIMERS];
+static uint32_t ulBenchTick = 0u;      /*Tick being processed, from the start of the run*/
+static uint32_t ulBenchErrorCnt = 0u;
+static uint64 ullBenchExpireCnt = 0u;
+static uint32_t ulBenchSeed = 12345u;
+static uint32_t ulBenchNowCnt = 0u;
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+
+/*---------------------Main Function--------------------------*/
+int main(int argc, char *argv[])
+{
+    static const uint32_t ulTimerNumber[] = {16u, 64u, 256u, 1024u, 4096u, 16384u};
+    uint32_t ulTicks = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_TICKS;
+    uint32_t ulRun;
+
+    printf("%8s %10s %12s %12s %14s %14s\n", "timers", "exp/tick", "wheel ns/tk", "ns/expiry", "start+stop ns", "linear ns/tk");
+
+    for(ulRun = 0u; ulRun < (sizeof(ulTimerNumber) / sizeof(ulTimerNumber[0])); ulRun++)
+    {
+        uint32_t ulNumber = ulTimerNumber[ulRun];
+        uint32_t ulIdx;
+        uint32_t ulTick;
+        uint64 ullLinearExpire = 0u;
+        double dStart;
+        double dWheelNs;
+        double dStartStopNs;
+        double dLinearNs;
+
+        /*Wheel: timers armed at random phases, then the ticks as the STM ISR would give them*/
+        for(ulIdx = 0u; ulIdx < ulNumber; ulIdx++)
+        {
+            ulBenchPeriodMs[ulIdx] = (ulNumber / 2u) + (BenchRandom() % (ulNumber + 1u));
+            ulBenchIndex[ulIdx]   = ulIdx;
+            ulBenchDueTick[ulIdx] = BenchRandom() % ulBenchPeriodMs[ulIdx];
+            MidSwTimerInit(&stBenchTimer[ulIdx], BenchCallback, &ulBenchIndex[ulIdx], MID_SW_TIMER_ISR);
+            MidSwTimerStart(&stBenchTimer[ulIdx], ulBenchDueTick[ulIdx], ulBenchPeriodMs[ulIdx]);
+        }
+
+
+        ullBenchExpireCnt = 0u;
+        dStart = BenchNowNs();
+
+        for(ulBenchTick = 0u; ulBenchTick < ulTicks; ulBenchTick++)
+        {
+            MidSwTimerProcess(ulBenchNowCnt);
+            ulBenchNowCnt += BENCH_TICK_CNT;
+        }
+
+        dWheelNs = (BenchNowNs() - dStart) / (double)ulTicks;
+
+        /*Restart of a timer with all the others armed, e.g. a timeout fed on every message*/
+        dStart = BenchNowNs();
+
+        for(ulTick = 0u; ulTick < ulTicks; ulTick++)
+        {
+            MidSwTimer *pTimer = &stBenchTimer[ulTick % ulNumber];
+
+            MidSwTimerStop(pTimer);
+            MidSwTimerStart(pTimer, ulBenchPeriodMs[ulTick % ulNumber], ulBenchPeriodMs[ulTick % ulNumber]);
+        }
+
+        dStartStopNs = (BenchNowNs() - dStart) / (double)ulTicks;
+
+        for(ulIdx = 0u; ulIdx < ulNumber; ulIdx++)
+        {
+            MidSwTimerStop(&stBenchTimer[ulIdx]);
+        }
+
+        /*Linear list: every timer compared on every tick*/
+        for(ulIdx = 0u; ulIdx < ulNumber; ulIdx++)
+        {
+            stBenchLinear[ulIdx].ulPeriodTick = ulBenchPeriodMs[ulIdx];
+            stBenchLinear[ulIdx].ulExpireTick = BenchRandom() % ulBenchPeriodMs[ulIdx];
+        }
+
+        dStart = BenchNowNs();
+
+        for(ulTick = 0u; ulTick < ulTicks; ulTick++)
+        {
+            for(ulIdx = 0u; ulIdx < ulNumber; ulIdx++)
+            {
+                if(stBenchLinear[ulIdx].ulExpireTick == ulTick)
+                {
+                    stBenchLinear[ulIdx].ulExpireTick += stBenchLinear[ulIdx].ulPeriodTick;
+                    ullLinearExpire++;
+                }
+            }
+        }
+
+        dLinearNs = (BenchNowNs() - dStart) / (double)ulTicks;
+
+        printf("%8u %10.2f %12.1f %12.1f %14.1f %14.1f\n", (unsigned)ulNumber,
+               (double)ullBenchExpireCnt / (double)ulTicks, dWheelNs,
+               (ullBenchExpireCnt != 0u) ? ((dWheelNs * (double)ulTicks) / (double)ullBenchExpireCnt) : 0.0,
+               dStartStopNs, dLinearNs);
+
+        /*Same load on both sides*/
+        if((ullLinearExpire > (ullBenchExpireCnt + (ullBenchExpireCnt / 10u))) ||
+           (ullBenchExpireCnt > (ullLinearExpire + (ullLinearExpire / 10u))))
+        {
+            printf("linear list expiries %llu, wheel %llu\n", (unsigned long long)ullLinearExpire, (unsigned long long)ullBenchExpireCnt);
+        }
+    }
+
+    printf("%s: %u expiries off their tick\n", (ulBenchErrorCnt == 0u) ? "ok" : "FAIL", (unsigned)ulBenchErrorCnt);
+
+    return (ulBenchErrorCnt == 0u) ? 0 : 1;
+}
+
+/*---------------------Static Function--------------------------*/
+static double BenchNowNs(void)
+{
+    struct timespec stNow;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &stNow);
+
+    return ((double)stNow.tv_sec * 1.0e9) + (double)stNow.tv_nsec;
+}
+
+static void BenchCallback(void *param_Ctx)
+{
+    uint32_t ulIdx = *(const uint32_t *)param_Ctx;
+
+    if(ulBenchTick != ulBenchDueTick[ulIdx])
+    {
+        ulBenchErrorCnt++;
+    }
+
+    ulBenchDueTick[ulIdx] += ulBenchPeriodMs[ulIdx];
+    ullBenchExpireCnt++;
+}
+
+/*xorshift32, the same sequence on every run*/
+static uint32_t BenchRandom(void)
+{
+    ulBenchSeed ^= ulBenchSeed << 13;
+    ulBenchSeed ^= ulBenchSeed >> 17;
+    ulBenchSeed ^= ulBenchSeed << 5;
+
+    return ulBenchSeed;
+}
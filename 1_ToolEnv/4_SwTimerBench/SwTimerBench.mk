@@ -0,0 +1,36 @@
+##################################################################
+#											                     #
+# 				  Sw Timer Bench Config Version 1.0.0 	         #
+#                                                                #
+##################################################################
+#-----------------------------------------------------------------
+#		MidSwTimer wheel benchmark, host tool (gcc)
+#		The IfxCpu.h of the bench directory replaces the iLLD one
+#-----------------------------------------------------------------
+SWTIMERBENCH_CC			= gcc
+SWTIMERBENCH_DIR		= ./1_ToolEnv/4_SwTimerBench
+SWTIMERBENCH_OUT_DIR	= ./Debug/Tools
+SWTIMERBENCH_TARGET		= $(SWTIMERBENCH_OUT_DIR)/SwTimerBench
+
+SWTIMERBENCH_CFLAGS		= -DIFX_HOST_SIM
+SWTIMERBENCH_CFLAGS		+= -O2
+SWTIMERBENCH_CFLAGS		+= -Wall
+SWTIMERBENCH_CFLAGS		+= -std=gnu99
+SWTIMERBENCH_CFLAGS		+= -I$(SWTIMERBENCH_DIR)
+SWTIMERBENCH_CFLAGS		+= -I./1_ToolEnv/1_HostSim
+SWTIMERBENCH_CFLAGS		+= $(patsubst %,-I%,$(INCLUDE))
+
+SWTIMERBENCH_SOURCE		= $(SWTIMERBENCH_DIR)/SwTimerBench.c
+SWTIMERBENCH_SOURCE		+= ./0_Src/Middle/MidSwTimer.c
+
+#-----------------------------------------------------------------
+#		Build targets
+#-----------------------------------------------------------------
+.PHONY: sw-timer-bench
+
+sw-timer-bench: $(SWTIMERBENCH_TARGET)
+
+$(SWTIMERBENCH_TARGET): $(SWTIMERBENCH_SOURCE) ./0_Src/Middle/MidSwTimer.h
+	@if test ! -d $(SWTIMERBENCH_OUT_DIR); then mkdir -p $(SWTIMERBENCH_OUT_DIR);fi
+	@$(SWTIMERBENCH_CC) -o $@ $(SWTIMERBENCH_CFLAGS) $(SWTIMERBENCH_SOURCE)
+	@echo $(notdir $@)
@@ -0,0 +1,267 @@
+/*----------------------------------------------------------------*/
+/*                        Include Header File                          */
+/*----------------------------------------------------------------*/
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "Odom.h"
+
+/*----------------------------------------------------------------*/
+/*                        Define                                        */
+/*----------------------------------------------------------------*/
+/*
+ * Host check of the odometry (0_Src/App/Odom/Odom.c built natively).
+ *
+ * Each profile drives synthetic left/right wheel speeds, constant over a
+ * step, into OdomStep and into a double precision reference that moves the
+ * car on the exact arc of every step. The pose drift is the distance between
+ * the two, checked against CHECK_DRIFT_PER_M of the path length. For
+ * comparison the same steps are run with libm sinf/cosf, a float heading and
+ * plain sums (libm column and the second time).
+ *
+ * usage: OdomCheck
+ */
+#define CHECK_TS                    0.005f      /*MOTOR_CTRL_PERIOD_S*/
+#define CHECK_TRACK_M               0.170f      /*MOTOR_TRACK_WIDTH_M*/
+#define CHECK_DRIFT_PER_M           1.0e-5      /*Allowed position error per m driven*/
+#define CHECK_HEADING_MAX_RAD       1.0e-4
+#define CHECK_PI                    3.14159265358979323846
+#define CHECK_TIME_STEPS            2000000u
+
+/*----------------------------------------------------------------*/
+/*                        Typedefs                                    */
+/*----------------------------------------------------------------*/
+typedef void (*CheckProfile)(double param_Time, float32_t *param_Left, float32_t *param_Right);
+
+typedef struct
+{
+    const char *pName;
+    CheckProfile pProfile;
+    double dTime;                       /*s*/
+    double dHeading;                    /*Start heading, rad*/
+}CheckCase;
+
+typedef struct
+{
+    double dX;
+    double dY;
+    double dHeading;
+}CheckPose;
+
+/*----------------------------------------------------------------*/
+/*                        Static Function Prototype                  */
+/*----------------------------------------------------------------*/
+static void CheckStraight(double param_Time, float32_t *param_Left, float32_t *param_Right);
+static void CheckCircle(double param_Time, float32_t *param_Left, float32_t *param_Right);
+static void CheckSpin(double param_Time, float32_t *param_Left, float32_t *param_Right);
+static void CheckSlalom(double param_Time, float32_t *param_Left, float32_t *param_Right);
+static void CheckDrive(double param_Time, float32_t *param_Left, float32_t *param_Right);
+static void CheckRefStep(CheckPose *param_Pose, double param_Left, double param_Right);
+static void CheckLibmStep(Odom *param_Odom, float32_t *param_Heading, float32_t param_Left, float32_t param_Right);
+static double CheckWrap(double param_Angle);
+static double CheckNowNs(void);
+
+/*----------------------------------------------------------------*/
+/*                        Variables                                    */
+/*----------------------------------------------------------------*/
+static const CheckCase stCheckCase[] =
+{
+    {"straight",    CheckStraight,  60.0,   0.3},
+    {"circle x10",  CheckCircle,    0.0,    0.0},      /*dTime set from the turn time*/
+    {"spin",        CheckSpin,      30.0,   -2.0},
+    {"slalom",      CheckSlalom,    120.0,  1.0},
+    {"drive",       CheckDrive,     600.0,  0.0},
+};
+
+static const OdomConfig stCheckCfg = {CHECK_TRACK_M, CHECK_TS};
+
+
+/*----------------------------------------------------------------*/
+/*                        Functions                                    */
+/*----------------------------------------------------------------*/
+int main(void)
+{
+    uint32_t ulFailCnt = 0u;
+    uint32_t ulCase;
+
+    printf("%-11s %9s %10s %12s %12s %12s %12s\n", "profile", "path m", "steps", "lut err m", "lut err/m", "libm err m", "heading rad");
+
+    for(ulCase = 0u; ulCase < (sizeof(stCheckCase) / sizeof(stCheckCase[0])); ulCase++)
+    {
+        const CheckCase *pCase = &stCheckCase[ulCase];
+        double dTime = pCase->dTime;
+        uint32_t ulSteps;
+        uint32_t ulStep;
+        Odom stOdom;
+        Odom stLibm;
+        float32_t fLibmHeading = (float32_t)pCase->dHeading;
+        CheckPose stRef = {0.0, 0.0, pCase->dHeading};
+        double dPath = 0.0;
+        double dErrMax = 0.0;
+        double dLibmErrMax = 0.0;
+        double dHeadingErr;
+        boolean bOk;
+
+        if(pCase->pProfile == CheckCircle)
+        {
+            float32_t fLeft;
+            float32_t fRight;
+
+            CheckCircle(0.0, &fLeft, &fRight);
+            dTime = 10.0 * (2.0 * CHECK_PI * CHECK_TRACK_M) / ((double)fRight - (double)fLeft);
+        }
+
+        ulSteps = (uint32_t)((dTime / CHECK_TS) + 0.5);
+
+        OdomInit(&stOdom, &stCheckCfg);
+        OdomReset(&stOdom, 0.0f, 0.0f, (float32_t)pCase->dHeading);
+        stLibm = stOdom;
+
+        for(ulStep = 0u; ulStep < ulSteps; ulStep++)
+        {
+            float32_t fLeft;
+            float32_t fRight;
+            double dErr;
+
+            pCase->pProfile((double)ulStep * CHECK_TS, &fLeft, &fRight);
+
+            OdomStep(&stOdom, fLeft, fRight);
+            CheckLibmStep(&stLibm, &fLibmHeading, fLeft, fRight);
+            CheckRefStep(&stRef, fLeft, fRight);
+            dPath += fabs(((double)fLeft + (double)fRight) * 0.5 * CHECK_TS);
+
+            dErr = hypot((double)stOdom.fX - stRef.dX, (double)stOdom.fY - stRef.dY);
+            dErrMax = (dErr > dErrMax) ? dErr : dErrMax;
+            dErr = hypot((double)stLibm.fX - stRef.dX, (double)stLibm.fY - stRef.dY);
+            dLibmErrMax = (dErr > dLibmErrMax) ? dErr : dLibmErrMax;
+        }
+
+        dHeadingErr = fabs(CheckWrap((double)OdomGetHeadingRad(&stOdom) - stRef.dHeading));
+        bOk = ((dErrMax <= (CHECK_DRIFT_PER_M * (dPath + 1.0))) && (dHeadingErr <= CHECK_HEADING_MAX_RAD)) ? TRUE : FALSE;
+        ulFailCnt += (bOk != FALSE) ? 0u : 1u;
+
+        printf("%-11s %9.1f %10u %12.2e %12.2e %12.2e %12.2e %s\n", pCase->pName, dPath, (unsigned)ulSteps,
+               dErrMax, (dPath > 0.0) ? (dErrMax / dPath) : 0.0, dLibmErrMax, dHeadingErr, (bOk != FALSE) ? "" : "FAIL");
+    }
+
+    /*Cost per step*/
+    {
+        Odom stOdom;
+        float32_t fHeading = 0.0f;
+        double dStart;
+        double dLutNs;
+        double dLibmNs;
+        uint32_t ulStep;
+
+        OdomInit(&stOdom, &stCheckCfg);
+        dStart = CheckNowNs();
+        for(ulStep = 0u; ulStep < CHECK_TIME_STEPS; ulStep++)
+        {
+            OdomStep(&stOdom, 0.50f, 0.52f + (float32_t)(ulStep & 7u) * 0.01f);
+        }
+        dLutNs = (CheckNowNs() - dStart) / CHECK_TIME_STEPS;
+
+        OdomInit(&stOdom, &stCheckCfg);
+        dStart = CheckNowNs();
+        for(ulStep = 0u; ulStep < CHECK_TIME_STEPS; ulStep++)
+        {
+            CheckLibmStep(&stOdom, &fHeading, 0.50f, 0.52f + (float32_t)(ulStep & 7u) * 0.01f);
+        }
+        dLibmNs = (CheckNowNs() - dStart) / CHECK_TIME_STEPS;
+
+        printf("OdomStep %.1f ns/step, libm sinf/cosf %.1f ns/step (x=%g)\n", dLutNs, dLibmNs, (double)stOdom.fX);
+    }
+
+    printf("%s: %u profiles over the drift limit\n", (ulFailCnt == 0u) ? "ok" : "FAIL", (unsigned)ulFailCnt);
+
+    return (ulFailCnt == 0u) ? 0 : 1;
+}
+
+/*---------------------Wheel Profiles--------------------------*/
+/*Wheel speeds in m/s, around the 80 rpm of the speed loop (0.27 m/s)*/
+static void CheckStraight(double param_Time, float32_t *param_Left, float32_t *param_Right)
+{
+    (void)param_Time;
+    *param_Left  = 0.5f;
+    *param_Right = 0.5f;
+}
+
+static void CheckCircle(double param_Time, float32_t *param_Left, float32_t *param_Right)
+{
+    (void)param_Time;
+    *param_Left  = 0.25f;
+    *param_Right = 0.35f;
+}
+
+static void CheckSpin(double param_Time, float32_t *param_Left, float32_t *param_Right)
+{
+    (void)param_Time;
+    *param_Left  = -0.3f;
+    *param_Right = 0.3f;
+}
+
+static void CheckSlalom(double param_Time, float32_t *param_Left, float32_t *param_Right)
+{
+    float32_t fSteer = (float32_t)(0.08 * sin(2.0 * CHECK_PI * 0.25 * param_Time));
+
+    *param_Left  = 0.4f - fSteer;
+    *param_Right = 0.4f + fSteer;
+}
+
+/*Accelerations, turns both ways and reversing*/
+static void CheckDrive(double param_Time, float32_t *param_Left, float32_t *param_Right)
+{
+    double dSpeed = 0.3 * sin(2.0 * CHECK_PI * 0.013 * param_Time) + 0.1 * sin(2.0 * CHECK_PI * 0.11 * param_Time);
+    double dSteer = 0.12 * sin(2.0 * CHECK_PI * 0.047 * param_Time) * cos(2.0 * CHECK_PI * 0.007 * param_Time);
+
+    *param_Left  = (float32_t)(dSpeed - dSteer);
+    *param_Right = (float32_t)(dSpeed + dSteer);
+}
+
+/*---------------------Static Function--------------------------*/
+/*Exact arc of one step in double*/
+static void CheckRefStep(CheckPose *param_Pose, double param_Left, double param_Right)
+{
+    double dSpeed = (param_Left + param_Right) * 0.5;
+    double dRate  = (param_Right - param_Left) / CHECK_TRACK_M;
+    double dNext  = param_Pose->dHeading + (dRate * CHECK_TS);
+
+    if(fabs(dRate) < 1.0e-12)
+    {
+        param_Pose->dX += dSpeed * CHECK_TS * cos(param_Pose->dHeading);
+        param_Pose->dY += dSpeed * CHECK_TS * sin(param_Pose->dHeading);
+    }
+    else
+    {
+        param_Pose->dX += (dSpeed / dRate) * (sin(dNext) - sin(param_Pose->dHeading));
+        param_Pose->dY -= (dSpeed / dRate) * (cos(dNext) - cos(param_Pose->dHeading));
+    }
+
+    param_Pose->dHeading = dNext;
+}
+
+/*OdomStep with a float heading and libm, for comparison*/
+static void CheckLibmStep(Odom *param_Odom, float32_t *param_Heading, float32_t param_Left, float32_t param_Right)
+{
+    float32_t fDelta = ((param_Right - param_Left) * CHECK_TS) / CHECK_TRACK_M;
+    float32_t fDist  = (param_Left + param_Right) * 0.5f * CHECK_TS * (1.0f - ((fDelta * fDelta) * (1.0f / 24.0f)));
+    float32_t fMid   = *param_Heading + (0.5f * fDelta);
+
+    param_Odom->fX += fDist * cosf(fMid);
+    param_Odom->fY += fDist * sinf(fMid);
+    *param_Heading += fDelta;
+}
+
+static double CheckWrap(double param_Angle)
+{
+    return param_Angle - (2.0 * CHECK_PI * floor((param_Angle + CHECK_PI) / (2.0 * CHECK_PI)));
+}
+
+static double CheckNowNs(void)
+{
+    struct timespec stNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &stNow);
+
+    return ((double)stNow.tv_sec * 1.0e9) + (double)stNow.tv_nsec;
+}
@@ -0,0 +1,41 @@
+##################################################################
+#											                     #
+# 				  Odom Check Config Version 1.0.0 		         #
+#                                                                #
+##################################################################
+#-----------------------------------------------------------------
+#		Odometry drift check, host tool (gcc)
+#		Odom.c and the iLLD sin/cos table are built unchanged
+#-----------------------------------------------------------------
+ODOMCHECK_CC			= gcc
+ODOMCHECK_DIR			= ./1_ToolEnv/5_OdomCheck
+ODOMCHECK_OUT_DIR		= ./Debug/Tools
+ODOMCHECK_TARGET		= $(ODOMCHECK_OUT_DIR)/OdomCheck
+ODOMCHECK_MATH_DIR		= ./2_ILLD/iLLD/Service/CpuGeneric/SysSe/Math
+
+ODOMCHECK_CFLAGS		= -DIFX_HOST_SIM
+ODOMCHECK_CFLAGS		+= -O2
+ODOMCHECK_CFLAGS		+= -Wall
+ODOMCHECK_CFLAGS		+= -Wno-pointer-to-int-cast
+ODOMCHECK_CFLAGS		+= -Wno-int-to-pointer-cast
+ODOMCHECK_CFLAGS		+= -std=gnu99
+ODOMCHECK_CFLAGS		+= -fgnu89-inline
+ODOMCHECK_CFLAGS		+= -I./1_ToolEnv/1_HostSim
+ODOMCHECK_CFLAGS		+= $(patsubst %,-I%,$(INCLUDE))
+
+ODOMCHECK_SOURCE		= $(ODOMCHECK_DIR)/OdomCheck.c
+ODOMCHECK_SOURCE		+= ./0_Src/App/Odom/Odom.c
+ODOMCHECK_SOURCE		+= $(ODOMCHECK_MATH_DIR)/Ifx_LutSincosF32.c
+ODOMCHECK_SOURCE		+= $(ODOMCHECK_MATH_DIR)/Ifx_LutSincosF32_Table.c
+
+#-----------------------------------------------------------------
+#		Build targets
+#-----------------------------------------------------------------
+.PHONY: odom-check
+
+odom-check: $(ODOMCHECK_TARGET)
+
+$(ODOMCHECK_TARGET): $(ODOMCHECK_SOURCE) ./0_Src/App/Odom/Odom.h
+	@if test ! -d $(ODOMCHECK_OUT_DIR); then mkdir -p $(ODOMCHECK_OUT_DIR);fi
+	@$(ODOMCHECK_CC) -o $@ $(ODOMCHECK_CFLAGS) $(ODOMCHECK_SOURCE) -lm
+	@echo $(notdir $@)
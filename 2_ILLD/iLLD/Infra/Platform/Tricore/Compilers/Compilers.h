@@ -58,7 +58,10 @@
 #define CFG_LONG_SIZE_T (0)
 #endif
 
-#if defined(__DCC__)
+#if defined(IFX_HOST_SIM)
+#include "CompilerHostSim.h"
+
+#elif defined(__DCC__)
 #include "CompilerDcc.h"
 
 #elif defined(__GNUC__)
@@ -94,7 +97,11 @@
 #error "Compiler unsupported"
 #endif
 
-#if defined(__GNUC__)
+#if defined(IFX_HOST_SIM)
+#define BEGIN_DATA_SECTION(sec)
+#define DATA_SECTION(sec)
+#define END_DATA_SECTION
+#elif defined(__GNUC__)
 #define BEGIN_DATA_SECTION(sec) DATA_SECTION(section #sec aw 4)
 #define DATA_SECTION(sec) _Pragma(#sec)
 #define END_DATA_SECTION DATA_SECTION(section)
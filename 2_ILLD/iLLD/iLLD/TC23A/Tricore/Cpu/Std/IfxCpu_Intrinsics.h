@@ -29,7 +29,10 @@
 /******************************************************************************/
 #include "Ifx_Types.h"
 
-#if defined(__DCC__)
+#if defined(IFX_HOST_SIM)
+#include "IfxCpu_IntrinsicsHostSim.h"
+
+#elif defined(__DCC__)
 #include "IfxCpu_IntrinsicsDcc.h"
 
 #elif defined(__GNUC__)
@@ -169,7 +169,10 @@ typedef enum
     Ifx_Pwm_Mode_count                      /**< \brief Number of defined modes */
 } Ifx_Pwm_Mode;
 
-#ifdef __DCC__
+#if defined(IFX_HOST_SIM)
+#include "Ifx_TypesHostSim.h"
+
+#elif defined(__DCC__)
 #include "Ifx_TypesDcc.h"
 
 #elif defined(__TASKING__)
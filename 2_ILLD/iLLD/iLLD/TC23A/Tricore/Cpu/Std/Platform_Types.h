@@ -88,8 +88,13 @@ typedef signed char    int8_t;               /*        -128 .. +127            *
 typedef unsigned char  uint8_t;               /*           0 .. 255             */
 typedef signed short   int16_t;              /*      -32768 .. +32767          */
 typedef unsigned short uint16_t;              /*           0 .. 65535           */
+#if defined(IFX_HOST_SIM)                    /* LP64 host: long is 64 bit      */
+typedef signed int     int32_t;              /* -2147483648 .. +2147483647     */
+typedef unsigned int   uint32_t;              /*           0 .. 4294967295      */
+#else
 typedef signed long    int32_t;              /* -2147483648 .. +2147483647     */
 typedef unsigned long  uint32_t;              /*           0 .. 4294967295      */
+#endif
 typedef float          float32_t;
 typedef double         float64_t;
 
@@ -101,8 +106,13 @@ typedef signed char    sint8;               /*        -128 .. +127            */
 typedef unsigned char  uint8;               /*           0 .. 255             */
 typedef signed short   sint16;              /*      -32768 .. +32767          */
 typedef unsigned short uint16;              /*           0 .. 65535           */
+#if defined(IFX_HOST_SIM)                   /* LP64 host: long is 64 bit      */
+typedef signed int     sint32;              /* -2147483648 .. +2147483647     */
+typedef unsigned int   uint32;              /*           0 .. 4294967295      */
+#else
 typedef signed long    sint32;              /* -2147483648 .. +2147483647     */
 typedef unsigned long  uint32;              /*           0 .. 4294967295      */
+#endif
 typedef float          float32;
 typedef double         float64;
 
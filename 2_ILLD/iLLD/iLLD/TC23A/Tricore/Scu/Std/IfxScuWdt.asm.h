@@ -48,7 +48,7 @@ IFX_INLINE uint16 IfxScuWdt_calculateLfsr(uint16 password);
 /**
  * \brief SCUWDT Inline API utility to Calculte new 14-bit LFSR.
  */
-#if defined(__GNUC__)
+#if defined(__GNUC__) && !defined(IFX_HOST_SIM)
 IFX_INLINE uint16 IfxScuWdt_calculateLfsr(uint16 password)
 {
     /* *INDENT-OFF* */
@@ -66,7 +66,7 @@ IFX_INLINE uint16 IfxScuWdt_calculateLfsr(uint16 password)
 
 
 #endif
-#if defined(__TASKING__)
+#if defined(__TASKING__) || defined(IFX_HOST_SIM)
 IFX_INLINE uint16 IfxScuWdt_calculateLfsr(uint16 password)
 {
     /* *INDENT-OFF* */